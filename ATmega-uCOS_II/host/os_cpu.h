@@ -0,0 +1,82 @@
+/*
+*********************************************************************************************************
+*                                              uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                                   Hosted (POSIX ucontext) Specific code
+*
+* File     : OS_CPU.H
+*
+* Note(s)  : 1) All tasks run in one thread of the host process.  Every task has its own ucontext and its
+*               own stack, allocated by OSTaskStkInit().  The stack passed to OSTaskCreate() is not used.
+*            2) There is no timer interrupt.  The idle task raises a clock tick with OSTaskIdleHook(), so
+*               time only advances when all tasks wait.
+*            3) The makefile force includes this file so that it takes the place of ../inc/OS_CPU.H.
+*********************************************************************************************************
+*/
+
+#ifndef _OS_CPU_H_
+#define _OS_CPU_H_
+
+#define  OS_CRITICAL_METHOD    1
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef unsigned char      BOOLEAN;
+typedef unsigned char      INT8U;                /* Unsigned  8 bit quantity                            */
+typedef signed   char      INT8S;                /* Signed    8 bit quantity                            */
+typedef unsigned short     INT16U;               /* Unsigned 16 bit quantity                            */
+typedef signed   short     INT16S;               /* Signed   16 bit quantity                            */
+typedef unsigned int       INT32U;               /* Unsigned 32 bit quantity                            */
+typedef signed   int       INT32S;               /* Signed   32 bit quantity                            */
+typedef float              FP32;                 /* Single precision floating point                     */
+
+typedef unsigned char      OS_STK;               /* Stack entries are not used by the hosted port       */
+typedef unsigned int       OS_CPU_SR;
+
+/*
+*********************************************************************************************************
+*                                          CRITICAL SECTIONS
+*
+* Note(s)  : 1) Nothing can interrupt a task, the clock tick is raised by the idle task.
+*********************************************************************************************************
+*/
+
+#if      OS_CRITICAL_METHOD == 1
+#define  OS_ENTER_CRITICAL()
+#define  OS_EXIT_CRITICAL()
+#endif
+
+/*
+*********************************************************************************************************
+*                                           MISCELLANEOUS
+*********************************************************************************************************
+*/
+
+#define  OS_STK_GROWTH      1
+#define  OS_TASK_SW()       OSCtxSw()
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  INT32U              OSHostTickCtr;       /* Number of clock ticks raised by the idle task       */
+extern  unsigned long long  OSHostTickTime;      /* Time in ns spent in OSTimeTick() for all ticks      */
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void       OSStartHighRdy(void);
+void       OSCtxSw(void);
+void       OSIntCtxSw(void);
+
+#endif /*_OS_CPU_H_*/
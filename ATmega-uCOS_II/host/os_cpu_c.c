@@ -0,0 +1,188 @@
+/*
+*********************************************************************************************************
+*                                              uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                                   Hosted (POSIX ucontext) Specific code
+*
+* File     : OS_CPU_C.C
+*********************************************************************************************************
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include <ucontext.h>
+#include "ucos_ii.h"
+
+/*
+*********************************************************************************************************
+*                                         LOCAL CONSTANTS/TYPES
+*********************************************************************************************************
+*/
+
+#define  OS_HOST_STK_SIZE   65536                /* Size of the host stack of every task (bytes)        */
+
+typedef struct os_host_ctx {
+    ucontext_t   Ctx;                            /* Saved context of the task                           */
+    void       (*Task)(void *p_arg);             /* Task function and its argument, for the first run   */
+    void        *Arg;
+} OS_HOST_CTX;
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+INT32U              OSHostTickCtr;
+unsigned long long  OSHostTickTime;
+
+/*
+*********************************************************************************************************
+*                                            TASK ENTRY
+*
+* Description: Every task context starts here.  OSTCBCur already points to the TCB of the new task.
+*********************************************************************************************************
+*/
+
+static  void  OS_HostTaskEntry (void)
+{
+    OS_HOST_CTX  *pctx;
+
+
+    pctx = (OS_HOST_CTX *)OSTCBCur->OSTCBStkPtr;
+    pctx->Task(pctx->Arg);
+    for (;;) {                                   /* Tasks must not return                               */
+        OSTaskSuspend(OS_PRIO_SELF);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                              HOOKS
+*********************************************************************************************************
+*/
+
+void  OSInitHookBegin (void)
+{
+    OSHostTickCtr  = 0;
+    OSHostTickTime = 0;
+}
+
+void  OSInitHookEnd (void)
+{
+}
+
+void  OSTaskCreateHook (OS_TCB *ptcb)
+{
+    ptcb = ptcb;                                 /* Prevent compiler warning                            */
+}
+
+void  OSTaskDelHook (OS_TCB *ptcb)
+{
+    if (ptcb != OSTCBCur) {                      /* A task that deletes itself still runs on its stack  */
+        free(ptcb->OSTCBStkPtr);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                             IDLE TASK HOOK
+*
+* Description: Raises a clock tick like the ticker ISR would do and measures the time spent in
+*              OSTimeTick().
+*********************************************************************************************************
+*/
+
+void  OSTaskIdleHook (void)
+{
+    struct timespec  start;
+    struct timespec  stop;
+
+
+    OSIntEnter();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    OSTimeTick();
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    OSHostTickCtr++;
+    OSHostTickTime += (unsigned long long)(stop.tv_sec - start.tv_sec) * 1000000000ULL
+                    + stop.tv_nsec - start.tv_nsec;
+    OSIntExit();
+}
+
+void  OSTaskStatHook (void)
+{
+}
+
+void  OSTaskSwHook (void)
+{
+}
+
+void  OSTCBInitHook (OS_TCB *ptcb)
+{
+    ptcb = ptcb;                                 /* Prevent compiler warning                            */
+}
+
+void  OSTimeTickHook (void)
+{
+}
+
+/*
+*********************************************************************************************************
+*                                        INITIALIZE A TASK'S STACK
+*
+* Description: Allocates the context and the host stack of a task.  The returned pointer is stored in
+*              OSTCBStkPtr and is used by the context switch functions below.
+*********************************************************************************************************
+*/
+
+OS_STK  *OSTaskStkInit (void (*task)(void *pd), void *p_arg, OS_STK *ptos, INT16U opt)
+{
+    OS_HOST_CTX  *pctx;
+
+
+    ptos = ptos;                                 /* Prevent compiler warning                            */
+    opt  = opt;
+    pctx = (OS_HOST_CTX *)malloc(sizeof(OS_HOST_CTX) + OS_HOST_STK_SIZE);
+    if (pctx == (OS_HOST_CTX *)0) {
+        abort();
+    }
+    pctx->Task = task;
+    pctx->Arg  = p_arg;
+    getcontext(&pctx->Ctx);
+    pctx->Ctx.uc_stack.ss_sp   = pctx + 1;
+    pctx->Ctx.uc_stack.ss_size = OS_HOST_STK_SIZE;
+    pctx->Ctx.uc_link          = (ucontext_t *)0;
+    makecontext(&pctx->Ctx, OS_HostTaskEntry, 0);
+    return ((OS_STK *)pctx);
+}
+
+/*
+*********************************************************************************************************
+*                                          CONTEXT SWITCHES
+*********************************************************************************************************
+*/
+
+void  OSStartHighRdy (void)
+{
+    OSTaskSwHook();
+    OSRunning = OS_TRUE;
+    setcontext(&((OS_HOST_CTX *)OSTCBHighRdy->OSTCBStkPtr)->Ctx);
+}
+
+void  OSCtxSw (void)
+{
+    OS_TCB  *ptcb;
+
+
+    OSTaskSwHook();
+    ptcb      = OSTCBCur;
+    OSTCBCur  = OSTCBHighRdy;
+    OSPrioCur = OSPrioHighRdy;
+    swapcontext(&((OS_HOST_CTX *)ptcb->OSTCBStkPtr)->Ctx, &((OS_HOST_CTX *)OSTCBCur->OSTCBStkPtr)->Ctx);
+}
+
+void  OSIntCtxSw (void)
+{
+    OSCtxSw();                                   /* The tick runs on the stack of the idle task         */
+}
@@ -0,0 +1,350 @@
+/*
+*********************************************************************************************************
+*                                              uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                                  Tick list test and OSTimeTick() benchmark
+*
+* File     : TICK_TEST.C
+*
+* Note(s)  : 1) The first part checks that delays and pend timeouts expire on the right tick, also when
+*               tasks are readied early, resumed or deleted.
+*            2) The second part measures the time spent in OSTimeTick() per clock tick with a growing
+*               number of tasks.  Build with TICK_LIST=0 to compare with the scan of all TCBs.
+*********************************************************************************************************
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ucos_ii.h"
+
+/*
+*********************************************************************************************************
+*                                              CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  TASK_STK_SIZE          16               /* The hosted port allocates its own stacks            */
+
+#define  CTRL_PRIO               5
+#define  MUTEX_PIP               4
+#define  WORK_PRIO              10               /* Priority of the first worker task                   */
+#define  BENCH_PRIO             20               /* Priority of the first benchmark task                */
+
+#define  N_WORK                  8
+#define  N_BENCH_MAX           200
+#define  N_BENCH_TICKS       10000
+
+#define  WORK_DLY                0               /* Operations of the worker tasks                      */
+#define  WORK_SEM                1
+#define  WORK_MBOX               2
+#define  WORK_Q                  3
+#define  WORK_FLAG               4
+#define  WORK_MUTEX              5
+
+#define  BENCH_EVENT             0               /* Benchmark tasks wait for an event forever           */
+#define  BENCH_LONG              1               /* Benchmark tasks wait longer than the benchmark      */
+#define  BENCH_PERIODIC          2               /* Benchmark tasks wake every 1..16 ticks              */
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct work {
+    OS_EVENT  *Start;                            /* Semaphore to start the operation                    */
+    INT8U      Op;
+    INT16U     Ticks;                            /* Delay or timeout of the operation                   */
+    INT8U      Err;
+    BOOLEAN    Done;
+    INT32U     Begin;                            /* Tick at the start and the end of the operation      */
+    INT32U     End;
+} WORK;
+
+/*
+*********************************************************************************************************
+*                                              VARIABLES
+*********************************************************************************************************
+*/
+
+static  OS_STK      CtrlStk[TASK_STK_SIZE];
+static  OS_STK      WorkStk[N_WORK][TASK_STK_SIZE];
+static  OS_STK      BenchStk[N_BENCH_MAX][TASK_STK_SIZE];
+
+static  WORK        Work[N_WORK];
+
+static  OS_EVENT   *SemTest;
+static  OS_EVENT   *MboxTest;
+static  OS_EVENT   *QTest;
+static  void       *QTestTbl[4];
+static  OS_FLAG_GRP *FlagTest;
+static  OS_EVENT   *MutexTest;
+static  OS_EVENT   *SemBench;
+
+static  INT8U       BenchMode;
+static  INT32U      Failures;
+
+/*
+*********************************************************************************************************
+*                                            HELPER FUNCTIONS
+*********************************************************************************************************
+*/
+
+static  void  Check (const char *name, BOOLEAN passed)
+{
+    printf("%-68s %s\n", name, passed ? "PASS" : "FAIL");
+    if (passed == OS_FALSE) {
+        Failures++;
+    }
+}
+
+static  void  WorkStart (INT8U i, INT8U op, INT16U ticks)
+{
+    Work[i].Op    = op;
+    Work[i].Ticks = ticks;
+    Work[i].Err   = 0xFF;
+    Work[i].Done  = OS_FALSE;
+    OSSemPost(Work[i].Start);
+}
+
+static  BOOLEAN  WorkWaited (INT8U i, INT8U err, INT32U ticks)
+{
+    return ((Work[i].Done == OS_TRUE) && (Work[i].Err == err) && (Work[i].End - Work[i].Begin == ticks));
+}
+
+static  unsigned long long  Now (void)
+{
+    struct timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/*
+*********************************************************************************************************
+*                                                TASKS
+*********************************************************************************************************
+*/
+
+static  void  WorkTask (void *p_arg)
+{
+    WORK   *pwork;
+    INT8U   err;
+
+
+    pwork = (WORK *)p_arg;
+    for (;;) {
+        OSSemPend(pwork->Start, 0, &err);
+        pwork->Begin = OSTimeGet();
+        switch (pwork->Op) {
+            case WORK_DLY:
+                 OSTimeDly(pwork->Ticks);
+                 pwork->Err = OS_ERR_NONE;
+                 break;
+
+            case WORK_SEM:
+                 OSSemPend(SemTest, pwork->Ticks, &pwork->Err);
+                 break;
+
+            case WORK_MBOX:
+                 (void)OSMboxPend(MboxTest, pwork->Ticks, &pwork->Err);
+                 break;
+
+            case WORK_Q:
+                 (void)OSQPend(QTest, pwork->Ticks, &pwork->Err);
+                 break;
+
+            case WORK_FLAG:
+                 (void)OSFlagPend(FlagTest, 0x01, OS_FLAG_WAIT_SET_ALL + OS_FLAG_CONSUME, pwork->Ticks, &pwork->Err);
+                 break;
+
+            case WORK_MUTEX:
+                 OSMutexPend(MutexTest, pwork->Ticks, &pwork->Err);
+                 if (pwork->Err == OS_ERR_NONE) {
+                     (void)OSMutexPost(MutexTest);
+                 }
+                 break;
+        }
+        pwork->End  = OSTimeGet();
+        pwork->Done = OS_TRUE;
+    }
+}
+
+static  void  BenchTask (void *p_arg)
+{
+    INT16U  period;
+    INT8U   err;
+
+
+    period = (INT16U)(INT32U)(size_t)p_arg;
+    for (;;) {
+        switch (BenchMode) {
+            case BENCH_EVENT:
+                 OSSemPend(SemBench, 0, &err);
+                 break;
+
+            case BENCH_LONG:
+                 OSTimeDly(60000);
+                 break;
+
+            case BENCH_PERIODIC:
+                 OSTimeDly(period);
+                 break;
+        }
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                                TESTS
+*********************************************************************************************************
+*/
+
+static  void  TestTimeouts (void)
+{
+    INT8U  i;
+
+
+    WorkStart(0, WORK_DLY,   5);                 /* Equal, shorter and longer delays next to timeouts   */
+    WorkStart(1, WORK_DLY,   3);
+    WorkStart(2, WORK_DLY,   5);
+    WorkStart(3, WORK_SEM,   7);
+    WorkStart(4, WORK_MBOX,  1);
+    WorkStart(5, WORK_Q,     6);
+    WorkStart(6, WORK_FLAG,  9);
+    WorkStart(7, WORK_MUTEX, 3);
+    OSTimeDly(20);
+    Check("OSTimeDly() wakes each task after its own delay",
+          WorkWaited(0, OS_ERR_NONE, 5) && WorkWaited(1, OS_ERR_NONE, 3) && WorkWaited(2, OS_ERR_NONE, 5));
+    Check("OSSemPend() times out after its timeout",   WorkWaited(3, OS_ERR_TIMEOUT, 7));
+    Check("OSMboxPend() times out after its timeout",  WorkWaited(4, OS_ERR_TIMEOUT, 1));
+    Check("OSQPend() times out after its timeout",     WorkWaited(5, OS_ERR_TIMEOUT, 6));
+    Check("OSFlagPend() times out after its timeout",  WorkWaited(6, OS_ERR_TIMEOUT, 9));
+    Check("OSMutexPend() times out after its timeout", WorkWaited(7, OS_ERR_TIMEOUT, 3));
+
+    WorkStart(0, WORK_SEM,  10);                 /* Ready pending tasks before their timeout            */
+    WorkStart(1, WORK_DLY,  12);
+    WorkStart(2, WORK_DLY,  10);
+    WorkStart(3, WORK_FLAG, 10);
+    WorkStart(4, WORK_Q,    10);
+    WorkStart(5, WORK_MBOX, 11);
+    OSTimeDly(4);
+    OSSemPost(SemTest);
+    (void)OSFlagPost(FlagTest, 0x01, OS_FLAG_SET, &i);
+    (void)OSQPost(QTest, (void *)&Work[4]);
+    OSMboxPendAbort(MboxTest, OS_PEND_OPT_NONE, &i);
+    OSTimeDly(20);
+    Check("A post before the timeout readies the pending task",
+          WorkWaited(0, OS_ERR_NONE, 4) && WorkWaited(3, OS_ERR_NONE, 4) && WorkWaited(4, OS_ERR_NONE, 4));
+    Check("An abort before the timeout readies the pending task", WorkWaited(5, OS_ERR_PEND_ABORT, 4));
+    Check("Delays behind readied tasks still expire on time",
+          WorkWaited(1, OS_ERR_NONE, 12) && WorkWaited(2, OS_ERR_NONE, 10));
+
+    WorkStart(0, WORK_DLY, 10);                  /* Resume a delayed task early                         */
+    WorkStart(1, WORK_DLY, 15);
+    OSTimeDly(3);
+    Check("OSTimeDlyResume() accepts a delayed task", OSTimeDlyResume(WORK_PRIO + 0) == OS_ERR_NONE);
+    Check("OSTimeDlyResume() rejects a task that is not delayed",
+          OSTimeDlyResume(WORK_PRIO + 2) == OS_ERR_TIME_NOT_DLY);
+    OSTimeDly(20);
+    Check("OSTimeDlyResume() ends the delay at once", WorkWaited(0, OS_ERR_NONE, 3));
+    Check("Delays behind a resumed task still expire on time", WorkWaited(1, OS_ERR_NONE, 15));
+
+    WorkStart(0, WORK_SEM, 0);                   /* No timeout                                          */
+    OSTimeDly(100);
+    Check("A task pending without timeout is not timed out", Work[0].Done == OS_FALSE);
+    OSSemPost(SemTest);
+    OSTimeDly(1);
+    Check("A task pending without timeout gets the post", WorkWaited(0, OS_ERR_NONE, 100));
+
+    WorkStart(0, WORK_DLY, 5);                   /* Delay expires while the task is suspended           */
+    OSTimeDly(1);
+    (void)OSTaskSuspend(WORK_PRIO + 0);
+    OSTimeDly(10);
+    Check("A suspended task stays suspended after its delay", Work[0].Done == OS_FALSE);
+    (void)OSTaskResume(WORK_PRIO + 0);
+    OSTimeDly(1);
+    Check("OSTaskResume() readies a task whose delay has expired", WorkWaited(0, OS_ERR_NONE, 11));
+
+    WorkStart(0, WORK_DLY, 10);                  /* Delete a delayed task                               */
+    WorkStart(1, WORK_DLY, 20);
+    OSTimeDly(2);
+    Check("OSTaskDel() deletes a delayed task", OSTaskDel(WORK_PRIO + 0) == OS_ERR_NONE);
+    OSTimeDly(30);
+    Check("Delays behind a deleted task still expire on time", WorkWaited(1, OS_ERR_NONE, 20));
+}
+
+/*
+*********************************************************************************************************
+*                                              BENCHMARK
+*********************************************************************************************************
+*/
+
+static  void  Bench (const char *name, INT8U mode)
+{
+    static  const  INT16U  ntasks[] = {0, 10, 50, 200};
+    unsigned long long     start;
+    INT8U                  i;
+    INT16U                 n;
+
+
+    printf("%-24s", name);
+    for (i = 0; i < sizeof(ntasks) / sizeof(ntasks[0]); i++) {
+        BenchMode = mode;
+        for (n = 0; n < ntasks[i]; n++) {
+            (void)OSTaskCreate(BenchTask, (void *)(size_t)(1 + n % 16), &BenchStk[n][TASK_STK_SIZE - 1],
+                               (INT8U)(BENCH_PRIO + n));
+        }
+        OSTimeDly(1);                            /* Let the benchmark tasks block                       */
+        OSHostTickCtr  = 0;
+        OSHostTickTime = 0;
+        start          = Now();
+        OSTimeDly(N_BENCH_TICKS);
+        printf(" %7.1f %7.1f", (double)OSHostTickTime / OSHostTickCtr, (double)(Now() - start) / OSHostTickCtr);
+        for (n = 0; n < ntasks[i]; n++) {
+            (void)OSTaskDel((INT8U)(BENCH_PRIO + n));
+        }
+    }
+    printf("\n");
+}
+
+static  void  CtrlTask (void *p_arg)
+{
+    INT8U  i;
+    INT8U  err;
+
+
+    p_arg = p_arg;
+    for (i = 0; i < N_WORK; i++) {
+        Work[i].Start = OSSemCreate(0);
+        (void)OSTaskCreate(WorkTask, (void *)&Work[i], &WorkStk[i][TASK_STK_SIZE - 1], (INT8U)(WORK_PRIO + i));
+    }
+    SemTest   = OSSemCreate(0);
+    MboxTest  = OSMboxCreate((void *)0);
+    QTest     = OSQCreate(&QTestTbl[0], 4);
+    FlagTest  = OSFlagCreate(0x00, &err);
+    MutexTest = OSMutexCreate(MUTEX_PIP, &err);
+    SemBench  = OSSemCreate(0);
+    OSMutexPend(MutexTest, 0, &err);             /* Workers can only time out on the mutex              */
+
+    printf("OS_TICK_LIST_EN = %d\n", OS_TICK_LIST_EN);
+    TestTimeouts();
+
+    printf("\nns per tick: OSTimeTick() and total, for 0, 10, 50 and 200 tasks\n");
+    Bench("Waiting for events",  BENCH_EVENT);
+    Bench("Long delays",         BENCH_LONG);
+    Bench("Delays of 1..16",     BENCH_PERIODIC);
+
+    exit(Failures != 0 ? 1 : 0);
+}
+
+int  main (void)
+{
+    OSInit();
+    (void)OSTaskCreate(CtrlTask, (void *)0, &CtrlStk[TASK_STK_SIZE - 1], CTRL_PRIO);
+    OSStart();
+    return (0);
+}
@@ -45,6 +45,7 @@
 
 #define OS_SCHED_LOCK_EN          0    /*     Include code for OSSchedLock() and OSSchedUnlock()       */
 
+#define OS_TICK_LIST_EN           1    /* OSTimeTick() only visits delayed tasks, kept in a delta list */
 #define OS_TICK_STEP_EN           0    /* Enable tick stepping feature for uC/OS-View                  */
 #define OS_TICKS_PER_SEC        200    /* Set the number of ticks in one second                        */
 
@@ -622,6 +622,11 @@ typedef struct os_tcb {
 #endif
 
     INT16U           OSTCBDly;         /* Nbr ticks to delay task or, timeout waiting for event        */
+#if OS_TICK_LIST_EN > 0
+    struct os_tcb   *OSTCBTickNext;    /* Pointer to next     TCB in the tick list                     */
+    struct os_tcb   *OSTCBTickPrev;    /* Pointer to previous TCB in the tick list                     */
+    INT16U           OSTCBTickDelta;   /* Nbr ticks after the expiry of the previous TCB in tick list  */
+#endif
     INT8U            OSTCBStat;        /* Task      status                                             */
     INT8U            OSTCBStatPend;    /* Task PEND status                                             */
     INT8U            OSTCBPrio;        /* Task priority (0 == highest)                                 */
@@ -750,6 +755,10 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+#if OS_TICK_LIST_EN > 0
+OS_EXT  OS_TCB           *OSTickList;               /* Pointer to delta list of delayed TCBs           */
+#endif
+
 #if OS_TICK_STEP_EN > 0
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
 #endif
@@ -1309,6 +1318,11 @@ INT8U         OS_TCBInit            (INT8U            prio,
                                      void            *pext,
                                      INT16U           opt);
 
+void          OS_TickListInsert     (OS_TCB          *ptcb,
+                                     INT16U           ticks);
+
+void          OS_TickListRemove     (OS_TCB          *ptcb);
+
 #if OS_TMR_EN > 0
 void          OSTmr_Init(void);
 #endif
@@ -1802,6 +1816,11 @@ void          OSCtxSw               (void);
 #endif
 
 
+#ifndef OS_TICK_LIST_EN
+#error  "OS_CFG.H, Missing OS_TICK_LIST_EN: Keeps only the delayed tasks in a sorted list for OSTimeTick()"
+#endif
+
+
 #ifndef OS_TICK_STEP_EN
 #error  "OS_CFG.H, Missing OS_TICK_STEP_EN: Allows to 'step' one tick at a time with uC/OS-View"
 #endif
@@ -554,6 +554,10 @@ void  OSStatInit (void)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) With OS_TICK_LIST_EN set to 1, only the first TCB of the tick list is decremented.  The
+*                 cost of a tick then no longer depends on the number of tasks but only on the number of
+*                 tasks whose delay or timeout expires on this tick.
 *********************************************************************************************************
 */
 
@@ -602,6 +606,29 @@ void  OSTimeTick (void)
             return;
         }
 #endif
+#if OS_TICK_LIST_EN > 0
+        OS_ENTER_CRITICAL();
+        ptcb = OSTickList;                                 /* Point at first TCB in tick list              */
+        if (ptcb != (OS_TCB *)0) {
+            ptcb->OSTCBTickDelta--;                        /* Decrement nbr of ticks to end of first delay */
+        }
+        while ((ptcb != (OS_TCB *)0) && (ptcb->OSTCBTickDelta == 0)) {
+            OS_TickListRemove(ptcb);                       /* Delay expired, remove TCB from tick list     */
+            if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
+                ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag           */
+                ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout            */
+            } else {
+                ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+            }
+
+            if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?               */
+                OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                  */
+                OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+            }
+            ptcb = OSTickList;                             /* Next TCB may expire on the same tick         */
+        }
+        OS_EXIT_CRITICAL();
+#else
         ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
         while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
             OS_ENTER_CRITICAL();
@@ -624,6 +651,7 @@ void  OSTimeTick (void)
             ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
             OS_EXIT_CRITICAL();
         }
+#endif
     }
 }
 
@@ -763,7 +791,7 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
         pevent->OSEventGrp &= ~bity;                    /* Clr group bit if this was only task pending */
     }
     ptcb                 =  OSTCBPrioTbl[prio];         /* Point to this task's OS_TCB                 */
-    ptcb->OSTCBDly       =  0;                          /* Prevent OSTimeTick() from readying task     */
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
     ptcb->OSTCBEventPtr  = (OS_EVENT *)0;               /* Unlink ECB from this task                   */
 #if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
     ptcb->OSTCBMsg       =  pmsg;                       /* Send message directly to waiting task       */
@@ -1174,6 +1202,9 @@ static  void  OS_InitTCBList (void)
 #endif
     OSTCBList               = (OS_TCB *)0;                       /* TCB lists initializations          */
     OSTCBFreeList           = &OSTCBTbl[0];
+#if OS_TICK_LIST_EN > 0
+    OSTickList              = (OS_TCB *)0;                       /* No task is delayed                 */
+#endif
 }
 /*$PAGE*/
 /*
@@ -1695,3 +1726,103 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
     OS_EXIT_CRITICAL();
     return (OS_ERR_TASK_NO_MORE_TCB);
 }
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   DELAY A TASK OR START ITS TIMEOUT
+*
+* Description: This function is called by OSTimeDly() and by the PEND services to load the number of ticks
+*              a task has to wait into its OS_TCB.  With OS_TICK_LIST_EN set to 1, the OS_TCB is also
+*              linked into the tick list.  The tick list is sorted by expiry and every OS_TCB only holds
+*              the number of ticks after the expiry of the OS_TCB in front of it, so OSTimeTick() only
+*              needs to look at the first entry.
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task to delay.  The task must not be in the tick
+*                       list already.
+*
+*              ticks    is the number of clock ticks to wait.  0 means the task waits forever and is not
+*                       linked into the tick list.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) OSTCBDly holds 'ticks' for as long as the task is in the tick list.  It is not decremented
+*                 by OSTimeTick() but it is still 0 if, and only if, the task is not delayed.
+*              3) Inserting costs one step per OS_TCB that expires earlier.
+*              4) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TickListInsert (OS_TCB *ptcb, INT16U ticks)
+{
+#if OS_TICK_LIST_EN > 0
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    ptcb->OSTCBDly = ticks;
+    if (ticks == 0) {                                      /* Waiting forever, no need to link the TCB */
+        return;
+    }
+    pprev = (OS_TCB *)0;
+    pnext = OSTickList;
+    while ((pnext != (OS_TCB *)0) && (pnext->OSTCBTickDelta <= ticks)) {
+        ticks -= pnext->OSTCBTickDelta;                    /* Skip TCBs that expire before or together */
+        pprev  = pnext;
+        pnext  = pnext->OSTCBTickNext;
+    }
+    ptcb->OSTCBTickDelta = ticks;                          /* Link TCB between pprev and pnext         */
+    ptcb->OSTCBTickPrev  = pprev;
+    ptcb->OSTCBTickNext  = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBTickDelta -= ticks;                    /* Next TCB expires relative to this one    */
+        pnext->OSTCBTickPrev   = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBTickNext = ptcb;
+    } else {
+        OSTickList           = ptcb;
+    }
+#else
+    ptcb->OSTCBDly = ticks;
+#endif
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 CANCEL THE DELAY OR TIMEOUT OF A TASK
+*
+* Description: This function is called when a delayed task is made ready before its delay expires or when
+*              a task is deleted.  With OS_TICK_LIST_EN set to 1, the OS_TCB is unlinked from the tick list
+*              and its remaining ticks are passed on to the next OS_TCB in the list.
+*
+* Arguments  : ptcb     is a pointer to the OS_TCB of the task.  The task does not need to be delayed.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TickListRemove (OS_TCB *ptcb)
+{
+#if OS_TICK_LIST_EN > 0
+    OS_TCB  *pnext;
+
+
+    if (ptcb->OSTCBDly != 0) {                             /* Is the TCB in the tick list?             */
+        pnext = ptcb->OSTCBTickNext;
+        if (pnext != (OS_TCB *)0) {
+            pnext->OSTCBTickDelta += ptcb->OSTCBTickDelta; /* Next TCB still expires at the same tick  */
+            pnext->OSTCBTickPrev   = ptcb->OSTCBTickPrev;
+        }
+        if (ptcb->OSTCBTickPrev != (OS_TCB *)0) {
+            ptcb->OSTCBTickPrev->OSTCBTickNext = pnext;
+        } else {
+            OSTickList                         = pnext;
+        }
+    }
+#endif
+    ptcb->OSTCBDly = 0;
+}
@@ -193,6 +193,9 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
                           + sizeof(OSTCBFreeList)
                           + sizeof(OSTCBHighRdy)
                           + sizeof(OSTCBList)
+#if OS_TICK_LIST_EN > 0
+                          + sizeof(OSTickList)
+#endif
                           + sizeof(OSTCBPrioTbl)
                           + sizeof(OSTCBTbl);
 
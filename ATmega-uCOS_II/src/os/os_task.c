@@ -456,7 +456,7 @@ INT8U  OSTaskDel (INT8U prio)
     }
 #endif
 
-    ptcb->OSTCBDly      = 0;                                    /* Prevent OSTimeTick() from updating  */
+    OS_TickListRemove(ptcb);                                    /* Prevent OSTimeTick() from updating  */
     ptcb->OSTCBStat     = OS_STAT_RDY;                          /* Prevent task from being resumed     */
     ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
     if (OSLockNesting < 255u) {                                 /* Make sure we don't context switch   */
@@ -194,6 +194,16 @@ asm volatile(\
 float LL_LIMIT[] = {1, 0.8284271247, 0.7797631497, 0.75682846, 0.743491775, 0.7347722899, 0.7286265957, 0.7240618613};
 #endif
 
+#if (OSSCHED_TYPE == OS_EDF)
+// Number of jobs completed after their absolute deadlines
+unsigned int _deadlineMisses=0;
+
+unsigned int OSGetDeadlineMisses()
+{
+	return _deadlineMisses;
+}
+#endif
+
 // Error handling
 unsigned int OSGetError()
 {
@@ -213,23 +223,107 @@ void OSSetError(unsigned int errno)
 
 #if OSUSE_SLEEP==1
 
-	// Sleep routine. Records number of milliseconds to sleep. sleep_flag tells you if process is indeed sleeping. 1 bit per process
-	// maximum 16 processes.
+	// Sleeping tasks form a delta list ordered by wake up time, linked through _sleepNext. _sleepTime[i] is the
+	// number of ticks between the wake up of task i and of its predecessor, so a tick only touches the head.
+	// sleep_flag tells you if process is indeed sleeping. 1 bit per process, maximum 16 processes.
 	unsigned long _sleepTime[OSMAX_TASKS];
+	unsigned char _sleepNext[OSMAX_TASKS];
+	unsigned char _sleepHead=255;
 	int _sleepFlag=0;
 
+	// Puts task pid to sleep for the given number of ticks (at least 1): it wakes up in the ticks-th
+	// _OSSleepTick() from now. Call with interrupts disabled.
+	void _OSSleepInsert(unsigned char pid, unsigned long ticks)
+	{
+		unsigned char prev=255, iter=_sleepHead;
+		
+		if(ticks==0)
+			ticks=1;
+			
+		// Tasks waking up at the same tick stay in FIFO order
+		while(iter != 255 && _sleepTime[iter] <= ticks)
+		{
+			ticks-=_sleepTime[iter];
+			prev=iter;
+			iter=_sleepNext[iter];
+		}
+		
+		_sleepTime[pid]=ticks;
+		_sleepNext[pid]=iter;
+		
+		if(iter != 255)
+			_sleepTime[iter]-=ticks;
+			
+		if(prev == 255)
+			_sleepHead=pid;
+		else
+			_sleepNext[prev]=pid;
+			
+		_sleepFlag |= (1<<pid);
+	}
+	
+	#if OSSCHED_TYPE == OS_EDF
+	// Sets the absolute deadline of the job released when task pid wakes up. Called from the timer ISR.
+	void _OSReleaseJob(unsigned char pid)
+	{
+		if(_tasks[pid].status & _OS_NEXTPERIOD)
+		{
+			_tasks[pid].status &= ~(_OS_NEXTPERIOD);
+			_tasks[pid].deadline=_tasks[pid].release+_tasks[pid].t;
+		}
+		else
+			if((_tasks[pid].t != 0 || _tasks[pid].c != 0) && (long) (_osticks - _tasks[pid].deadline) >= 0)
+			{
+				// A timed task that slept past its deadline with OSSleep starts a new job now
+				_tasks[pid].release=_osticks;
+				_tasks[pid].deadline=_osticks+_tasks[pid].t;
+			}
+	}
+	#endif
+	
+	// Called from the tick ISR. Wakes up all tasks due at this tick and merges them into the ready queue at once.
+	// Returns the number of tasks woken up.
+	unsigned char _OSSleepTick()
+	{
+		unsigned char woken[OSMAX_TASKS], n=0, pid;
+		
+		if(_sleepHead == 255)
+			return 0;
+			
+		if(_sleepTime[_sleepHead] > 0)
+			_sleepTime[_sleepHead]--;
+			
+		while(_sleepHead != 255 && _sleepTime[_sleepHead] == 0)
+		{
+			pid=_sleepHead;
+			_sleepHead=_sleepNext[pid];
+			
+			// Clear the flag
+			_sleepFlag &= ~(1 << pid);
+			
+			// Unblock the task
+			_tasks[pid].status &= ~(_OS_BLOCKED);
+			#if OSSCHED_TYPE == OS_EDF
+			// New job of a timed task gets its absolute deadline before it is keyed into the ready heap
+			_OSReleaseJob(pid);
+			#endif
+			
+			woken[n++]=pid;
+		}
+		
+		if(n)
+			procEnqBatch(woken, n, _tasks, &_ready);
+			
+		return n;
+	}
+
 	// Sleep routine. Sleeps in milliseconds
 	void OSSleep(unsigned long millis)
 	{
 		unsigned char sreg;
 		OSMakeAtomic(&sreg);
 		// Set sleep time
-		_sleepTime[_running]=millis-1;
-		
-		if(_sleepTime[_running]<0)
-			_sleepTime[_running]=0;
-			
-		_sleepFlag |= (1<<_running);
+		_OSSleepInsert(_running, millis);
 	
 		// Set blocked flag
 		_tasks[_running].status|=_OS_BLOCKED;
@@ -240,6 +334,46 @@ void OSSetError(unsigned int errno)
 		OSExitAtomic(sreg);
 		OSSwap();
 	}
+	
+	#if OSSCHED_TYPE == OS_EDF
+	
+	// Ends current job. The next job is released one period after the previous release, so
+	// the release times do not drift with the task's response time.
+	void OSWaitNextPeriod()
+	{
+		unsigned char sreg;
+		OSMakeAtomic(&sreg);
+		
+		if((long) (_osticks - _tasks[_running].deadline) > 0)
+			_deadlineMisses++;
+			
+		#if OSUSE_PROFILER == 1 && PROFILERUSE_JOBS
+		profileJobEnd(_running);
+		#endif
+			
+		_tasks[_running].release+=_tasks[_running].t;
+		
+		if((long) (_osticks - _tasks[_running].release) >= 0)
+		{
+			// Overrun: next job is already released. Run it if it still has the earliest deadline.
+			_tasks[_running].deadline=_tasks[_running].release+_tasks[_running].t;
+			#if OSUSE_PROFILER == 1 && PROFILERUSE_JOBS
+			profileRelease(_running);
+			profileSwitchIn(_running);
+			#endif
+			OSExitAtomic(sreg);
+			OSPrioSwap();
+			return;
+		}
+		
+		// Sleep until the release
+		_OSSleepInsert(_running, _tasks[_running].release-_osticks);
+		_tasks[_running].status|=(_OS_BLOCKED | _OS_NEXTPERIOD);
+		
+		OSExitAtomic(sreg);
+		OSSwap();
+	}
+	#endif
 #endif
 
 // OS Task Management Routines
@@ -328,6 +462,11 @@ unsigned int OSCreateTimedTask(unsigned long c, unsigned long t, void (*rptr)(vo
 	_tasks[_procCount].prio=0;
 	_tasks[_procCount].c=c;
 	_tasks[_procCount].t=t;
+	#if OSSCHED_TYPE == OS_EDF
+	// First job is released now
+	_tasks[_procCount].release=_osticks;
+	_tasks[_procCount].deadline=_osticks+t;
+	#endif
 	_tasks[_procCount].taskptr=rptr;
 	_tasks[_procCount].rarg=rarg;
 	_tasks[_procCount].stack=(unsigned long *) calloc((size_t) _taskStackSize, sizeof(unsigned long));
@@ -359,8 +498,10 @@ void OSScheduler()
 	
 	// Check to see that it is a proper process
 	if(_nextRun != 255)
-	#if (OSSCHED_TYPE==OS_PRIORITY )|| (OSSCHED_TYPE==OS_RMS) || (OSSCHED_TYPE==OS_EDF )
+	#if (OSSCHED_TYPE==OS_PRIORITY )|| (OSSCHED_TYPE==OS_RMS)
 	if(_running==255 || _tasks[_nextRun].prio < _tasks[_running].prio || _forcedSwap)
+	#elif OSSCHED_TYPE==OS_EDF
+	if(_running==255 || procBefore(_nextRun, _running, _tasks) || _forcedSwap)
 	#endif
 	{
 		_nextRun=procDeq(&_ready);
@@ -368,11 +509,20 @@ void OSScheduler()
 		{
 			_tasks[_running].sp=pxCurrentTCB;
 			
+			#if OSUSE_PROFILER == 1 && PROFILERUSE_JOBS
+			profileSwitchOut(_running, _tasks[_running].status & _OS_BLOCKED);
+			#endif
+			
 			// Push to READY queue if not blocked
 			if(!(_tasks[_running].status & _OS_BLOCKED))
 				procEnq(_running, _tasks, &_ready);
 		}
 
+		#if OSUSE_PROFILER == 1 && PROFILERUSE_JOBS
+		if(_nextRun != _running)
+			profileSwitchIn(_nextRun);
+		#endif
+		
 		pxCurrentTCB=_tasks[_nextRun].sp;
 		_running=_nextRun;
 		
@@ -384,7 +534,7 @@ void OSScheduler()
 #if (OSSCHED_TYPE == OS_RMS) 
 unsigned int OSTestSchedulability()
 {
-	float utilization;
+	float utilization=0;
 	int i;
 	for (i = 0; i< _numTasks; i++){
 		utilization += (float)_tasks[i].c / (float) _tasks[i].t;
@@ -399,6 +549,82 @@ unsigned int OSTestSchedulability()
 		
 }
 #endif
+
+#if (OSSCHED_TYPE == OS_EDF)
+
+// Limit of the demand analysis interval. Longer hyperperiods fall back to the utilization test.
+#define OSEDF_MAX_INTERVAL	0x7FFFFFFFUL
+// Utilization below this bound is accepted without the demand test, above 1.0001 rejected:
+// the band between them covers the rounding error of the float sum
+#define OSEDF_SAFE_UTILIZATION	0.9999
+
+// Processor demand of jobs with both release and deadline within [0, l] (deadline = period)
+static unsigned long demandBound(unsigned long l)
+{
+	unsigned long h=0;
+	unsigned char i;
+	for(i=0; i<_procCount; i++)
+		if(_tasks[i].t != 0)
+			h+=(l / _tasks[i].t) * _tasks[i].c;
+	return h;
+}
+
+// Hyperperiod of the timed tasks, 0 if it exceeds OSEDF_MAX_INTERVAL
+static unsigned long hyperPeriod()
+{
+	unsigned long h=1, a, b, r;
+	unsigned char i;
+	for(i=0; i<_procCount; i++)
+		if(_tasks[i].t != 0)
+		{
+			a=h;
+			b=_tasks[i].t;
+			while(b != 0)
+			{
+				r=a % b;
+				a=b;
+				b=r;
+			}
+			if(h / a > OSEDF_MAX_INTERVAL / _tasks[i].t)
+				return 0;
+			h=(h / a) * _tasks[i].t;
+		}
+	return h;
+}
+
+// Processor-demand test (Baruah et al.): the set is schedulable by EDF iff demandBound(d) <= d
+// for every absolute deadline d in [0, L]. With deadline = period demandBound(d) <= d * U, so for
+// U < 1 the interval L* is the longest period and no deadline in it can fail. Only a sum in the
+// rounding band around 1 needs the demand: at the hyperperiod H demandBound(H) = H * U exactly,
+// so one integer check replaces a walk over every deadline of the busy period.
+unsigned int OSTestSchedulability()
+{
+	float utilization=0;
+	unsigned long h;
+	unsigned char i;
+	
+	for(i=0; i<_procCount; i++)
+		if(_tasks[i].t != 0)
+			utilization += (float)_tasks[i].c / (float) _tasks[i].t;
+		
+	if(utilization > 1.0001)
+	{
+		OSSetError(OS_ERR_NOT_SCHED);
+		return OSGetError();
+	}
+	
+	if(utilization < OSEDF_SAFE_UTILIZATION)
+		return 0;
+	
+	h=hyperPeriod();
+	if(h != 0 ? demandBound(h) > h : utilization > 1.0)
+	{
+		OSSetError(OS_ERR_NOT_SCHED);
+		return OSGetError();
+	}
+	return 0;
+}
+#endif
 	
 inline void runTask()
 {
@@ -468,6 +694,11 @@ ISR(TIMER2_OVF_vect, ISR_NAKED)
 {
 	portSAVE_CONTEXT();
 	OSMakeAtomic(&_csreg);
+	
+	#if OSUSE_PROFILER == 1 && PROFILERUSE_ISR
+	profileIsrEnter();
+	#endif
+	
 	// Increment tick counter
 	_osticks++;
 	
@@ -477,7 +708,7 @@ ISR(TIMER2_OVF_vect, ISR_NAKED)
 	
 	
 		#if OSUSE_SLEEP == 1
-		if (_sleepTime[_running]==0)
+		if (!(_sleepFlag & (1 << _running)))
 			tickTask();
 		#else
 		tickTask();
@@ -486,32 +717,25 @@ ISR(TIMER2_OVF_vect, ISR_NAKED)
 	#endif
 	
 	#if OSUSE_SLEEP==1
-		// Decrement wait counters
-		unsigned char i;
-	
-		for(i=0; i<_maxTasks; i++)
-			if(_sleepTime[i]>0)
-				_sleepTime[i]--;
-			else
-				if(_sleepFlag & (0b1 << i))
-				{
-					// Clear the flag
-					_sleepFlag &= ~(0b1 << i);
-				
-					// Unblock the task
-					_tasks[i].status &= ~(_OS_BLOCKED);
-					// Put onto ready queue, call scheduler
-					procEnq(i, _tasks, &_ready);
-				
-					// Call scheduler if this is fixed priority
-				
-					#if (OSSCHED_TYPE==OS_PRIORITY || OSSCHED_TYPE == OS_RMS) && OS_PREEMPTIVE==1
-						portRESTORE_CONTEXT();
-						OSExitAtomic(_csreg);
-						_OSSwap(0);
-						asm("reti");
-					#endif
-				}
+		// Wake up tasks due at this tick, call scheduler if this is fixed priority or EDF
+		#if (OSSCHED_TYPE==OS_PRIORITY || OSSCHED_TYPE == OS_RMS || OSSCHED_TYPE == OS_EDF) && OS_PREEMPTIVE==1
+			if(_OSSleepTick())
+			{
+				#if OSUSE_PROFILER == 1 && PROFILERUSE_ISR
+				profileIsrExit();
+				#endif
+				portRESTORE_CONTEXT();
+				OSExitAtomic(_csreg);
+				_OSSwap(0);
+				asm("reti");
+			}
+		#else
+			_OSSleepTick();
+		#endif
+	#endif
+	
+	#if OSUSE_PROFILER == 1 && PROFILERUSE_ISR
+	profileIsrExit();
 	#endif
 	portRESTORE_CONTEXT();
 	OSExitAtomic(_csreg);
@@ -555,10 +779,15 @@ void OSInit(unsigned char numTasks)
 	initQ(_readybuf, _maxTasks, &_ready);
 }
 
-// The idle task. Just wastes CPU cycles
+// The idle task. Just wastes CPU cycles, or writes deferred profile records to EEPROM
 void _OSIdle(void *p)
 {
-	while(1);
+	while(1)
+	{
+		#if OSUSE_PROFILER == 1
+		profileIdleFlush();
+		#endif
+	}
 }
 
 void OSRun()
@@ -568,6 +797,8 @@ void OSRun()
 	#if OSSCHED_TYPE == OS_RMS
 	OSTestSchedulability();
 	initialPrioAssign( _tasks, &_ready);
+	#elif OSSCHED_TYPE == OS_EDF
+	OSTestSchedulability();
 	#endif
 	
 	
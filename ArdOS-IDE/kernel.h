@@ -122,6 +122,10 @@ typedef struct tc
 	unsigned long c;	// Task execution time
 	unsigned long t;	//Task period
 	#endif
+	#if OSSCHED_TYPE == OS_EDF
+	unsigned long release;	// Release time of current job (ticks)
+	unsigned long deadline;	// Absolute deadline of current job (ticks)
+	#endif
 	
 	unsigned char status; // bit 0 = first run flag, bit 1 = blocked flag
 	unsigned long *stack; // The task stack
@@ -144,6 +148,11 @@ void printProcQ(tQueue *q, tTCB *tasklist);
 void initQ(unsigned char *, unsigned char len, tQueue *q);
 void prioEnq(int pid, tTCB *tasklist, tQueue *q);
 
+// EDF ordering: returns non-zero if task pid1 has to run before task pid2
+#if OSSCHED_TYPE == OS_EDF
+unsigned char procBefore(int pid1, int pid2, tTCB *tasklist);
+#endif
+
 // Initializes task priorities based on the priority queue to ensure properness
 #if (OSSCHED_TYPE == OS_RMS) 
 void initialPrioAssign(tTCB *tasklist, tQueue *q);
@@ -151,6 +160,9 @@ void initialPrioAssign(tTCB *tasklist, tQueue *q);
 
 void enq(int pid, tQueue *q);
 void procEnq(int pid, tTCB *tasklist, tQueue *q);
+
+// Puts n tasks onto the queue with one merge. Reorders pids.
+void procEnqBatch(unsigned char *pids, unsigned char n, tTCB *tasklist, tQueue *q);
 unsigned char procPeek(tQueue *q);
 unsigned char procDeq(tQueue *q);
 
@@ -182,6 +194,7 @@ extern unsigned char _numTasks, _maxTasks;
 // Task Status flags
 #define _OS_FIRSTRUN	0b1
 #define _OS_BLOCKED		0b10
+#define _OS_NEXTPERIOD	0b100	// EDF: task waits for release of its next job
 
 
 // Error codes
@@ -207,6 +220,11 @@ void OSSetError(unsigned int);
 
 void _OSSwap(unsigned char forcedSwap) __attribute__ ((naked));
 
+#if OSUSE_SLEEP==1
+// Puts task pid onto the sleep list for the given number of ticks. Call with interrupts disabled.
+void _OSSleepInsert(unsigned char pid, unsigned long ticks);
+#endif
+
 /* =====================================================================================
 
 	PUBLIC ARDOS SECTION:
@@ -230,6 +248,20 @@ unsigned int OSCreateTask(int prio, void (*rptr)(void *), void *rarg);
 // c = task running time, t = task period
 #if (OSSCHED_TYPE == OS_RMS) || (OSSCHED_TYPE == OS_EDF)
 unsigned int OSCreateTimedTask(unsigned long c, unsigned long t, void (*rptr)(void *), void *rarg);
+
+// Tests the timed task set: Liu-Layland bound for RMS, exact processor-demand test for EDF.
+unsigned int OSTestSchedulability();
+#endif
+
+#if OSSCHED_TYPE == OS_EDF && OSUSE_SLEEP == 1
+// Ends the current job of a timed task and blocks until the release of its next job
+// (one period after the previous release). Absolute deadline of the new job is release + t.
+void OSWaitNextPeriod();
+#endif
+
+#if OSSCHED_TYPE == OS_EDF
+// Number of jobs that completed after their absolute deadline
+unsigned int OSGetDeadlineMisses();
 #endif
 
 // Swaps task. Causes current task to relinquish control of the CPU. Scheduler selects next task to run.
@@ -238,7 +270,11 @@ void OSSwap() __attribute__ ((naked));
 // Priority swap: Swap takes place only if new task has a higher priority
 void OSPrioSwap() __attribute__ ((naked));
 
-// Makes the current task sleep for the given number of milliseconds
+// Makes the current task sleep for the given number of milliseconds (ticks). The task is woken up by
+// the millis-th tick after the call, the current partial tick counts as the first one, as with the
+// former counter scan. OSSleep(0) sleeps one tick (the scan used to underflow to ~2^32 ticks). Tasks
+// due at the same tick are all woken by that tick; the preemptive scan returned after the first one
+// and woke the tasks behind it a tick or more later.
 void OSSleep(unsigned long millis);
 
 // Returns the number of milliseconds since the OS was started up
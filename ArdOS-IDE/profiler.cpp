@@ -28,6 +28,7 @@
 
  */
  
+#include <string.h>
 #include "profiler.h"
 #include "kernel.h"
 // Use EEPROM
@@ -40,6 +41,199 @@ volatile int _currentProfiled;
 
 volatile uint16_t _profileBin[OSMAX_TASKS];
 
+#if PROFILERUSE_EEPROM
+// Records waiting for the idle task to write them to EEPROM, 1 bit per task
+volatile unsigned int _binDirty=0, _responseDirty=0;
+volatile uint16_t _pendingBin[OSMAX_TASKS];
+#endif
+
+#if PROFILERUSE_ISR
+
+volatile uint16_t _isrHistogram[PROFILER_ISR_BINS];
+
+unsigned char _isrStart;
+
+void profileIsrEnter()
+{
+	_isrStart=TCNT2;
+}
+
+void profileIsrExit()
+{
+	unsigned char duration=TCNT2 - _isrStart;
+	
+	if(duration >= PROFILER_ISR_BINS)
+		duration=PROFILER_ISR_BINS - 1;
+	
+	// Saturate instead of wrapping around
+	if(_isrHistogram[duration] != 0xFFFF)
+		_isrHistogram[duration]++;
+}
+
+void getIsrHistogram(uint16_t *bins)
+{
+	unsigned char sreg, i;
+	OSMakeAtomic(&sreg);
+	for(i=0; i<PROFILER_ISR_BINS; i++)
+		bins[i]=_isrHistogram[i];
+	OSExitAtomic(sreg);
+}
+
+void resetIsrHistogram()
+{
+	unsigned char sreg, i;
+	OSMakeAtomic(&sreg);
+	for(i=0; i<PROFILER_ISR_BINS; i++)
+		_isrHistogram[i]=0;
+	OSExitAtomic(sreg);
+}
+
+#endif
+
+#if PROFILERUSE_JOBS
+
+extern volatile unsigned long _osticks;
+
+tJobProfile _jobProfile[OSMAX_TASKS];
+
+#define _PROF_ACTIVE	0b1
+#define _PROF_STARTED	0b10
+
+/**
+ * Tick counter in the upper bits and TCNT2 in the lower 8 bits. An overflow that is pending
+ * but not yet counted by the tick ISR is added here.
+ **/
+unsigned long profileTimestamp()
+{
+	unsigned char cnt=TCNT2;
+	unsigned long ticks=_osticks;
+	
+	if((TIFR2 & 0b1) && cnt < 128)
+		ticks++;
+	
+	return (ticks << 8) | cnt;
+}
+
+// Task is put onto the ready queue. Ignored if it is a preempted task of an active job.
+void profileRelease(unsigned char PID)
+{
+	if(_jobProfile[PID].status & _PROF_ACTIVE)
+		return;
+		
+	_jobProfile[PID].release=profileTimestamp();
+	_jobProfile[PID].status=_PROF_ACTIVE;
+}
+
+void profileSwitchIn(unsigned char PID)
+{
+	unsigned long now=profileTimestamp();
+	
+	// Job released before the profiler was reset
+	if(!(_jobProfile[PID].status & _PROF_ACTIVE))
+	{
+		_jobProfile[PID].release=now;
+		_jobProfile[PID].status=_PROF_ACTIVE;
+	}
+	
+	if(!(_jobProfile[PID].status & _PROF_STARTED))
+	{
+		_jobProfile[PID].status|=_PROF_STARTED;
+		if(now - _jobProfile[PID].release > _jobProfile[PID].maxLatency)
+			_jobProfile[PID].maxLatency=now - _jobProfile[PID].release;
+	}
+}
+
+// A task that leaves the CPU unblocked was preempted. A blocked one (sleep, semaphore, queue)
+// keeps its job active: the job ends in OSWaitNextPeriod() only.
+void profileSwitchOut(unsigned char PID, unsigned char blocked)
+{
+	if(!blocked && (_jobProfile[PID].status & _PROF_ACTIVE))
+		_jobProfile[PID].preemptions++;
+}
+
+// Called by OSWaitNextPeriod() when the running task completes its job
+void profileJobEnd(unsigned char PID)
+{
+	tJobProfile *prof=&_jobProfile[PID];
+	unsigned long response;
+	
+	if(!(prof->status & _PROF_ACTIVE))
+		return;
+		
+	response=profileTimestamp() - prof->release;
+	prof->status=0;
+	
+	if(!prof->jobs || response < prof->minResponse)
+		prof->minResponse=response;
+	
+	if(response > prof->maxResponse)
+	{
+		prof->maxResponse=response;
+		#if PROFILERUSE_EEPROM
+		_responseDirty |= (1 << PID);
+		#endif
+	}
+	
+	if(prof->sumResponse + response < prof->sumResponse)
+	{
+		prof->sumResponse >>= 1;
+		prof->sumJobs >>= 1;
+	}
+	prof->sumResponse+=response;
+	prof->sumJobs++;
+	prof->jobs++;
+}
+
+void resetJobProfiles()
+{
+	unsigned char sreg;
+	OSMakeAtomic(&sreg);
+	memset(_jobProfile, 0, sizeof(_jobProfile));
+	OSExitAtomic(sreg);
+}
+
+void getJobProfile(unsigned char PID, tJobProfile *profile)
+{
+	unsigned char sreg;
+	OSMakeAtomic(&sreg);
+	*profile=_jobProfile[PID];
+	OSExitAtomic(sreg);
+}
+
+static unsigned char *putLE(unsigned char *buf, unsigned long value, unsigned char size)
+{
+	while(size--)
+	{
+		*buf++=value & 0xFF;
+		value >>= 8;
+	}
+	return buf;
+}
+
+unsigned int profileDump(unsigned char *buf, unsigned int len)
+{
+	unsigned char i;
+	unsigned int count=0;
+	tJobProfile prof;
+	
+	for(i=0; i<_procCount && count + PROFILER_RECORD_SIZE <= len; i++)
+	{
+		getJobProfile(i, &prof);
+		
+		buf=putLE(buf, i, 1);
+		buf=putLE(buf, prof.jobs, 4);
+		buf=putLE(buf, prof.preemptions, 2);
+		buf=putLE(buf, prof.minResponse, 4);
+		buf=putLE(buf, prof.maxResponse, 4);
+		buf=putLE(buf, prof.sumJobs ? prof.sumResponse / prof.sumJobs : 0, 4);
+		buf=putLE(buf, prof.maxLatency, 4);
+		count+=PROFILER_RECORD_SIZE;
+	}
+	return count;
+}
+
+#endif
+
 /**
  * setCurrentProfiled and tickTask needs to be inside an atomic chunk.
  *
@@ -60,6 +254,14 @@ void tickTask()
 	for(i = 0 ; i < _numTasks ; i++) {
 		_profileBin[i] = 0;
 	}
+	
+	#if PROFILERUSE_JOBS
+	resetJobProfiles();
+	#endif
+	
+	#if PROFILERUSE_ISR
+	resetIsrHistogram();
+	#endif
  }
  
  #if PROFILERUSE_PRINT
@@ -98,29 +300,96 @@ void tickTask()
 	 return _profileBin[PID];
  }
  
- // Warning: the usage of this eeprom writer and reader might cause a severe impact on the overall system performance 
+ // Warning: the usage of this eeprom reader might cause a severe impact on the overall system performance 
  #if PROFILERUSE_EEPROM
  /**
-  *	This update function consumes a lot of time. Use EEP profiler with care
+  *	Only records the profile bin. The EEPROM is written later by the idle task in profileIdleFlush().
   **/
  void updateWorstTimeAnalysis(int PID)
  {
-	uint16_t value = getTaskProfileFromROM(PID);
+	unsigned char sreg;
+	OSMakeAtomic(&sreg);
+	if (_pendingBin[PID] < _profileBin[PID])
+		_pendingBin[PID] = _profileBin[PID];
+	_binDirty |= (1 << PID);
+	OSExitAtomic(sreg);
+ }
+ 
+ // Writes only bytes those differ to save EEPROM write cycles and time
+ static void writeROM(int address, unsigned long value, unsigned char size)
+ {
+	while (size--) {
+		if (EEPROM.read(address) != (byte) (value & 0xFF))
+			EEPROM.write(address, (byte) (value & 0xFF));
+		address++;
+		value >>= 8;
+	}
+ }
+ 
+ #if PROFILERUSE_JOBS
+ unsigned long getResponseTimeFromROM(int PID)
+ {
+	int startingAddress = PROFILER_RESPONSE_ADDRESS + (PID * 4);
+	unsigned long value = 0;
+	int i;
 	
-	OSMakeAtomic(&_csreg);
-	if (value < _profileBin[PID]) {
+	for (i = 3; i >= 0; i--)
+		value = (value << 8) | EEPROM.read(startingAddress + i);
 	
-		int startingAddress = PROFILER_START_ADDRESS + ( PID * 2);
-		
-		byte lowByte = ((_profileBin[PID] >> 0) & 0xFF);
-		byte highByte = ((_profileBin[PID] >> 8) & 0xFF);
-		EEPROM.write(startingAddress, lowByte);
-		EEPROM.write(startingAddress + 1, highByte);
-		
+	return value;
+ }
+ #endif
+ 
+ #endif
+ 
+ /**
+  *	Writes at most one deferred record per call, with interrupts enabled, so the EEPROM
+  *	write time never adds to the tick ISR or to a critical section.
+  **/
+ void profileIdleFlush()
+ {
+	#if PROFILERUSE_EEPROM
+	unsigned char sreg;
+	unsigned char pid;
+	unsigned long value = 0;
+	unsigned char isBin = 0, found = 0;
+	
+	OSMakeAtomic(&sreg);
+	for (pid = 0; pid < OSMAX_TASKS && !found; pid++)
+	{
+		if (_binDirty & (1 << pid)) {
+			_binDirty &= ~(1 << pid);
+			value = _pendingBin[pid];
+			_pendingBin[pid] = 0;
+			isBin = 1;
+			found = 1;
+		}
+		#if PROFILERUSE_JOBS
+		else if (_responseDirty & (1 << pid)) {
+			_responseDirty &= ~(1 << pid);
+			value = _jobProfile[pid].maxResponse;
+			found = 1;
+		}
+		#endif
 	}
-	OSExitAtomic(_csreg);
+	OSExitAtomic(sreg);
 	
+	if (!found)
+		return;
+	pid--;
+	
+	if (isBin) {
+		if (getTaskProfileFromROM(pid) < value)
+			writeROM(PROFILER_START_ADDRESS + (pid * 2), value, 2);
+	}
+	#if PROFILERUSE_JOBS
+	else if (getResponseTimeFromROM(pid) < value)
+		writeROM(PROFILER_RESPONSE_ADDRESS + (pid * 4), value, 4);
+	#endif
+	#endif
  }
+ 
+ #if PROFILERUSE_EEPROM
  /**
   * Retrieves previously saved task profiles
   *
@@ -185,6 +454,12 @@ uint16_t getTaskProfileFromROM(int PID)
 	{
 		EEPROM.write(i, 0);
 	}
+	#if PROFILERUSE_JOBS
+	for (i = PROFILER_RESPONSE_ADDRESS; i < PROFILER_RESPONSE_ADDRESS + (_numTasks * 4) ; i++)
+	{
+		EEPROM.write(i, 0);
+	}
+	#endif
 	OSExitAtomic(_csreg);
  }
  #endif
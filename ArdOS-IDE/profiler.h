@@ -41,12 +41,94 @@
  **/
 #define PROFILERUSE_PRINT	0
 
+/**
+ *	Job profiler: response time of each job (release to completion) measured with Timer 2.
+ *	Time stamps are in Timer 2 counts of PROFILER_CYCLES_PER_COUNT CPU cycles.
+ *	A job ends in OSWaitNextPeriod() only, so the profiler needs the EDF scheduler.
+ **/
+#define PROFILERUSE_JOBS	(OSSCHED_TYPE == OS_EDF)
+
+#define PROFILER_CYCLES_PER_COUNT	64
+
+/**
+ *	Histogram of the tick ISR duration. Bin i counts ISRs that took i Timer 2 counts
+ *	(PROFILER_CYCLES_PER_COUNT cycles each), the last bin collects all longer ones.
+ **/
+#define PROFILERUSE_ISR	1
+
+#define PROFILER_ISR_BINS	16
+
+// EEPROM address of the worst response times (4 bytes per task), after the tick profile bins
+#define PROFILER_RESPONSE_ADDRESS	(PROFILER_START_ADDRESS + OSMAX_TASKS * 2)
+
+// Size of one task record written by profileDump()
+#define PROFILER_RECORD_SIZE	23
+
+// Job statistics of one task. Jitter of the response time is maxResponse - minResponse.
+// Deadline misses are counted by the kernel, see OSGetDeadlineMisses().
+typedef struct tjp
+{
+	unsigned long release;		// Release time of current job
+	unsigned long minResponse;
+	unsigned long maxResponse;
+	unsigned long sumResponse;	// For the mean response time
+	unsigned long sumJobs;		// Jobs in sumResponse, both are halved before sumResponse overflows
+	unsigned long maxLatency;	// Release to first dispatch
+	unsigned long jobs;
+	uint16_t preemptions;
+	unsigned char status;		// bit 0 = job active, bit 1 = job started
+} tJobProfile;
+
 void setCurrentProfiled(int PID);
 
 void tickTask();
 
 void resetAllProfileBins();
 
+#if PROFILERUSE_JOBS
+/**
+ *	Scheduler hooks. Called with interrupts disabled.
+ **/
+unsigned long profileTimestamp();
+
+void profileRelease(unsigned char PID);
+
+void profileSwitchIn(unsigned char PID);
+
+void profileSwitchOut(unsigned char PID, unsigned char blocked);
+
+void profileJobEnd(unsigned char PID);
+
+void resetJobProfiles();
+
+void getJobProfile(unsigned char PID, tJobProfile *profile);
+
+/**
+ *	Writes PROFILER_RECORD_SIZE bytes per task into buf (little endian):
+ *	pid, jobs (4 bytes), preemptions, min, max, mean response time, max latency.
+ *	Returns number of bytes written; stops at the last record that fits into len.
+ **/
+unsigned int profileDump(unsigned char *buf, unsigned int len);
+#endif
+
+#if PROFILERUSE_ISR
+/**
+ *	Tick ISR hooks. Called with interrupts disabled.
+ **/
+void profileIsrEnter();
+
+void profileIsrExit();
+
+void getIsrHistogram(uint16_t *bins);
+
+void resetIsrHistogram();
+#endif
+
+/**
+ *	Persists deferred profile records to EEPROM. Called by the idle task only.
+ **/
+void profileIdleFlush();
+
 #if PROFILERUSE_PRINT
 void printTaskProfile(int PID);
 #endif
@@ -64,6 +146,10 @@ void loadWorstTimeAnalysis();
 
 uint16_t getTaskProfileFromROM(int PID);
 
+#if PROFILERUSE_JOBS
+unsigned long getResponseTimeFromROM(int PID);
+#endif
+
 void clearEEPROMProfiler();
 
 void reportWorstTimeAnalysis();
@@ -138,9 +138,6 @@ void OSCreatePrioQueue(TPrioNode *buffer, unsigned char length, TMsgQ *queue)
 	OSExitAtomic(sreg);
 }
 
-extern unsigned long _sleepTime[];
-extern int _sleepFlag;
-
 void OSPrioEnqueue(int data, unsigned char prio, TMsgQ *queue)
 {
 		unsigned char i;
@@ -193,8 +190,7 @@ void OSPrioEnqueue(int data, unsigned char prio, TMsgQ *queue)
 
 		/* Block of code below is a work around that resolves the data corruption issue */
 		// Set sleep time
-		_sleepTime[_running]=0;
-		_sleepFlag |= (1<<_running);
+		_OSSleepInsert(_running, 1);
 		
 		// Set blocked flag
 		_tasks[_running].status|=_OS_BLOCKED;
@@ -28,6 +28,70 @@
  */
 
 #include "kernel.h"
+
+#if OSSCHED_TYPE == OS_EDF
+
+// Earliest absolute deadline first. Tasks without timing parameters (idle task, tasks created
+// with OSCreateTask) run after all timed tasks, ordered by their priority.
+unsigned char procBefore(int pid1, int pid2, tTCB *tasklist)
+{
+	unsigned char timed1=(tasklist[pid1].t != 0 || tasklist[pid1].c != 0);
+	unsigned char timed2=(tasklist[pid2].t != 0 || tasklist[pid2].c != 0);
+	
+	if(timed1 && timed2)
+		return (long) (tasklist[pid1].deadline - tasklist[pid2].deadline) < 0;
+	
+	if(timed1 != timed2)
+		return timed1;
+		
+	return tasklist[pid1].prio < tasklist[pid2].prio;
+}
+
+// For EDF a task queue is a binary min-heap keyed by deadline, kept in qptr[0..ctr-1].
+// The head is always at index 0, so procPeek works unchanged.
+void prioEnq(int pid, tTCB *tasklist, tQueue *q)
+{
+	unsigned char sreg;
+	OSMakeAtomic(&sreg);
+
+	unsigned char i, parent;
+	
+	if(q->ctr >= q->len)
+	{
+		OSExitAtomic(sreg);
+		return;
+	}
+	
+	// Sift up
+	i=q->ctr++;
+	while(i>0)
+	{
+		parent=(i-1)>>1;
+		if(!procBefore(pid, q->qptr[parent], tasklist))
+			break;
+		q->qptr[i]=q->qptr[parent];
+		i=parent;
+	}
+	
+	q->qptr[i]=pid;
+	q->tail=q->ctr % q->len;
+	OSExitAtomic(sreg);
+}
+
+#else
+
+// Returns non-zero if task pid1 is queued after task pid2. Tasks of equal rank stay in FIFO order.
+static unsigned char procLater(int pid1, int pid2, tTCB *tasklist)
+{
+	#if  OSSCHED_TYPE == OS_PRIORITY
+	return (tasklist[pid1].prio > tasklist[pid2].prio);
+	#elif OSSCHED_TYPE == OS_RMS
+	return ((tasklist[pid1].t >  tasklist[pid2].t ||(tasklist[pid1].t == tasklist[pid2].t && tasklist[pid1].c >  tasklist[pid2].c )) && !(tasklist[pid2].t == 0 && tasklist[pid2].c == 0));
+	#else
+	return 0;
+	#endif
+}
+
 // Priority queue routines
 void prioEnq(int pid, tTCB *tasklist, tQueue *q)
 {
@@ -46,11 +110,7 @@ void prioEnq(int pid, tTCB *tasklist, tQueue *q)
 			
 	while(iter != q->tail && !flag)
 	{
-		#if  OSSCHED_TYPE == OS_PRIORITY
-		flag=(tasklist[q->qptr[iter]].prio > tasklist[pid].prio);
-		#elif (OSSCHED_TYPE == OS_RMS) || (OSSCHED_TYPE == OS_EDF)
-		flag=((tasklist[q->qptr[iter]].t >  tasklist[pid].t ||(tasklist[q->qptr[iter]].t == tasklist[pid].t && tasklist[q->qptr[iter]].c >  tasklist[pid].c )) && !(tasklist[pid].t == 0 && tasklist[pid].c == 0));
-		#endif
+		flag=procLater(q->qptr[iter], pid, tasklist);
 		if(!flag)
 			iter=(iter+1) % q->len;
 	}
@@ -84,6 +144,8 @@ void prioEnq(int pid, tTCB *tasklist, tQueue *q)
 	OSExitAtomic(sreg);
 }
 
+#endif
+
 
 // Initializes task priorities based on the priority queue to ensure properness
 #if (OSSCHED_TYPE == OS_RMS) 
@@ -106,9 +168,73 @@ void initialPrioAssign(tTCB *tasklist, tQueue *q)
 
 void procEnq(int pid, tTCB *tasklist, tQueue *q)
 {
+		#if OSUSE_PROFILER == 1 && PROFILERUSE_JOBS
+		// Ready queue entry releases a job (ignored for a preempted task)
+		if(q == &_ready)
+			profileRelease(pid);
+		#endif
 		prioEnq(pid, tasklist, q);
 }
 
+void procEnqBatch(unsigned char *pids, unsigned char n, tTCB *tasklist, tQueue *q)
+{
+	unsigned char i;
+	
+	#if OSSCHED_TYPE == OS_EDF
+	
+	// Heap insertion is O(log n) already
+	for(i=0; i<n; i++)
+		procEnq(pids[i], tasklist, q);
+		
+	#else
+	
+	unsigned char sreg;
+	OSMakeAtomic(&sreg);
+	
+	unsigned char j, pid, count=0, left=q->ctr, iter=q->head;
+	unsigned char merged[OSMAX_TASKS+1];
+	
+	#if OSUSE_PROFILER == 1 && PROFILERUSE_JOBS
+	if(q == &_ready)
+		for(i=0; i<n; i++)
+			profileRelease(pids[i]);
+	#endif
+	
+	// Sort the batch, keeping the order of tasks of equal rank
+	for(i=1; i<n; i++)
+	{
+		pid=pids[i];
+		for(j=i; j>0 && procLater(pids[j-1], pid, tasklist); j--)
+			pids[j]=pids[j-1];
+		pids[j]=pid;
+	}
+	
+	// Merge with the queue. A queued task goes first unless it ranks after the new one, as in prioEnq.
+	i=0;
+	while((left || i<n) && count < q->len)
+	{
+		if(left && (i >= n || !procLater(q->qptr[iter], pids[i], tasklist)))
+		{
+			merged[count++]=q->qptr[iter];
+			iter=(iter+1) % q->len;
+			left--;
+		}
+		else
+			merged[count++]=pids[i++];
+	}
+	
+	for(j=0; j<q->len; j++)
+		q->qptr[j]=(j < count ? merged[j] : 255);
+		
+	q->head=0;
+	q->tail=count % q->len;
+	q->ctr=count;
+	
+	OSExitAtomic(sreg);
+	
+	#endif
+}
+
 unsigned char procPeek(tQueue *q)
 {
 	unsigned char sreg;
@@ -125,6 +251,43 @@ unsigned char procPeek(tQueue *q)
 	}
 }
 
+#if OSSCHED_TYPE == OS_EDF
+
+// Removes the task with the earliest deadline from the heap. All task queues hold indices into _tasks.
+unsigned char procDeq(tQueue *q)
+{
+	unsigned char sreg;
+	OSMakeAtomic(&sreg);
+	unsigned char ret=255, last, i, child;
+	if(q->ctr>0)
+	{
+		ret=q->qptr[0];
+		last=q->qptr[--q->ctr];
+		q->qptr[q->ctr]=255;
+		
+		// Sift down the last element from the root
+		if(q->ctr>0)
+		{
+			i=0;
+			while((child=2*i+1) < q->ctr)
+			{
+				if(child+1 < q->ctr && procBefore(q->qptr[child+1], q->qptr[child], _tasks))
+					child++;
+				if(!procBefore(q->qptr[child], last, _tasks))
+					break;
+				q->qptr[i]=q->qptr[child];
+				i=child;
+			}
+			q->qptr[i]=last;
+		}
+		q->tail=q->ctr % q->len;
+	}
+	OSExitAtomic(sreg);
+	return ret;
+}
+
+#else
+
 unsigned char procDeq(tQueue *q)
 {
 	unsigned char sreg;
@@ -140,6 +303,8 @@ unsigned char procDeq(tQueue *q)
 	return ret;
 }
 
+#endif
+
 void initQ(unsigned char *qbuf, unsigned char len, tQueue *q)
 {
 	unsigned char sreg;
@@ -82,6 +82,12 @@ extern "C" {
 #define KERNEL_NUMBER_OF_SEMAPHORES    3
 #define KERNEL_NUMBER_OF_QUEUES        2
 
+/**
+ * Number of task priorities. Every priority needs two pointers for its
+ * READY list, so keep this small on systems with little RAM.
+ */
+#define KERNEL_NUMBER_OF_PRIORITIES    8
+
 /**
  * \def  Kernel idle task hook function
  * Can be used to do some work while the kernel is idle.
@@ -0,0 +1,207 @@
+#include "AvRtos.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------
+/* Test application stack size definitions */
+#define STACK_SIZE            8192
+
+/* Test application task priorities */
+#define LOW_PRIORITY          (KERNEL_IDLE_TASK_PRIORITY + 1)
+#define BLOCKING_PRIORITY     (KERNEL_IDLE_TASK_PRIORITY + 2)
+#define MEDIUM_PRIORITY       (KERNEL_IDLE_TASK_PRIORITY + 3)
+#define HIGH_PRIORITY         (KERNEL_IDLE_TASK_PRIORITY + 4)
+#define CONTROL_PRIORITY      (KERNEL_IDLE_TASK_PRIORITY + 5)
+
+/* Number of system ticks the medium priority task keeps the CPU busy */
+#define MEDIUM_WORK           50
+
+/* Test application start events */
+#define START_LOW             0x01
+#define START_BLOCKING        0x02
+#define START_MEDIUM          0x04
+#define START_HIGH            0x08
+
+//----------------------------------------------------------------------------
+/* Test application stack declaration */
+static tStack controlTaskStack[STACK_SIZE];
+static tStack lowTaskStack[STACK_SIZE];
+static tStack blockingTaskStack[STACK_SIZE];
+static tStack mediumTaskStack[STACK_SIZE];
+static tStack highTaskStack[STACK_SIZE];
+
+/* Test application start event, the control task starts the test tasks with it */
+static tEventHandle startEvent;
+
+/* Test application mutexes */
+static tMutexHandle outerMutex;
+static tMutexHandle innerMutex;
+
+/* Test scenario, set by the control task */
+static uint8_t scenario;
+static uint32_t startTick;
+
+/* Test results, in system ticks since the start of the scenario */
+static uint32_t lowDone;
+static uint32_t mediumDone;
+static uint32_t highLocked;
+static uint8_t highResult;
+static uint8_t failures = 0;
+
+//----------------------------------------------------------------------------
+/* Keep the CPU busy for the given number of system ticks. The host port
+ * raises the system tick only from the idle task, so the tick is raised
+ * here like a timer interrupt while the task is running. */
+static void work( uint16_t ticks )
+{
+   while( ticks-- )
+      kernelHostTick();
+}
+
+static uint32_t now( void )
+{
+   return kernelHostTickCount - startTick;
+}
+
+static void check( const char* name, uint8_t passed )
+{
+   printf( "%-52s %s\n", name, passed ? "PASS" : "FAIL" );
+   if( !passed )
+      failures++;
+}
+
+//----------------------------------------------------------------------------
+void lowTaskFunction( void )
+{
+   while( 1 )
+   {
+      eventRetrieve( startEvent, START_LOW, 0, EVENT_OPTION_OR_CONSUME, KERNEL_WAIT_FOREVER );
+
+      /* Lock the mutex first and hold it for a while */
+      mutexGet( outerMutex, KERNEL_WAIT_FOREVER );
+      work( 20 );
+      lowDone = now();
+      mutexGive( outerMutex );
+   }
+}
+
+void blockingTaskFunction( void )
+{
+   while( 1 )
+   {
+      eventRetrieve( startEvent, START_BLOCKING, 0, EVENT_OPTION_OR_CONSUME, KERNEL_WAIT_FOREVER );
+
+      /* Lock the inner mutex and wait for the outer one. This will chain
+       * the priority of the high priority task to the low priority task. */
+      taskSleep( 1 );
+      mutexGet( innerMutex, KERNEL_WAIT_FOREVER );
+      mutexGet( outerMutex, KERNEL_WAIT_FOREVER );
+      mutexGive( outerMutex );
+      mutexGive( innerMutex );
+   }
+}
+
+void mediumTaskFunction( void )
+{
+   while( 1 )
+   {
+      eventRetrieve( startEvent, START_MEDIUM, 0, EVENT_OPTION_OR_CONSUME, KERNEL_WAIT_FOREVER );
+
+      /* Start after the high priority task is blocked and keep the CPU busy */
+      taskSleep( 4 );
+      work( MEDIUM_WORK );
+      mediumDone = now();
+   }
+}
+
+void highTaskFunction( void )
+{
+   while( 1 )
+   {
+      eventRetrieve( startEvent, START_HIGH, 0, EVENT_OPTION_OR_CONSUME, KERNEL_WAIT_FOREVER );
+
+      taskSleep( 3 );
+
+      if( scenario == 0 )
+      {
+         /* Wait for the mutex of the low priority task */
+         highResult = mutexGet( outerMutex, KERNEL_WAIT_FOREVER );
+         highLocked = now();
+         mutexGive( outerMutex );
+      }
+      else if( scenario == 1 )
+      {
+         /* Wait for the mutex of the blocking task, that waits for the low priority task */
+         highResult = mutexGet( innerMutex, KERNEL_WAIT_FOREVER );
+         highLocked = now();
+         mutexGive( innerMutex );
+      }
+      else
+      {
+         /* Give up before the low priority task gives back the mutex */
+         highResult = mutexGet( outerMutex, 2 );
+         highLocked = now();
+      }
+   }
+}
+
+void controlTask( void )
+{
+   for( scenario = 0; scenario < 3; scenario++ )
+   {
+      startTick = kernelHostTickCount;
+      lowDone = mediumDone = highLocked = 0;
+
+      if( scenario == 1 )
+         eventSet( startEvent, START_LOW | START_BLOCKING | START_MEDIUM | START_HIGH, EVENT_OPTION_OR );
+      else
+         eventSet( startEvent, START_LOW | START_MEDIUM | START_HIGH, EVENT_OPTION_OR );
+
+      /* All test tasks are done after this time */
+      taskSleep( 200 );
+
+      if( scenario == 0 )
+      {
+         printf( "Inversion: low %u, medium %u, high %u\n", lowDone, mediumDone, highLocked );
+         check( "High task locks the mutex", highResult == KERNEL_NO_ERROR );
+         check( "Medium task can not preempt the boosted low task", lowDone < mediumDone );
+         check( "High task gets the mutex before the medium task ends", highLocked < mediumDone );
+      }
+      else if( scenario == 1 )
+      {
+         printf( "Chained inversion: low %u, medium %u, high %u\n", lowDone, mediumDone, highLocked );
+         check( "High task locks the inner mutex", highResult == KERNEL_NO_ERROR );
+         check( "Priority is passed on through both mutexes", lowDone < mediumDone );
+         check( "High task gets the mutex before the medium task ends", highLocked < mediumDone );
+      }
+      else
+      {
+         printf( "Timeout: low %u, medium %u, high %u\n", lowDone, mediumDone, highLocked );
+         check( "High task times out", highResult == KERNEL_TIMEOUT_ERROR );
+         check( "Low task loses the inherited priority after the timeout", lowDone > mediumDone );
+      }
+   }
+
+   exit( failures ? 1 : 0 );
+}
+
+int main( void )
+{
+   /* Create the needed tasks. The test tasks wait for the start event of the control task. */
+   taskCreate( controlTask, "control", controlTaskStack, STACK_SIZE, CONTROL_PRIORITY );
+   taskCreate( lowTaskFunction, "low", lowTaskStack, STACK_SIZE, LOW_PRIORITY );
+   taskCreate( blockingTaskFunction, "blocking", blockingTaskStack, STACK_SIZE, BLOCKING_PRIORITY );
+   taskCreate( mediumTaskFunction, "medium", mediumTaskStack, STACK_SIZE, MEDIUM_PRIORITY );
+   taskCreate( highTaskFunction, "high", highTaskStack, STACK_SIZE, HIGH_PRIORITY );
+
+   /* Create the needed mutexes and events. */
+   outerMutex = mutexCreate();
+   innerMutex = mutexCreate();
+   startEvent = eventCreate();
+
+   /* Finally start the scheduler */
+   kernelStartScheduler();
+
+   /* We should never get here. */
+   return 0;
+}
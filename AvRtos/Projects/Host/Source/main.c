@@ -0,0 +1,119 @@
+#include "AvRtos.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------
+/* Test application stack size definitions */
+#define STACK_SIZE            8192
+#define WORKER_STACK_SIZE     2048
+
+/* Number of worker tasks, one task is needed for the control task */
+#define NUMBER_OF_WORKERS     (KERNEL_NUMBER_OF_TASKS - 1)
+
+/* Timeout of the blocking calls in the worker tasks */
+#define WORKER_TIMEOUT        50000
+
+/* Number of system ticks to measure for each step */
+#define MEASURE_TICKS         5000
+
+//----------------------------------------------------------------------------
+/* Test application stack declaration */
+static tStack controlTaskStack[STACK_SIZE];
+static tStack workerTaskStack[NUMBER_OF_WORKERS][WORKER_STACK_SIZE];
+
+/* Test application worker tasks */
+static tTaskHandle workerTasks[NUMBER_OF_WORKERS];
+static uint8_t numberOfWorkers = 0;
+
+/* Test application synchronization elements. None of them will ever be released. */
+static tSemaphoreHandle semaphore;
+static tMutexHandle mutex;
+static tEventHandle event;
+static tQueueHandle emptyQueue;
+static tQueueHandle fullQueue;
+
+/* Test application queue buffers */
+static uint8_t emptyQueueBuffer[1];
+static uint8_t fullQueueBuffer[1];
+
+/* Number of blocked workers for each measurement step */
+static const uint8_t steps[] = { 0, 1, 2, 4, 8, 16, 32, NUMBER_OF_WORKERS };
+
+//----------------------------------------------------------------------------
+void workerTask( void )
+{
+   uint8_t kind = numberOfWorkers++ % 6;
+   uint8_t message = 0;
+
+   /* Every worker blocks with a timeout on one of the blocking functions */
+   while( 1 )
+   {
+      switch( kind )
+      {
+         case 0:  taskSleep( WORKER_TIMEOUT ); break;
+         case 1:  semaphoreGet( semaphore, WORKER_TIMEOUT ); break;
+         case 2:  mutexGet( mutex, WORKER_TIMEOUT ); break;
+         case 3:  eventRetrieve( event, 1, 0, EVENT_OPTION_OR, WORKER_TIMEOUT ); break;
+         case 4:  queueGet( emptyQueue, &message, WORKER_TIMEOUT ); break;
+         default: queuePut( fullQueue, &message, WORKER_TIMEOUT ); break;
+      }
+   }
+}
+
+void controlTask( void )
+{
+   uint8_t message = 0;
+   uint8_t blocked = 0;
+   uint8_t i;
+   uint32_t ticks;
+   uint64_t time;
+
+   /* Own the mutex and fill the queue, so the workers will block */
+   mutexGet( mutex, KERNEL_WAIT_FOREVER );
+   queuePut( fullQueue, &message, 0 );
+
+   printf( "blocked tasks   ns per tick\n" );
+
+   for( i = 0; i < sizeof(steps); i++ )
+   {
+      /* Resume the workers. They block as soon as we sleep. */
+      while( blocked < steps[i] )
+         taskResume( workerTasks[blocked++] );
+      taskSleep( 1 );
+
+      /* Measure the system tick while all workers are blocked */
+      ticks = kernelHostTickCount;
+      time = kernelHostTickTime;
+      taskSleep( MEASURE_TICKS );
+
+      printf( "%13u   %11.1f\n", blocked, (double)(kernelHostTickTime - time) / (kernelHostTickCount - ticks) );
+   }
+
+   exit( 0 );
+}
+
+int main( void )
+{
+   uint8_t i;
+
+   /* Create the needed tasks. The workers will be resumed by the control task. */
+   taskCreate( controlTask, "control", controlTaskStack, STACK_SIZE, KERNEL_IDLE_TASK_PRIORITY + 2 );
+   for( i = 0; i < NUMBER_OF_WORKERS; i++ )
+   {
+      workerTasks[i] = taskCreate( workerTask, "worker", workerTaskStack[i], WORKER_STACK_SIZE, KERNEL_IDLE_TASK_PRIORITY + 1 );
+      taskSuspend( workerTasks[i] );
+   }
+
+   /* Create the needed synchronization elements. */
+   semaphore = semaphoreCreate( 0 );
+   mutex = mutexCreate();
+   event = eventCreate();
+   emptyQueue = queueCreate( emptyQueueBuffer, 1, 1 );
+   fullQueue = queueCreate( fullQueueBuffer, 1, 1 );
+
+   /* Finally start the scheduler */
+   kernelStartScheduler();
+
+   /* We should never get here. */
+   return 0;
+}
@@ -0,0 +1,206 @@
+#include "AvRtos.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//----------------------------------------------------------------------------
+/* Test application stack size definitions */
+#define STACK_SIZE            8192
+
+/* Test application task priorities */
+#define CONTROL_PRIORITY      (KERNEL_IDLE_TASK_PRIORITY + 1)
+#define CONSUMER_PRIORITY     (KERNEL_IDLE_TASK_PRIORITY + 2)
+
+/* Size of one frame, like a block of ADC samples */
+#define FRAME_SIZE            32
+
+/* Number of frames in a copy queue, the queue buffer must not exceed 255 bytes */
+#define QUEUE_DEPTH           7
+
+/* Number of frame buffers in the buffer pool */
+#define POOL_DEPTH            16
+
+/* Number of frames to pass for each measurement */
+#define NUMBER_OF_FRAMES      (QUEUE_DEPTH * 30000UL)
+
+//----------------------------------------------------------------------------
+typedef struct
+{
+   uint32_t sequence;
+   uint8_t  samples[FRAME_SIZE - sizeof(uint32_t)];
+} tFrame;
+
+//----------------------------------------------------------------------------
+/* Test application stack declaration */
+static tStack controlTaskStack[STACK_SIZE];
+static tStack consumerTaskStack[STACK_SIZE];
+
+/* Test application queues */
+static tQueueHandle frameQueue;
+static tQueueHandle handOffQueue;
+static tQueueHandle pointerQueue;
+static tQueueHandle poolQueue;
+
+/* Test application queue buffers */
+static uint8_t frameQueueBuffer[QUEUE_DEPTH * FRAME_SIZE];
+static uint8_t handOffQueueBuffer[QUEUE_DEPTH * FRAME_SIZE];
+static uint8_t pointerQueueBuffer[POOL_DEPTH * sizeof(void*)];
+static uint8_t poolQueueBuffer[POOL_DEPTH * sizeof(void*)];
+
+/* Test application frame buffers, they are passed by pointer */
+static tFrame pool[POOL_DEPTH];
+
+/* Number of valid frames received by the consumer task */
+static uint32_t consumed = 0;
+static uint8_t failures = 0;
+
+//----------------------------------------------------------------------------
+static uint64_t now( void )
+{
+   struct timespec ts;
+
+   clock_gettime( CLOCK_MONOTONIC, &ts );
+   return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void report( const char* name, uint64_t start, uint32_t frames )
+{
+   printf( "%-36s %8.1f\n", name, (double)(now() - start) / NUMBER_OF_FRAMES );
+   if( frames != NUMBER_OF_FRAMES )
+   {
+      printf( "  %u valid frames, expected %lu\n", frames, NUMBER_OF_FRAMES );
+      failures++;
+   }
+}
+
+static void fill( tFrame* frame, uint32_t sequence )
+{
+   frame->sequence = sequence;
+   memset( frame->samples, (uint8_t)sequence, sizeof(frame->samples) );
+}
+
+static uint8_t valid( tFrame* frame, uint32_t sequence )
+{
+   return frame->sequence == sequence && frame->samples[sizeof(frame->samples) - 1] == (uint8_t)sequence;
+}
+
+//----------------------------------------------------------------------------
+void consumerTask( void )
+{
+   tFrame frame;
+
+   /* The consumer has the higher priority, so it always waits in queueGet
+    * when the control task puts a frame. The frame will be copied directly
+    * to the frame buffer of the consumer. */
+   while( 1 )
+   {
+      queueGet( handOffQueue, &frame, KERNEL_WAIT_FOREVER );
+      if( valid( &frame, consumed ) )
+         consumed++;
+   }
+}
+
+void controlTask( void )
+{
+   tFrame frames[QUEUE_DEPTH];
+   tFrame* buffers[QUEUE_DEPTH];
+   uint32_t sequence;
+   uint32_t passed;
+   uint64_t start;
+   uint8_t count;
+   uint8_t i;
+
+   printf( "%d byte frames                      ns per frame\n", FRAME_SIZE );
+
+   /* Copy each frame to the queue and back, one frame with each call */
+   passed = 0;
+   start = now();
+   for( sequence = 0; sequence < NUMBER_OF_FRAMES; )
+   {
+      for( i = 0; i < QUEUE_DEPTH; i++ )
+      {
+         fill( &frames[i], sequence + i );
+         queuePut( frameQueue, &frames[i], 0 );
+      }
+      for( i = 0; i < QUEUE_DEPTH; i++, sequence++ )
+      {
+         if( queueGet( frameQueue, &frames[i], 0 ) == KERNEL_NO_ERROR && valid( &frames[i], sequence ) )
+            passed++;
+      }
+   }
+   report( "queuePut/queueGet", start, passed );
+
+   /* Copy all frames with one call */
+   passed = 0;
+   start = now();
+   for( sequence = 0; sequence < NUMBER_OF_FRAMES; )
+   {
+      for( i = 0; i < QUEUE_DEPTH; i++ )
+         fill( &frames[i], sequence + i );
+      count = QUEUE_DEPTH;
+      queuePutN( frameQueue, frames, &count, 0 );
+      count = QUEUE_DEPTH;
+      queueGetN( frameQueue, frames, &count, 0 );
+      for( i = 0; i < count; i++, sequence++ )
+      {
+         if( valid( &frames[i], sequence ) )
+            passed++;
+      }
+   }
+   report( "queuePutN/queueGetN", start, passed );
+
+   /* Take the frame buffers from the pool and pass them by pointer */
+   passed = 0;
+   start = now();
+   for( sequence = 0; sequence < NUMBER_OF_FRAMES; )
+   {
+      for( i = 0; i < QUEUE_DEPTH; i++ )
+      {
+         queueGetPointer( poolQueue, (void**)&buffers[i], 0 );
+         fill( buffers[i], sequence + i );
+         queuePutPointer( pointerQueue, buffers[i], 0 );
+      }
+      for( i = 0; i < QUEUE_DEPTH; i++, sequence++ )
+      {
+         if( queueGetPointer( pointerQueue, (void**)&buffers[i], 0 ) == KERNEL_NO_ERROR && valid( buffers[i], sequence ) )
+            passed++;
+         queuePutPointer( poolQueue, buffers[i], 0 );
+      }
+   }
+   report( "Buffer pool and pointer queue", start, passed );
+
+   /* Pass each frame directly to the waiting consumer task */
+   start = now();
+   for( sequence = 0; sequence < NUMBER_OF_FRAMES; sequence++ )
+   {
+      fill( &frames[0], sequence );
+      queuePut( handOffQueue, &frames[0], KERNEL_WAIT_FOREVER );
+   }
+   report( "Hand-off to waiting task", start, consumed );
+
+   exit( failures ? 1 : 0 );
+}
+
+int main( void )
+{
+   uint8_t i;
+
+   /* Create the needed tasks. */
+   taskCreate( controlTask, "control", controlTaskStack, STACK_SIZE, CONTROL_PRIORITY );
+   taskCreate( consumerTask, "consumer", consumerTaskStack, STACK_SIZE, CONSUMER_PRIORITY );
+
+   /* Create the needed queues and fill the buffer pool. */
+   frameQueue = queueCreate( frameQueueBuffer, FRAME_SIZE, QUEUE_DEPTH );
+   handOffQueue = queueCreate( handOffQueueBuffer, FRAME_SIZE, QUEUE_DEPTH );
+   pointerQueue = queueCreate( pointerQueueBuffer, sizeof(void*), POOL_DEPTH );
+   poolQueue = queueCreate( poolQueueBuffer, sizeof(void*), POOL_DEPTH );
+   for( i = 0; i < POOL_DEPTH; i++ )
+      queuePutPointer( poolQueue, &pool[i], 0 );
+
+   /* Finally start the scheduler */
+   kernelStartScheduler();
+
+   /* We should never get here. */
+   return 0;
+}
@@ -28,6 +28,8 @@
 /*****************************************************************************
  * 2. file local constants/definitions
  *****************************************************************************/
+/* Number of 32 bit words of the ready bitmap */
+#define KERNEL_READY_WORDS       ((KERNEL_NUMBER_OF_PRIORITIES + 31) / 32)
 
 /*****************************************************************************
  * 3. global variables
@@ -54,10 +56,22 @@ typedef struct _Task
 {
    tStack* stackPointer;   /**< Pointer to the current task stack. THIS MUST BE THE FIRST ENTRY IN THIS STRUCTURE */
    tTaskState state;       /**< Current task state */
-   uint8_t priority;       /**< Task priority */
-   uint16_t ticksToWait;   /**< Timeout value that will be counted down at each system tick */
+   uint8_t priority;       /**< Current task priority, maybe inherited from a mutex waiter */
+   uint8_t basePriority;   /**< Task priority given at task creation */
+   uint16_t ticksToWait;   /**< Timeout value of the blocking call. Will be set to 0 if the timeout was reached */
+   uint16_t timeoutDelta;  /**< Ticks to wait relative to the previous task in the timeoutQ */
    char* taskName;         /**< Pointer to the task name */
    struct _Task* next;     /**< Pointer to the next task in the linked list */
+   struct _Task** waitQ;   /**< Pointer to the waitQ the task is blocked on, 0 if the task sleeps */
+   struct _Task* timeoutPrev; /**< Pointer to the previous task in the timeoutQ */
+   struct _Task* timeoutNext; /**< Pointer to the next task in the timeoutQ */
+#if KERNEL_CONFIG_USE_MUTEXES == 1
+   struct _Mutex* waitMutex;  /**< Pointer to the mutex the task is blocked on */
+   struct _Mutex* mutexList;  /**< Linked list of mutexes owned by the task */
+#endif
+#if KERNEL_CONFIG_USE_QUEUES == 1
+   uint8_t* msgBuffer;     /**< Message buffer of a task that waits for a queue, 0 after the message was passed */
+#endif
 
 } tTask;
 
@@ -67,7 +81,6 @@ typedef struct _Task
 typedef struct _Element
 {
    tTask* waitingQ;        /**< Linked list of tasks that waits for this element */
-   struct _Element* next;  /**< Pointer to the element in the linked list */
 
 } tElement;
 
@@ -101,8 +114,9 @@ typedef struct _Event
  */
 typedef struct _Mutex
 {
-   tTaskHandle owner;      /**< Handle to the task that owns the mutex */
+   tTask* owner;           /**< Pointer to the task that owns the mutex */
    tElement element;       /**< Element to handle linked list */
+   struct _Mutex* next;    /**< Pointer to the next mutex owned by the same task */
 
 } tMutex;
 #endif
@@ -131,9 +145,11 @@ typedef struct _Queue
 static uint8_t kernelRunning = 0;         /**< Flag to identify if scheduler is running */
 static uint32_t kernelTicks = 0;          /**< General scheduler tick counter */
 static tTask* kernelIdleTask = 0;         /**< Pointer to the kernel idle task */
-static tTask* kernelTaskReadyQ = 0;       /**< Head of the linked list of tasks in the READY state */
-static tTask* kernelTaskWaitQ = 0;        /**< Head of the linked list of tasks in the WAIT */
-static tElement* kernelTimeoutQ = 0;      /**< Head of elements that wait for a timeout */
+static tTask* kernelTaskReadyQ[KERNEL_NUMBER_OF_PRIORITIES];    /**< Heads of the lists of tasks in the READY state, one for each priority */
+static tTask* kernelTaskReadyTail[KERNEL_NUMBER_OF_PRIORITIES]; /**< Tails of the lists of tasks in the READY state */
+static uint32_t kernelReadyGroups = 0;                          /**< One bit for each word of kernelReadyMap that is not 0 */
+static uint32_t kernelReadyMap[KERNEL_READY_WORDS];             /**< One bit for each priority that has a READY task */
+static tTask* kernelTimeoutQ = 0;         /**< Head of the delta list of tasks that wait for a timeout */
 
 /* Memory allocation of system task control blocks + one for system idle task */
 static uint8_t kernelNumberOfTasks = 0;
@@ -169,6 +185,14 @@ static tStack kernelIdelTaskStack[KERNEL_IDLE_TASK_STACK_SIZE];
 /*****************************************************************************
  * 6. file local macros
  *****************************************************************************/
+/**
+ * Number of the highest bit set in a 32 bit value. The value must not be 0.
+ * The CPU specific part of the RTOS can define it, if the compiler builtin is
+ * not the fastest way. On ARM Cortex-M the builtin is a single CLZ instruction.
+ */
+#ifndef KERNEL_HIGHEST_BIT
+#define KERNEL_HIGHEST_BIT(x)    (31 - ((sizeof(unsigned int) >= 4) ? __builtin_clz(x) : __builtin_clzl(x)))
+#endif
 
 /*****************************************************************************
  * 7. file local function prototypes
@@ -194,22 +218,78 @@ static void _kernelDequeueTask( tTask** queue, tTask* task );
 static tTask* _kernelDequeueHighestPrioTask( tTask** queue );
 
 /**
- * Linked list handling function for system elements like semaphores and queues.
- * This function will put the given element to the end of the list.
+ * Ready list handling function. This function will put the given task to the
+ * end of the READY list of its priority and marks the priority in the bitmap.
+ */
+static void _kernelEnqueueReadyTask( tTask* task );
+
+/**
+ * Ready list handling function.
+ * Remove the given task from the READY list of its priority.
+ */
+static void _kernelDequeueReadyTask( tTask* task );
+
+/**
+ * Ready list handling function.
+ * Get the first task of the highest priority READY list, without removing it.
+ */
+static tTask* _kernelHighestReadyTask( void );
+
+/**
+ * Ready list handling function.
+ * Get and remove the first task of the highest priority READY list.
+ */
+static tTask* _kernelDequeueHighestReadyTask( void );
+
+#if KERNEL_CONFIG_USE_MUTEXES == 1
+/**
+ * Change the current priority of the given task. If the task is in a READY
+ * list or in the waitQ of an element, it will be moved to the new position.
+ */
+static void _kernelSetTaskPriority( tTask* task, uint8_t priority );
+
+/**
+ * Priority inheritance function. Calculate the priority of the given task
+ * from its base priority and the waiters of all mutexes it owns.
+ * If the task waits for a mutex, the new priority will be passed on to the
+ * owner of this mutex and so on.
+ */
+static void _kernelUpdateInheritedPriority( tTask* task );
+#endif
+
+#if KERNEL_CONFIG_USE_QUEUES == 1
+/**
+ * Copy one message of the given size.
+ */
+static void _kernelCopyMessage( uint8_t* dest, uint8_t* source, uint8_t size );
+
+/**
+ * Queue handling function. Copy one message to the end of the queue buffer.
+ * The caller has to check if there is room for the message.
+ */
+static void _kernelQueueWrite( tQueue* que, uint8_t* source );
+
+/**
+ * Queue handling function. Copy the first message out of the queue buffer.
+ * The caller has to check if there is a message.
  */
-static void _kernelEnqueueElement( tElement** queue, tElement* element );
+static void _kernelQueueRead( tQueue* que, uint8_t* dest );
+#endif
 
 /**
- * Linked list handling function for system elements like semaphores and queues.
- * This function will get the given element from the list.
+ * Timeout list handling function. The timeoutQ is a delta list, every task
+ * stores its timeout relative to the previous task. So the system tick has
+ * only to count down the first task of the list.
+ * waitQ is the waitQ of the element the task is blocked on or 0 if the task
+ * only sleeps. Tasks that wait for ever will not be put to the list.
  */
-static void _kernelDequeueElement( tElement** queue, tElement* element );
+static void _kernelEnqueueTimeout( tTask* task, tTask** waitQ, uint16_t ticks );
 
 /**
- * This function counts down the timeout value of every task in the linked list.
- * If the timeout was reached, the task will be put to the running queue again.
+ * Timeout list handling function.
+ * Remove the given task from the timeoutQ, if it is in the list.
  */
-static void _kernelProcessTaskTimeout( tTask** queue );
+static void _kernelDequeueTimeout( tTask* task );
 
 /**
  * Idle task. This task will be executed when no other task is ready to run.
@@ -358,117 +438,347 @@ static tTask* _kernelDequeueHighestPrioTask( tTask** queue )
 }
 
 //----------------------------------------------------------------------------
-static void _kernelEnqueueElement( tElement** queue, tElement* element )
+static void _kernelEnqueueReadyTask( tTask* task )
 {
    /************************************************************************
     * local variables
     *************************************************************************/
-   tElement* next;
+   uint8_t priority;
 
    /************************************************************************
     * function code
     *************************************************************************/
 
-   if( (queue != 0) && (element != 0) )
-   {
-      next = *queue;
-      while( (next) && (next != element) )
-         next = next->next;
+   if( task == 0 )
+      return;
 
-      if( next != element )
-      {
-         element->next = *queue;
-         *queue = element;
-      }
+   priority = task->priority;
+   task->next = 0;
+
+   if( kernelTaskReadyQ[priority] )
+   {
+      /* Tasks with the same priority will be linked in FIFO order */
+      kernelTaskReadyTail[priority]->next = task;
    }
+   else
+   {
+      /* This is the first task with this priority */
+      kernelTaskReadyQ[priority] = task;
+      kernelReadyMap[priority >> 5] |= (uint32_t)1 << (priority & 31);
+      kernelReadyGroups |= (uint32_t)1 << (priority >> 5);
+   }
+
+   kernelTaskReadyTail[priority] = task;
 }
 
 //----------------------------------------------------------------------------
-static void _kernelDequeueElement( tElement** queue, tElement* element )
+static void _kernelDequeueReadyTask( tTask* task )
 {
    /************************************************************************
     * local variables
     *************************************************************************/
-   tElement* prev;
-   tElement* next;
+   uint8_t priority;
+   tTask* prev;
+   tTask* next;
 
    /************************************************************************
     * function code
     *************************************************************************/
 
-   prev = next = kernelTimeoutQ;
-   while( next )
-   {
-      /* Is this entry the one we're looking for? */
-      if( next == element )
-      {
-         if( next == kernelTimeoutQ )
-            /* We're removing the list head */
-            kernelTimeoutQ = next->next;
-         else
-         {
-            /* We're removing a mid or tail TCB */
-            prev->next = next->next;
-         }
-         next->next = 0;
-         break;
-      }
+   if( task == 0 )
+      return;
 
-      /* Move on to the next in the list */
+   priority = task->priority;
+   prev = 0;
+   next = kernelTaskReadyQ[priority];
+   while( (next) && (next != task) )
+   {
       prev = next;
       next = next->next;
    }
+
+   /* The task is not in the READY list */
+   if( next == 0 )
+      return;
+
+   if( prev )
+      prev->next = task->next;
+   else
+      kernelTaskReadyQ[priority] = task->next;
+
+   if( kernelTaskReadyTail[priority] == task )
+      kernelTaskReadyTail[priority] = prev;
+
+   task->next = 0;
+
+   /* Clear the priority in the bitmap if there is no other task */
+   if( kernelTaskReadyQ[priority] == 0 )
+   {
+      kernelReadyMap[priority >> 5] &= ~((uint32_t)1 << (priority & 31));
+      if( kernelReadyMap[priority >> 5] == 0 )
+         kernelReadyGroups &= ~((uint32_t)1 << (priority >> 5));
+   }
 }
 
 //----------------------------------------------------------------------------
-static void _kernelProcessTaskTimeout( tTask** queue )
+static tTask* _kernelHighestReadyTask( void )
 {
    /************************************************************************
     * local variables
     *************************************************************************/
-   tTask* nextT;
-   tTask* task;
+   uint8_t group;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   if( kernelReadyGroups == 0 )
+      return 0;
+
+   group = KERNEL_HIGHEST_BIT( kernelReadyGroups );
+
+   return kernelTaskReadyQ[(group << 5) + KERNEL_HIGHEST_BIT( kernelReadyMap[group] )];
+}
+
+//----------------------------------------------------------------------------
+static tTask* _kernelDequeueHighestReadyTask( void )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   tTask* result;
 
    /************************************************************************
     * function code
     *************************************************************************/
 
-   if( queue == 0 )
+   /* The highest priority task is always the first one of its list */
+   result = _kernelHighestReadyTask();
+   _kernelDequeueReadyTask( result );
+
+   return (result);
+}
+
+#if KERNEL_CONFIG_USE_MUTEXES == 1
+//----------------------------------------------------------------------------
+static void _kernelSetTaskPriority( tTask* task, uint8_t priority )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   if( task->priority == priority )
       return;
 
-   /* Process the waitQ */
-   nextT = *queue;
-   while( nextT )
+   if( (task->state == READY) && (task != kernelRunningTask) )
    {
-      if( nextT->ticksToWait < KERNEL_WAIT_FOREVER )
-      {
-         nextT->ticksToWait--;
-         if( nextT->ticksToWait == 0 )
-         {
-            /* Copy pointer for queue manipulation */
-            task = nextT;
-            nextT = nextT->next;
+      /* Move the task to the READY list of the new priority */
+      _kernelDequeueReadyTask( task );
+      task->priority = priority;
+      _kernelEnqueueReadyTask( task );
+   }
+   else if( (task->state == WAIT) && (task->waitQ) )
+   {
+      /* Keep the waitQ of the element in priority order */
+      _kernelDequeueTask( task->waitQ, task );
+      task->priority = priority;
+      _kernelEnqueueTask( task->waitQ, task );
+   }
+   else
+   {
+      task->priority = priority;
+   }
+}
 
-            /* Set new task state */
-            task->state = READY;
+//----------------------------------------------------------------------------
+static void _kernelUpdateInheritedPriority( tTask* task )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   uint8_t i;
+   uint8_t priority;
+   tMutex* mu;
 
-            /* Remove this task from waitQ */
-            _kernelDequeueTask( queue, task );
+   /************************************************************************
+    * function code
+    *************************************************************************/
 
-            /* Insert this task to readyQ */
-            _kernelEnqueueTask( &kernelTaskReadyQ, task );
-         }
-         else
-         {
-            nextT = nextT->next;
-         }
-      }
-      else
+   /* Follow the chain of owners. Every task can only wait for one mutex,
+    * so the chain can not be longer than the number of tasks. */
+   for( i = 0; (i < kernelNumberOfTasks) && (task); i++ )
+   {
+      /* The task inherits the priority of the highest priority waiter
+       * of all its mutexes. This is always the first task of the waitQ. */
+      priority = task->basePriority;
+      for( mu = task->mutexList; mu; mu = mu->next )
       {
-         nextT = nextT->next;
+         if( (mu->element.waitingQ) && (mu->element.waitingQ->priority > priority) )
+            priority = mu->element.waitingQ->priority;
       }
+
+      /* Nothing changed, so the rest of the chain is up to date */
+      if( priority == task->priority )
+         break;
+
+      _kernelSetTaskPriority( task, priority );
+
+      /* Pass the new priority on to the owner of the mutex the task waits for */
+      task = (task->waitMutex) ? task->waitMutex->owner : 0;
    }
 }
+#endif
+
+#if KERNEL_CONFIG_USE_QUEUES == 1
+//----------------------------------------------------------------------------
+static void _kernelCopyMessage( uint8_t* dest, uint8_t* source, uint8_t size )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   uint8_t i;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   for( i = 0; i < size; i++ )
+      *dest++ = *source++;
+}
+
+//----------------------------------------------------------------------------
+static void _kernelQueueWrite( tQueue* que, uint8_t* source )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   /* There is space in the queue, copy it in */
+   _kernelCopyMessage( que->queueBuffer + que->insertPointer, source, que->msgSize );
+
+   que->insertPointer += que->msgSize;
+   que->msgCount++;
+
+   /* Check if the insert index should now wrap to the beginning */
+   if( que->insertPointer >= (que->msgSize * que->msgMax) )
+      que->insertPointer = 0;
+}
+
+//----------------------------------------------------------------------------
+static void _kernelQueueRead( tQueue* que, uint8_t* dest )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   /* Copy the message out of the queue */
+   _kernelCopyMessage( dest, que->queueBuffer + que->removePointer, que->msgSize );
+
+   que->removePointer += que->msgSize;
+   que->msgCount--;
+
+   /* Check if the remove index should now wrap to the beginning */
+   if( que->removePointer >= (que->msgSize * que->msgMax) )
+      que->removePointer = 0;
+}
+#endif
+
+//----------------------------------------------------------------------------
+static void _kernelEnqueueTimeout( tTask* task, tTask** waitQ, uint16_t ticks )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   tTask* prev;
+   tTask* next;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   if( task == 0 )
+      return;
+
+   task->waitQ = waitQ;
+   task->timeoutPrev = 0;
+   task->timeoutNext = 0;
+
+   /* Tasks that wait for ever will never time out */
+   if( ticks == KERNEL_WAIT_FOREVER )
+      return;
+
+   /* Search the insert position. Tasks with the same timeout will be linked
+    * in FIFO order. Make the timeout relative to the previous task. */
+   prev = 0;
+   next = kernelTimeoutQ;
+   while( (next) && (next->timeoutDelta <= ticks) )
+   {
+      ticks -= next->timeoutDelta;
+      prev = next;
+      next = next->timeoutNext;
+   }
+
+   task->timeoutDelta = ticks;
+   task->timeoutPrev = prev;
+   task->timeoutNext = next;
+
+   /* The next task is now relative to the inserted one */
+   if( next )
+   {
+      next->timeoutDelta -= ticks;
+      next->timeoutPrev = task;
+   }
+
+   if( prev )
+      prev->timeoutNext = task;
+   else
+      kernelTimeoutQ = task;
+}
+
+//----------------------------------------------------------------------------
+static void _kernelDequeueTimeout( tTask* task )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   tTask* next;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   /* Check if the task is in the timeoutQ */
+   if( (task == 0) || ((task->timeoutPrev == 0) && (kernelTimeoutQ != task)) )
+      return;
+
+   /* The remaining ticks of this task belong to the next task now */
+   next = task->timeoutNext;
+   if( next )
+   {
+      next->timeoutDelta += task->timeoutDelta;
+      next->timeoutPrev = task->timeoutPrev;
+   }
+
+   if( task->timeoutPrev )
+      task->timeoutPrev->timeoutNext = next;
+   else
+      kernelTimeoutQ = next;
+
+   task->timeoutPrev = 0;
+   task->timeoutNext = 0;
+}
 
 //----------------------------------------------------------------------------
 void _kernelSwitchIsrContext(void)
@@ -484,13 +794,14 @@ void _kernelSwitchIsrContext(void)
 
    /* Check if the next task in the readyQ has a higher or equal priority to the
     * currently running task. If so switch to it. */
-   if( (kernelTaskReadyQ) && (kernelTaskReadyQ->priority >= ((tTask*)kernelRunningTask)->priority) )
+   task = _kernelHighestReadyTask();
+   if( (task) && (task->priority >= ((tTask*)kernelRunningTask)->priority) )
    {
       /* Get task to switch to */
-      task = _kernelDequeueHighestPrioTask( &kernelTaskReadyQ );
+      _kernelDequeueReadyTask( task );
 
       /* Add the current task to the readyQ */
-      _kernelEnqueueTask( &kernelTaskReadyQ, kernelRunningTask );
+      _kernelEnqueueReadyTask( kernelRunningTask );
 
       /* Switch to the new task */
       kernelRunningTask = task;
@@ -511,7 +822,7 @@ void _kernelSwitchContext( void )
    CONTEXT_SWITCH_SAVE_CONTEXT();
 
    /* Get next task to switch to */
-   kernelRunningTask = _kernelDequeueHighestPrioTask( &kernelTaskReadyQ );
+   kernelRunningTask = _kernelDequeueHighestReadyTask();
 
    /* If there is no task to run, switch to idle task */
    if( kernelRunningTask == 0 )
@@ -536,24 +847,39 @@ void _kernelScheduleTick( void )
    /************************************************************************
     * local variables
     *************************************************************************/
-   tElement* nextS;
+   tTask* task;
 
    /************************************************************************
     * function code
     *************************************************************************/
 
-   /* Process the waitQ */
-   _kernelProcessTaskTimeout( &kernelTaskWaitQ );
+   kernelTicks++;
 
-   /* Process the timeoutQ */
-   nextS = kernelTimeoutQ;
-   while( nextS )
+   /* Only the first task of the timeoutQ has to be counted down,
+    * all other timeouts are relative to it. */
+   if( kernelTimeoutQ )
    {
-      /* Process all the tasks in this timeout waitQ */
-      _kernelProcessTaskTimeout( &nextS->waitingQ );
+      kernelTimeoutQ->timeoutDelta--;
+
+      /* Wake up all tasks whose timeout was reached */
+      while( (kernelTimeoutQ) && (kernelTimeoutQ->timeoutDelta == 0) )
+      {
+         task = kernelTimeoutQ;
+
+         /* Remove this task from timeoutQ */
+         _kernelDequeueTimeout( task );
+
+         /* Set new task state. A ticksToWait of 0 signals the timeout
+          * to the blocking function. */
+         task->state = READY;
+         task->ticksToWait = 0;
+
+         /* Remove this task from the waitQ of the element */
+         _kernelDequeueTask( task->waitQ, task );
 
-      /* Move on to the next in the list */
-      nextS = nextS->next;
+         /* Insert this task to readyQ */
+         _kernelEnqueueReadyTask( task );
+      }
    }
 }
 
@@ -587,7 +913,7 @@ uint8_t kernelStartScheduler( void )
    kernelTicks = 0;
 
    /* Get next task to switch to */
-   kernelRunningTask = _kernelDequeueHighestPrioTask( &kernelTaskReadyQ );
+   kernelRunningTask = _kernelDequeueHighestReadyTask();
 
    /* Simulate a function call end as generated by the compiler.  We will now
     jump to the start of the task the context of which we have just restored. */
@@ -612,7 +938,7 @@ tTaskHandle taskCreate( tKernelTaskFunction taskFunction, char* taskName, tStack
     *************************************************************************/
 
    /* Check if we can create this task */
-   if( kernelNumberOfTasks >= (KERNEL_NUMBER_OF_TASKS + 1) )
+   if(( kernelNumberOfTasks >= (KERNEL_NUMBER_OF_TASKS + 1) ) || ( priority >= KERNEL_NUMBER_OF_PRIORITIES ))
       return task;
 
    ENTER_CRITICAL();
@@ -624,12 +950,23 @@ tTaskHandle taskCreate( tKernelTaskFunction taskFunction, char* taskName, tStack
    task = &kernelTasks[kernelNumberOfTasks++];
    task->state = READY;
    task->priority = priority;
+   task->basePriority = priority;
    task->stackPointer = sp;
    task->taskName = taskName;
    task->ticksToWait = KERNEL_WAIT_FOREVER;
+   task->waitQ = 0;
+   task->timeoutPrev = 0;
+   task->timeoutNext = 0;
+#if KERNEL_CONFIG_USE_MUTEXES == 1
+   task->waitMutex = 0;
+   task->mutexList = 0;
+#endif
+#if KERNEL_CONFIG_USE_QUEUES == 1
+   task->msgBuffer = 0;
+#endif
 
    /* Insert task to readyQ */
-   _kernelEnqueueTask( &kernelTaskReadyQ, task );
+   _kernelEnqueueReadyTask( task );
 
    EXIT_CRITICAL();
 
@@ -660,10 +997,10 @@ void taskSleep( uint16_t ticks )
    task->ticksToWait = ticks;
 
    /* Remove task from readyQ */
-   _kernelDequeueTask( &kernelTaskReadyQ, task );
+   _kernelDequeueReadyTask( task );
 
-   /* Insert the task to waitQ */
-   _kernelEnqueueTask( &kernelTaskWaitQ, task );
+   /* Insert the task to timeoutQ. A sleeping task waits for no element. */
+   _kernelEnqueueTimeout( task, 0, ticks );
 
    /* Switch the context */
    if( kernelRunning )
@@ -694,7 +1031,7 @@ void taskSuspend( tTaskHandle taskToSuspend )
       task->state = SUSPENDED;
 
       /* Remove task from readyQ */
-      _kernelDequeueTask( &kernelTaskReadyQ, task );
+      _kernelDequeueReadyTask( task );
    }
 
    EXIT_CRITICAL();
@@ -723,7 +1060,7 @@ void taskResume( tTaskHandle taskToResume )
 
       /* Insert this task to readyQ */
       if( task != kernelRunningTask )
-         _kernelEnqueueTask( &kernelTaskReadyQ, task );
+         _kernelEnqueueReadyTask( task );
    }
 
    EXIT_CRITICAL();
@@ -751,7 +1088,6 @@ tSemaphoreHandle semaphoreCreate( uint8_t initValue )
    sem = &kernelSemaphores[kernelNumberOfSemaphores];
    sem->count = initValue;
    sem->element.waitingQ = 0;
-   sem->element.next = 0;
    kernelNumberOfSemaphores++;
    EXIT_CRITICAL();
 
@@ -791,9 +1127,9 @@ uint8_t semaphoreGet( tSemaphoreHandle semaphore, uint16_t timeoutTicks )
          ((tTask*)kernelRunningTask)->state = WAIT;
          ((tTask*)kernelRunningTask)->ticksToWait = timeoutTicks;
 
-         /* Place this semaphore to the timeoutQ.
-          * The timeout will be handled and checked at each system tick. */
-         _kernelEnqueueElement( &kernelTimeoutQ, &(sem->element) );
+         /* Place this task to the timeoutQ.
+          * Only the first task of the timeoutQ will be checked at each system tick. */
+         _kernelEnqueueTimeout( kernelRunningTask, &(sem->element.waitingQ), timeoutTicks );
 
          /* Switch the context */
          if( kernelRunning )
@@ -855,20 +1191,20 @@ void semaphoreSet( tSemaphoreHandle semaphore )
    /* Increment the semaphore */
    sem->count++;
 
-   /* Remove the semaphore from the timeoutQ */
-   _kernelDequeueElement( &kernelTimeoutQ, &sem->element );
-
    /* Check if there are tasks that wait for this semaphore */
    if( sem->element.waitingQ )
    {
       /* Remove task from semaphore waitQ */
       task = _kernelDequeueHighestPrioTask( &(sem->element.waitingQ) );
 
+      /* Remove this task from timeoutQ */
+      _kernelDequeueTimeout( task );
+
       /* Set new task state */
       task->state = READY;
 
       /* Insert this task to readyQ */
-      _kernelEnqueueTask( &kernelTaskReadyQ, task );
+      _kernelEnqueueReadyTask( task );
    }
 
    /* If this function was called from an interrupt service routine and
@@ -904,7 +1240,7 @@ tMutexHandle mutexCreate( void )
    mutex = &kernelMutexes[kernelNumberOfMutexes];
    mutex->owner = 0;
    mutex->element.waitingQ = 0;
-   mutex->element.next = 0;
+   mutex->next = 0;
    kernelNumberOfMutexes++;
    EXIT_CRITICAL();
 
@@ -918,6 +1254,7 @@ uint8_t mutexGet( tMutexHandle mutex, uint16_t timeoutTicks )
     * local variables
     *************************************************************************/
    tMutex* mu;
+   tTask* task;
    uint8_t error = KERNEL_NO_ERROR;
    CRITICAL_SECTION;
 
@@ -934,22 +1271,28 @@ uint8_t mutexGet( tMutexHandle mutex, uint16_t timeoutTicks )
    ENTER_CRITICAL();
 
    mu = (tMutex*) mutex;
-   if(( mu->owner != kernelRunningTask ) && ( mu->owner != 0 ))
+   task = (tTask*) kernelRunningTask;
+   if(( mu->owner != task ) && ( mu->owner != 0 ))
    {
       /* Check if a timeout value was set.
        * If not we will return immediately with timeout error. */
       if( timeoutTicks )
       {
          /* Insert the task to waitQ of this semaphore */
-         _kernelEnqueueTask( &(mu->element.waitingQ), kernelRunningTask );
+         _kernelEnqueueTask( &(mu->element.waitingQ), task );
 
          /* Set new task state */
-         ((tTask*)kernelRunningTask)->state = WAIT;
-         ((tTask*)kernelRunningTask)->ticksToWait = timeoutTicks;
+         task->state = WAIT;
+         task->ticksToWait = timeoutTicks;
+         task->waitMutex = mu;
+
+         /* Place this task to the timeoutQ.
+          * Only the first task of the timeoutQ will be checked at each system tick. */
+         _kernelEnqueueTimeout( task, &(mu->element.waitingQ), timeoutTicks );
 
-         /* Place this mutex to the timeoutQ.
-          * The timeout will be handled and checked at each system tick. */
-         _kernelEnqueueElement( &kernelTimeoutQ, &(mu->element) );
+         /* The owner inherits our priority if it is lower. If the owner waits
+          * for an other mutex, the owner of that mutex inherits it too. */
+         _kernelUpdateInheritedPriority( mu->owner );
 
          /* Switch the context */
          if( kernelRunning )
@@ -960,15 +1303,16 @@ uint8_t mutexGet( tMutexHandle mutex, uint16_t timeoutTicks )
          ENTER_CRITICAL();
 
          /* We reach this section only if the mutex was given back by an other task
-          * or if there was an timeout. */
-         if( ((tTask*)kernelRunningTask)->ticksToWait == 0 )
+          * or if there was an timeout. If the mutex was given back, mutexGive
+          * has already made us the owner. */
+         if( task->ticksToWait == 0 )
          {
             error = KERNEL_TIMEOUT_ERROR;
-         }
-         else
-         {
-            /* Become the owner of the mutex */
-            mu->owner = kernelRunningTask;
+
+            /* We do not wait any longer, so the owner may lose the priority
+             * it has inherited from us. */
+            task->waitMutex = 0;
+            _kernelUpdateInheritedPriority( mu->owner );
          }
       }
       else
@@ -976,10 +1320,12 @@ uint8_t mutexGet( tMutexHandle mutex, uint16_t timeoutTicks )
          error = KERNEL_TIMEOUT_ERROR;
       }
    }
-   else
+   else if( mu->owner == 0 )
    {
       /* Become the owner of the mutex */
-      mu->owner = kernelRunningTask;
+      mu->owner = task;
+      mu->next = task->mutexList;
+      task->mutexList = mu;
    }
 
    EXIT_CRITICAL();
@@ -994,7 +1340,9 @@ uint8_t mutexGive( tMutexHandle mutex )
     * local variables
     *************************************************************************/
    tTask *task = 0;
+   tTask *owner;
    tMutex* mu;
+   tMutex** list;
    uint8_t error = KERNEL_NO_ERROR;
    CRITICAL_SECTION;
 
@@ -1011,15 +1359,20 @@ uint8_t mutexGive( tMutexHandle mutex )
    ENTER_CRITICAL();
 
    mu = (tMutex*) mutex;
+   owner = (tTask*) kernelRunningTask;
 
    /* We can only give back the mutex if we are the owner */
-   if( mu->owner == kernelRunningTask )
+   if( mu->owner == owner )
    {
-      /* We are the owner. Give mutex back */
-      mu->owner = 0;
+      /* We are the owner. Remove the mutex from our list and give it back */
+      list = &owner->mutexList;
+      while( (*list) && (*list != mu) )
+         list = &(*list)->next;
+      if( *list )
+         *list = mu->next;
 
-      /* Remove the mutex from the timeoutQ */
-      _kernelDequeueElement( &kernelTimeoutQ, &mu->element );
+      mu->owner = 0;
+      mu->next = 0;
 
       /* Check if there are tasks that wait for this mutex */
       if( mu->element.waitingQ )
@@ -1027,11 +1380,42 @@ uint8_t mutexGive( tMutexHandle mutex )
          /* Remove task from mutex waitQ */
          task = _kernelDequeueHighestPrioTask( &(mu->element.waitingQ) );
 
+         /* Remove this task from timeoutQ */
+         _kernelDequeueTimeout( task );
+
+         /* Pass the mutex directly to the waiting task. So no other task
+          * can take it before the waiting task runs. */
+         task->waitMutex = 0;
+         mu->owner = task;
+         mu->next = task->mutexList;
+         task->mutexList = mu;
+
          /* Set new task state */
          task->state = READY;
 
          /* Insert this task to readyQ */
-         _kernelEnqueueTask( &kernelTaskReadyQ, task );
+         _kernelEnqueueReadyTask( task );
+
+         /* The new owner inherits the priority of the remaining waiters */
+         _kernelUpdateInheritedPriority( task );
+      }
+
+      /* Drop the priority we have inherited from the waiters of this mutex */
+      _kernelUpdateInheritedPriority( owner );
+
+      /* If a task with a higher priority is ready now, switch to it */
+      task = _kernelHighestReadyTask();
+      if( (task) && (task->priority > owner->priority) )
+      {
+         _kernelEnqueueReadyTask( owner );
+
+         /* Switch the context */
+         if( kernelRunning )
+            RESCHEDULE();
+
+         /* At this point we have to disable interrupts again, because _kernelSwitchContext
+          * has enabled the global interrupt. */
+         ENTER_CRITICAL();
       }
    }
    else
@@ -1067,7 +1451,6 @@ tEventHandle eventCreate( void )
    event = &kernelEvents[kernelNumberOfEvents];
    event->events = 0;
    event->element.waitingQ = 0;
-   event->element.next = 0;
    kernelNumberOfEvents++;
    EXIT_CRITICAL();
 
@@ -1139,9 +1522,9 @@ uint8_t eventRetrieve( tEventHandle event, uint32_t reqEvents, uint32_t* retEven
             ((tTask*)kernelRunningTask)->state = WAIT;
             ((tTask*)kernelRunningTask)->ticksToWait = timeoutTicks;
 
-            /* Place this event to the timeoutQ.
-             * The timeout will be handled and checked at each system tick. */
-            _kernelEnqueueElement( &kernelTimeoutQ, &(ev->element) );
+            /* Place this task to the timeoutQ.
+             * Only the first task of the timeoutQ will be checked at each system tick. */
+            _kernelEnqueueTimeout( kernelRunningTask, &(ev->element.waitingQ), timeoutTicks );
 
             /* Switch the context */
             if( kernelRunning )
@@ -1206,20 +1589,20 @@ uint8_t eventSet( tEventHandle event, uint32_t eventFalgs, tEventOption option )
       ev->events = ev->events | eventFalgs;
    }
 
-   /* Remove the semaphore from the timeoutQ */
-   _kernelDequeueElement( &kernelTimeoutQ, &ev->element );
-
    /* Check if there are tasks that wait for this event */
    while( ev->element.waitingQ )
    {
       /* Remove task from semaphore waitQ */
       task = _kernelDequeueHighestPrioTask( &(ev->element.waitingQ) );
 
+      /* Remove this task from timeoutQ */
+      _kernelDequeueTimeout( task );
+
       /* Set new task state */
       task->state = READY;
 
       /* Insert this task to readyQ */
-      _kernelEnqueueTask( &kernelTaskReadyQ, task );
+      _kernelEnqueueReadyTask( task );
    }
 
    /* If this function was called from an interrupt service routine and
@@ -1263,9 +1646,7 @@ tQueueHandle queueCreate( uint8_t *buff, uint8_t size, uint8_t num_msgs )
    que->msgSize = size;
    que->msgMax = num_msgs;
    que->putElement.waitingQ = 0;
-   que->putElement.next = 0;
    que->getElement.waitingQ = 0;
-   que->getElement.next = 0;
    kernelNumberOfQueues++;
    EXIT_CRITICAL();
 
@@ -1274,45 +1655,66 @@ tQueueHandle queueCreate( uint8_t *buff, uint8_t size, uint8_t num_msgs )
 
 //----------------------------------------------------------------------------
 uint8_t queueGet( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   uint8_t count = 1;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   return queueGetN( queue, msgBuffer, &count, timeoutTicks );
+}
+
+//----------------------------------------------------------------------------
+uint8_t queueGetN( tQueueHandle queue, void* msgBuffer, uint8_t* count, uint16_t timeoutTicks )
 {
    /************************************************************************
     * local variables
     *************************************************************************/
    tQueue* que;
-   tTask *task = 0;
+   tTask* running;
+   tTask* task = 0;
    uint8_t error = KERNEL_NO_ERROR;
-   uint8_t returnNext = 0;
-   uint8_t* source;
    uint8_t* dest;
-   uint8_t i;
+   uint8_t number;
+   uint8_t done = 0;
    CRITICAL_SECTION;
 
    /************************************************************************
     * function code
     *************************************************************************/
 
-   if(( queue == 0 ) || ( msgBuffer == 0 ))
+   if(( queue == 0 ) || ( msgBuffer == 0 ) || ( count == 0 ) || ( *count == 0 ))
       return KERNEL_PARAMETER_ERROR;
 
    ENTER_CRITICAL();
 
    que = (tQueue*) queue;
+   running = (tTask*) kernelRunningTask;
+   dest = (uint8_t*) msgBuffer;
+   number = *count;
+
    if( que->msgCount == 0 )
    {
       /* Check if a timeout value was set.
        * If not we will return immediately with timeout error. */
       if( timeoutTicks )
       {
-         /* Insert the task to waitQ of this queue */
-         _kernelEnqueueTask( &(que->getElement.waitingQ), kernelRunningTask );
+         /* Insert the task to waitQ of this queue. The next message
+          * will be put directly to our buffer. */
+         running->msgBuffer = dest;
+         _kernelEnqueueTask( &(que->getElement.waitingQ), running );
 
          /* Set new task state */
-         ((tTask*)kernelRunningTask)->state = WAIT;
-         ((tTask*)kernelRunningTask)->ticksToWait = timeoutTicks;
+         running->state = WAIT;
+         running->ticksToWait = timeoutTicks;
 
-         /* Place this semaphore to the timeoutQ.
-          * The timeout will be handled and checked at each system tick. */
-         _kernelEnqueueElement( &kernelTimeoutQ, &(que->getElement) );
+         /* Place this task to the timeoutQ.
+          * Only the first task of the timeoutQ will be checked at each system tick. */
+         _kernelEnqueueTimeout( running, &(que->getElement.waitingQ), timeoutTicks );
 
          /* Switch the context */
          if( kernelRunning )
@@ -1322,16 +1724,17 @@ uint8_t queueGet( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
           * has enabled the global interrupt. */
          ENTER_CRITICAL();
 
-         /* We reach this section only if the queue was set by an other task
+         /* We reach this section only if a message was put by an other task
           * or if there was an timeout. */
-         if( ((tTask*)kernelRunningTask)->ticksToWait == 0 )
+         if( running->ticksToWait == 0 )
          {
             error = KERNEL_TIMEOUT_ERROR;
          }
          else
          {
-            /* Receive the queue message and return it */
-            returnNext = 1;
+            /* The message was put directly to our buffer */
+            dest += que->msgSize;
+            done++;
          }
       }
       else
@@ -1339,46 +1742,59 @@ uint8_t queueGet( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
          error = KERNEL_TIMEOUT_ERROR;
       }
    }
-   else
-   {
-      /* Receive the queue message and return it */
-      returnNext = 1;
-   }
 
-   if( returnNext )
+   /* Receive as many messages as available */
+   while( (error == KERNEL_NO_ERROR) && (done < number) && (que->msgCount) )
    {
-      /* There is space in the queue, copy it in */
-      source = que->queueBuffer + que->removePointer;
-      dest = (uint8_t*)msgBuffer;
-      for( i = 0; i < que->msgSize; i++ )
-         *dest++ = *source++;
-
-      que->removePointer += que->msgSize;
-      que->msgCount--;
-
-      /* Check if the insert index should now wrap to the beginning */
-      if( que->removePointer >= (que->msgSize * que->msgMax) )
-         que->removePointer = 0;
+      _kernelQueueRead( que, dest );
+      dest += que->msgSize;
+      done++;
 
-      /* Check if there are tasks that wait for this queue */
-      while( que->putElement.waitingQ )
+      /* Check if there are tasks that wait for this queue.
+       * The queue has room now, so take the message of the first one. */
+      if( que->putElement.waitingQ )
       {
          /* Remove task from queue waitQ */
          task = _kernelDequeueHighestPrioTask( &(que->putElement.waitingQ) );
 
+         /* Remove this task from timeoutQ */
+         _kernelDequeueTimeout( task );
+
+         /* Put its message to the queue */
+         _kernelQueueWrite( que, task->msgBuffer );
+         task->msgBuffer = 0;
+
          /* Set new task state */
          task->state = READY;
 
          /* Insert this task to readyQ */
-         _kernelEnqueueTask( &kernelTaskReadyQ, task );
+         _kernelEnqueueReadyTask( task );
       }
+   }
 
+   *count = done;
+
+   if( task )
+   {
       /* If this function was called from an interrupt service routine and
        * there is a task that waits for this queue, switch directly to it. */
-      if( (kernelCurrentContext) && (task) )
+      if( kernelCurrentContext )
       {
          _kernelSwitchIsrContext();
       }
+      /* If a task with a higher priority is ready now, switch to it */
+      else if( _kernelHighestReadyTask()->priority > running->priority )
+      {
+         _kernelEnqueueReadyTask( running );
+
+         /* Switch the context */
+         if( kernelRunning )
+            RESCHEDULE();
+
+         /* At this point we have to disable interrupts again, because _kernelSwitchContext
+          * has enabled the global interrupt. */
+         ENTER_CRITICAL();
+      }
    }
 
    EXIT_CRITICAL();
@@ -1388,45 +1804,66 @@ uint8_t queueGet( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
 
 //----------------------------------------------------------------------------
 uint8_t queuePut( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   uint8_t count = 1;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   return queuePutN( queue, msgBuffer, &count, timeoutTicks );
+}
+
+//----------------------------------------------------------------------------
+uint8_t queuePutN( tQueueHandle queue, void* msgBuffer, uint8_t* count, uint16_t timeoutTicks )
 {
    /************************************************************************
     * local variables
     *************************************************************************/
    tQueue* que;
-   tTask *task = 0;
+   tTask* running;
+   tTask* task = 0;
    uint8_t error = KERNEL_NO_ERROR;
-   uint8_t putNext = 0;
    uint8_t* source;
-   uint8_t* dest;
-   uint8_t i;
+   uint8_t number;
+   uint8_t done = 0;
    CRITICAL_SECTION;
 
    /************************************************************************
     * function code
     *************************************************************************/
 
-   if(( queue == 0 ) || ( msgBuffer == 0 ))
+   if(( queue == 0 ) || ( msgBuffer == 0 ) || ( count == 0 ) || ( *count == 0 ))
       return KERNEL_PARAMETER_ERROR;
 
    ENTER_CRITICAL();
 
    que = (tQueue*) queue;
+   running = (tTask*) kernelRunningTask;
+   source = (uint8_t*) msgBuffer;
+   number = *count;
+
    if( que->msgCount == que->msgMax )
    {
       /* Check if a timeout value was set.
        * If not we will return immediately with timeout error. */
       if( timeoutTicks )
       {
-         /* Insert the task to waitQ of this queue */
-         _kernelEnqueueTask( &(que->putElement.waitingQ), kernelRunningTask );
+         /* Insert the task to waitQ of this queue. The first message
+          * will be taken directly from our buffer. */
+         running->msgBuffer = source;
+         _kernelEnqueueTask( &(que->putElement.waitingQ), running );
 
          /* Set new task state */
-         ((tTask*)kernelRunningTask)->state = WAIT;
-         ((tTask*)kernelRunningTask)->ticksToWait = timeoutTicks;
+         running->state = WAIT;
+         running->ticksToWait = timeoutTicks;
 
-         /* Place this semaphore to the timeoutQ.
-          * The timeout will be handled and checked at each system tick. */
-         _kernelEnqueueElement( &kernelTimeoutQ, &(que->putElement) );
+         /* Place this task to the timeoutQ.
+          * Only the first task of the timeoutQ will be checked at each system tick. */
+         _kernelEnqueueTimeout( running, &(que->putElement.waitingQ), timeoutTicks );
 
          /* Switch the context */
          if( kernelRunning )
@@ -1436,16 +1873,17 @@ uint8_t queuePut( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
           * has enabled the global interrupt. */
          ENTER_CRITICAL();
 
-         /* We reach this section only if the queue was set by an other task
+         /* We reach this section only if a message was taken by an other task
           * or if there was an timeout. */
-         if( ((tTask*)kernelRunningTask)->ticksToWait == 0 )
+         if( running->ticksToWait == 0 )
          {
             error = KERNEL_TIMEOUT_ERROR;
          }
          else
          {
-            /* Put the queue message to the queue */
-            putNext = 1;
+            /* The message was taken directly from our buffer */
+            source += que->msgSize;
+            done++;
          }
       }
       else
@@ -1453,50 +1891,104 @@ uint8_t queuePut( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
          error = KERNEL_TIMEOUT_ERROR;
       }
    }
-   else
-   {
-      /* Put the queue message to the queue */
-      putNext = 1;
-   }
 
-   if( putNext )
+   /* Put as many messages as there is room for */
+   while( (error == KERNEL_NO_ERROR) && (done < number) )
    {
-      /* Copy message to destination buffer */
-      dest = que->queueBuffer + que->insertPointer;
-      source = (uint8_t*)msgBuffer;
-      for( i = 0; i < que->msgSize; i++ )
-         *dest++ = *source++;
-
-      que->insertPointer += que->msgSize;
-      que->msgCount++;
-
-      /* Check if the insert index should now wrap to the beginning */
-      if( que->insertPointer >= (que->msgSize * que->msgMax) )
-         que->insertPointer = 0;
-
-      /* Check if there are tasks that wait for this queue */
-      while( que->getElement.waitingQ )
+      /* Check if there are tasks that wait for this queue.
+       * The queue is empty then, so pass the message directly to the first one. */
+      if( que->getElement.waitingQ )
       {
          /* Remove task from waitQ */
          task = _kernelDequeueHighestPrioTask( &(que->getElement.waitingQ) );
 
+         /* Remove this task from timeoutQ */
+         _kernelDequeueTimeout( task );
+
+         /* Copy message to the buffer of the task */
+         _kernelCopyMessage( task->msgBuffer, source, que->msgSize );
+         task->msgBuffer = 0;
+
          /* Set new task state */
          task->state = READY;
 
          /* Insert this task to readyQ */
-         _kernelEnqueueTask( &kernelTaskReadyQ, task );
+         _kernelEnqueueReadyTask( task );
+      }
+      else if( que->msgCount < que->msgMax )
+      {
+         _kernelQueueWrite( que, source );
       }
+      else
+      {
+         break;
+      }
+
+      source += que->msgSize;
+      done++;
+   }
 
+   *count = done;
+
+   if( task )
+   {
       /* If this function was called from an interrupt service routine and
        * there is a task that waits for this queue, switch directly to it. */
-      if( (kernelCurrentContext) && (task) )
+      if( kernelCurrentContext )
       {
          _kernelSwitchIsrContext();
       }
+      /* If a task with a higher priority is ready now, switch to it */
+      else if( _kernelHighestReadyTask()->priority > running->priority )
+      {
+         _kernelEnqueueReadyTask( running );
+
+         /* Switch the context */
+         if( kernelRunning )
+            RESCHEDULE();
+
+         /* At this point we have to disable interrupts again, because _kernelSwitchContext
+          * has enabled the global interrupt. */
+         ENTER_CRITICAL();
+      }
    }
 
    EXIT_CRITICAL();
 
    return error;
 }
+
+//----------------------------------------------------------------------------
+uint8_t queueGetPointer( tQueueHandle queue, void** pointer, uint16_t timeoutTicks )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   if(( queue == 0 ) || ( ((tQueue*)queue)->msgSize != sizeof(void*) ))
+      return KERNEL_PARAMETER_ERROR;
+
+   return queueGet( queue, pointer, timeoutTicks );
+}
+
+//----------------------------------------------------------------------------
+uint8_t queuePutPointer( tQueueHandle queue, void* pointer, uint16_t timeoutTicks )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   if(( queue == 0 ) || ( ((tQueue*)queue)->msgSize != sizeof(void*) ))
+      return KERNEL_PARAMETER_ERROR;
+
+   return queuePut( queue, &pointer, timeoutTicks );
+}
 #endif
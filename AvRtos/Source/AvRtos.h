@@ -17,9 +17,9 @@
  * overhead of RAM for task control structures and task synchronization elements.
  * As a result AvRtos uses the following system resources:\n
  * - 1 kByte of flash memory for code
- * - 11 Byte RAM for each task control block
- * - 5 Byte RAM for each semaphore control block
- * - 13 Byte RAM for each queue control block
+ * - 26 Byte RAM for each task control block
+ * - 3 Byte RAM for each semaphore control block
+ * - 9 Byte RAM for each queue control block
  *
  * Currently AvRtos supports following task synchronization elements:\n
  * - Mutexes
@@ -162,7 +162,7 @@ typedef void* tQueueHandle;
  * \def KERNEL_VERSION
  * Current kernel version
  */
-#define KERNEL_VERSION        "2.0.3"
+#define KERNEL_VERSION        "2.0.4"
 
 /**
  * \def KERNEL_IDLE_TASK_PRIORITY
@@ -171,6 +171,15 @@ typedef void* tQueueHandle;
  */
 #define KERNEL_IDLE_TASK_PRIORITY      0
 
+/**
+ * \def KERNEL_NUMBER_OF_PRIORITIES
+ * Number of task priorities. Each priority has its own READY list, the highest
+ * priority will be found by a bitmap. Can be changed in AvRtosConfig.h.
+ */
+#ifndef KERNEL_NUMBER_OF_PRIORITIES
+#define KERNEL_NUMBER_OF_PRIORITIES    32
+#endif
+
 /**
  * \def KERNEL_WAIT_FOREVER
  * Timeout value definition.
@@ -218,9 +227,10 @@ uint8_t kernelStartScheduler( void );
  * \param    stackSize The size in bytes of the stack.
  *
  * \param    priority The task priority. It should be higher than KERNEL_IDLE_TASK_PRIORITY
+ *           and must be lower than KERNEL_NUMBER_OF_PRIORITIES.
  *
  * \return   tTaskHandle Pointer to the created task. This handle can be used to
- *           suspend and resume the task manually.
+ *           suspend and resume the task manually. 0 if the task could not be created.
  *
  * \brief    This function will initialize the task control block and prepares
  *           the task stack for the first usage.
@@ -334,6 +344,9 @@ tMutexHandle mutexCreate( void );
  *           KERNEL_CONTEXT_ERROR      If this function is called from an interrupt.
  *
  * \brief    This function will try to lock the given mutex.\n
+ *           While the task waits, the owner of the mutex inherits the task
+ *           priority, if it is lower. If the owner waits for an other mutex,
+ *           the priority will be passed on through the chain of owners.\n
  *           This function can NOT be called from an interrupt service routine.
  ****************************************************************************/
 uint8_t mutexGet( tMutexHandle mutex, uint16_t timeoutTicks );
@@ -346,7 +359,9 @@ uint8_t mutexGet( tMutexHandle mutex, uint16_t timeoutTicks );
  *           KERNEL_CONTEXT_ERROR   If this function is called from an interrupt.
  *
  * \brief    This function will unlock the given mutex, if the current
- *           running task is the owner of the mutex.\n
+ *           running task is the owner of the mutex. The mutex will be passed
+ *           to the highest priority waiting task and an inherited priority
+ *           will be dropped.\n
  *           This function can NOT be called from an interrupt service routine.
  ****************************************************************************/
 uint8_t mutexGive( tMutexHandle mutex );
@@ -453,12 +468,38 @@ tQueueHandle queueCreate( uint8_t *buff, uint8_t size, uint8_t num_msgs );
  *
  * \brief   This function will try to get a message from the queue buffer.
  *          If there is a message, it will be stored to the given
- *          message buffer.\n
+ *          message buffer. While the task waits, the next message will be
+ *          put directly to the message buffer.\n
  *          This function can be called from an interrupt service routine.
  *          In this case the timeoutTicks MUST be 0
  ****************************************************************************/
 uint8_t queueGet( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks );
 
+/*************************************************************************//**
+ * \fn      uint8_t queueGetN( tQueueHandle queue, void* msgBuffer, uint8_t* count, uint16_t timeoutTicks )
+ *
+ * \param   queue Handle to a previously created queue.
+ *
+ * \param   msgBuffer Pointer to the buffer where the messages will be
+ *          stored to. It must have room for count messages.
+ *
+ * \param   count Number of messages to get. Returns the number of
+ *          messages that were stored to the message buffer.
+ *
+ * \param   timeoutTicks Timeout value to wait for the first message.
+ *          See queueGet.
+ *
+ * \return  KERNEL_PARAMETER_ERROR If the queue handle, buffer or count is not valid\n
+ *          KERNEL_TIMEOUT_ERROR   If there was an timeout.
+ *
+ * \brief   This function works like queueGet, but gets all available
+ *          messages up to count within one critical section. It only waits
+ *          for the first message.\n
+ *          This function can be called from an interrupt service routine.
+ *          In this case the timeoutTicks MUST be 0
+ ****************************************************************************/
+uint8_t queueGetN( tQueueHandle queue, void* msgBuffer, uint8_t* count, uint16_t timeoutTicks );
+
 /*************************************************************************//**
  * \fn      uint8_t queuePut( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks )
  *
@@ -478,10 +519,77 @@ uint8_t queueGet( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks );
  * \brief   This function will try to put a message from the given message buffer.
  *          If the queue is already full this function waits for the given
  *          timeout value to put the message to the queue.\n
+ *          If a task waits for a message, the message will be passed
+ *          directly to this task and the queue buffer will not be used.\n
  *          This function can be called from an interrupt service routine.
  *          In this case the timeoutTicks MUST be 0
  ****************************************************************************/
 uint8_t queuePut( tQueueHandle queue, void* msgBuffer, uint16_t timeoutTicks );
+
+/*************************************************************************//**
+ * \fn      uint8_t queuePutN( tQueueHandle queue, void* msgBuffer, uint8_t* count, uint16_t timeoutTicks )
+ *
+ * \param   queue Handle to a previously created queue.
+ *
+ * \param   msgBuffer Pointer to count messages.
+ *
+ * \param   count Number of messages to put. Returns the number of
+ *          messages that were put to the queue.
+ *
+ * \param   timeoutTicks Timeout value to wait for room for the first
+ *          message. See queuePut.
+ *
+ * \return  KERNEL_PARAMETER_ERROR If the queue handle, buffer or count is not valid\n
+ *          KERNEL_TIMEOUT_ERROR   If there was an timeout.
+ *
+ * \brief   This function works like queuePut, but puts as many messages
+ *          as there is room for within one critical section. It only waits
+ *          for room for the first message.\n
+ *          This function can be called from an interrupt service routine.
+ *          In this case the timeoutTicks MUST be 0
+ ****************************************************************************/
+uint8_t queuePutN( tQueueHandle queue, void* msgBuffer, uint8_t* count, uint16_t timeoutTicks );
+
+/*************************************************************************//**
+ * \fn      uint8_t queueGetPointer( tQueueHandle queue, void** pointer, uint16_t timeoutTicks )
+ *
+ * \param   queue Handle to a queue created with a message size of sizeof(void*).
+ *
+ * \param   pointer Returns the pointer that was put to the queue.
+ *
+ * \param   timeoutTicks Timeout value. See queueGet.
+ *
+ * \return  KERNEL_PARAMETER_ERROR If the queue handle is not valid or no pointer queue\n
+ *          KERNEL_TIMEOUT_ERROR   If there was an timeout.
+ *
+ * \brief   This function gets a buffer pointer from a pointer queue. Only
+ *          the pointer will be copied, the receiver becomes the owner of
+ *          the buffer. A pointer queue filled with free buffers can be
+ *          used as buffer pool.\n
+ *          This function can be called from an interrupt service routine.
+ *          In this case the timeoutTicks MUST be 0
+ ****************************************************************************/
+uint8_t queueGetPointer( tQueueHandle queue, void** pointer, uint16_t timeoutTicks );
+
+/*************************************************************************//**
+ * \fn      uint8_t queuePutPointer( tQueueHandle queue, void* pointer, uint16_t timeoutTicks )
+ *
+ * \param   queue Handle to a queue created with a message size of sizeof(void*).
+ *
+ * \param   pointer Pointer to the buffer that will be passed.
+ *
+ * \param   timeoutTicks Timeout value. See queuePut.
+ *
+ * \return  KERNEL_PARAMETER_ERROR If the queue handle is not valid or no pointer queue\n
+ *          KERNEL_TIMEOUT_ERROR   If there was an timeout.
+ *
+ * \brief   This function puts a buffer pointer to a pointer queue. Only
+ *          the pointer will be copied, the ownership of the buffer passes
+ *          to the receiver.\n
+ *          This function can be called from an interrupt service routine.
+ *          In this case the timeoutTicks MUST be 0
+ ****************************************************************************/
+uint8_t queuePutPointer( tQueueHandle queue, void* pointer, uint16_t timeoutTicks );
 #endif
 
 #ifdef __cplusplus
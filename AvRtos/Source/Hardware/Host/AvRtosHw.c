@@ -0,0 +1,185 @@
+/***************************************************************************
+ * $Source$: AvRtosHw.c
+ * $Rev$: 2.0.0
+ * $Author$: Harald
+ * $Date$: 2016/01/12
+ *
+ * Module: AvRtosHw
+ *
+ * Copyright (c) 2016, Harald Baumeister, Dggingen
+ * All rights reserved.
+ *
+ * This program is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation. Either version 2 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY. Without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * 1. includes
+ *****************************************************************************/
+#include <time.h>
+#include <signal.h>
+#include <ucontext.h>
+#include "AvRtos.h"
+
+/*****************************************************************************
+ * 2. file local constants/definitions
+ *****************************************************************************/
+/* Number of tStack entries used to hold the task context */
+#define HOST_CONTEXT_SIZE        ((sizeof(ucontext_t) + sizeof(tStack) - 1) / sizeof(tStack))
+
+/*****************************************************************************
+ * 3. global variables
+ *****************************************************************************/
+uint32_t kernelHostTickCount = 0;
+uint64_t kernelHostTickTime = 0;
+
+/*****************************************************************************
+ * 6. file local macros
+ *****************************************************************************/
+/* The first entry of the task control block points to the task context */
+#define HOST_TASK_CONTEXT(task)  (*(ucontext_t**)(task))
+
+/*****************************************************************************
+ * 9. exported functions
+ *****************************************************************************/
+//----------------------------------------------------------------------------
+void kernelHostTick( void )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   void* task = kernelRunningTask;
+   struct timespec start;
+   struct timespec stop;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   kernelCurrentContext = 1;
+
+   clock_gettime( CLOCK_MONOTONIC, &start );
+   _kernelScheduleTick();
+   clock_gettime( CLOCK_MONOTONIC, &stop );
+
+   kernelHostTickCount++;
+   kernelHostTickTime += (uint64_t)(stop.tv_sec - start.tv_sec) * 1000000000ULL + stop.tv_nsec - start.tv_nsec;
+
+   _kernelSwitchIsrContext();
+
+   kernelCurrentContext = 0;
+
+   kernelHostSwitchTask( task );
+}
+
+//----------------------------------------------------------------------------
+void kernelHostReschedule( void )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   void* task = kernelRunningTask;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   _kernelSwitchContext();
+   kernelHostSwitchTask( task );
+}
+
+//----------------------------------------------------------------------------
+void kernelHostSwitchTask( void* task )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   if( task != kernelRunningTask )
+      swapcontext( HOST_TASK_CONTEXT( task ), HOST_TASK_CONTEXT( kernelRunningTask ) );
+}
+
+//----------------------------------------------------------------------------
+void kernelSetupTimerInterrupt( void )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   /* There is no timer interrupt. The system tick will be raised by
+    * kernelHostTick from the kernel idle hook. */
+   kernelHostTickCount = 0;
+   kernelHostTickTime = 0;
+}
+
+//----------------------------------------------------------------------------
+void kernelSetupHardware( void )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+}
+
+//----------------------------------------------------------------------------
+tStack* kernelSetupTaskStack( void* taskFunction, tStack* stackPointer, uint16_t stackSize )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+   ucontext_t* context;
+   uint16_t i;
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   /* Initialize complete stack with defined values.
+    * This is only done for debugging the stack. */
+   for( i = 0; i < stackSize; i++ )
+      stackPointer[i] = (tStack)0x5555555555555555ULL;
+
+   /* The task context is placed at the start of the stack buffer,
+    * the remaining buffer is used as task stack. */
+   context = (ucontext_t*) stackPointer;
+   getcontext( context );
+   context->uc_stack.ss_sp = stackPointer + HOST_CONTEXT_SIZE;
+   context->uc_stack.ss_size = (stackSize - HOST_CONTEXT_SIZE) * sizeof(tStack);
+   context->uc_link = 0;
+   sigemptyset( &context->uc_sigmask );
+   makecontext( context, (void (*)(void)) taskFunction, 0 );
+
+   return (tStack*) context;
+}
+
+//----------------------------------------------------------------------------
+void kernelStartFirstTask( void )
+{
+   /************************************************************************
+    * local variables
+    *************************************************************************/
+
+   /************************************************************************
+    * function code
+    *************************************************************************/
+
+   setcontext( HOST_TASK_CONTEXT( kernelRunningTask ) );
+}
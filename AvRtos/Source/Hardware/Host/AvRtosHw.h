@@ -0,0 +1,207 @@
+/***************************************************************************
+ * $Source$: AvRtosHw.h
+ * $Rev$: 2.0.0
+ * $Author$: Harald
+ * $Date$: 2016/01/12
+ *
+ * Module: AvRtosHw
+ *
+ * Copyright (c) 2016, Harald Baumeister, Dggingen
+ * All rights reserved.
+ *
+ * This program is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation. Either version 2 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY. Without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ ****************************************************************************/
+
+#ifndef AVRTOSHW_H
+#define AVRTOSHW_H
+
+/*****************************************************************************
+ * 1. includes
+ *****************************************************************************/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * 2. exported constants/definitions
+ *****************************************************************************/
+
+/*****************************************************************************
+ * 3. global variables/function prototypes
+ *****************************************************************************/
+extern void*   kernelRunningTask;
+extern uint8_t kernelCurrentContext;
+
+extern uint32_t kernelHostTickCount;   /**< Number of system ticks raised by kernelHostTick */
+extern uint64_t kernelHostTickTime;    /**< Time in ns spent in _kernelScheduleTick for all system ticks */
+
+extern void _kernelScheduleTick( void );
+extern void _kernelSwitchIsrContext( void );
+extern void _kernelSwitchContext( void );
+
+/*****************************************************************************
+ * 4. exported typedefs
+ *****************************************************************************/
+typedef uint64_t tStack;
+
+/*****************************************************************************
+ * 6. exported macros
+ *****************************************************************************/
+#define __ATTRIBUTE__
+
+/**
+ * Macro to save the current processor context
+ * Used by _kernelSwitchContext. The host port switches the task context
+ * after _kernelSwitchContext has selected the next task.
+ */
+#define CONTEXT_SWITCH_SAVE_CONTEXT()
+
+/**
+ * Macro to restore a new processor context and maybe to switch to a new task
+ * Used by _kernelSwitchContext
+ */
+#define CONTEXT_SWITCH_RESTORE_CONTEXT()
+
+/**
+ * Macro to return from a context switch
+ * Used by _kernelSwitchContext
+ */
+#define CONTEXT_SWITCH_RETURN()
+
+/**
+ * Macro to call the scheduler
+ */
+#define RESCHEDULE()             kernelHostReschedule();
+
+/**
+ * Macro to define a critical system section.
+ * All tasks of the host port run in one thread and the system tick is only
+ * raised by kernelHostTick, so there is nothing to lock.
+ */
+#define CRITICAL_SECTION
+
+/**
+ * Macro to enter a critical system section
+ */
+#define ENTER_CRITICAL()
+
+/**
+ * Macro to exit from a critical system section
+ */
+#define EXIT_CRITICAL()
+
+/*
+ * Redefine the ISR macro. The host application can call the declared function
+ * to simulate an interrupt.
+ */
+#ifdef ISR
+#undef ISR
+#endif
+
+#ifdef __cplusplus
+#  define ISR(vector, ...)            \
+    extern "C" void vector (void); \
+    void vector ## _func(void); \
+    void vector (void) \
+    { \
+       void* task = kernelRunningTask; \
+       kernelCurrentContext = 1; \
+       vector ## _func(); \
+       kernelCurrentContext = 0; \
+       kernelHostSwitchTask( task ); \
+    } \
+    void vector ## _func(void)
+#else
+#  define ISR(vector, ...)            \
+    void vector (void); \
+    void vector ## _func(void); \
+    void vector (void) \
+    { \
+       void* task = kernelRunningTask; \
+       kernelCurrentContext = 1; \
+       vector ## _func(); \
+       kernelCurrentContext = 0; \
+       kernelHostSwitchTask( task ); \
+    } \
+    void vector ## _func(void)
+#endif
+
+/*****************************************************************************
+ * 9. exported function prototypes
+ *****************************************************************************/
+/*************************************************************************//**
+ * \fn       void kernelSetupTimerInterrupt( void )
+ *
+ * \brief    Function to initialize the system tick interrupt.
+ ****************************************************************************/
+void kernelSetupTimerInterrupt( void );
+
+/*************************************************************************//**
+ * \fn       void kernelSetupHardware( void )
+ *
+ * \brief    Function to initialize some CPU hardware.
+ ****************************************************************************/
+void kernelSetupHardware( void );
+
+/*************************************************************************//**
+ * \fn      void kernelSetupTaskStack( void* taskFunction, tStack* stackPointer, uint16_t stackSize )
+ *
+ * \param   taskFunction Pointer to current task function
+ *
+ * \param   stackPointer Pointer to the tasks stack buffer.
+ *
+ * \param   stackSize    Size of the task stack in sizeof(tStack) bytes.
+ *
+ * \brief   Function to initialize the task stack. The host port places the
+ *          task context at the start of the stack buffer.
+ ****************************************************************************/
+tStack* kernelSetupTaskStack( void* taskFunction, tStack* stackPointer, uint16_t stackSize );
+
+/*************************************************************************//**
+ * \fn       void kernelStartFirstTask( void )
+ *
+ * \brief    Function to start the first task.
+ *           This function will not return.
+ ****************************************************************************/
+void kernelStartFirstTask( void );
+
+/*************************************************************************//**
+ * \fn       void kernelHostReschedule( void )
+ *
+ * \brief    Function to select the next task and to switch to it.
+ ****************************************************************************/
+void kernelHostReschedule( void );
+
+/*************************************************************************//**
+ * \fn       void kernelHostSwitchTask( void* task )
+ *
+ * \param    task Task that was running before the scheduler was called.
+ *
+ * \brief    Function to switch from the given task to kernelRunningTask.
+ ****************************************************************************/
+void kernelHostSwitchTask( void* task );
+
+/*************************************************************************//**
+ * \fn       void kernelHostTick( void )
+ *
+ * \brief    Function to raise a system tick. The host port has no timer
+ *           interrupt, the tick will be raised from the kernel idle hook,
+ *           so the system time only advances if all tasks wait.
+ ****************************************************************************/
+void kernelHostTick( void );
+
+
+#ifdef __cplusplus
+}
+#endif
+#endif // AVRTOSHW_H
@@ -0,0 +1,407 @@
+/*
+**
+**                           Main.c
+**
+** Test of the alarms of FreeOSEK, built for the posix arch and run on
+** the host. Random SetRelAlarm, SetAbsAlarm, CancelAlarm and counter
+** increments are done on the sorted alarm queues and on a model, which
+** counts every alarm down tick by tick, and the expired alarms, their
+** remaining ticks and the counter values of both are compared.
+**
+**********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "os.h"
+#include "Os_Internal.h"
+
+/* random operations done */
+#define TEST_STEPS 200000
+
+/* expirations logged by one operation at most, an increment of two rounds
+ * of CounterA expires each alarm of a cycle of 1 as many times */
+#define TEST_LOG 32768
+
+/* the alarm queues of the counters start this close to the wrap of
+ * their ticks */
+#define TEST_TICKS_A 0xFFFFFF00U
+#define TEST_TICKS_B 0xFFFFFFF0U
+
+/* an alarm as the model keeps it */
+typedef struct {
+    uint8 Active;
+    /* ticks of its counter until it expires */
+    uint32 Left;
+    uint32 Cycle;
+    /* alarms expiring on the same tick expire in the order of their
+     * stamps, which is the order they were set or reloaded in */
+    uint32 Stamp;
+    /* set by SetAbsAlarm and not expired yet, it has to expire when the
+     * counter value is Start */
+    uint8 Abs;
+    uint32 Start;
+    /* expirations in the current operation */
+    uint32 Expired;
+} ModelAlarmType;
+
+static ModelAlarmType Model[ALARMS_COUNT];
+static uint32 ModelTime[COUNTERS_COUNT];
+static uint32 ModelStamp;
+
+/* alarms expired by the OS and by the model in the current operation */
+static AlarmType Actual[TEST_LOG];
+static uint32 ActualCount;
+static AlarmType Expected[TEST_LOG];
+static uint32 ExpectedCount;
+
+/* what the random operations went through */
+static uint32 CatchUps;
+static uint32 Cascades;
+static uint32 AbsWraps;
+static uint32 TickWraps[COUNTERS_COUNT];
+static uint32 LastTicks[COUNTERS_COUNT];
+
+static uint32 Step;
+static uint32 Seed = 0x2545F491U;
+
+static uint32 Random(uint32 range)
+{
+    /* xorshift, the same sequence on every run */
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed % range;
+}
+
+static void Fail(const char * what, AlarmType AlarmID)
+{
+    printf("FAIL at step %u: %s, alarm %u\n", Step, what, AlarmID);
+    exit(EXIT_FAILURE);
+}
+
+static void Log(AlarmType AlarmID)
+{
+    if (ActualCount >= TEST_LOG)
+    {
+        Fail("too many expirations", AlarmID);
+    }
+    Actual[ActualCount++] = AlarmID;
+}
+
+static void ModelTick(CounterType CounterID)
+{
+    AlarmType AlarmID;
+    AlarmType first;
+
+    ModelTime[CounterID]++;
+    if (ModelTime[CounterID] == CountersConst[CounterID].MaxAllowedValue)
+    {
+        ModelTime[CounterID] = 0;
+    }
+
+    for (AlarmID = 0; AlarmID < ALARMS_COUNT; AlarmID++)
+    {
+        if (Model[AlarmID].Active && (AlarmsConst[AlarmID].Counter == CounterID))
+        {
+            Model[AlarmID].Left--;
+        }
+    }
+
+    /* the alarms down to 0 expire, the one set first first */
+    while(1)
+    {
+        first = INVALID_ALARM;
+        for (AlarmID = 0; AlarmID < ALARMS_COUNT; AlarmID++)
+        {
+            if (Model[AlarmID].Active && (AlarmsConst[AlarmID].Counter == CounterID) &&
+                (Model[AlarmID].Left == 0) &&
+                ((first == INVALID_ALARM) || (Model[AlarmID].Stamp < Model[first].Stamp)))
+            {
+                first = AlarmID;
+            }
+        }
+        if (first == INVALID_ALARM)
+        {
+            break;
+        }
+
+        if (Model[first].Abs && (ModelTime[CounterID] != Model[first].Start))
+        {
+            Fail("absolute alarm expired off its start", first);
+        }
+        Model[first].Abs = 0;
+
+        if (Model[first].Cycle == 0)
+        {
+            Model[first].Active = 0;
+        }
+        else
+        {
+            Model[first].Left = Model[first].Cycle;
+            Model[first].Stamp = ++ModelStamp;
+        }
+
+        if (++Model[first].Expired == 2)
+        {
+            CatchUps++;
+        }
+
+        if (AlarmsConst[first].AlarmAction == INCREMENT)
+        {
+            Cascades++;
+            ModelTick(AlarmsConst[first].AlarmActionInfo.Counter);
+        }
+        else if (ExpectedCount < TEST_LOG)
+        {
+            Expected[ExpectedCount++] = first;
+        }
+    }
+}
+
+static void ModelSet(AlarmType AlarmID, uint32 Left, uint32 Cycle)
+{
+    Model[AlarmID].Active = 1;
+    Model[AlarmID].Left = Left;
+    Model[AlarmID].Cycle = Cycle;
+    Model[AlarmID].Stamp = ++ModelStamp;
+    Model[AlarmID].Abs = 0;
+}
+
+static void Increment(CounterType CounterID, uint32 Increment)
+{
+    uint32 loopi;
+
+    (void)IncrementCounter(CounterID, Increment);
+    for (loopi = 0; loopi < Increment; loopi++)
+    {
+        ModelTick(CounterID);
+    }
+}
+
+/* the cycle of a random alarm, a third of them single shot */
+static uint32 RandomCycle(CounterType CounterID)
+{
+    if (Random(3) == 0)
+    {
+        return 0;
+    }
+    return 1 + Random(CounterID == CounterA ? 40 : 10);
+}
+
+static void Operation(void)
+{
+    AlarmType AlarmID = Random(ALARMS_COUNT);
+    CounterType CounterID = AlarmsConst[AlarmID].Counter;
+    uint32 max = CountersConst[CounterID].MaxAllowedValue;
+    uint32 start;
+    uint32 cycle;
+    uint32 left;
+    uint32 choice = Random(100);
+
+    if (choice < 30)
+    {
+        if (!Model[AlarmID].Active)
+        {
+            left = 1 + Random(CounterID == CounterA ? 100 : 20);
+            cycle = RandomCycle(CounterID);
+            SetRelAlarm(AlarmID, left, cycle);
+            ModelSet(AlarmID, left, cycle);
+        }
+    }
+    else if (choice < 40)
+    {
+        if (!Model[AlarmID].Active)
+        {
+            /* Start is a counter value, max included, which the counter
+             * shows as 0 */
+            start = Random(max + 1);
+            cycle = RandomCycle(CounterID);
+            SetAbsAlarm(AlarmID, start, cycle);
+
+            start %= max;
+            if (start > ModelTime[CounterID])
+            {
+                left = start - ModelTime[CounterID];
+            }
+            else
+            {
+                /* the counter has to come round to it */
+                left = start + max - ModelTime[CounterID];
+                AbsWraps++;
+            }
+            ModelSet(AlarmID, left, cycle);
+            Model[AlarmID].Abs = 1;
+            Model[AlarmID].Start = start;
+        }
+    }
+    else if (choice < 55)
+    {
+        if (Model[AlarmID].Active)
+        {
+            CancelAlarm(AlarmID);
+            Model[AlarmID].Active = 0;
+        }
+    }
+    else if (choice < 90)
+    {
+        /* longer than most cycles, so that alarms expire more than once */
+        Increment(CounterA, 1 + Random(64));
+    }
+    else if (choice < 98)
+    {
+        Increment(CounterB, 1 + Random(16));
+    }
+    else
+    {
+        /* more than a round of the counter */
+        max = CountersConst[CounterA].MaxAllowedValue;
+        Increment(CounterA, max + Random(max));
+    }
+}
+
+static void Check(void)
+{
+    AlarmType AlarmID;
+    CounterType CounterID;
+    TickType left;
+    uint32 loopi;
+
+    if (ActualCount != ExpectedCount)
+    {
+        printf("%u expirations, the model has %u\n", ActualCount, ExpectedCount);
+        Fail("expirations differ", INVALID_ALARM);
+    }
+    for (loopi = 0; loopi < ActualCount; loopi++)
+    {
+        if (Actual[loopi] != Expected[loopi])
+        {
+            printf("expiration %u is alarm %u, the model has %u\n", loopi,
+                Actual[loopi], Expected[loopi]);
+            Fail("order of expirations differs", Actual[loopi]);
+        }
+    }
+
+    for (AlarmID = 0; AlarmID < ALARMS_COUNT; AlarmID++)
+    {
+        if ((AlarmsVar[AlarmID].AlarmState != 0) != Model[AlarmID].Active)
+        {
+            Fail("state differs", AlarmID);
+        }
+        if (Model[AlarmID].Active)
+        {
+            GetAlarm(AlarmID, &left);
+            if (left != Model[AlarmID].Left)
+            {
+                printf("%u ticks left, the model has %u\n", left, Model[AlarmID].Left);
+                Fail("ticks left differ", AlarmID);
+            }
+        }
+        Model[AlarmID].Expired = 0;
+    }
+
+    for (CounterID = 0; CounterID < COUNTERS_COUNT; CounterID++)
+    {
+        if (GetCounter(CounterID) != ModelTime[CounterID])
+        {
+            Fail("counter value differs", INVALID_ALARM);
+        }
+
+        /* also by the cascaded increments */
+        if (CountersVar[CounterID].Ticks < LastTicks[CounterID])
+        {
+            TickWraps[CounterID]++;
+        }
+        LastTicks[CounterID] = CountersVar[CounterID].Ticks;
+    }
+
+    ActualCount = 0;
+    ExpectedCount = 0;
+}
+
+int main(void)
+{
+    printf("Starting OSEK-OS in AppMode1\n");
+    StartOS(AppMode1);
+
+    /* we shouldn't return here */
+    while(1);
+}
+
+void ErrorHook(void)
+{
+    printf("FAIL at step %u: service %u returned %u\n", Step,
+        OSErrorGetServiceId(), OSErrorGetRet());
+    exit(EXIT_FAILURE);
+}
+
+TASK(TaskTest)
+{
+    /* no alarm is set yet, the ticks can be moved */
+    CountersVar[CounterA].Ticks = TEST_TICKS_A;
+    CountersVar[CounterB].Ticks = TEST_TICKS_B;
+    LastTicks[CounterA] = TEST_TICKS_A;
+    LastTicks[CounterB] = TEST_TICKS_B;
+
+    /* the task never waits, so the OS never idles and the systick does
+     * not increment counters behind the model */
+    for (Step = 0; Step < TEST_STEPS; Step++)
+    {
+        Operation();
+        Check();
+    }
+
+    printf("%u operations: %u alarms expired more than once in an increment, "
+        "%u increments cascaded, %u absolute alarms came round the counter, "
+        "ticks of CounterA wrapped %u times, of CounterB %u times\n",
+        TEST_STEPS, CatchUps, Cascades, AbsWraps,
+        TickWraps[CounterA], TickWraps[CounterB]);
+
+    if ((CatchUps == 0) || (Cascades == 0) || (AbsWraps == 0) ||
+        (TickWraps[CounterA] == 0) || (TickWraps[CounterB] == 0))
+    {
+        printf("FAIL: a case was not covered\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("PASS\n");
+    exit(EXIT_SUCCESS);
+}
+
+ALARMCALLBACK(CallbackA0)
+{
+    Log(AlarmA0);
+}
+
+ALARMCALLBACK(CallbackA1)
+{
+    Log(AlarmA1);
+}
+
+ALARMCALLBACK(CallbackA2)
+{
+    Log(AlarmA2);
+}
+
+ALARMCALLBACK(CallbackA3)
+{
+    Log(AlarmA3);
+}
+
+ALARMCALLBACK(CallbackA4)
+{
+    Log(AlarmA4);
+}
+
+ALARMCALLBACK(CallbackA5)
+{
+    Log(AlarmA5);
+}
+
+ALARMCALLBACK(CallbackB0)
+{
+    Log(AlarmB0);
+}
+
+ALARMCALLBACK(CallbackB1)
+{
+    Log(AlarmB1);
+}
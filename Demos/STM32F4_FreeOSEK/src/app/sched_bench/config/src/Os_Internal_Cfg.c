@@ -0,0 +1,485 @@
+/********************************************************
+ * DO NOT CHANGE THIS FILE, IT IS GENERATED AUTOMATICALY*
+ ********************************************************/
+
+/* Copyright 2008, 2009 Mariano Cerdeiro
+ * Copyright 2014, ACSE & CADIEEL
+ *      ACSE: http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *      CADIEEL: http://www.cadieel.org.ar
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief FreeOSEK Os Generated Internal Configuration Implementation File
+ **
+ ** \file Os_Internal_Cfg.c
+ **
+ **/
+
+/** \addtogroup FreeOSEK
+ ** @{ */
+/** \addtogroup FreeOSEK_Os
+ ** @{ */
+/** \addtogroup FreeOSEK_Os_Internal
+ ** @{ */
+
+/*
+ * Initials     Name
+ * ---------------------------
+ * MaCe         Mariano Cerdeiro
+ * JuCe         Juan Cecconi
+ */
+
+/*
+ * modification history (new versions first)
+ * -----------------------------------------------------------
+ * 20141125 v0.1.3 JuCe additional stack for x86 ARCH
+ * 20090719 v0.1.2 MaCe rename file to Os_
+ * 20090128 v0.1.1 MaCe add OSEK_MEMMAP check
+ * 20080713 v0.1.0 MaCe initial version
+ */
+
+/*==================[inclusions]=============================================*/
+#include "Os_Internal.h"
+
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+/** \brief TaskBench stack */
+uint8 StackTaskTaskBench[32768];
+/** \brief TaskChain1 stack */
+uint8 StackTaskTaskChain1[16384];
+/** \brief TaskChain2 stack */
+uint8 StackTaskTaskChain2[16384];
+/** \brief TaskChain3 stack */
+uint8 StackTaskTaskChain3[16384];
+/** \brief TaskChain4 stack */
+uint8 StackTaskTaskChain4[16384];
+/** \brief TaskChain5 stack */
+uint8 StackTaskTaskChain5[16384];
+/** \brief TaskChain6 stack */
+uint8 StackTaskTaskChain6[16384];
+/** \brief TaskChain7 stack */
+uint8 StackTaskTaskChain7[16384];
+/** \brief TaskChain8 stack */
+uint8 StackTaskTaskChain8[16384];
+/** \brief TaskEvent stack */
+uint8 StackTaskTaskEvent[16384];
+/** \brief TaskHigh stack */
+uint8 StackTaskTaskHigh[16384];
+
+/** \brief TaskBench context */
+TaskContextType ContextTaskTaskBench;
+/** \brief TaskChain1 context */
+TaskContextType ContextTaskTaskChain1;
+/** \brief TaskChain2 context */
+TaskContextType ContextTaskTaskChain2;
+/** \brief TaskChain3 context */
+TaskContextType ContextTaskTaskChain3;
+/** \brief TaskChain4 context */
+TaskContextType ContextTaskTaskChain4;
+/** \brief TaskChain5 context */
+TaskContextType ContextTaskTaskChain5;
+/** \brief TaskChain6 context */
+TaskContextType ContextTaskTaskChain6;
+/** \brief TaskChain7 context */
+TaskContextType ContextTaskTaskChain7;
+/** \brief TaskChain8 context */
+TaskContextType ContextTaskTaskChain8;
+/** \brief TaskEvent context */
+TaskContextType ContextTaskTaskEvent;
+/** \brief TaskHigh context */
+TaskContextType ContextTaskTaskHigh;
+
+/** \brief Ready List for Priority 10 */
+TaskType ReadyList10[1];
+
+/** \brief Ready List for Priority 9 */
+TaskType ReadyList9[1];
+
+/** \brief Ready List for Priority 8 */
+TaskType ReadyList8[1];
+
+/** \brief Ready List for Priority 7 */
+TaskType ReadyList7[1];
+
+/** \brief Ready List for Priority 6 */
+TaskType ReadyList6[1];
+
+/** \brief Ready List for Priority 5 */
+TaskType ReadyList5[1];
+
+/** \brief Ready List for Priority 4 */
+TaskType ReadyList4[1];
+
+/** \brief Ready List for Priority 3 */
+TaskType ReadyList3[1];
+
+/** \brief Ready List for Priority 2 */
+TaskType ReadyList2[1];
+
+/** \brief Ready List for Priority 1 */
+TaskType ReadyList1[1];
+
+/** \brief Ready List for Priority 0 */
+TaskType ReadyList0[1];
+
+const AlarmType OSEK_ALARMLIST_HardwareCounter[1] = {
+	WakeTaskBench, /* this alarm has to be incremented with this counter */
+};
+
+
+/*==================[external data definition]===============================*/
+/* FreeOSEK to configured priority table
+ *
+ * This table show the relationship between the user selected
+ * priorities and the OpenOSE priorities:
+ *
+ * User P.			Osek P.
+ * 20					10
+ * 19					9
+ * 9					8
+ * 8					7
+ * 7					6
+ * 6					5
+ * 5					4
+ * 4					3
+ * 3					2
+ * 2					1
+ * 1					0
+ */
+
+const TaskConstType TasksConst[TASKS_COUNT] = {
+	/* Task TaskBench */
+	{
+ 		OSEK_TASK_TaskBench,	/* task entry point */
+		&ContextTaskTaskBench, /* pointer to task context */
+		StackTaskTaskBench, /* pointer stack memory */
+		32768, /* stack size */
+		0, /* task priority */
+		1, /* task max activations */
+		{
+			1, /* extended task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 | evWake , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain1 */
+	{
+ 		OSEK_TASK_TaskChain1,	/* task entry point */
+		&ContextTaskTaskChain1, /* pointer to task context */
+		StackTaskTaskChain1, /* pointer stack memory */
+		16384, /* stack size */
+		1, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain2 */
+	{
+ 		OSEK_TASK_TaskChain2,	/* task entry point */
+		&ContextTaskTaskChain2, /* pointer to task context */
+		StackTaskTaskChain2, /* pointer stack memory */
+		16384, /* stack size */
+		2, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain3 */
+	{
+ 		OSEK_TASK_TaskChain3,	/* task entry point */
+		&ContextTaskTaskChain3, /* pointer to task context */
+		StackTaskTaskChain3, /* pointer stack memory */
+		16384, /* stack size */
+		3, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain4 */
+	{
+ 		OSEK_TASK_TaskChain4,	/* task entry point */
+		&ContextTaskTaskChain4, /* pointer to task context */
+		StackTaskTaskChain4, /* pointer stack memory */
+		16384, /* stack size */
+		4, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain5 */
+	{
+ 		OSEK_TASK_TaskChain5,	/* task entry point */
+		&ContextTaskTaskChain5, /* pointer to task context */
+		StackTaskTaskChain5, /* pointer stack memory */
+		16384, /* stack size */
+		5, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain6 */
+	{
+ 		OSEK_TASK_TaskChain6,	/* task entry point */
+		&ContextTaskTaskChain6, /* pointer to task context */
+		StackTaskTaskChain6, /* pointer stack memory */
+		16384, /* stack size */
+		6, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain7 */
+	{
+ 		OSEK_TASK_TaskChain7,	/* task entry point */
+		&ContextTaskTaskChain7, /* pointer to task context */
+		StackTaskTaskChain7, /* pointer stack memory */
+		16384, /* stack size */
+		7, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskChain8 */
+	{
+ 		OSEK_TASK_TaskChain8,	/* task entry point */
+		&ContextTaskTaskChain8, /* pointer to task context */
+		StackTaskTaskChain8, /* pointer stack memory */
+		16384, /* stack size */
+		8, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskEvent */
+	{
+ 		OSEK_TASK_TaskEvent,	/* task entry point */
+		&ContextTaskTaskEvent, /* pointer to task context */
+		StackTaskTaskEvent, /* pointer stack memory */
+		16384, /* stack size */
+		9, /* task priority */
+		1, /* task max activations */
+		{
+			1, /* extended task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 | evPing , /* events mask */
+		0 /* resources mask */
+	},
+	/* Task TaskHigh */
+	{
+ 		OSEK_TASK_TaskHigh,	/* task entry point */
+		&ContextTaskTaskHigh, /* pointer to task context */
+		StackTaskTaskHigh, /* pointer stack memory */
+		16384, /* stack size */
+		10, /* task priority */
+		1, /* task max activations */
+		{
+			0, /* basic task */
+			1, /* preemtive task */
+			0
+		}, /* task const flags */
+		0 , /* events mask */
+		0 /* resources mask */
+	}
+};
+
+/** \brief TaskVar Array */
+TaskVariableType TasksVar[TASKS_COUNT];
+
+/** \brief List of Auto Start Tasks in Application Mode AppMode1 */
+const TaskType TasksAppModeAppMode1[1]  = {
+	TaskBench
+};
+/** \brief AutoStart Array */
+const AutoStartType AutoStart[1]  = {
+	/* Application Mode AppMode1 */
+	{
+		1, /* Total Auto Start Tasks in this Application Mode */
+		(TaskRefType)TasksAppModeAppMode1 /* Pointer to the list of Auto Start Stacks on this Application Mode */
+	}
+};
+
+const ReadyConstType ReadyConst[11] = { 
+	{
+		1, /* Length of this ready list */
+		ReadyList10 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList9 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList8 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList7 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList6 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList5 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList4 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList3 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList2 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList1 /* Pointer to the Ready List */
+	},
+	{
+		1, /* Length of this ready list */
+		ReadyList0 /* Pointer to the Ready List */
+	}
+};
+
+/** TODO replace next line with: 
+ ** ReadyVarType ReadyVar[11] ; */
+ReadyVarType ReadyVar[11];
+/** \brief Ready Bitmap */
+ReadyMapType ReadyMap[READYMAP_COUNT];
+
+/** \brief Resources Priorities */
+const TaskPriorityType ResourcesPriority[0]  = {
+
+};
+/** TODO replace next line with: 
+ ** AlarmVarType AlarmsVar[1]; */
+AlarmVarType AlarmsVar[1];
+
+const AlarmConstType AlarmsConst[1]  = {
+	{
+		OSEK_COUNTER_HardwareCounter, /* Counter */
+		SETEVENT, /* Alarm action */
+		{
+			NULL, /* no callback */
+			TaskBench, /* TaskID */
+			evWake, /* no event */
+			0 /* no counter */
+		},
+	}
+};
+
+const AutoStartAlarmType AutoStartAlarm[ALARM_AUTOSTART_COUNT] = {
+
+};
+
+CounterVarType CountersVar[1];
+
+const CounterConstType CountersConst[1] = {
+	{
+		1, /* quantity of alarms for this counter */
+		(AlarmType*)OSEK_ALARMLIST_HardwareCounter, /* alarms list */
+		60000000, /* max allowed value */
+		1, /* min cycle */
+		1 /* ticks per base */
+	}
+};
+
+
+/** TODO replace the next line with
+ ** uint8 ApplicationMode; */
+uint8 ApplicationMode;
+
+/** TODO replace the next line with
+ ** uint8 ErrorHookRunning; */
+uint8 ErrorHookRunning;
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
@@ -0,0 +1,210 @@
+/*
+**
+**                           Main.c
+**
+** Scheduling latency benchmark of FreeOSEK, built for the posix arch
+** and run on the host.
+**
+**********************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "os.h"
+
+/* times every measure is repeated */
+#define BENCH_LOOPS 200000
+
+/* tasks TaskChain1 to TaskChainN, each on its own priority */
+#define BENCH_CHAIN 8
+
+/* the scheduler lookup of the OS, not part of its API */
+extern TaskType GetNextTask(void);
+
+/* time stamp taken before the service which switches task */
+static uint64_t BenchStart;
+
+/* latencies from BenchStart to the task which has been switched to */
+static uint64_t BenchSum;
+static uint64_t BenchMin;
+
+static uint64_t Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + ts.tv_nsec;
+}
+
+static void BenchReset(void)
+{
+    BenchSum = 0;
+    BenchMin = ~(uint64_t)0;
+}
+
+/* called first thing by the task which has been switched to */
+static void BenchRecord(void)
+{
+    uint64_t latency = Now() - BenchStart;
+
+    BenchSum += latency;
+    if (latency < BenchMin)
+    {
+        BenchMin = latency;
+    }
+}
+
+static void BenchReport(const char * name, uint64_t total)
+{
+    printf("%-34s %8.1f ns avg %8llu ns min %8.1f ns loop\n", name,
+        (double)BenchSum / BENCH_LOOPS, (unsigned long long)BenchMin,
+        (double)total / BENCH_LOOPS);
+}
+
+int main(void)
+{
+    printf("Starting OSEK-OS in AppMode1\n");
+    StartOS(AppMode1);
+
+    /* we shouldn't return here */
+    while(1);
+}
+
+void ErrorHook(void)
+{
+    /* kernel panic :( */
+    printf("kernel panic: service %u returned %u\n",
+        OSErrorGetServiceId(), OSErrorGetRet());
+    exit(EXIT_FAILURE);
+}
+
+TASK(TaskBench)
+{
+    uint32 loopi;
+    uint64_t begin;
+    uint64_t total;
+    volatile TaskType next;
+
+    printf("%d loops, %d chained tasks\n\n", BENCH_LOOPS, BENCH_CHAIN);
+
+    /* activation of a higher priority task, which terminates at once */
+    BenchReset();
+    begin = Now();
+    for (loopi = 0; loopi < BENCH_LOOPS; loopi++)
+    {
+        BenchStart = Now();
+        ActivateTask(TaskHigh);
+    }
+    BenchReport("ActivateTask to preempting task", Now() - begin);
+
+    /* event to a higher priority task waiting for it */
+    ActivateTask(TaskEvent);
+    BenchReset();
+    begin = Now();
+    for (loopi = 0; loopi < BENCH_LOOPS; loopi++)
+    {
+        BenchStart = Now();
+        SetEvent(TaskEvent, evPing);
+    }
+    BenchReport("SetEvent to waiting task", Now() - begin);
+
+    /* every task of the chain activates the next one, which preempts it,
+     * and then all terminate back down the priorities */
+    BenchReset();
+    begin = Now();
+    for (loopi = 0; loopi < BENCH_LOOPS; loopi++)
+    {
+        BenchStart = Now();
+        ActivateTask(TaskChain1);
+    }
+    total = Now() - begin;
+    BenchReport("Chain of tasks, end to end", total);
+    printf("%-34s %8.1f ns\n", "Chain of tasks, per switch",
+        (double)total / BENCH_LOOPS / (2 * BENCH_CHAIN));
+
+    /* the scheduler looking up the next task, only the task of the lowest
+     * priority is ready */
+    begin = Now();
+    for (loopi = 0; loopi < BENCH_LOOPS; loopi++)
+    {
+        next = GetNextTask();
+    }
+    total = Now() - begin;
+    printf("%-34s %8.1f ns\n", "GetNextTask, lowest priority",
+        (double)total / BENCH_LOOPS);
+    (void)next;
+
+    /* the OS idles until the alarm expires */
+    begin = Now();
+    SetRelAlarm(WakeTaskBench, 10, 0);
+    WaitEvent(evWake);
+    ClearEvent(evWake);
+    printf("\nAlarm of 10 ticks expired after %.2f ms\n",
+        (double)(Now() - begin) / 1000000);
+
+    exit(EXIT_SUCCESS);
+}
+
+TASK(TaskHigh)
+{
+    BenchRecord();
+    TerminateTask();
+}
+
+TASK(TaskEvent)
+{
+    while(1)
+    {
+        WaitEvent(evPing);
+        BenchRecord();
+        ClearEvent(evPing);
+    }
+}
+
+TASK(TaskChain1)
+{
+    ActivateTask(TaskChain2);
+    TerminateTask();
+}
+
+TASK(TaskChain2)
+{
+    ActivateTask(TaskChain3);
+    TerminateTask();
+}
+
+TASK(TaskChain3)
+{
+    ActivateTask(TaskChain4);
+    TerminateTask();
+}
+
+TASK(TaskChain4)
+{
+    ActivateTask(TaskChain5);
+    TerminateTask();
+}
+
+TASK(TaskChain5)
+{
+    ActivateTask(TaskChain6);
+    TerminateTask();
+}
+
+TASK(TaskChain6)
+{
+    ActivateTask(TaskChain7);
+    TerminateTask();
+}
+
+TASK(TaskChain7)
+{
+    ActivateTask(TaskChain8);
+    TerminateTask();
+}
+
+TASK(TaskChain8)
+{
+    BenchRecord();
+    TerminateTask();
+}
@@ -0,0 +1,392 @@
+/*
+ * Host test of the IPC FIFO and frames, without the board: fifo.c and
+ * frame.c are built as they are for the target. The FIFO is checked
+ * against a plain model, the table CRC against the bitwise one it
+ * replaced, and both are timed against the byte at a time versions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "fifo.h"
+#include "frame.h"
+
+#define TEST_ROUNDS      200000
+#define TEST_BENCH_BYTES (64UL * 1024 * 1024)
+
+extern uint8_t IPC_Frame_Crc8(uint8_t *Data, uint16_t Len);
+extern bool IPC_Frame_Create(IPC_Frame_t *Frame, uint8_t *Data, uint16_t Len);
+extern bool IPC_Frame_Check(IPC_Frame_t *Frame);
+
+static int g_Failures;
+
+static void Check(const char *Name, bool Ok)
+{
+    printf("%-56s %s\n", Name, Ok ? "PASS" : "FAIL");
+    if (!Ok)
+    {
+        g_Failures++;
+    }
+}
+
+static double Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * The CRC-8 as it was computed before the table
+ */
+static uint8_t Crc8Bitwise(uint8_t *Data, uint16_t Len)
+{
+    unsigned Crc = 0;
+    int i, j;
+
+    for (j = Len; j; j--, Data++)
+    {
+        Crc ^= (*Data << 8);
+
+        for(i = 8; i; i--)
+        {
+            if (Crc & 0x8000)
+            {
+                Crc ^= (0x1070 << 3);
+            }
+            Crc <<= 1;
+        }
+    }
+    return (uint8_t)(Crc >> 8);
+}
+
+/*
+ * The multi push and pop as they were, one byte at a time. FifoPush and
+ * FifoPop no longer divide to wrap, so this is faster than it was.
+ */
+static void FifoPushMultiBytewise(Fifo_t *fifo, uint8_t *buffer, uint16_t size)
+{
+    uint16_t i;
+
+    for(i = 0; i < size; i++)
+    {
+        FifoPush(fifo, buffer[i]);
+    }
+}
+
+static uint16_t FifoPopMultiBytewise(Fifo_t *fifo, uint8_t *buffer, uint16_t size)
+{
+    uint16_t i;
+
+    if (size > FifoGetDataSize(fifo))
+    {
+        size = FifoGetDataSize(fifo);
+    }
+
+    for(i = 0; i < size; i++)
+    {
+        buffer[i] = FifoPop(fifo);
+    }
+
+    return size;
+}
+
+static void TestCrc(void)
+{
+    uint8_t Data[IPC_TRANSFER_LEN];
+    uint16_t Len;
+    bool Ok = true;
+    int i, j;
+
+    for (i = 0; i < 256; i++)
+    {
+        Data[0] = (uint8_t)i;
+        Ok &= (IPC_Frame_Crc8(Data, 1) == Crc8Bitwise(Data, 1));
+    }
+    Check("CRC-8 table matches bitwise on every byte value", Ok);
+
+    Ok = true;
+    for (i = 0; i < 10000; i++)
+    {
+        Len = rand() % (sizeof(Data) + 1);
+        for (j = 0; j < Len; j++)
+        {
+            Data[j] = (uint8_t)rand();
+        }
+        Ok &= (IPC_Frame_Crc8(Data, Len) == Crc8Bitwise(Data, Len));
+    }
+    Check("CRC-8 table matches bitwise on random data", Ok);
+
+    Check("CRC-8 of \"123456789\" is 0xF4",
+          IPC_Frame_Crc8((uint8_t *)"123456789", 9) == 0xF4);
+}
+
+static void TestFrame(void)
+{
+    uint8_t Buff[IPC_TRANSFER_LEN];
+    IPC_Frame_t *Frame = (IPC_Frame_t *)Buff;
+    uint8_t Data[IPC_DATA_MAX_LEN];
+    int i;
+
+    for (i = 0; i < IPC_DATA_MAX_LEN; i++)
+    {
+        Data[i] = (uint8_t)(i * 7);
+    }
+
+    Check("frame of max length is created",
+          IPC_Frame_Create(Frame, Data, IPC_DATA_MAX_LEN));
+    Check("frame checks", IPC_Frame_Check(Frame));
+
+    Frame->Data[100] ^= 0x10;
+    Check("frame with a bad data byte fails", !IPC_Frame_Check(Frame));
+
+    IPC_Frame_Create(Frame, Data, 10);
+    Frame->Header.Len = 11;
+    Check("frame with a bad length fails", !IPC_Frame_Check(Frame));
+
+    Frame->Header.Len = IPC_DATA_MAX_LEN + 1;
+    Frame->Header.Crc8 = IPC_Frame_Crc8((uint8_t *)&Frame->Header, 3);
+    Check("frame longer than the max length fails", !IPC_Frame_Check(Frame));
+}
+
+/*
+ * Random pushes and pops of all kinds against a model that keeps the
+ * bytes in order in a flat array
+ */
+static void TestFifoModel(uint16_t Size)
+{
+    static uint8_t Storage[1024];
+    static uint8_t Model[1024];
+    uint8_t In[1024], Out[1024];
+    uint16_t ModelCount = 0;
+    uint16_t Len, Span, Got;
+    uint8_t *Ptr;
+    uint8_t Next = 0;
+    Fifo_t Fifo;
+    bool Ok = true;
+    char Name[64];
+    int i, j;
+
+    FifoInit(&Fifo, Storage, Size);
+
+    for (i = 0; (i < TEST_ROUNDS) && Ok; i++)
+    {
+        switch (rand() % 8)
+        {
+        case 0:
+            if (ModelCount < Size)
+            {
+                FifoPush(&Fifo, Next);
+                Model[ModelCount++] = Next++;
+            }
+            break;
+
+        case 1:
+            if (ModelCount > 0)
+            {
+                Ok &= (FifoRead(&Fifo) == Model[0]);
+                Ok &= (FifoPop(&Fifo) == Model[0]);
+                memmove(Model, &Model[1], --ModelCount);
+            }
+            break;
+
+        case 2:
+            Len = rand() % (Size - ModelCount + 1);
+            for (j = 0; j < Len; j++)
+            {
+                In[j] = Next++;
+            }
+            FifoPushMulti(&Fifo, In, Len);
+            memcpy(&Model[ModelCount], In, Len);
+            ModelCount += Len;
+            break;
+
+        case 3:
+            Len = rand() % (Size + 1);
+            Got = FifoPopMulti(&Fifo, Out, Len);
+            Ok &= (Got == (Len < ModelCount ? Len : ModelCount));
+            Ok &= (memcmp(Out, Model, Got) == 0);
+            memmove(Model, &Model[Got], ModelCount - Got);
+            ModelCount -= Got;
+            break;
+
+        case 4:
+            /* Written in place, like a DMA receive */
+            Span = FifoReservePush(&Fifo, &Ptr);
+            Ok &= (Span <= Size - ModelCount);
+            Ok &= (Span > 0) || (ModelCount == Size);
+            Len = Span ? rand() % (Span + 1) : 0;
+            for (j = 0; j < Len; j++)
+            {
+                Ptr[j] = Next;
+                Model[ModelCount++] = Next++;
+            }
+            FifoCommitPush(&Fifo, Len);
+            break;
+
+        case 5:
+            /* Read in place, like a DMA send */
+            Span = FifoReservePop(&Fifo, &Ptr);
+            Ok &= (Span <= ModelCount);
+            Ok &= (Span > 0) || (ModelCount == 0);
+            Ok &= (memcmp(Ptr, Model, Span) == 0);
+            Len = Span ? rand() % (Span + 1) : 0;
+            FifoCommitPop(&Fifo, Len);
+            memmove(Model, &Model[Len], ModelCount - Len);
+            ModelCount -= Len;
+            break;
+
+        case 6:
+            if ((rand() % 64) == 0)
+            {
+                FifoFlush(&Fifo);
+                ModelCount = 0;
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        Ok &= (FifoGetDataSize(&Fifo) == ModelCount);
+        Ok &= (FifoGetFreeSize(&Fifo) == Size - ModelCount);
+        Ok &= (IsFifoEmpty(&Fifo) == (ModelCount == 0));
+        Ok &= (IsFifoFull(&Fifo) == (ModelCount == Size));
+    }
+
+    snprintf(Name, sizeof(Name), "FIFO of %u bytes matches the model", Size);
+    Check(Name, Ok);
+}
+
+/*
+ * With whole frames only going in and out, a frame is never split at the
+ * end of the FIFO, which is what lets the SPI DMA work on FIFO storage
+ */
+static void TestFifoFrames(void)
+{
+    static uint8_t Storage[FIFO_BUF_SIZE];
+    uint8_t *Ptr;
+    Fifo_t Fifo;
+    bool Ok = true;
+    int i;
+
+    FifoInit(&Fifo, Storage, FIFO_BUF_SIZE);
+
+    for (i = 0; i < 10000; i++)
+    {
+        if (rand() & 1)
+        {
+            if (FifoGetFreeSize(&Fifo) >= IPC_TRANSFER_LEN)
+            {
+                Ok &= (FifoReservePush(&Fifo, &Ptr) >= IPC_TRANSFER_LEN);
+                FifoCommitPush(&Fifo, IPC_TRANSFER_LEN);
+            }
+        }
+        else
+        {
+            if (FifoGetDataSize(&Fifo) >= IPC_TRANSFER_LEN)
+            {
+                Ok &= (FifoReservePop(&Fifo, &Ptr) >= IPC_TRANSFER_LEN);
+                FifoCommitPop(&Fifo, IPC_TRANSFER_LEN);
+            }
+        }
+    }
+
+    Check("IPC frames are contiguous in FIFO storage", Ok);
+}
+
+static void BenchFifo(void)
+{
+    static uint8_t Storage[FIFO_BUF_SIZE];
+    uint8_t Frame[IPC_TRANSFER_LEN];
+    unsigned long Count, Frames = TEST_BENCH_BYTES / IPC_TRANSFER_LEN;
+    double Start, Time[2];
+    Fifo_t Fifo;
+    int Pass;
+
+    memset(Frame, 0x5A, sizeof(Frame));
+
+    /* Half full, so that the frames wrap at the end of the buffer */
+    for (Pass = 0; Pass < 2; Pass++)
+    {
+        FifoInit(&Fifo, Storage, FIFO_BUF_SIZE - 3);
+        FifoPushMulti(&Fifo, Storage, FIFO_BUF_SIZE / 2);
+
+        Start = Now();
+        for (Count = 0; Count < Frames; Count++)
+        {
+            if (Pass == 0)
+            {
+                FifoPushMultiBytewise(&Fifo, Frame, IPC_TRANSFER_LEN);
+                FifoPopMultiBytewise(&Fifo, Frame, IPC_TRANSFER_LEN);
+            }
+            else
+            {
+                FifoPushMulti(&Fifo, Frame, IPC_TRANSFER_LEN);
+                FifoPopMulti(&Fifo, Frame, IPC_TRANSFER_LEN);
+            }
+        }
+
+        Time[Pass] = Now() - Start;
+    }
+
+    printf("FIFO push+pop of %u byte frames: bytewise %7.1f MB/s, "
+           "block %7.1f MB/s (x%.1f)\n", IPC_TRANSFER_LEN,
+           TEST_BENCH_BYTES / Time[0] / 1e6, TEST_BENCH_BYTES / Time[1] / 1e6,
+           Time[0] / Time[1]);
+}
+
+static void BenchCrc(void)
+{
+    uint8_t Data[IPC_TRANSFER_LEN];
+    unsigned long Count, Frames = TEST_BENCH_BYTES / IPC_TRANSFER_LEN / 4;
+    volatile uint8_t Sink = 0;
+    double Start, Bitwise, Table;
+
+    memset(Data, 0xC3, sizeof(Data));
+
+    Start = Now();
+    for (Count = 0; Count < Frames; Count++)
+    {
+        Data[0] = (uint8_t)Count;
+        Sink ^= Crc8Bitwise(Data, IPC_TRANSFER_LEN);
+    }
+    Bitwise = Now() - Start;
+
+    Start = Now();
+    for (Count = 0; Count < Frames; Count++)
+    {
+        Data[0] = (uint8_t)Count;
+        Sink ^= IPC_Frame_Crc8(Data, IPC_TRANSFER_LEN);
+    }
+    Table = Now() - Start;
+
+    printf("CRC-8 of %u byte frames:         bitwise %7.1f MB/s, "
+           "table %7.1f MB/s (x%.1f)\n", IPC_TRANSFER_LEN,
+           TEST_BENCH_BYTES / 4 / Bitwise / 1e6, TEST_BENCH_BYTES / 4 / Table / 1e6,
+           Bitwise / Table);
+}
+
+int main(void)
+{
+    srand(1);
+
+    TestCrc();
+    TestFrame();
+    TestFifoModel(1);
+    TestFifoModel(7);
+    TestFifoModel(256);
+    TestFifoModel(1000);
+    TestFifoFrames();
+
+    BenchFifo();
+    BenchCrc();
+
+    printf("%d failure(s)\n", g_Failures);
+    return g_Failures ? 1 : 0;
+}
@@ -60,6 +60,44 @@ void FifoPushMulti(Fifo_t *fifo, uint8_t *buffer, uint16_t size);
  */
 uint16_t FifoPopMulti(Fifo_t *fifo, uint8_t *buffer, uint16_t size);
 
+/*!
+ * Gives the free space at the FIFO end that can be written in place, as
+ * for a DMA transfer, and returns its contiguous size. The data only goes
+ * into the FIFO with FifoCommitPush
+ *
+ * \param [IN]  fifo   Pointer to the FIFO object
+ * \param [OUT] buffer Where to write the data
+ * \retval size        Contiguous free space at buffer
+ */
+uint16_t FifoReservePush(Fifo_t *fifo, uint8_t **buffer);
+
+/*!
+ * Adds data written in place after FifoReservePush to the FIFO
+ *
+ * \param [IN] fifo Pointer to the FIFO object
+ * \param [IN] size Data size, at most what FifoReservePush returned
+ */
+void FifoCommitPush(Fifo_t *fifo, uint16_t size);
+
+/*!
+ * Gives the data at the FIFO begin that can be read in place, as for a
+ * DMA transfer, and returns its contiguous size. The data stays in the
+ * FIFO until FifoCommitPop
+ *
+ * \param [IN]  fifo   Pointer to the FIFO object
+ * \param [OUT] buffer Where to read the data
+ * \retval size        Contiguous data size at buffer
+ */
+uint16_t FifoReservePop(Fifo_t *fifo, uint8_t **buffer);
+
+/*!
+ * Removes data read in place after FifoReservePop from the FIFO
+ *
+ * \param [IN] fifo Pointer to the FIFO object
+ * \param [IN] size Data size, at most what FifoReservePop returned
+ */
+void FifoCommitPop(Fifo_t *fifo, uint16_t size);
+
 /*!
  * Read data from the FIFO (without change FIFO buffer)
  *
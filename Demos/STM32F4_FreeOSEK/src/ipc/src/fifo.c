@@ -1,9 +1,28 @@
 #include <stdio.h>
+#include <string.h>
 #include "fifo.h"
 
+/*
+ * The data is Size - FreeSize bytes from Begin on, the free space is
+ * FreeSize bytes from End on, both wrapping at the end of the buffer.
+ * Either of them is at most two contiguous spans.
+ */
+
 static uint16_t FifoNext(Fifo_t *fifo, uint16_t index)
 {
-    return ( index + 1 ) % fifo->Size;
+    return (index + 1 == fifo->Size) ? 0 : (index + 1);
+}
+
+static uint16_t FifoAdvance(Fifo_t *fifo, uint16_t index, uint16_t size)
+{
+    uint32_t next = (uint32_t)index + size;
+
+    if (next >= fifo->Size)
+    {
+        next -= fifo->Size;
+    }
+
+    return (uint16_t)next;
 }
 
 void FifoInit(Fifo_t *fifo, uint8_t *buffer, uint16_t size)
@@ -17,14 +36,14 @@ void FifoInit(Fifo_t *fifo, uint8_t *buffer, uint16_t size)
 
 void FifoPush(Fifo_t *fifo, uint8_t data)
 {
-    fifo->End = FifoNext(fifo, fifo->End);
     fifo->Data[fifo->End] = data;
+    fifo->End = FifoNext(fifo, fifo->End);
     fifo->FreeSize--;
 }
 
 uint8_t FifoPop(Fifo_t *fifo)
 {
-    uint8_t data = fifo->Data[FifoNext( fifo, fifo->Begin )];
+    uint8_t data = fifo->Data[fifo->Begin];
 
     fifo->Begin = FifoNext(fifo, fifo->Begin);
     fifo->FreeSize++;
@@ -33,14 +52,21 @@ uint8_t FifoPop(Fifo_t *fifo)
 
 void FifoPushMulti(Fifo_t *fifo, uint8_t *buffer, uint16_t size)
 {
-    uint16_t i;
+    uint16_t span;
 
     if (size <= fifo->FreeSize)
     {
-        for(i = 0; i < size; i++)
+        /* Up to the end of the buffer, then the rest from the start */
+        span = fifo->Size - fifo->End;
+        if (span > size)
         {
-            FifoPush(fifo, buffer[i]);
+            span = size;
         }
+
+        memcpy(&fifo->Data[fifo->End], buffer, span);
+        memcpy(fifo->Data, &buffer[span], size - span);
+
+        FifoCommitPush(fifo, size);
     }
     else
     {
@@ -50,35 +76,71 @@ void FifoPushMulti(Fifo_t *fifo, uint8_t *buffer, uint16_t size)
 
 uint16_t FifoPopMulti(Fifo_t *fifo, uint8_t *buffer, uint16_t size)
 {
-    uint16_t i, FifoDataCount, PopSize = 0;
+    uint16_t span, FifoDataCount;
 
     FifoDataCount = FifoGetDataSize(fifo);
 
-    if (size <= FifoDataCount)
+    if (size > FifoDataCount)
     {
-        for(i = 0; i < size; i++)
-        {
-            buffer[i] = FifoPop(fifo);
-        }
+        size = FifoDataCount;
+    }
 
-        PopSize = size;
+    /* Up to the end of the buffer, then the rest from the start */
+    span = fifo->Size - fifo->Begin;
+    if (span > size)
+    {
+        span = size;
     }
-    else
+
+    memcpy(buffer, &fifo->Data[fifo->Begin], span);
+    memcpy(&buffer[span], fifo->Data, size - span);
+
+    FifoCommitPop(fifo, size);
+
+    return size;
+}
+
+uint16_t FifoReservePush(Fifo_t *fifo, uint8_t **buffer)
+{
+    uint16_t span = fifo->Size - fifo->End;
+
+    if (span > fifo->FreeSize)
     {
-        for(i = 0; i < FifoDataCount; i++)
-        {
-            buffer[i] = FifoPop(fifo);
-        }
+        span = fifo->FreeSize;
+    }
+
+    *buffer = &fifo->Data[fifo->End];
+    return span;
+}
 
-        PopSize = FifoDataCount;
+void FifoCommitPush(Fifo_t *fifo, uint16_t size)
+{
+    fifo->End = FifoAdvance(fifo, fifo->End, size);
+    fifo->FreeSize -= size;
+}
+
+uint16_t FifoReservePop(Fifo_t *fifo, uint8_t **buffer)
+{
+    uint16_t span = fifo->Size - fifo->Begin;
+
+    if (span > FifoGetDataSize(fifo))
+    {
+        span = FifoGetDataSize(fifo);
     }
 
-    return PopSize;
+    *buffer = &fifo->Data[fifo->Begin];
+    return span;
+}
+
+void FifoCommitPop(Fifo_t *fifo, uint16_t size)
+{
+    fifo->Begin = FifoAdvance(fifo, fifo->Begin, size);
+    fifo->FreeSize += size;
 }
 
 uint8_t FifoRead(Fifo_t *fifo)
 {
-    uint8_t data = fifo->Data[FifoNext( fifo, fifo->Begin )];
+    uint8_t data = fifo->Data[fifo->Begin];
     return data;
 }
 
@@ -86,6 +148,7 @@ void FifoFlush(Fifo_t *fifo)
 {
     fifo->Begin = 0;
     fifo->End = 0;
+    fifo->FreeSize = fifo->Size;
 }
 
 uint16_t FifoGetFreeSize(Fifo_t *fifo)
@@ -100,10 +163,10 @@ uint16_t FifoGetDataSize(Fifo_t *fifo)
 
 bool IsFifoEmpty(Fifo_t *fifo)
 {
-    return (fifo->Begin == fifo->End);
+    return (fifo->FreeSize == fifo->Size);
 }
 
 bool IsFifoFull(Fifo_t *fifo)
 {
-    return (FifoNext(fifo, fifo->End) == fifo->Begin);
+    return (fifo->FreeSize == 0);
 }
@@ -26,7 +26,8 @@
  *  GLOBAL VARIABLE DEFINITION
  ***************************************************************/
 /*
- * IPC buffers definition
+ * IPC buffers definition, the empty frame sent when there is nothing
+ * to send and where a frame is received when the Rx FIFO has no room
  */
 static uint8_t g_TxBuff[IPC_TRANSFER_LEN + 1] = {0};
 static uint8_t g_RxBuff[IPC_TRANSFER_LEN + 1] = {0};
@@ -37,10 +38,12 @@ static uint8_t g_RxBuff[IPC_TRANSFER_LEN + 1] = {0};
 static uint8_t g_TmpBuff[IPC_TRANSFER_LEN] = {0};
 
 /*
- * FIFO buffers definition
+ * FIFO buffers definition. Frames are transferred straight from and into
+ * FIFO storage, by transfers one byte longer than a frame. The spare byte
+ * takes that byte after the frame at the end of the buffer.
  */
-static uint8_t g_TxFifoBuff[FIFO_BUF_SIZE];
-static uint8_t g_RxFifoBuff[FIFO_BUF_SIZE];
+static uint8_t g_TxFifoBuff[FIFO_BUF_SIZE + 1];
+static uint8_t g_RxFifoBuff[FIFO_BUF_SIZE + 1];
 
 /*
  * FIFO objects definition
@@ -48,6 +51,12 @@ static uint8_t g_RxFifoBuff[FIFO_BUF_SIZE];
 static Fifo_t g_TxFifo;
 static Fifo_t g_RxFifo;
 
+/*
+ * Buffers of the SPI transfer in progress
+ */
+static uint8_t *g_TxSlot = g_TxBuff;
+static uint8_t *g_RxSlot = g_RxBuff;
+
 /*
  * IPC Initialization status
  */
@@ -97,8 +106,31 @@ bool IPC_InitStatus(void)
  */
 static void IPC_SPITransferQueue(void)
 {
+    uint16_t Len;
+
+    /*
+     * Sends the next frame from Tx FIFO storage, it is popped when
+     * the transfer is completed. Tx FIFO holds whole frames only.
+     */
+    if (FifoReservePop(&g_TxFifo, &g_TxSlot) < IPC_TRANSFER_LEN)
+    {
+        g_TxSlot = g_TxBuff;
+    }
+
+    /*
+     * Receives into Rx FIFO storage when the byte after the frame
+     * does not fall on data, it is pushed if the frame is good
+     */
+    Len = FifoReservePush(&g_RxFifo, &g_RxSlot);
+
+    if ((Len < IPC_TRANSFER_LEN) ||
+        ((Len == IPC_TRANSFER_LEN) && (&g_RxSlot[Len] != &g_RxFifoBuff[FIFO_BUF_SIZE])))
+    {
+        g_RxSlot = g_RxBuff;
+    }
+
     /* Master transfer request */
-    SPI_AsyncTransfer(g_TxBuff, g_RxBuff, IPC_TRANSFER_LEN + 1, &IPC_TransferCompleted);
+    SPI_AsyncTransfer(g_TxSlot, g_RxSlot, IPC_TRANSFER_LEN + 1, &IPC_TransferCompleted);
 
 #ifndef SPI_MASTER
     /* Signals that SPI slaver is free */
@@ -112,29 +144,37 @@ static void IPC_SPITransferQueue(void)
  */
 void IPC_TransferCompleted(void)
 {
-    IPC_Frame_t *Frame = (IPC_Frame_t *)g_RxBuff;
+    IPC_Frame_t *Frame = (IPC_Frame_t *)g_RxSlot;
 
 #ifndef SPI_MASTER
     /* Signals that SPI slaver is busy */
     SPI_RequestOutSetValue(false);
 #endif
 
+    /* The frame sent from Tx FIFO storage is done with */
+    if (g_TxSlot != g_TxBuff)
+    {
+        FifoCommitPop(&g_TxFifo, IPC_TRANSFER_LEN);
+        g_TxSlot = g_TxBuff;
+    }
+
     if (IPC_Frame_Check(Frame))
     {
         /* Pushes data to Rx FIFO buffer */
-        FifoPushMulti(&g_RxFifo, g_RxBuff, IPC_TRANSFER_LEN);
+        if (g_RxSlot != g_RxBuff)
+        {
+            FifoCommitPush(&g_RxFifo, IPC_TRANSFER_LEN);
+        }
+        else
+        {
+            FifoPushMulti(&g_RxFifo, g_RxBuff, IPC_TRANSFER_LEN);
+        }
 
         /* Notify data received handler */
         SetEvent(TaskIPC, evIPCDataReceived);
     }
 
 #ifndef SPI_MASTER
-    /* Reset IPC slaver transmit buffer */
-    memset(g_TxBuff, 0, IPC_TRANSFER_LEN + 1);
-
-    /* Fetch data from Tx FIFO buffer */
-    FifoPopMulti(&g_TxFifo, g_TxBuff, IPC_TRANSFER_LEN);
-
     /* Slaver transfer request SPI DMA queue */
     IPC_SPITransferQueue();
 #endif
@@ -157,12 +197,6 @@ static void IPC_ManageSPIMasterTransmit(EventMaskType eventMask)
         /* Check if SPI slaver is free */
         if(SPI_RequestInGetStatus())
         {
-            /* Reset IPC transmit buffer */
-            memset(g_TxBuff, 0, IPC_TRANSFER_LEN + 1);
-
-            /* Fetch data from Tx FIFO buffer */
-            FifoPopMulti(&g_TxFifo, g_TxBuff, IPC_TRANSFER_LEN);
-
             /* Master transfer request SPI DMA queue */
             IPC_SPITransferQueue();
         }
@@ -208,13 +242,14 @@ static void IPC_ManageDataReceived(EventMaskType eventMask)
  */
 void IPC_Send(uint8_t *Data, uint16_t Len)
 {
-    IPC_Frame_t *Frame = (IPC_Frame_t *)g_TmpBuff;
+    uint8_t *Frame;
 
-    if(FifoGetFreeSize(&g_TxFifo) >= IPC_TRANSFER_LEN)
+    /* The frame is created in Tx FIFO storage */
+    if(FifoReservePush(&g_TxFifo, &Frame) >= IPC_TRANSFER_LEN)
     {
-        if(IPC_Frame_Create(Frame, Data, Len))
+        if(IPC_Frame_Create((IPC_Frame_t *)Frame, Data, Len))
         {
-            FifoPushMulti(&g_TxFifo, (uint8_t *)Frame, IPC_TRANSFER_LEN);
+            FifoCommitPush(&g_TxFifo, IPC_TRANSFER_LEN);
         }
     }
 }
@@ -284,6 +284,10 @@ else
 
 #define READYLISTS_COUNT <?php echo count($priority); ?>
 
+
+/** \brief Count of words of the ready bitmap, one bit for each ready list */
+#define READYMAP_COUNT <?php echo intval((count($priority) + 31) / 32); ?>
+
 #define SetError_Api(api)   ( Osek_ErrorApi = (api) )
 #define SetError_Param1(param1) ( Osek_ErrorParam1 = (param1) )
 #define SetError_Param2(param2) ( Osek_ErrorParam2 = (param2) )
@@ -321,6 +325,9 @@ foreach ($counters as $counter)
 	$count++;
 }
 
+print "/** \brief COUNTERS_COUNT define */\n";
+print "#define COUNTERS_COUNT " . count($counters) . "\n\n";
+
 $alarms = $config->getList("/OSEK","ALARM");
 print "/** \brief ALARMS_COUNT define */\n";
 print "#define ALARMS_COUNT " . count($alarms) . "\n\n";
@@ -470,6 +477,14 @@ typedef struct {
 	TaskTotalType ListCount;
 } ReadyVarType;
 
+/** \brief Ready Bitmap Type
+ **
+ ** A bit for each ready list, set while one or more tasks are on the list.
+ ** The ready list 0 is the most significant bit of the first word, the
+ ** ready list 1 the next one and so on.
+ **/
+typedef uint32 ReadyMapType;
+
 /** \brief Alarm State
  **
  ** This type defines the possibly states of one alarm which are:
@@ -478,7 +493,10 @@ typedef struct {
  **/
 typedef uint8 AlarmStateType;
 
-/** \brief Alarm Time */
+/** \brief Alarm Time
+ **
+ ** The expiration of an alarm, on the ticks of its counter
+ **/
 typedef uint32 AlarmTimeType;
 
 /** \brief Alarm Cycle Time */
@@ -512,11 +530,18 @@ typedef struct {
 	CounterType Counter;
 } AlarmActionInfoType;
 
-/** \brief Alarm Variable Type */
+/** \brief Alarm Variable Type
+ **
+ ** \param AlarmState 1 if the alarm is set
+ ** \param AlarmTime ticks of the counter at which the alarm expires
+ ** \param AlarmCycleTime cycle of the alarm, 0 if it is not cyclic
+ ** \param NextAlarm next alarm in the queue of the counter
+ **/
 typedef struct {
 	AlarmStateType AlarmState;
 	AlarmTimeType AlarmTime;
 	AlarmCycleTimeType AlarmCycleTime;
+	AlarmType NextAlarm;
 } AlarmVarType;
 
 /** \brief Alarm Constant Type */
@@ -542,8 +567,18 @@ typedef struct {
 	TickType TicksPerBase;
 } CounterConstType;
 
+/** \brief Counter Variable Type
+ **
+ ** \param Time value of the counter, up to the max allowed value
+ ** \param Ticks increments of the counter since the os was started, the
+ **              alarm expirations are kept on them
+ ** \param FirstAlarm first alarm in the queue of the alarms set on this
+ **                   counter, sorted by expiration, or INVALID_ALARM
+ **/
 typedef struct {
 	TickType Time;
+	AlarmTimeType Ticks;
+	AlarmType FirstAlarm;
 } CounterVarType;
 
 /*==================[external data declaration]==============================*/
@@ -612,6 +647,8 @@ print "/** \brief Ready Const List */\n";
 print "extern const ReadyConstType ReadyConst[" . count($priority) .  "];\n\n";
 print "/** \brief Ready Variable List */\n";
 print "extern ReadyVarType ReadyVar[" . count($priority) . "];\n\n";
+print "/** \brief Ready Bitmap */\n";
+print "extern ReadyMapType ReadyMap[READYMAP_COUNT];\n\n";
 
 $resources = $config->getList("/OSEK","RESOURCE");
 print "/** \brief Resources Priorities */\n";
@@ -307,6 +307,9 @@ print "\n};\n\n";
 print "/** TODO replace next line with: \n";
 print " ** ReadyVarType ReadyVar[" . count($priority) . "] ; */\n";
 print "ReadyVarType ReadyVar[" . count($priority) . "];\n";
+
+print "/** \brief Ready Bitmap */\n";
+print "ReadyMapType ReadyMap[READYMAP_COUNT];\n";
 ?>
 
 <?php
@@ -83,6 +83,12 @@
 /** \brief Invalid Task */
 #define INVALID_TASK  ((TaskType)~0)
 
+/** \brief Invalid Alarm
+ **
+ ** Marks the end of the alarm queue of a counter
+ **/
+#define INVALID_ALARM ((AlarmType)~0)
+
 /** \brief State for Suspended Tasks */
 #define TASK_ST_SUSPENDED	SUSPENDED
 
@@ -248,6 +254,26 @@ extern void OSEK_ISR_NoHandler(void);
  **/
 extern CounterIncrementType IncrementCounter(CounterType CounterID, CounterIncrementType Increment);
 
+/** \brief Insert Alarm
+ **
+ ** This function sets the expiration of an alarm and puts it in the alarm
+ ** queue of its counter, which is sorted by expiration. The alarm shall not
+ ** be in the queue already.
+ **
+ ** \param[in] AlarmID id of the alarm
+ ** \param[in] Expiration value of the Ticks of the counter at which the
+ **            alarm expires
+ **/
+extern void InsertAlarm(AlarmType AlarmID, AlarmTimeType Expiration);
+
+/** \brief Remove Alarm
+ **
+ ** This function takes an alarm out of the alarm queue of its counter.
+ **
+ ** \param[in] AlarmID id of the alarm
+ **/
+extern void RemoveAlarm(AlarmType AlarmID);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
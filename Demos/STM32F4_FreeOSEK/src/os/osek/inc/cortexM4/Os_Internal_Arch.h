@@ -246,6 +246,51 @@ extern TaskType TerminatingTask;
  **/
 #define GetCounter_Arch(CounterID) (CountersVar[CounterID].Time)
 
+/** \brief Count Leading Zeros Arch
+ **
+ ** This macro returns the count of leading zero bits of a 32 bits value
+ ** which is not zero, it is a single clz instruction on the Cortex-M4.
+ **
+ ** \param[in] value value to be checked, shall not be 0
+ ** \return count of zero bits over the most significant bit set
+ **/
+#define Clz_Arch(value) ((uint8)__builtin_clz(value))
+
+/** \brief Counter incremented by the SysTick */
+#define SYSTICK_COUNTER_ARCH 0
+
+/** \brief Tickless SysTick
+ **
+ ** With OSEK_ENABLE the SysTick does not interrupt on every tick of its
+ ** counter but only when the next alarm of the counter expires, or after
+ ** the longest period it can count. With OSEK_DISABLE it interrupts on
+ ** every tick.
+ **/
+#define TICKLESS_ARCH OSEK_ENABLE
+
+#if (TICKLESS_ARCH == OSEK_ENABLE)
+/** \brief Update Counter Arch
+ **
+ ** This macro is called before the alarms of a counter are read or set, to
+ ** add the ticks elapsed since the last SysTick interrupt to the counter.
+ **
+ ** \param[in] CounterID id of the counter
+ **/
+#define UpdateCounter_Arch(CounterID) UpdateCounterTickless_Arch(CounterID)
+
+/** \brief Alarms Changed Arch
+ **
+ ** This macro is called after an alarm has been set on a counter, to bring
+ ** the next SysTick interrupt forward if the alarm expires before it.
+ **
+ ** \param[in] CounterID id of the counter
+ **/
+#define AlarmsChanged_Arch(CounterID) AlarmsChangedTickless_Arch(CounterID)
+#else /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
+#define UpdateCounter_Arch(CounterID)
+#define AlarmsChanged_Arch(CounterID)
+#endif /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
+
 /** \brief Pre ISR Macro
  **
  ** This macro is called every time that an ISR Cat 2 is started
@@ -285,6 +330,21 @@ extern TaskType TerminatingTask;
 /*==================[external functions declaration]=========================*/
 void InitStack_Arch(uint8 TaskID);
 
+#if (TICKLESS_ARCH == OSEK_ENABLE)
+/** \brief Start the tickless SysTick
+ **
+ ** This function is called once the SysTick has been started for one tick
+ ** per period.
+ **/
+void StartOs_Arch_Tickless(void);
+
+/** \brief Add the ticks elapsed in the SysTick period to the counter */
+void UpdateCounterTickless_Arch(uint8 CounterID);
+
+/** \brief Shorten the SysTick period to the first alarm of the counter */
+void AlarmsChangedTickless_Arch(uint8 CounterID);
+#endif /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
+
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,235 @@
+/* Copyright 2014, ACSE & CADIEEL
+ *      ACSE: http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *      CADIEEL: http://www.cadieel.org.ar
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef _OS_INTERNAL_ARCH_H_
+#define _OS_INTERNAL_ARCH_H_
+
+/** \brief FreeOSEK Internal Architecture Dependent Header File
+ **
+ ** The tasks run on their own stacks in one posix process, a context switch
+ ** is a swap of the ucontext of the tasks. This lets the OS be built and
+ ** measured on a host.
+ **
+ ** \file posix/Os_Internal_Arch.h
+ ** \arch posix
+ **/
+
+/** \addtogroup FreeOSEK
+ ** @{ */
+/** \addtogroup FreeOSEK_Os
+ ** @{ */
+/** \addtogroup FreeOSEK_Os_Internal
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+
+/*==================[macros]=================================================*/
+extern TaskType TerminatingTask;
+
+/** \brief Interrupt Secure Start Macro
+ **
+ ** This macro will be used internaly by the OS in any part of code that
+ ** has to be executed atomic.
+ **/
+#define IntSecure_Start() SuspendAllInterrupts()
+
+/** \brief Interrupt Secure End Macro
+ **
+ ** This macro is the countra part of IntSecure_Start()
+ **/
+#define IntSecure_End() ResumeAllInterrupts()
+
+/** \brief osekpause
+ **
+ ** This macro is called by the scheduler when not task has to be executed.
+ ** It sleeps until the next tick of the SysTick counter and takes it.
+ **/
+#define osekpause()	Idle_Arch()
+
+/** \brief Call to an other Task
+ **
+ ** This function saves the context of the actual task and jmps to the
+ ** indicated task.
+ **/
+#define CallTask(actualtask, nexttask) CallTask_Arch((actualtask), (nexttask))
+
+/** \brief Jmp to an other Task
+ **
+ ** This function jmps to the indicated task.
+ **/
+#define JmpTask(task) JmpTask_Arch(task)
+
+/** \brief Save context */
+#define SaveContext(task)                                                  \
+{                                                                          \
+   extern TaskType WaitingTask;                                            \
+   if(TasksVar[GetRunningTask()].Flags.State == TASK_ST_WAITING)           \
+   {                                                                       \
+      WaitingTask = GetRunningTask();                                      \
+   }                                                                       \
+   flag = 0;                                                               \
+   /* remove of the Ready List */                                          \
+   RemoveTask(GetRunningTask());                                           \
+   /* set system context */                                                \
+   SetActualContext(CONTEXT_SYS);                                          \
+   /* set running task to invalid */                                       \
+   SetRunningTask(INVALID_TASK);                                           \
+   /* finish cirtical code */                                              \
+   IntSecure_End();                                                        \
+   /* call scheduler */                                                    \
+   Schedule();                                                             \
+   /* add this call in order to maintain counter balance when returning */ \
+   IntSecure_Start();                                                      \
+}
+
+/** \brief */
+#define ResetStack(task)		\
+{								      \
+	TerminatingTask = (task);	\
+}
+
+/** \brief Set the entry point for a task */
+#define SetEntryPoint(task)   \
+{								      \
+	TerminatingTask = (task);	\
+}
+
+/** \brief Enable OS Interruptions */
+#define EnableOSInterrupts()
+
+/** \brief Enable Interruptions */
+#define EnableInterrupts()	EnableOSInterrupts()
+
+/** \brief Disable OS Interruptions */
+#define DisableOSInterrupts()
+
+/** \brief Disable Interruptions */
+#define DisableInterrupts()	DisableOSInterrupts()
+
+/** \brief Get Counter Actual Value
+ **
+ ** This macro returns the actual value of the a counter
+ **
+ ** \param[in] CounterID id of the counter to be readed
+ ** \return Actual value of the counter
+ **/
+#define GetCounter_Arch(CounterID) (CountersVar[CounterID].Time)
+
+/** \brief Count Leading Zeros Arch
+ **
+ ** This macro returns the count of leading zero bits of a 32 bits value
+ ** which is not zero.
+ **
+ ** \param[in] value value to be checked, shall not be 0
+ ** \return count of zero bits over the most significant bit set
+ **/
+#define Clz_Arch(value) ((uint8)__builtin_clz(value))
+
+/** \brief Counter incremented by the SysTick */
+#define SYSTICK_COUNTER_ARCH 0
+
+/** \brief SysTick period in nanoseconds */
+#define SYSTICK_PERIOD_NS_ARCH 1000000
+
+/** \brief Tickless SysTick
+ **
+ ** The SysTick only ticks while the OS is idle, the time the tasks run is
+ ** not counted. There is no tickless mode.
+ **/
+#define TICKLESS_ARCH OSEK_DISABLE
+
+/** \brief Update Counter Arch */
+#define UpdateCounter_Arch(CounterID)
+
+/** \brief Alarms Changed Arch */
+#define AlarmsChanged_Arch(CounterID)
+
+/** \brief Pre ISR Macro
+ **
+ ** This macro is called every time that an ISR Cat 2 is started
+ **/
+#define PreIsr2_Arch(isr)
+
+/** \brief Post ISR Macro
+ **
+ ** This macro is called every time that an ISR Cat 2 is finished
+ **/
+#define PostIsr2_Arch(isr) Schedule()
+
+/** \brief ShutdownOs Arch service
+ **
+ ** This macro is called on the ShutdownOS to perform the architecture
+ ** dependent shutdown actions.
+ **/
+#define ShutdownOs_Arch()
+
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/** \brief Set a task to start from its entry point
+ **
+ ** The context of the task shall have been got with getcontext before.
+ **
+ ** \param[in] TaskID task to be set
+ **/
+void InitStack_Arch(uint8 TaskID);
+
+/** \brief Save the context of a task and continue another one
+ **
+ ** Returns when the saved task is continued.
+ **
+ ** \param[in] OldTask task which is saved
+ ** \param[in] NewTask task to be continued
+ **/
+void CallTask_Arch(TaskType OldTask, TaskType NewTask);
+
+/** \brief Continue a task
+ **
+ ** The context of the waiting task is saved, if there is one. In other case
+ ** the running task has terminated and this function does not return.
+ **
+ ** \param[in] NewTask task to be continued
+ **/
+void JmpTask_Arch(TaskType NewTask);
+
+/** \brief Wait for the next tick of the SysTick and take it */
+void Idle_Arch(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+#endif /* #ifndef _OS_INTERNAL_ARCH_H_ */
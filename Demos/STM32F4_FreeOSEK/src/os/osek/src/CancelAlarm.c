@@ -109,8 +109,15 @@ StatusType CancelAlarm
 	}
 	else
 	{
+		IntSecure_Start();
+
 		/* \req OSEK_SYS_3.23.1 The system service shall cancel the alarm AlarmID */
 		AlarmsVar[AlarmID].AlarmState = 0;
+
+		/* take it out of the alarm queue of its counter */
+		RemoveAlarm(AlarmID);
+
+		IntSecure_End();
 	}
 
 #if (HOOK_ERRORHOOK == OSEK_ENABLE)
@@ -113,9 +113,16 @@ StatusType GetAlarm
 	else
 
 	{
+		IntSecure_Start();
+
+		/* bring the counter up to date */
+		UpdateCounter_Arch(AlarmsConst[AlarmID].Counter);
+
 		/* \req OSEK_SYS_3.20.1 The system service GetAlarm shall return the
 		 ** relative value in ticks before the alarm AlarmID expires */
-		*Tick = AlarmsVar[AlarmID].AlarmTime;
+		*Tick = AlarmsVar[AlarmID].AlarmTime - CountersVar[AlarmsConst[AlarmID].Counter].Ticks;
+
+		IntSecure_End();
 	}
 
 #if (HOOK_ERRORHOOK == OSEK_ENABLE)
@@ -70,6 +70,15 @@
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
+#if (ALARMS_COUNT != 0)
+/** \brief Expire Alarm
+ **
+ ** This function executes the action of an alarm which has expired.
+ **
+ ** \param[in] AlarmID id of the alarm
+ **/
+static void ExpireAlarm(AlarmType AlarmID);
+#endif /* #if (ALARMS_COUNT != 0) */
 
 /*==================[internal data definition]===============================*/
 
@@ -79,6 +88,40 @@ TaskType RunningTask;
 ContextType ActualContext;
 
 /*==================[internal functions definition]==========================*/
+#if (ALARMS_COUNT != 0)
+static void ExpireAlarm(AlarmType AlarmID)
+{
+	/* check alarm actions */
+	switch(AlarmsConst[AlarmID].AlarmAction)
+	{
+		case INCREMENT:
+			/* increment the counter driven by this alarm */
+			(void)IncrementCounter(AlarmsConst[AlarmID].AlarmActionInfo.Counter, 1);
+			break;
+		case ACTIVATETASK:
+			/* activate task */
+			ActivateTask(AlarmsConst[AlarmID].AlarmActionInfo.TaskID);
+			break;
+		case ALARMCALLBACK:
+			/* callback */
+			if(AlarmsConst[AlarmID].AlarmActionInfo.CallbackFunction != NULL)
+			{
+				AlarmsConst[AlarmID].AlarmActionInfo.CallbackFunction();
+			}
+			break;
+#if (NO_EVENTS == OSEK_DISABLE)
+		case SETEVENT:
+			/* set event */
+			SetEvent(AlarmsConst[AlarmID].AlarmActionInfo.TaskID, AlarmsConst[AlarmID].AlarmActionInfo.Event);
+			break;
+#endif /* #if (NO_EVENTS == OSEK_DISABLE) */
+		default:
+			/* some error */
+			/* possibly TODO, report an error */
+			break;
+	}
+}
+#endif /* #if (ALARMS_COUNT != 0) */
 
 /*==================[external functions definition]==========================*/
 void AddReady(TaskType TaskID)
@@ -120,6 +163,9 @@ void AddReady(TaskType TaskID)
 	readylist[position] = TaskID;
 	/* increment the list counter */
 	ReadyVar[priority].ListCount++;
+
+	/* mark the ready list as not empty */
+	ReadyMap[priority >> 5] |= (ReadyMapType)0x80000000U >> (priority & 31);
 }
 
 void RemoveTask
@@ -154,6 +200,12 @@ void RemoveTask
 
 	/* decrement the count of ready tasks */
 	ReadyVar[priority].ListCount--;
+
+	/* mark the ready list as empty if it was the last task */
+	if (ReadyVar[priority].ListCount == 0)
+	{
+		ReadyMap[priority >> 5] &= ~((ReadyMapType)0x80000000U >> (priority & 31));
+	}
 }
 
 TaskType GetNextTask
@@ -168,17 +220,21 @@ TaskType GetNextTask
 #endif /* #if (RESOURCES_COUNT != 0) */
 
 	uint8f loopi;
+	uint8f list;
 	boolean found = FALSE;
 	TaskType ret = INVALID_TASK;
 
-	/* check in all ready lists */
-	for (loopi = 0; ( loopi < READYLISTS_COUNT ) && (!found) ; loopi++)
+	/* check the ready bitmap, the first list of each word is on its most
+	 * significant bit so the leading zeros give the highest priority list
+	 * with one or more tasks ready */
+	for (loopi = 0; ( loopi < READYMAP_COUNT ) && (!found) ; loopi++)
 	{
-		/* if one or more tasks are ready */
-		if (ReadyVar[loopi].ListCount > 0)
+		if (ReadyMap[loopi] != 0)
 		{
+			list = ( loopi << 5 ) + Clz_Arch(ReadyMap[loopi]);
+
 			/* return the first ready task */
-			ret = ReadyConst[loopi].TaskRef[ReadyVar[loopi].ListStart];
+			ret = ReadyConst[list].TaskRef[ReadyVar[list].ListStart];
 
 			/* set found true */
 			found = TRUE;
@@ -219,121 +275,50 @@ void OSEK_ISR_NoHandler(void)
 	while(1);
 }
 
-#if (ALARMS_COUNT != 0)
-AlarmIncrementType IncrementAlarm(AlarmType AlarmID, AlarmIncrementType Increment)
+void InsertAlarm(AlarmType AlarmID, AlarmTimeType Expiration)
 {
-	AlarmIncrementType RestIncrements;
-	AlarmIncrementType AlarmCount;
-	CounterIncrementType CounterIncrement;
+	AlarmType* link;
 
-	/* init arlarms count */
-	AlarmCount = 0;
+	/* set the absolute expiration time */
+	AlarmsVar[AlarmID].AlarmTime = Expiration;
 
-	/* check if the increment is smaller than the expiration time */
-	if ( AlarmsVar[AlarmID].AlarmTime > Increment )
+	/* look for the first alarm expiring later, alarms expiring together
+	 * stay in the order they were set */
+	link = &CountersVar[AlarmsConst[AlarmID].Counter].FirstAlarm;
+	while ( ( *link != INVALID_ALARM ) &&
+			  ( (sint32)(AlarmsVar[*link].AlarmTime - Expiration) <= 0 ) )
 	{
-		/* decrement the alarm*/
-		AlarmsVar[AlarmID].AlarmTime -= Increment;
-
-		/* alarm doesn't expires now */
-		RestIncrements = AlarmsVar[AlarmID].AlarmTime;
+		link = &AlarmsVar[*link].NextAlarm;
 	}
-	else
-	{
-		/* increment is graeter or equal than the alarm time, the alarm may
-			expire one or more times */
-
-		/* check if new alarm time has to be set */
-		if(AlarmsVar[AlarmID].AlarmCycleTime == 0)
-		{
-			/* in case of a non cyclic alarm */
-
-			/* alarm has expires 1 time */
-			AlarmCount = 1;
-
-			/* set alarm to 0 */
-			AlarmsVar[AlarmID].AlarmTime = 0;
-
-			/* disable alarm */
-			AlarmsVar[AlarmID].AlarmState = 0;
-
-			/* set rest increments to zero */
-			RestIncrements = 0;
-		}
-		else
-		{
-			/* the alarm is cyclic */
-
-			/* decrement alarm */
-			while ( AlarmsVar[AlarmID].AlarmTime <= Increment )
-			{
-				/* add cycle time */
-				AlarmsVar[AlarmID].AlarmTime += AlarmsVar[AlarmID].AlarmCycleTime;
-
-				/* increment Alarms expiration times */
-				AlarmCount++;
-			}
 
-			/* decrement the increments of this alarm */
-			AlarmsVar[AlarmID].AlarmTime -= Increment;
-
-			/* store the rest increments */
-			RestIncrements = AlarmsVar[AlarmID].AlarmTime;
-		}
+	/* link the alarm in front of it */
+	AlarmsVar[AlarmID].NextAlarm = *link;
+	*link = AlarmID;
+}
 
-		if (AlarmsConst[AlarmID].AlarmAction == INCREMENT)
-		{
-			/* call counter function */
-			CounterIncrement = IncrementCounter(AlarmsConst[AlarmID].AlarmActionInfo.Counter, AlarmCount);
+void RemoveAlarm(AlarmType AlarmID)
+{
+	AlarmType* link;
 
-			/* re-calculate the rest of the increments */
-			RestIncrements += AlarmsVar[AlarmID].AlarmCycleTime * ( CounterIncrement-1 );
-		}
-		else
-		{
-			/* execute the alarm so many times as needed */
-			for ( ;AlarmCount > 0; AlarmCount--)
-			{
-				/* check alarm actions differents to INCREMENT */
-				switch(AlarmsConst[AlarmID].AlarmAction)
-				{
-					case ACTIVATETASK:
-						/* activate task */
-						ActivateTask(AlarmsConst[AlarmID].AlarmActionInfo.TaskID);
-						break;
-					case ALARMCALLBACK:
-						/* callback */
-						if(AlarmsConst[AlarmID].AlarmActionInfo.CallbackFunction != NULL)
-						{
-							AlarmsConst[AlarmID].AlarmActionInfo.CallbackFunction();
-						}
-						break;
-#if (NO_EVENTS == OSEK_DISABLE)
-					case SETEVENT:
-						/* set event */
-						SetEvent(AlarmsConst[AlarmID].AlarmActionInfo.TaskID, AlarmsConst[AlarmID].AlarmActionInfo.Event);
-						break;
-#endif /* #if (NO_EVENTS == OSEK_DISABLE) */
-					default:
-						/* some error */
-						/* possibly TODO, report an error */
-						break;
-				}
-			}
-		}
+	/* look for the alarm in the queue of its counter */
+	link = &CountersVar[AlarmsConst[AlarmID].Counter].FirstAlarm;
+	while ( ( *link != INVALID_ALARM ) && ( *link != AlarmID ) )
+	{
+		link = &AlarmsVar[*link].NextAlarm;
 	}
 
-	return RestIncrements;
+	/* unlink it */
+	if (*link == AlarmID)
+	{
+		*link = AlarmsVar[AlarmID].NextAlarm;
+	}
 }
-#endif /* #if (ALARMS_COUNT != 0) */
 
 #if (ALARMS_COUNT != 0)
 CounterIncrementType IncrementCounter(CounterType CounterID, CounterIncrementType Increment)
 {
-	uint8f loopi;
 	AlarmType AlarmID;
 	AlarmIncrementType MinimalCount = -1;
-	AlarmIncrementType TmpCount;
 
 	/* increment counter */
 	CountersVar[CounterID].Time+=Increment;
@@ -345,25 +330,41 @@ CounterIncrementType IncrementCounter(CounterType CounterID, CounterIncrementTyp
 		CountersVar[CounterID].Time -= CountersConst[CounterID].MaxAllowedValue;
 	}
 
-	/* for alarms on this counter */
-	for(loopi = 0; loopi < CountersConst[CounterID].AlarmsCount; loopi++)
+	/* the alarms expire against the ticks, which do not overflow at the
+	 * max allowed value */
+	CountersVar[CounterID].Ticks += Increment;
+
+	/* the queue is sorted, so only the alarms at its head may expire */
+	AlarmID = CountersVar[CounterID].FirstAlarm;
+	while ( ( AlarmID != INVALID_ALARM ) &&
+			  ( (sint32)(AlarmsVar[AlarmID].AlarmTime - CountersVar[CounterID].Ticks) <= 0 ) )
 	{
-		/* get alarm id */
-		AlarmID = CountersConst[CounterID].AlarmRef[loopi];
+		/* take the alarm out of the queue */
+		CountersVar[CounterID].FirstAlarm = AlarmsVar[AlarmID].NextAlarm;
 
-		/* check if the alarm is eanble */
-		if (AlarmsVar[AlarmID].AlarmState == 1)
+		/* check if new alarm time has to be set */
+		if(AlarmsVar[AlarmID].AlarmCycleTime == 0)
 		{
-			/* increment alarm and get the next alarm time */
-			TmpCount = IncrementAlarm(AlarmID, Increment);
-
-			/* if the actual count is smaller */
-			if (MinimalCount > TmpCount)
-			{
-				/* set it as minimal count */
-				MinimalCount = TmpCount;
-			}
+			/* disable alarm */
+			AlarmsVar[AlarmID].AlarmState = 0;
 		}
+		else
+		{
+			/* a cyclic alarm goes back into the queue, if the increment
+			 * was longer than its cycle it expires again in this loop */
+			InsertAlarm(AlarmID, AlarmsVar[AlarmID].AlarmTime + AlarmsVar[AlarmID].AlarmCycleTime);
+		}
+
+		/* execute the alarm action */
+		ExpireAlarm(AlarmID);
+
+		AlarmID = CountersVar[CounterID].FirstAlarm;
+	}
+
+	/* the next alarm to expire */
+	if (AlarmID != INVALID_ALARM)
+	{
+		MinimalCount = AlarmsVar[AlarmID].AlarmTime - CountersVar[CounterID].Ticks;
 	}
 
 	/* return the minimal increment */
@@ -95,6 +95,8 @@ StatusType SetAbsAlarm
 	/* \req OSEK_SYS_3.22.3-1/2 Possible return values in Standard mode are E_OK,
 	 ** E_OS_STATE */
 	StatusType ret = E_OK;
+	TickType Counter;
+	TickType Increment;
 
 #if (ERROR_CHECKING_TYPE == ERROR_CHECKING_EXTENDED)
 	/* check if the alarm id is in range */
@@ -125,15 +127,32 @@ StatusType SetAbsAlarm
    }
 	else
 	{
-
 		IntSecure_Start();
 
+		/* bring the counter up to date */
+		UpdateCounter_Arch(AlarmsConst[AlarmID].Counter);
+
+		/* increments until the counter reaches start, if it is there
+		 * already the alarm expires when it comes back to it */
+		Counter = GetCounter(AlarmsConst[AlarmID].Counter);
+		if (Start > Counter)
+		{
+			Increment = Start - Counter;
+		}
+		else
+		{
+			Increment = Start + CountersConst[AlarmsConst[AlarmID].Counter].MaxAllowedValue - Counter;
+		}
+
 		/* enable alarm */
 		AlarmsVar[AlarmID].AlarmState = 1;
 
 		/* set abs alarm */
-		AlarmsVar[AlarmID].AlarmTime = GetCounter(AlarmsConst[AlarmID].Counter) + Start;
 		AlarmsVar[AlarmID].AlarmCycleTime = Cycle;
+		InsertAlarm(AlarmID, CountersVar[AlarmsConst[AlarmID].Counter].Ticks + Increment);
+
+		/* the alarm may expire before the next counter interrupt */
+		AlarmsChanged_Arch(AlarmsConst[AlarmID].Counter);
 
 		IntSecure_End();
 	}
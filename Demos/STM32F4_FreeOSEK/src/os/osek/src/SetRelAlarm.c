@@ -125,12 +125,18 @@ StatusType SetRelAlarm
 	{
 		IntSecure_Start();
 
+		/* bring the counter up to date */
+		UpdateCounter_Arch(AlarmsConst[AlarmID].Counter);
+
 		/* enable alarm */
 		AlarmsVar[AlarmID].AlarmState = 1;
 
 		/* set alarm */
-		AlarmsVar[AlarmID].AlarmTime = Increment;
 		AlarmsVar[AlarmID].AlarmCycleTime = Cycle;
+		InsertAlarm(AlarmID, CountersVar[AlarmsConst[AlarmID].Counter].Ticks + Increment);
+
+		/* the alarm may expire before the next counter interrupt */
+		AlarmsChanged_Arch(AlarmsConst[AlarmID].Counter);
 
 		IntSecure_End();
 	}
@@ -98,6 +98,14 @@ void StartOS
 	/* save the aplication mode */
 	ApplicationMode = Mode;
 
+#if (ALARMS_COUNT != 0)
+	/* no alarms are set on any counter */
+	for (loopi = 0; loopi < COUNTERS_COUNT; loopi++)
+	{
+		CountersVar[loopi].FirstAlarm = INVALID_ALARM;
+	}
+#endif /* #if (ALARMS_COUNT != 0) */
+
 	/* StartOs_Arch */
 	StartOs_Arch();
 
@@ -59,6 +59,12 @@
 #include "Os_Internal.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief Fewest SysTick cycles to an interrupt
+ **
+ ** A period which has already run out when it is programmed is cut down to
+ ** this, so that it still ends with an interrupt.
+ **/
+#define TICKLESS_MIN_CYCLES_ARCH 64
 
 /*==================[internal data declaration]==============================*/
 
@@ -72,9 +78,85 @@ void* Osek_OldTaskPtr_Arch;
 TaskType TerminatingTask = INVALID_TASK;
 TaskType WaitingTask = INVALID_TASK;
 
+#if ((TICKLESS_ARCH == OSEK_ENABLE) && (ALARMS_COUNT != 0))
+/** \brief SysTick cycles per tick of the counter */
+static uint32 TickCycles;
+
+/** \brief Most ticks in one SysTick period */
+static CounterIncrementType TickMax;
+
+/** \brief Ticks from the start of the SysTick period to its interrupt */
+static CounterIncrementType TickPeriod;
+
+/** \brief Ticks of the SysTick period already added to the counter */
+static CounterIncrementType TickDone;
+
+/** \brief Cycles of the SysTick period before the SysTick was reloaded
+ **
+ ** The period starts at the interrupt, when the period is changed the
+ ** SysTick is reloaded and starts counting again from there.
+ **/
+static uint32 TickSkew;
+
+/** \brief Set while the SysTick handler increments the counter */
+static boolean TickHandlerRunning;
+#endif /* #if ((TICKLESS_ARCH == OSEK_ENABLE) && (ALARMS_COUNT != 0)) */
+
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+#if ((TICKLESS_ARCH == OSEK_ENABLE) && (ALARMS_COUNT != 0))
+/** \brief Cycles of the SysTick period elapsed */
+static uint32 TickElapsed(void)
+{
+	return TickSkew + (SysTick->LOAD - SysTick->VAL);
+}
+
+/** \brief Set the SysTick period
+ **
+ ** Sets the period which started at the last interrupt to end Ticks ticks
+ ** after it.
+ **
+ ** \param[in] Ticks ticks from the start of the period
+ **/
+static void SetTickPeriod(CounterIncrementType Ticks)
+{
+	uint32 elapsed;
+	uint32 cycles;
+
+	if (Ticks > TickMax)
+	{
+		Ticks = TickMax;
+	}
+
+	elapsed = TickElapsed();
+	cycles = Ticks * TickCycles;
+	if (cycles < (elapsed + TICKLESS_MIN_CYCLES_ARCH))
+	{
+		cycles = elapsed + TICKLESS_MIN_CYCLES_ARCH;
+	}
+
+	/* reload the SysTick now with the rest of the period */
+	SysTick->LOAD = cycles - elapsed - 1;
+	SysTick->VAL = 0;
+
+	TickSkew = elapsed;
+	TickPeriod = Ticks;
+}
+
+/** \brief The SysTick may be reprogrammed
+ **
+ ** Not from its own handler, which sets the next period once the counter
+ ** is up to date, nor while its interrupt is pending, since the period has
+ ** ended and the handler has not yet added it to the counter.
+ **/
+static boolean TickChangeable(uint8 CounterID)
+{
+	return ( ( CounterID == SYSTICK_COUNTER_ARCH ) &&
+				( !TickHandlerRunning ) &&
+				( 0 == ( SCB->ICSR & SCB_ICSR_PENDSTSET_Msk ) ) );
+}
+#endif /* #if ((TICKLESS_ARCH == OSEK_ENABLE) && (ALARMS_COUNT != 0)) */
 
 /*==================[external functions definition]==========================*/
 
@@ -113,6 +195,80 @@ void InitStack_Arch(uint8 TaskID)
 
 }
 
+#if (TICKLESS_ARCH == OSEK_ENABLE)
+void StartOs_Arch_Tickless(void)
+{
+#if (ALARMS_COUNT != 0)
+	/* the SysTick has been started for one tick */
+	TickCycles = SysTick->LOAD + 1;
+	TickMax = (SysTick_LOAD_RELOAD_Msk + 1) / TickCycles;
+	TickPeriod = 1;
+	TickDone = 0;
+	TickSkew = 0;
+	TickHandlerRunning = FALSE;
+#endif /* #if (ALARMS_COUNT != 0) */
+}
+
+void UpdateCounterTickless_Arch(uint8 CounterID)
+{
+#if (ALARMS_COUNT != 0)
+	CounterIncrementType done;
+
+	if (TickChangeable(CounterID))
+	{
+		/* whole ticks elapsed in this period */
+		done = TickElapsed() / TickCycles;
+		if (done > TickPeriod)
+		{
+			done = TickPeriod;
+		}
+
+		/* no alarm expires before the end of the period, this only moves
+		 * the counter on */
+		if (done > TickDone)
+		{
+			(void)IncrementCounter(CounterID, done - TickDone);
+			TickDone = done;
+		}
+	}
+#else
+	(void)CounterID;
+#endif /* #if (ALARMS_COUNT != 0) */
+}
+
+void AlarmsChangedTickless_Arch(uint8 CounterID)
+{
+#if (ALARMS_COUNT != 0)
+	AlarmType AlarmID;
+	CounterIncrementType next;
+
+	if (TickChangeable(CounterID))
+	{
+		AlarmID = CountersVar[CounterID].FirstAlarm;
+		if (AlarmID != INVALID_ALARM)
+		{
+			/* ticks from now to the first alarm, an alarm set to expire now
+			 * expires on the next tick */
+			next = AlarmsVar[AlarmID].AlarmTime - CountersVar[CounterID].Ticks;
+			if ( ( next == 0 ) || ( (sint32)next < 0 ) )
+			{
+				next = 1;
+			}
+
+			/* only bring the interrupt forward, a later one just finds
+			 * nothing to do */
+			if ((TickDone + next) < TickPeriod)
+			{
+				SetTickPeriod(TickDone + next);
+			}
+		}
+	}
+#else
+	(void)CounterID;
+#endif /* #if (ALARMS_COUNT != 0) */
+}
+#endif /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
+
 /* Periodic Interrupt Timer, included in all Cortex-M4 processors */
 void SysTick_Handler(void)
 {
@@ -122,15 +278,30 @@ void SysTick_Handler(void)
 	SetActualContext(CONTEXT_ISR2);
 
 #if (ALARMS_COUNT != 0)
-	/* counter increment */
-	static CounterIncrementType CounterIncrement = 1;
-   (void)CounterIncrement; /* TODO remove me */
+#if (TICKLESS_ARCH == OSEK_ENABLE)
+	/* ticks to the next alarm */
+	CounterIncrementType CounterIncrement;
+#endif /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
 
 	/* increment the disable interrupt conter to avoid enable the interrupts */
 	IntSecure_Start();
 
+#if (TICKLESS_ARCH == OSEK_ENABLE)
+	/* add the rest of the period to the counter, and get the ticks to the
+	 * next alarm */
+	TickHandlerRunning = TRUE;
+	CounterIncrement = IncrementCounter(SYSTICK_COUNTER_ARCH, TickPeriod - TickDone);
+	TickHandlerRunning = FALSE;
+
+	/* the next period starts at this interrupt and lasts until the next
+	 * alarm expires */
+	TickSkew = 0;
+	TickDone = 0;
+	SetTickPeriod(CounterIncrement);
+#else /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
 	/* call counter interrupt handler */
-	CounterIncrement = IncrementCounter(0, 1 /* CounterIncrement */); /* TODO FIXME */
+	(void)IncrementCounter(SYSTICK_COUNTER_ARCH, 1);
+#endif /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
 
 	/* set the disable interrupt counter back */
 	IntSecure_End();
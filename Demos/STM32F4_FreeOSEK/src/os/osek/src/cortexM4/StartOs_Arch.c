@@ -77,6 +77,9 @@
 void StartOs_Arch_Cpu(void)
 {
    StartOs_Arch_SysTick();
+#if (TICKLESS_ARCH == OSEK_ENABLE)
+   StartOs_Arch_Tickless();
+#endif /* #if (TICKLESS_ARCH == OSEK_ENABLE) */
    Enable_User_ISRs();
 }
 
@@ -0,0 +1,202 @@
+/* Copyright 2014, ACSE & CADIEEL
+ *      ACSE: http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *      CADIEEL: http://www.cadieel.org.ar
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief FreeOSEK Os Internal Arch Implementation File
+ **
+ ** \file posix/Os_Internal_Arch.c
+ ** \arch posix
+ **/
+
+/** \addtogroup FreeOSEK
+ ** @{ */
+/** \addtogroup FreeOSEK_Os
+ ** @{ */
+/** \addtogroup FreeOSEK_Os_Internal
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include <time.h>
+#include <unistd.h>
+#include "Os_Internal.h"
+
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/** \brief Entry of every task
+ **
+ ** Calls the entry point of the running task, which shall not return.
+ **/
+static void TaskEntry(void);
+
+/*==================[internal data definition]===============================*/
+#if (ALARMS_COUNT != 0)
+/** \brief Time of the next tick of the SysTick, while the OS is idle */
+static struct timespec NextTick;
+#endif /* #if (ALARMS_COUNT != 0) */
+
+/*==================[external data definition]===============================*/
+TaskType TerminatingTask = INVALID_TASK;
+TaskType WaitingTask = INVALID_TASK;
+
+/*==================[internal functions definition]==========================*/
+static void TaskEntry(void)
+{
+	TasksConst[GetRunningTask()].EntryPoint();
+
+	/* Tasks shouldn't return here... */
+	while(1) osekpause();
+}
+
+/** \brief Reset the stack of the task which has terminated
+ **
+ ** The stack may be the one in use, only its top is written which belongs
+ ** to the entry of the terminated task.
+ **/
+static void CheckTerminatingTask(void)
+{
+	if(TerminatingTask != INVALID_TASK)
+	{
+		InitStack_Arch(TerminatingTask);
+	}
+	TerminatingTask = INVALID_TASK;
+}
+
+#if (ALARMS_COUNT != 0)
+/** \brief Add a SysTick period to a time */
+static void AddTickPeriod(struct timespec * Time)
+{
+	Time->tv_nsec += SYSTICK_PERIOD_NS_ARCH;
+	if (Time->tv_nsec >= 1000000000)
+	{
+		Time->tv_nsec -= 1000000000;
+		Time->tv_sec++;
+	}
+}
+
+/** \brief SysTick Interrupt
+ **
+ ** Only taken while the OS is idle, so no task is preempted by it.
+ **/
+static void SysTick(void)
+{
+	/* store the calling context in a variable */
+	ContextType actualContext = GetCallingContext();
+	/* set isr 2 context */
+	SetActualContext(CONTEXT_ISR2);
+
+	/* increment the disable interrupt conter to avoid enable the interrupts */
+	IntSecure_Start();
+
+	/* call counter interrupt handler */
+	(void)IncrementCounter(SYSTICK_COUNTER_ARCH, 1);
+
+	/* set the disable interrupt counter back */
+	IntSecure_End();
+
+	/* reset context */
+	SetActualContext(actualContext);
+}
+#endif /* #if (ALARMS_COUNT != 0) */
+
+/*==================[external functions definition]==========================*/
+void InitStack_Arch(uint8 TaskID)
+{
+	ucontext_t * context = TasksConst[TaskID].TaskContext;
+
+	context->uc_stack.ss_sp = TasksConst[TaskID].StackPtr;
+	context->uc_stack.ss_size = TasksConst[TaskID].StackSize;
+	context->uc_link = NULL;
+	makecontext(context, TaskEntry, 0);
+}
+
+void CallTask_Arch(TaskType OldTask, TaskType NewTask)
+{
+	CheckTerminatingTask();
+
+	(void)swapcontext(TasksConst[OldTask].TaskContext,
+			TasksConst[NewTask].TaskContext);
+}
+
+void JmpTask_Arch(TaskType NewTask)
+{
+	TaskType oldTask = WaitingTask;
+
+	CheckTerminatingTask();
+
+	if(oldTask != INVALID_TASK)
+	{
+		/* the waiting task continues from here once its events are set */
+		WaitingTask = INVALID_TASK;
+		(void)swapcontext(TasksConst[oldTask].TaskContext,
+				TasksConst[NewTask].TaskContext);
+	}
+	else
+	{
+		(void)setcontext(TasksConst[NewTask].TaskContext);
+	}
+}
+
+void Idle_Arch(void)
+{
+#if (ALARMS_COUNT != 0)
+	struct timespec now;
+
+	/* the SysTick does not count while the tasks run, if its tick is due
+	 * already it is a period from now */
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	if ( ( now.tv_sec > NextTick.tv_sec ) ||
+		  ( ( now.tv_sec == NextTick.tv_sec ) &&
+			 ( now.tv_nsec >= NextTick.tv_nsec ) ) )
+	{
+		NextTick = now;
+		AddTickPeriod(&NextTick);
+	}
+
+	/* sleep until the tick, as the cpu does waiting for an interrupt */
+	(void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &NextTick, NULL);
+	AddTickPeriod(&NextTick);
+
+	SysTick();
+#else /* #if (ALARMS_COUNT != 0) */
+	/* nothing will ever be activated */
+	(void)pause();
+#endif /* #if (ALARMS_COUNT != 0) */
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
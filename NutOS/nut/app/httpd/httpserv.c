@@ -565,6 +565,13 @@ THREAD(Service, arg)
         if ((stream = _fdopen((int) ((uintptr_t) sock), "r+b")) == 0) {
             printf("[%u] Creating stream failed\n", id);
         } else {
+            /*
+             * Collect the response headers and the small writes of our
+             * CGIs in a buffer, which is passed to the socket as a
+             * whole. Streams are unbuffered by default.
+             */
+            setvbuf(stream, NULL, _IOFBF, 256);
+
             /*
              * This API call saves us a lot of work. It will parse the
              * client's HTTP request, send any requested file from the
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 by the Nut/OS contributors
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * For additional information see http://www.ethernut.de/
+ */
+
+/*!
+ * \example stdiobench/stdiobench.c
+ *
+ * Compares unbuffered and buffered streams.
+ *
+ * HTTP response headers, written the way NutHttpSendHeaderTop() and
+ * NutHttpSendHeaderBottom() do, and printf style log lines are sent
+ * to a stream created by funopen(). Its write function just counts
+ * the calls, so the results show the number of driver calls per item
+ * and the time spent in the C runtime.
+ */
+
+#include <dev/board.h>
+#include <sys/timer.h>
+#include <sys/version.h>
+
+#include <stdio.h>
+#include <io.h>
+
+#define LOOPS   1000
+
+static char *banner = "\nNut/OS Stdio Benchmark " __DATE__ " " __TIME__ "\n";
+
+static unsigned long calls;
+
+static int CountWrite(void *cookie, const char *buf, int len)
+{
+    calls++;
+    return len;
+}
+
+static int NoRead(void *cookie, char *buf, int len)
+{
+    return 0;
+}
+
+static long NoSeek(void *cookie, long pos, int whence)
+{
+    return 0;
+}
+
+static int NoClose(void *cookie)
+{
+    return 0;
+}
+
+static void HttpHeader(FILE * stream, int i)
+{
+    static const char head_P[] PROGMEM = "HTTP/%d.%d %d %s\r\nServer: Ethernut %s\r\n";
+    static const char ctype_P[] PROGMEM = "Content-Type: %s\r\n";
+    static const char clen_P[] PROGMEM = "Content-Length: %ld\r\n";
+    static const char conn_P[] PROGMEM = "Connection: ";
+    static const char close_P[] PROGMEM = "close\r\n\r\n";
+
+    fprintf_P(stream, head_P, 1, 1, 200, "OK", NutVersionString());
+    fprintf_P(stream, ctype_P, "text/html");
+    fprintf_P(stream, clen_P, 1024L + i);
+    fputs_P(conn_P, stream);
+    fputs_P(close_P, stream);
+}
+
+static void LogLine(FILE * stream, int i)
+{
+    fprintf(stream, "[%8lu] %-6s rx=%5u tx=%5u err=%d\n", (unsigned long) i, "eth0", i & 0x3fff, (i * 7) & 0x3fff, i & 3);
+}
+
+static void Run(const char *name, FILE * stream, void (*item) (FILE *, int))
+{
+    uint32_t ms;
+    int i;
+
+    calls = 0;
+    ms = NutGetMillis();
+    for (i = 0; i < LOOPS; i++) {
+        item(stream, i);
+    }
+    fflush(stream);
+    ms = NutGetMillis() - ms;
+    printf("%-26s %3lu.%02lu calls %6lu us per item\n", name,
+           calls / LOOPS, (calls % LOOPS) / (LOOPS / 100), (unsigned long) ms * 1000UL / LOOPS);
+}
+
+int main(void)
+{
+    uint32_t baud = 115200;
+    FILE *stream;
+
+    NutRegisterDevice(&DEV_CONSOLE, 0, 0);
+    freopen(DEV_CONSOLE.dev_name, "w", stdout);
+    _ioctl(_fileno(stdout), UART_SETSPEED, &baud);
+    puts(banner);
+
+    stream = funopen(NULL, NoRead, CountWrite, NoSeek, NoClose);
+    if (stream == NULL) {
+        puts("funopen failed");
+        for (;;);
+    }
+    for (;;) {
+        setvbuf(stream, NULL, _IONBF, 0);
+        Run("HTTP header, unbuffered", stream, HttpHeader);
+        Run("Log line, unbuffered", stream, LogLine);
+
+        setvbuf(stream, NULL, _IOFBF, 256);
+        Run("HTTP header, full", stream, HttpHeader);
+        Run("Log line, full", stream, LogLine);
+
+        setvbuf(stream, NULL, _IOLBF, 128);
+        Run("Log line, line", stream, LogLine);
+
+        NutSleep(5000);
+    }
+    return 0;
+}
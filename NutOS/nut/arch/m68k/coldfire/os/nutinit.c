@@ -44,6 +44,9 @@ struct __iobuf {
     uint16_t    iob_mode;
     uint8_t     iob_flags;
     int         iob_unget;
+    char       *iob_buf;
+    size_t      iob_size;
+    size_t      iob_len;
 };
 #endif
 
@@ -167,6 +167,7 @@ nutcrt =
         provides = { "CRT_STREAM" },
         sources =
         {
+            "fbuf.c",
             "fclose.c",
             "fcloseall.c",
             "fdopen.c",
@@ -184,6 +185,7 @@ nutcrt =
             "ftell.c",
             "funopen.c",
             "seek.c",
+            "setvbuf.c",
             "tell.c"
         },
         options =
@@ -271,6 +273,7 @@ nutcrt =
         provides = { "CRT_STREAM_WRITE_P" },
         sources =
         {
+            "fbuf_p.c",
             "fprintf_p.c",
             "fputs_p.c",
             "fwrite_p.c",
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 by the Nut/OS contributors
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * For additional information see http://www.ethernut.de/
+ */
+
+#include "nut_io.h"
+
+#include <string.h>
+#include <io.h>
+
+/*!
+ * \addtogroup xgCrtStdio
+ */
+/*@{*/
+
+/*!
+ * \brief Write out the output buffer of a stream.
+ * \internal
+ *
+ * The buffer is passed to the driver as a whole. What the driver does
+ * not take on error is discarded.
+ *
+ * \param stream Pointer to a previously opened stream.
+ *
+ * \return 0 on success, EOF if an error occured.
+ */
+int _fflushbuf(FILE * stream)
+{
+    size_t off;
+    int rc;
+
+    for (off = 0; off < stream->iob_len; off += rc) {
+        rc = _write(stream->iob_fd, stream->iob_buf + off, stream->iob_len - off);
+        if (rc <= 0) {
+            stream->iob_flags |= _IOERR;
+            stream->iob_len = 0;
+            return EOF;
+        }
+    }
+    stream->iob_len = 0;
+
+    return 0;
+}
+
+/*!
+ * \brief Write data to a stream through its output buffer.
+ * \internal
+ *
+ * Data is collected in the buffer and passed to the driver when the
+ * buffer is full, or at the end of a line on line buffered streams.
+ * Data that fills more than a buffer goes to the driver directly.
+ * Unbuffered streams pass the data to the driver right away.
+ *
+ * \param stream Pointer to a previously opened stream.
+ * \param data   Pointer to the data to write.
+ * \param count  Number of bytes to write.
+ *
+ * \return The number of bytes written or -1 in case of an error.
+ */
+int _fputbuf(FILE * stream, const void *data, size_t count)
+{
+    const char *cp = (const char *) data;
+    size_t n;
+    int rc;
+
+    if (stream->iob_buf == NULL) {
+        return _write(stream->iob_fd, data, count);
+    }
+
+    n = stream->iob_size - stream->iob_len;
+    if (count > n) {
+        /* Top up the buffer and pass it to the driver. */
+        memcpy(stream->iob_buf + stream->iob_len, cp, n);
+        stream->iob_len += n;
+        if (_fflushbuf(stream)) {
+            return -1;
+        }
+        cp += n;
+        n = count - n;
+        /* Whole buffers need no copy. */
+        if (n >= stream->iob_size) {
+            rc = _write(stream->iob_fd, cp, n);
+            if (rc < 0) {
+                stream->iob_flags |= _IOERR;
+                return -1;
+            }
+            return (int) (count - n) + rc;
+        }
+    } else {
+        n = count;
+    }
+    memcpy(stream->iob_buf + stream->iob_len, cp, n);
+    stream->iob_len += n;
+
+    if ((stream->iob_flags & _IOLINE) && memchr(stream->iob_buf + stream->iob_len - n, '\n', n)) {
+        if (_fflushbuf(stream)) {
+            return -1;
+        }
+    }
+    return (int) count;
+}
+
+/*!
+ * \brief Output function for _putf(), which writes to a stream.
+ * \internal
+ *
+ * \param fd    Pointer to the stream, casted to an integer.
+ * \param data  Pointer to the data to write.
+ * \param count Number of bytes to write.
+ *
+ * \return The number of bytes written or -1 in case of an error.
+ */
+int _fputb(int fd, const void *data, size_t count)
+{
+    return _fputbuf((FILE *) ((uintptr_t) fd), data, count);
+}
+
+/*@}*/
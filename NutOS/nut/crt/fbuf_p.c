@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 by the Nut/OS contributors
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * For additional information see http://www.ethernut.de/
+ */
+
+#include "nut_io.h"
+
+#include <string.h>
+#include <io.h>
+
+/*!
+ * \addtogroup xgCrtStdio
+ */
+/*@{*/
+
+#ifdef __HARVARD_ARCH__
+
+/*!
+ * \brief Write data from program space to a stream through its output
+ *        buffer.
+ * \internal
+ *
+ * Similar to _fputbuf() except that the data is located in program
+ * memory.
+ *
+ * \param stream Pointer to a previously opened stream.
+ * \param data   Pointer to the data in program space.
+ * \param count  Number of bytes to write.
+ *
+ * \return The number of bytes written or -1 in case of an error.
+ */
+int _fputbuf_P(FILE * stream, PGM_P data, size_t count)
+{
+    size_t n;
+    int rc;
+
+    if (stream->iob_buf == NULL) {
+        return _write_P(stream->iob_fd, data, count);
+    }
+
+    n = stream->iob_size - stream->iob_len;
+    if (count > n) {
+        /* Top up the buffer and pass it to the driver. */
+        memcpy_P(stream->iob_buf + stream->iob_len, data, n);
+        stream->iob_len += n;
+        if (_fflushbuf(stream)) {
+            return -1;
+        }
+        data += n;
+        n = count - n;
+        /* Whole buffers need no copy. */
+        if (n >= stream->iob_size) {
+            rc = _write_P(stream->iob_fd, data, n);
+            if (rc < 0) {
+                stream->iob_flags |= _IOERR;
+                return -1;
+            }
+            return (int) (count - n) + rc;
+        }
+    } else {
+        n = count;
+    }
+    memcpy_P(stream->iob_buf + stream->iob_len, data, n);
+    stream->iob_len += n;
+
+    if ((stream->iob_flags & _IOLINE) && memchr(stream->iob_buf + stream->iob_len - n, '\n', n)) {
+        if (_fflushbuf(stream)) {
+            return -1;
+        }
+    }
+    return (int) count;
+}
+
+/*!
+ * \brief Output function for _putf(), which writes data from program
+ *        space to a stream.
+ * \internal
+ *
+ * \param fd    Pointer to the stream, casted to an integer.
+ * \param data  Pointer to the data in program space.
+ * \param count Number of bytes to write.
+ *
+ * \return The number of bytes written or -1 in case of an error.
+ */
+int _fputb_P(int fd, PGM_P data, size_t count)
+{
+    return _fputbuf_P((FILE *) ((uintptr_t) fd), data, count);
+}
+
+#endif
+
+/*@}*/
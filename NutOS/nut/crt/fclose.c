@@ -99,10 +99,14 @@ int fclose(FILE * stream)
     //    return 0;
 
     /*
-     * Close the file or device.
+     * Write out buffered output and close the file or device.
      */
-    if (_close(stream->iob_fd) == 0)
+    if (_fflushbuf(stream) == 0)
         rc = 0;
+    if (_close(stream->iob_fd))
+        rc = EOF;
+    if (stream->iob_flags & _IOMYBUF)
+        free(stream->iob_buf);
     free(stream);
     __iob[i] = 0;
 
@@ -148,6 +148,9 @@ FILE *_fdopen(int fd, const char *mode)
         __iob[i]->iob_mode = mflags;
         __iob[i]->iob_flags = 0;
         __iob[i]->iob_unget = 0;
+        __iob[i]->iob_buf = NULL;
+        __iob[i]->iob_size = 0;
+        __iob[i]->iob_len = 0;
     } else
         errno = ENOMEM;
 
@@ -71,7 +71,7 @@
 int fflush(FILE * stream)
 {
     NUTASSERT(stream != NULL);
-    if (_write(stream->iob_fd, 0, 0))
+    if (_fflushbuf(stream) || _write(stream->iob_fd, 0, 0))
         return EOF;
     return 0;
 }
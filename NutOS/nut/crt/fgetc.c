@@ -88,6 +88,9 @@ int fgetc(FILE * stream)
         stream->iob_flags &= ~_IOUNG;
         return stream->iob_unget;
     }
+    /* Let the other side see what we wrote before we wait for a reply. */
+    if (stream->iob_len)
+        _fflushbuf(stream);
     if ((rc = _read(stream->iob_fd, &ch, 1)) != 1) {
         if (rc) {
             /* Error. */
@@ -113,6 +113,9 @@ FILE *fopen(const char *name, const char *mode)
     __iob[i]->iob_mode = mflags;
     __iob[i]->iob_flags = 0;
     __iob[i]->iob_unget = 0;
+    __iob[i]->iob_buf = NULL;
+    __iob[i]->iob_size = 0;
+    __iob[i]->iob_len = 0;
 
     return __iob[i];
 }
@@ -53,7 +53,8 @@
 /*@{*/
 
 /*!
- * \brief Purge a stream, i.e. discards the input buffer.
+ * \brief Purge a stream, i.e. discards the input buffer and any
+ *        buffered output.
  *
  * \param stream Pointer to a previously opened stream.
  *
@@ -66,6 +67,7 @@
 int fpurge(FILE * stream)
 {
     NUTASSERT(stream != NULL);
+    stream->iob_len = 0;
     if (_read(stream->iob_fd, 0, 0))
         return EOF;
     return 0;
@@ -71,7 +71,12 @@ int fputc(int c, FILE * stream)
     char ch = (char) c;
 
     NUTASSERT(stream != NULL);
-    if (_write(stream->iob_fd, &ch, 1) != 1)
+    /* Room in the buffer and no line to end. */
+    if (stream->iob_len < stream->iob_size && (ch != '\n' || (stream->iob_flags & _IOLINE) == 0)) {
+        stream->iob_buf[stream->iob_len++] = ch;
+        return c;
+    }
+    if (_fputbuf(stream, &ch, 1) != 1)
         c = EOF;
 
     return c;
@@ -71,7 +71,7 @@ int fputs(const char *string, FILE * stream)
 {
     NUTASSERT(stream != NULL);
     NUTASSERT(string != NULL);
-    return _write(stream->iob_fd, string, strlen(string));
+    return _fputbuf(stream, string, strlen(string));
 }
 
 /*@}*/
@@ -73,7 +73,7 @@
 int fputs_P(PGM_P string, FILE * stream)
 {
     NUTASSERT(stream != NULL);
-    return _write_P(stream->iob_fd, string, strlen_P(string));
+    return _fputbuf_P(stream, string, strlen_P(string));
 }
 
 /*@}*/
@@ -88,6 +88,8 @@ size_t fread(void *buffer, size_t size, size_t count, FILE * stream)
         count--;
         nu++;
     }
+    if (stream->iob_len)
+        _fflushbuf(stream);
     rc = (size_t) _read(stream->iob_fd, buffer, count);
     if (rc == 0) {
         stream->iob_flags |= _IOEOF;
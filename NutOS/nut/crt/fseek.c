@@ -70,6 +70,8 @@
 int fseek(FILE * stream, long offset, int origin)
 {
     NUTASSERT(stream != NULL);
+    if (_fflushbuf(stream))
+        return -1;
     return _seek(stream->iob_fd, offset, origin);
 }
 
@@ -67,8 +67,13 @@
  */
 long ftell(FILE * stream)
 {
+    long pos;
+
     NUTASSERT(stream != NULL);
-    return _tell(stream->iob_fd);
+    /* Buffered output is not yet at the device. */
+    if ((pos = _tell(stream->iob_fd)) >= 0)
+        pos += stream->iob_len;
+    return pos;
 }
 
 /*@}*/
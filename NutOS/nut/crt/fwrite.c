@@ -83,7 +83,7 @@ size_t fwrite(const void *data, size_t size, size_t count, FILE * stream)
     NUTASSERT(stream != NULL);
     if (size > 1)
         count *= size;
-    if ((int) (rc = (size_t) _write(stream->iob_fd, data, count)) <= 0)
+    if ((int) (rc = (size_t) _fputbuf(stream, data, count)) <= 0)
         return 0;
     if (size > 1)
         rc /= size;
@@ -77,7 +77,7 @@ size_t fwrite_P(PGM_P data, size_t size, size_t count, FILE * stream)
     NUTASSERT(stream != NULL);
     if (size > 1)
         count *= size;
-    if ((int) (rc = (size_t) _write_P(stream->iob_fd, data, count)) <= 0)
+    if ((int) (rc = (size_t) _fputbuf_P(stream, data, count)) <= 0)
         return 0;
     if (size > 1)
         rc /= size;
@@ -66,14 +66,16 @@
  */
 /*@{*/
 
+#define _IOLINE     0x01    /*!< \internal Output is line buffered. */
+#define _IOMYBUF    0x02    /*!< \internal Output buffer allocated by setvbuf(). */
 #define _IOUNG      0x08    /*!< \internal Unget buffer filled. */
 #define _IOERR      0x10    /*!< \internal Error occured. */
 #define _IOEOF      0x20    /*!< \internal End of file reached. */
 #define _IOPGM      0x40    /*!< \internal Input from program memory. */
 
 #ifndef BUFSIZ
-#define BUFSIZ      128     /*!< \brief Default maximum size of stream buffers.
-                 Currently not used.
+#define BUFSIZ      128     /*!< \brief Default size of stream buffers.
+                 Used by setvbuf() when no size is given.
                  \showinitializer */
 #endif
 
@@ -90,6 +92,9 @@ struct __iobuf {
     uint16_t iob_mode;      /*!< \internal Access mode, see fcntl.h. */
     uint8_t iob_flags;      /*!< \internal Status flags. */
     int     iob_unget;      /*!< \internal Unget buffer. */
+    char   *iob_buf;        /*!< \internal Output buffer, NULL if unbuffered. */
+    size_t  iob_size;       /*!< \internal Size of the output buffer. */
+    size_t  iob_len;        /*!< \internal Number of bytes in the output buffer. */
 };
 
 struct __memstream {
@@ -116,6 +121,14 @@ extern int _sputb_P(int fd, PGM_P buffer_P, size_t count);
 extern int _snputb_P(int fd, PGM_P buffer_P, size_t count);
 #endif
 
+extern int _fflushbuf(FILE * stream);
+extern int _fputbuf(FILE * stream, const void *data, size_t count);
+extern int _fputb(int fd, const void *data, size_t count);
+#ifdef __HARVARD_ARCH__
+extern int _fputbuf_P(FILE * stream, PGM_P data, size_t count);
+extern int _fputb_P(int fd, PGM_P data, size_t count);
+#endif
+
 extern int _getf(int _getb(int, void *, size_t), int fd, const char *fmt, va_list ap);
 
 #endif
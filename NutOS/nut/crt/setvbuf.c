@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 by the Nut/OS contributors
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * For additional information see http://www.ethernut.de/
+ */
+
+#include "nut_io.h"
+
+#include <sys/nutdebug.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <memdebug.h>
+
+/*!
+ * \addtogroup xgCrtStdio
+ */
+/*@{*/
+
+/*!
+ * \brief Set the buffering of a stream.
+ *
+ * Streams are unbuffered when opened, each output function passes its
+ * data to the device driver right away. A buffered stream collects the
+ * output and passes it to the driver in one go, when the buffer is full,
+ * at the end of a line in line buffered mode, or on fflush(), fclose()
+ * and fseek(). Input is not buffered, but reading from a stream first
+ * writes out its buffered output.
+ *
+ * Any buffered output is written before the buffering is changed.
+ *
+ * \param stream Pointer to a previously opened stream.
+ * \param buf    Buffer to use, which must stay valid until the stream
+ *               is closed or its buffering changed. If NULL, a buffer
+ *               is allocated from the heap and released by fclose().
+ * \param mode   _IOFBF for full buffering, _IOLBF for line buffering
+ *               or _IONBF to switch off buffering.
+ * \param size   Size of the buffer. If 0, BUFSIZ bytes are allocated.
+ *
+ * \return 0 on success, EOF if the mode is invalid, the buffered output
+ *         could not be written or no buffer could be allocated.
+ */
+int setvbuf(FILE * stream, char *buf, int mode, size_t size)
+{
+    NUTASSERT(stream != NULL);
+
+    if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF) {
+        errno = EINVAL;
+        return EOF;
+    }
+    if (_fflushbuf(stream)) {
+        return EOF;
+    }
+    if (stream->iob_flags & _IOMYBUF) {
+        free(stream->iob_buf);
+    }
+    stream->iob_flags &= ~(_IOLINE | _IOMYBUF);
+    stream->iob_buf = NULL;
+    stream->iob_size = 0;
+
+    if (mode == _IONBF) {
+        return 0;
+    }
+    if (size == 0) {
+        buf = NULL;
+        size = BUFSIZ;
+    }
+    if (buf == NULL) {
+        if ((buf = malloc(size)) == NULL) {
+            errno = ENOMEM;
+            return EOF;
+        }
+        stream->iob_flags |= _IOMYBUF;
+    }
+    if (mode == _IOLBF) {
+        stream->iob_flags |= _IOLINE;
+    }
+    stream->iob_buf = buf;
+    stream->iob_size = size;
+
+    return 0;
+}
+
+/*@}*/
@@ -69,11 +69,11 @@
 int vfprintf(FILE * stream, const char *fmt, va_list ap)
 {
     NUTASSERT(stream != NULL);
-    return _putf(_write,
+    return _putf(_fputb,
 #ifdef __HARVARD_ARCH__
-                 _write_P,
+                 _fputb_P,
 #endif
-                 stream->iob_fd, fmt, ap);
+                 (int) ((uintptr_t) stream), fmt, ap);
 }
 
 /*@}*/
@@ -65,6 +65,8 @@
  */
 int vfscanf(FILE * stream, const char *fmt, va_list ap)
 {
+    if (stream->iob_len)
+        _fflushbuf(stream);
     return _getf(_read, _fileno(stream), fmt, ap);
 }
 
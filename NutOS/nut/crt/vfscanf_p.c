@@ -80,6 +80,8 @@ int vfscanf_P(FILE * stream, PGM_P fmt, va_list ap)
     if ((rp = NutHeapAlloc(rl)) == 0)
         return -1;
     memcpy_P(rp, fmt, rl);
+    if (stream->iob_len)
+        _fflushbuf(stream);
     rc = _getf(_read, _fileno(stream), rp, ap);
     NutHeapFree(rp);
 
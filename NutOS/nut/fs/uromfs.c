@@ -84,6 +84,7 @@
  *
  */
 
+#include <compiler.h>
 #include <sys/heap.h>
 #include <sys/file.h>
 #include <sys/device.h>
@@ -114,6 +115,189 @@ static long UromSize(NUTFILE * fp);
  */
 /*@{*/
 
+/*
+ * The index is missing in images created by older versions of crurom.
+ */
+#ifndef NUT_WEAK_SYMBOL
+#ifdef __GNUC__
+#define NUT_WEAK_SYMBOL __attribute__((__weak__))
+#else
+#define NUT_WEAK_SYMBOL
+#endif
+#endif
+extern ROMINDEX romIndex NUT_WEAK_SYMBOL;
+
+/*! \brief No block decompressed yet. */
+#define UROM_NO_BLOCK   ((unsigned int) -1)
+
+/*!
+ * \brief Find the entry of a file.
+ *
+ * \param name Filename without leading slash.
+ *
+ * \return Pointer to the entry or NULL if the file doesn't exist.
+ */
+static ROMENTRY *UromLookup(const char *name)
+{
+    ROMENTRY *rome;
+    const char *cp;
+    uint32_t h;
+    unsigned int d;
+
+    if (&romIndex == NULL) {
+        for (rome = romEntryList; rome; rome = rome->rome_next) {
+            if (strcmp_P(name, rome->rome_name) == 0)
+                break;
+        }
+        return rome;
+    }
+
+    /* FNV-1a hash, see ROMINDEX. */
+    h = romIndex.romi_seed;
+    for (cp = name; *cp; cp++) {
+        h ^= (uint8_t) *cp;
+        h *= 16777619UL;
+    }
+    d = romIndex.romi_disp[(unsigned int) (h >> 20) & romIndex.romi_bmask];
+    rome = romIndex.romi_slot[((unsigned int) (h & 0xFFFF) + d * ((unsigned int) (h >> 16) | 1)) & romIndex.romi_smask];
+    if (rome && strcmp_P(name, rome->rome_name)) {
+        rome = NULL;
+    }
+    return rome;
+}
+
+/*!
+ * \brief Number of bytes, which can be read from a file.
+ */
+static unsigned int UromLength(ROMENTRY * rome)
+{
+    return (rome->rome_flags & ROMF_LZ4) ? rome->rome_usize : rome->rome_size;
+}
+
+/*!
+ * \brief Decompress an LZ4 block from program space.
+ *
+ * \param dst  Destination buffer.
+ * \param dlen Expected number of decompressed bytes.
+ * \param src  Compressed data.
+ * \param slen Number of compressed bytes.
+ *
+ * \return 0 on success, -1 if the data is corrupted.
+ */
+static int UromLz4Decode(uint8_t *dst, unsigned int dlen, PGM_P src, unsigned int slen)
+{
+    unsigned int ip = 0;
+    unsigned int op = 0;
+    unsigned int len;
+    unsigned int off;
+    uint8_t token;
+    uint8_t c;
+
+    while (ip < slen) {
+        token = (uint8_t) PRG_RDB(src + ip);
+        ip++;
+        /* Literals. */
+        len = token >> 4;
+        if (len == 15) {
+            do {
+                if (ip >= slen)
+                    return -1;
+                c = (uint8_t) PRG_RDB(src + ip);
+                ip++;
+                len += c;
+            } while (c == 255);
+        }
+        if (len > slen - ip || len > dlen - op)
+            return -1;
+        memcpy_P(dst + op, src + ip, len);
+        ip += len;
+        op += len;
+        /* The last sequence has no match. */
+        if (ip == slen)
+            break;
+        /* Match. */
+        if (slen - ip < 2)
+            return -1;
+        off = (uint8_t) PRG_RDB(src + ip) | ((unsigned int) (uint8_t) PRG_RDB(src + ip + 1) << 8);
+        ip += 2;
+        if (off == 0 || off > op)
+            return -1;
+        len = token & 15;
+        if (len == 15) {
+            do {
+                if (ip >= slen)
+                    return -1;
+                c = (uint8_t) PRG_RDB(src + ip);
+                ip++;
+                len += c;
+            } while (c == 255);
+        }
+        len += 4;
+        if (len > dlen - op)
+            return -1;
+        /* Matches may overlap their own output. */
+        while (len--) {
+            dst[op] = dst[op - off];
+            op++;
+        }
+    }
+    return op == dlen ? 0 : -1;
+}
+
+/*!
+ * \brief Decompress a block of an LZ4 file.
+ *
+ * Blocks are found by walking the block headers, starting at the
+ * current block when moving forward.
+ *
+ * \return 0 on success, -1 if the data is corrupted.
+ */
+static int UromLoadBlock(ROMFILE * romf, unsigned int blkno)
+{
+    ROMENTRY *rome = romf->romf_entry;
+    unsigned int b;
+    unsigned int ofs;
+    unsigned int hdr;
+    unsigned int len;
+    unsigned int dlen;
+
+    if (romf->romf_blkno != UROM_NO_BLOCK && blkno > romf->romf_blkno) {
+        b = romf->romf_blkno + 1;
+        ofs = romf->romf_blkend;
+    } else {
+        b = 0;
+        ofs = 0;
+    }
+    romf->romf_blkno = UROM_NO_BLOCK;
+    for (;;) {
+        if (rome->rome_size - ofs < 2)
+            return -1;
+        hdr = (uint8_t) PRG_RDB(rome->rome_data + ofs) | ((unsigned int) (uint8_t) PRG_RDB(rome->rome_data + ofs + 1) << 8);
+        ofs += 2;
+        len = hdr & 0x7FFF;
+        if (len > rome->rome_size - ofs)
+            return -1;
+        if (b == blkno)
+            break;
+        ofs += len;
+        b++;
+    }
+    dlen = rome->rome_usize - blkno * UROM_LZ4_BLOCK;
+    if (dlen > UROM_LZ4_BLOCK)
+        dlen = UROM_LZ4_BLOCK;
+    if (hdr & 0x8000) {
+        if (len != dlen)
+            return -1;
+        memcpy_P(romf->romf_blk, (PGM_P) (rome->rome_data + ofs), len);
+    } else if (UromLz4Decode(romf->romf_blk, dlen, (PGM_P) (rome->rome_data + ofs), len)) {
+        return -1;
+    }
+    romf->romf_blkno = blkno;
+    romf->romf_blkend = ofs + len;
+
+    return 0;
+}
+
 static int UromSeek(NUTFILE * fp, long *pos, int whence)
 {
     ROMFILE *romf = fp->nf_fcb;
@@ -127,11 +311,11 @@ static int UromSeek(NUTFILE * fp, long *pos, int whence)
         npos += romf->romf_pos;
         break;
     case SEEK_END:
-        npos += rome->rome_size;
+        npos += UromLength(rome);
         break;
     }
 
-    if (npos < 0 || npos > rome->rome_size) {
+    if (npos < 0 || npos > UromLength(rome)) {
         rc = EINVAL;
     } else {
         romf->romf_pos = npos;
@@ -147,14 +331,36 @@ static int UromRead(NUTFILE * fp, void *buffer, int size)
 {
     ROMFILE *romf = fp->nf_fcb;
     ROMENTRY *rome = romf->romf_entry;
+    unsigned int blkno;
+    unsigned int off;
+    unsigned int n;
+    int rc;
+
+    if ((unsigned int) size > UromLength(rome) - romf->romf_pos)
+        size = UromLength(rome) - romf->romf_pos;
+    if (romf->romf_blk == NULL) {
+        if (size) {
+            memcpy_P(buffer, (PGM_P)(rome->rome_data + romf->romf_pos), size);
+            romf->romf_pos += size;
+        }
+        return size;
+    }
 
-    if ((unsigned int) size > rome->rome_size - romf->romf_pos)
-        size = rome->rome_size - romf->romf_pos;
-    if (size) {
-        memcpy_P(buffer, (PGM_P)(rome->rome_data + romf->romf_pos), size);
-        romf->romf_pos += size;
+    /* LZ4 compressed, copy from the decompressed blocks. */
+    for (rc = 0; rc < size; rc += n) {
+        blkno = romf->romf_pos / UROM_LZ4_BLOCK;
+        off = romf->romf_pos % UROM_LZ4_BLOCK;
+        if (blkno != romf->romf_blkno && UromLoadBlock(romf, blkno)) {
+            errno = EIO;
+            return rc ? rc : -1;
+        }
+        n = UROM_LZ4_BLOCK - off;
+        if (n > (unsigned int) (size - rc))
+            n = size - rc;
+        memcpy((char *) buffer + rc, romf->romf_blk + off, n);
+        romf->romf_pos += n;
     }
-    return size;
+    return rc;
 }
 
 /*!
@@ -204,14 +410,17 @@ static NUTFILE *UromOpen(NUTDEVICE * dev, const char *name, int mode,
     if (*name == '/') {
         name++;
     }
-    for (rome = romEntryList; rome; rome = rome->rome_next) {
-        if (strcmp_P(name, rome->rome_name) == 0)
-            break;
-    }
+    rome = UromLookup(name);
     if (rome) {
-        if ((romf = calloc(1, sizeof(ROMFILE))) != 0)
+        if ((romf = calloc(1, sizeof(ROMFILE))) != 0) {
             romf->romf_entry = rome;
-        else
+            romf->romf_blkno = UROM_NO_BLOCK;
+            if ((rome->rome_flags & ROMF_LZ4) && (romf->romf_blk = malloc(UROM_LZ4_BLOCK)) == NULL) {
+                free(romf);
+                romf = NULL;
+                errno = ENOMEM;
+            }
+        } else
             errno = ENOMEM;
     } else
         errno = ENOENT;
@@ -232,9 +441,15 @@ static NUTFILE *UromOpen(NUTDEVICE * dev, const char *name, int mode,
  */
 static int UromClose(NUTFILE * fp)
 {
+    ROMFILE *romf;
+
     if (fp && fp != NUTFILE_EOF) {
-        if (fp->nf_fcb)
-            free(fp->nf_fcb);
+        romf = fp->nf_fcb;
+        if (romf) {
+            if (romf->romf_blk)
+                free(romf->romf_blk);
+            free(romf);
+        }
         free(fp);
     }
     return 0;
@@ -248,15 +463,21 @@ static long UromSize(NUTFILE * fp)
     ROMFILE *romf = fp->nf_fcb;
     ROMENTRY *rome = romf->romf_entry;
 
-    return (long) rome->rome_size;
+    return (long) UromLength(rome);
 }
 
 /*!
  * \brief Device specific functions.
+ *
+ * FS_FILE_INFO returns the entity tag created by crurom and reports
+ * gzip compressed files, which can be sent to HTTP clients as they are.
  */
 int UromIOCtl(NUTDEVICE * dev, int req, void *conf)
 {
     int rc = -1;
+    FSCP_FILE_INFO *info;
+    ROMENTRY *rome;
+    const char *name;
 
     (void)dev;
 
@@ -266,6 +487,18 @@ int UromIOCtl(NUTDEVICE * dev, int req, void *conf)
                      (long *) ((IOCTL_ARG3 *) conf)->arg2,      /* */
                      (int) ((IOCTL_ARG3 *) conf)->arg3);
         break;
+    case FS_FILE_INFO:
+        info = (FSCP_FILE_INFO *) conf;
+        name = info->par_path;
+        if (*name == '/') {
+            name++;
+        }
+        if ((rome = UromLookup(name)) != NULL) {
+            info->par_etag = rome->rome_etag;
+            info->par_encoding = (rome->rome_flags & ROMF_GZIP) ? FSCP_ENC_GZIP : 0;
+            rc = 0;
+        }
+        break;
     }
     return rc;
 }
@@ -118,6 +118,11 @@
  */
 #define FS_FILE_SEEK    0x1123
 
+/*!
+ * \brief Query the entity tag and the content encoding of a file.
+ */
+#define FS_FILE_INFO    0x1124
+
 /*@}*/
 
 #define FS_VOL_MOUNT         0x1130
@@ -165,6 +170,17 @@ typedef struct _FSCP_STATUS {
     struct stat *par_stp;
 } FSCP_STATUS;
 
+/*!
+ * \brief Content encoding of a file, see FSCP_FILE_INFO.
+ */
+#define FSCP_ENC_GZIP   0x01
+
+typedef struct _FSCP_FILE_INFO {
+    const char *par_path;       /*!< \brief File path, set by the caller. */
+    uint32_t par_etag;          /*!< \brief Entity tag, 0 if none. */
+    uint8_t par_encoding;       /*!< \brief Content encoding, FSCP_ENC_GZIP or 0. */
+} FSCP_FILE_INFO;
+
 /*@}*/
 
 #endif
@@ -95,6 +95,59 @@ struct _ROMENTRY {
     prog_char *rome_name;   /*!< Filename. */
     unsigned int rome_size;        /*!< File size. */
     prog_char *rome_data;   /* __attribute__ ((progmem));  !< File data. */
+    unsigned int rome_usize;    /*!< Uncompressed file size. */
+    uint32_t rome_etag;     /*!< Entity tag, 0 if none. */
+    uint8_t rome_flags;     /*!< Content flags, ROMF_GZIP or ROMF_LZ4. */
+};
+
+/*!
+ * \name Micro-ROM content flags
+ *
+ * Entries created by older versions of crurom have no flags set and
+ * contain the plain file data.
+ */
+/*@{*/
+/*! \brief File data is a gzip stream, which is passed on as it is. */
+#define ROMF_GZIP       0x01
+/*! \brief File data is LZ4 compressed and decompressed when read. */
+#define ROMF_LZ4        0x02
+/*@}*/
+
+/*!
+ * \brief Uncompressed size of LZ4 blocks.
+ *
+ * LZ4 compressed files are split into blocks of this size, which are
+ * compressed independently. Each block is preceded by its compressed
+ * size as a 16 bit little endian value. If bit 15 is set, the block
+ * is stored uncompressed. Must match the value used by crurom.
+ */
+#define UROM_LZ4_BLOCK  512
+
+/*!
+ * \brief Mikro-ROM directory index type.
+ */
+typedef struct _ROMINDEX ROMINDEX;
+
+/*!
+ * \struct _ROMINDEX uromfs.h fs/uromfs.h
+ * \brief Mikro-ROM directory index structure.
+ *
+ * Perfect hash table created by crurom. The FNV-1a hash of a filename,
+ * started with romi_seed instead of the usual offset basis, selects a
+ * bucket by bits 20 and above and the bucket's displacement \e d. The
+ * file's entry is then found in slot
+ *
+ * ((hash & 0xFFFF) + d * ((hash >> 16) | 1)) & romi_smask
+ *
+ * of the table, unless the file doesn't exist. Only one filename needs
+ * to be compared, regardless of the number of files.
+ */
+struct _ROMINDEX {
+    uint32_t romi_seed;         /*!< Start value of the hash. */
+    unsigned int romi_bmask;    /*!< Number of buckets minus 1. */
+    unsigned int romi_smask;    /*!< Number of slots minus 1. */
+    const uint8_t *romi_disp;   /*!< Displacement of each bucket. */
+    ROMENTRY * const *romi_slot;    /*!< Entry of each slot, NULL if empty. */
 };
 
 /*!
@@ -109,6 +162,9 @@ typedef struct _ROMFILE ROMFILE;
 struct _ROMFILE {
     ROMENTRY *romf_entry;   /*!< Points to ROMENTRY */
     unsigned int romf_pos;      /*!< Current read position. */
+    uint8_t *romf_blk;      /*!< Decompressed LZ4 block, NULL for other files. */
+    unsigned int romf_blkno;    /*!< Number of the block in romf_blk. */
+    unsigned int romf_blkend;   /*!< Data offset of the block following romf_blkno. */
 };
 
 /*!
@@ -116,4 +172,12 @@ struct _ROMFILE {
  */
 extern ROMENTRY *romEntryList;
 
+/*!
+ * \brief Directory index of all microROM files.
+ *
+ * Created by crurom 3 and above. If missing, files are searched in
+ * romEntryList.
+ */
+extern ROMINDEX romIndex;
+
 #endif
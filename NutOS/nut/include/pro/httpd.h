@@ -122,6 +122,7 @@ struct _REQUEST {
     int req_connection;         /*!< \brief Connection type, HTTP_CONN_. */
     char *req_encoding;         /*!< \brief Accept encoding */
     char *req_disposition;      /*!< \breif Content disposition */
+    char *req_inm;              /*!< \brief If-none-match condition. */
 };
 
 typedef struct _MIMETYPES MIMETYPES;
@@ -172,6 +172,7 @@ extern int putc(int c, FILE * stream);
 extern int putchar(int c);
 extern int puts(const char *string);
 extern int scanf(const char *fmt, ...);
+extern int setvbuf(FILE * stream, char *buf, int mode, size_t size);
 extern int sprintf(char *buffer, const char *fmt, ...);
 extern int snprintf(char *buffer, size_t size, const char *fmt, ...);
 extern int sscanf(const char *string, const char *fmt, ...);
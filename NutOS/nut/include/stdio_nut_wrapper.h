@@ -33,6 +33,7 @@
 #define putchar(...) NUT_putchar(__VA_ARGS__)
 #define puts(...) NUT_puts(__VA_ARGS__)
 #define scanf(...) NUT_scanf(__VA_ARGS__)
+#define setvbuf(...) NUT_setvbuf(__VA_ARGS__)
 #define sprintf(...) NUT_sprintf(__VA_ARGS__)
 #define snprintf(...) NUT_snprintf(__VA_ARGS__)
 #define sscanf(...) NUT_sscanf(__VA_ARGS__)
@@ -159,6 +159,8 @@
 
 #include <sys/heap.h>
 #include <sys/version.h>
+#include <sys/device.h>
+#include <fs/fs.h>
 
 #include <pro/rfctime.h>
 #include <pro/httpd.h>
@@ -237,6 +239,7 @@ static const REQUEST_LOOKUP req_lookup[] = {
 #else
     { 17, "if-modified-since" },
 #endif
+    { 13, "if-none-match" },
     {  7, "referer" },
     { 10, "user-agent" },
     { 19, "content-disposition" }
@@ -387,6 +390,8 @@ void NutHttpSendHeaderBottom(FILE * stream, REQUEST * req, char *mime_type, long
     NutHttpSendHeaderBottomEx(stream, req, mime_type, bytes, 0);
 }
 
+static void NutHttpSendErrorEx(FILE * stream, REQUEST * req, int status, FSCP_FILE_INFO * finfo);
+
 /*!
  * \brief Send a HTTP error response.
  *
@@ -398,6 +403,43 @@ void NutHttpSendHeaderBottom(FILE * stream, REQUEST * req, char *mime_type, long
  * \param status Error code to be returned.
  */
 void NutHttpSendError(FILE * stream, REQUEST * req, int status)
+{
+    NutHttpSendErrorEx(stream, req, status, NULL);
+}
+
+/*!
+ * \brief Send entity tag and content encoding related header lines.
+ *
+ * \param stream Stream of the socket connection.
+ * \param finfo  File information, see GetFileInfo().
+ */
+static void NutHttpSendFileInfo(FILE * stream, FSCP_FILE_INFO * finfo)
+{
+    static const char etag_fmt_P[] PROGMEM = "ETag: \"%08lx\"\r\n";
+    static const char vary_str_P[] PROGMEM = "Vary: Accept-Encoding\r\n";
+
+    if (finfo->par_etag) {
+        fprintf_P(stream, etag_fmt_P, (unsigned long) finfo->par_etag);
+    }
+    /* The response depends on Accept-Encoding, tell any caches. */
+    if (finfo->par_encoding & FSCP_ENC_GZIP) {
+        fputs_P(vary_str_P, stream);
+    }
+}
+
+/*!
+ * \brief Send a HTTP error response for a file.
+ *
+ * Same as NutHttpSendError(), but adds the entity tag and the Vary
+ * header, if available. A 304 response is sent without body.
+ *
+ * \param stream Stream of the socket connection, previously opened for
+ *               binary read and write.
+ * \param req    Contains the HTTP request.
+ * \param status Error code to be returned.
+ * \param finfo  File information or NULL.
+ */
+static void NutHttpSendErrorEx(FILE * stream, REQUEST * req, int status, FSCP_FILE_INFO * finfo)
 {
     static const char err_fmt_P[] PROGMEM = "<HTML><HEAD><TITLE>%d %s</TITLE></HEAD><BODY>%d %s</BODY></HTML>\r\n";
     static const char auth_fmt_P[] PROGMEM = "WWW-Authenticate: Basic realm=\"%s\"\r\n";
@@ -416,6 +458,9 @@ void NutHttpSendError(FILE * stream, REQUEST * req, int status)
     case 404:
         title = "Not Found";
         break;
+    case 406:
+        title = "Not Acceptable";
+        break;
     case 500:
         title = "Internal Error";
         break;
@@ -444,6 +489,14 @@ void NutHttpSendError(FILE * stream, REQUEST * req, int status)
         if (cp)
             *cp = '/';
     }
+    if (finfo) {
+        NutHttpSendFileInfo(stream, finfo);
+    }
+    /* A 304 response must not contain a message body. */
+    if (status == 304) {
+        NutHttpSendHeaderBottom(stream, req, NULL, -1);
+        return;
+    }
     NutHttpSendHeaderBottom(stream, req, "text/html", -1);
     fprintf_P(stream, err_fmt_P, status, title, status, title);
 }
@@ -585,6 +638,36 @@ void NutHttpProcessQueryString(REQUEST * req)
     }
 }
 
+/*!
+ * \brief Query the entity tag and the content encoding of a file.
+ *
+ * \param path Pathname of the file, including the device.
+ * \param info Receives the information.
+ *
+ * \return 0 on success, -1 if not supported by the file system.
+ */
+static int GetFileInfo(const char *path, FSCP_FILE_INFO *info)
+{
+    NUTDEVICE *dev;
+    char dev_name[9];
+    uint_fast8_t nidx;
+
+    info->par_etag = 0;
+    info->par_encoding = 0;
+
+    /* Extract the device name. */
+    for (nidx = 0; *path && *path != ':' && nidx < 8; nidx++) {
+        dev_name[nidx] = *path++;
+    }
+    dev_name[nidx] = 0;
+    if (*path != ':' || (dev = NutDeviceLookup(dev_name)) == NULL || dev->dev_ioctl == NULL) {
+        return -1;
+    }
+    info->par_path = path + 1;
+
+    return (*dev->dev_ioctl) (dev, FS_FILE_INFO, info);
+}
+
 static void NutHttpProcessFileRequest(FILE * stream, REQUEST * req)
 {
     int fd;
@@ -596,6 +679,8 @@ static void NutHttpProcessFileRequest(FILE * stream, REQUEST * req)
     char *filename = NULL;
     char *modstr = NULL;
     unsigned short first2bytes = 0;
+    FSCP_FILE_INFO finfo;
+    char etag[11];
 
     /*
      * Validate authorization.
@@ -641,6 +726,36 @@ static void NutHttpProcessFileRequest(FILE * stream, REQUEST * req)
     mime_type = NutGetMimeType(filename);
     handler = NutGetMimeHandler(filename);
 
+    /*
+     * Some file systems keep an entity tag and gzip compressed files,
+     * which are sent as they are. We can't decompress them for
+     * clients, which don't accept gzip.
+     */
+    if (GetFileInfo(filename, &finfo) || handler) {
+        finfo.par_etag = 0;
+        finfo.par_encoding = 0;
+    }
+    if (finfo.par_etag) {
+        sprintf(etag, "\"%08lx\"", (unsigned long) finfo.par_etag);
+        if (req->req_inm && (strstr(req->req_inm, etag) || strcmp(req->req_inm, "*") == 0)) {
+            _close(fd);
+            NutHttpSendErrorEx(stream, req, 304, &finfo);
+            free(filename);
+            return;
+        }
+    }
+    if (finfo.par_encoding & FSCP_ENC_GZIP) {
+        if (req->req_encoding == NULL || strstr(req->req_encoding, "gzip") == NULL) {
+            _close(fd);
+            /* The error page is not the tagged entity. */
+            finfo.par_etag = 0;
+            NutHttpSendErrorEx(stream, req, 406, &finfo);
+            free(filename);
+            return;
+        }
+        first2bytes = GZIP_ID;
+    }
+
 #if !defined(HTTPD_EXCLUDE_DATE)
     /*
      * Optionally process modification time.
@@ -680,6 +795,7 @@ static void NutHttpProcessFileRequest(FILE * stream, REQUEST * req)
         fprintf(stream, "Last-Modified: %s GMT\r\n", modstr);
         free(modstr);
     }
+    NutHttpSendFileInfo(stream, &finfo);
 
     file_len = _filelength(fd);
 
@@ -693,7 +809,7 @@ static void NutHttpProcessFileRequest(FILE * stream, REQUEST * req)
 
 #if (HTTPD_SUPPORT_GZIP >= 1)
         /* Check for Accept-Encoding: gzip support */
-        if (req->req_encoding != NULL) {
+        if (req->req_encoding != NULL && first2bytes == 0) {
             if (strstr(req->req_encoding, "gzip") != NULL) {
                 /* Read first two bytes, needed for gzip header check */
                 _read(fd, &first2bytes, 2);
@@ -1018,14 +1134,18 @@ static int ParserHeaderLines(FILE *stream, REQUEST *req)
                         break;
 #endif
                     case 8:
+                        /* If-None-Match: Store as string. */
+                        strval = &req->req_inm;
+                        break;
+                    case 9:
                         /* Referer: Store as string. */
                         strval = &req->req_referer;
                         break;
-                    case 9:
+                    case 10:
                         /* User-Agent: Store as string. */
                         strval = &req->req_agent;
                         break;
-                    case 10:
+                    case 11:
                         /* Content disposition: Store as a string. */
                         strval = &req->req_disposition;
                         break;
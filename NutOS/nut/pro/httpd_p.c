@@ -97,6 +97,8 @@ void DestroyRequestInfo(REQUEST * req)
             free(req->req_host);
         if (req->req_encoding)
             free(req->req_encoding);
+        if (req->req_inm)
+            free(req->req_inm);
         free(req);
     }
 }
@@ -24,6 +24,10 @@ const char crurom_rcsid[] = "@(#) $Id: crurom.c 5351 2013-09-24 10:16:53Z harald
 
 #include "getopt.h"
 
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
 #ifndef O_BINARY
 #define O_BINARY 0
 #endif
@@ -31,7 +35,12 @@ const char crurom_rcsid[] = "@(#) $Id: crurom.c 5351 2013-09-24 10:16:53Z harald
 
 #define IDENT   "crurom"
 #undef VERSION
-#define VERSION "2.0.0"
+#define VERSION "3.0.0"
+
+/* Must match include/fs/uromfs.h. */
+#define ROMF_GZIP       0x01
+#define ROMF_LZ4        0x02
+#define UROM_LZ4_BLOCK  512
 
 static int entryno = 0;
 static int verbose = 0;
@@ -41,27 +50,217 @@ static int enc_hex = 0;
 static int enc_dec = 0;
 static int enc_strings = 0;
 static int enc_ugly = 0;
+static int zip_gzip = 0;
+static int zip_lz4 = 0;
 static int max_char_per_line = 16;
 static char rootdir[256];
 static int rootlen = 0;
 static char outname[256];
 static FILE *fpout;
 
-int dofile(char *name)
+/* Names of all entries, needed for the index. */
+static char **entryname;
+
+/* Files, which httpd passes through a mime handler. */
+static char *gzip_skip[] = { ".shtml", ".asp", NULL };
+
+/*
+ * CRC-32 of the file contents, used as the entity tag.
+ */
+unsigned long crc32buf(const unsigned char *buf, long len)
 {
-    static char *esc_seq = "\aa\bb\ff\nn\rr\tt\vv";
-    int rc = 0;
-    int fd;
-    unsigned char buf[512];
+    unsigned long crc = 0xFFFFFFFFUL;
     int i;
-    int nl_flag = 1;
-    int cpl_cnt = 0;
-    int cnt;
+
+    while (len--) {
+        crc ^= *buf++;
+        for (i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc & 0xFFFFFFFFUL;
+}
+
+/*
+ * FNV-1a hash of a filename, started with the given seed. Must match
+ * UromLookup() in fs/uromfs.c.
+ */
+unsigned long namehash(const char *name, unsigned long seed)
+{
+    unsigned long h = seed;
+
+    while (*name) {
+        h ^= (unsigned char) *name++;
+        h = (h * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return h;
+}
+
+/*
+ * Compress a block into the LZ4 block format.
+ *
+ * Greedy parsing with a single hash table, which is good enough for
+ * web content. The last 5 bytes are always literals and no match
+ * starts within the last 12 bytes, as required by the format.
+ *
+ * Returns the compressed size. The destination must be able to take
+ * len + len / 255 + 16 bytes.
+ */
+int lz4block(const unsigned char *src, int len, unsigned char *dst)
+{
+    static int table[4096];
+    const unsigned char *anchor = src;
+    const unsigned char *ip = src;
+    const unsigned char *mlimit = src + (len > 12 ? len - 12 : 0);
+    const unsigned char *mend = src + (len > 5 ? len - 5 : 0);
+    const unsigned char *ref;
+    unsigned char *op = dst;
+    unsigned char *token;
+    unsigned long seq;
+    int h;
+    int lit;
+    int mlen;
+
+    for (h = 0; h < 4096; h++) {
+        table[h] = -1;
+    }
+    while (ip < mlimit) {
+        seq = ip[0] | (ip[1] << 8) | ((unsigned long) ip[2] << 16) | ((unsigned long) ip[3] << 24);
+        h = (int) (((seq * 2654435761UL) & 0xFFFFFFFFUL) >> 20);
+        ref = table[h] < 0 ? NULL : src + table[h];
+        table[h] = (int) (ip - src);
+        if (ref == NULL || memcmp(ref, ip, 4)) {
+            ip++;
+            continue;
+        }
+        for (mlen = 4; ip + mlen < mend && ref[mlen] == ip[mlen]; mlen++);
+
+        /* Literals since the last match. */
+        lit = (int) (ip - anchor);
+        token = op++;
+        if (lit >= 15) {
+            *token = 15 << 4;
+            for (lit -= 15; lit >= 255; lit -= 255) {
+                *op++ = 255;
+            }
+            *op++ = (unsigned char) lit;
+        } else {
+            *token = (unsigned char) (lit << 4);
+        }
+        memcpy(op, anchor, ip - anchor);
+        op += ip - anchor;
+
+        /* The match. */
+        *op++ = (unsigned char) ((ip - ref) & 0xFF);
+        *op++ = (unsigned char) ((ip - ref) >> 8);
+        ip += mlen;
+        mlen -= 4;
+        if (mlen >= 15) {
+            *token |= 15;
+            for (mlen -= 15; mlen >= 255; mlen -= 255) {
+                *op++ = 255;
+            }
+            *op++ = (unsigned char) mlen;
+        } else {
+            *token |= (unsigned char) mlen;
+        }
+        anchor = ip;
+    }
+
+    /* The remaining literals. */
+    lit = (int) (src + len - anchor);
+    if (lit >= 15) {
+        *op++ = 15 << 4;
+        for (lit -= 15; lit >= 255; lit -= 255) {
+            *op++ = 255;
+        }
+        *op++ = (unsigned char) lit;
+    } else {
+        *op++ = (unsigned char) (lit << 4);
+    }
+    memcpy(op, anchor, src + len - anchor);
+    op += src + len - anchor;
+
+    return (int) (op - dst);
+}
+
+/*
+ * Compress a file into LZ4 blocks, each preceded by its compressed
+ * size. Blocks, which don't get smaller, are stored with bit 15 of
+ * the size set.
+ *
+ * Returns the compressed size or -1, if the file doesn't get smaller.
+ */
+long lz4file(const unsigned char *src, long len, unsigned char *dst)
+{
     long total = 0;
-    char *fsname = name;
+    int blen;
+    int clen;
+    unsigned char *cp;
 
-    if(strnicmp(fsname, rootdir, rootlen) == 0)
-        fsname += rootlen;
+    while (len) {
+        blen = len > UROM_LZ4_BLOCK ? UROM_LZ4_BLOCK : (int) len;
+        cp = dst + total + 2;
+        clen = lz4block(src, blen, cp);
+        if (clen >= blen) {
+            memcpy(cp, src, blen);
+            clen = blen;
+            dst[total] = (unsigned char) (blen & 0xFF);
+            dst[total + 1] = (unsigned char) ((blen >> 8) | 0x80);
+        } else {
+            dst[total] = (unsigned char) (clen & 0xFF);
+            dst[total + 1] = (unsigned char) (clen >> 8);
+        }
+        total += clen + 2;
+        src += blen;
+        len -= blen;
+    }
+    return total;
+}
+
+/*
+ * Compress a file into a gzip stream.
+ *
+ * Returns the compressed size or -1 on errors.
+ */
+long gzipfile(const unsigned char *src, long len, unsigned char *dst, long size)
+{
+#ifdef HAVE_LIBZ
+    z_stream zs;
+    long total;
+
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return -1;
+    }
+    zs.next_in = (Bytef *) src;
+    zs.avail_in = (uInt) len;
+    zs.next_out = dst;
+    zs.avail_out = (uInt) size;
+    if (deflate(&zs, Z_FINISH) != Z_STREAM_END) {
+        deflateEnd(&zs);
+        return -1;
+    }
+    total = (long) zs.total_out;
+    deflateEnd(&zs);
+
+    return total;
+#else
+    return -1;
+#endif
+}
+
+/*
+ * Read a file into a buffer allocated from the heap.
+ *
+ * Returns the file size or -1 on errors.
+ */
+long readfile(char *name, unsigned char **buf)
+{
+    int fd;
+    int cnt;
+    long total = 0;
+    long size = 4096;
 
     if((fd = open(name, O_RDONLY | O_BINARY)) == -1) {
         perror(name);
@@ -70,127 +269,225 @@ int dofile(char *name)
     if(verbose)
         fprintf(stderr, IDENT ": Reading %s\n", name);
 
+    *buf = malloc(size);
     for(;;) {
-        if((cnt = read(fd, buf, sizeof(buf))) < 0) {
-            perror(name);
-            rc = -1;
-            total = 0;
+        if (*buf == NULL) {
+            fprintf(stderr, IDENT ": Out of memory\n");
+            total = -1;
             break;
         }
-        if(total == 0) {
-            entryno++;
-            if (!enc_ugly) {
-                fprintf(fpout, "/*\n * File entry %d: %s\n */\n", entryno, fsname);
-            }
-            if (prog_types_compat) {
-                fprintf(fpout, "prog_char file%ddata[]", entryno);
-            } else {
-                fprintf(fpout, "const char file%ddata[] PROGMEM", entryno);
-            }
-            if (enc_strings) {
-                fputs(" = ", fpout);
-            } else {
-                fputs(" = {", fpout);
-            }
+        if((cnt = read(fd, *buf + total, size - total)) < 0) {
+            perror(name);
+            total = -1;
+            break;
         }
         if(cnt == 0)
             break;
-        if (enc_strings) {
-            /*
-             * Encode buffer to string.
-             *
-             * When using this format, then at least text files will
-             * become user-editable. However, due to the string terminator
-             * each file occupies an additional byte in memory.
-             */
-            for(i = 0; i < cnt; i++) {
-                if (nl_flag) {
-                    fputs("\n\"", fpout);
-                    nl_flag = 0;
-                    cpl_cnt = 0;
+        total += cnt;
+        if(total == size) {
+            size *= 2;
+            *buf = realloc(*buf, size);
+        }
+    }
+    close(fd);
+    if (total < 0) {
+        free(*buf);
+        *buf = NULL;
+    }
+    return total;
+}
+
+int dofile(char *name)
+{
+    static char *esc_seq = "\aa\bb\ff\nn\rr\tt\vv";
+    unsigned char *data;
+    unsigned char *zdata = NULL;
+    unsigned char *buf;
+    int i;
+    int nl_flag = 1;
+    int cpl_cnt = 0;
+    long cnt;
+    long usize;
+    long zsize;
+    unsigned long etag;
+    int flags = 0;
+    char *fsname = name;
+    char *ext;
+
+    if(strnicmp(fsname, rootdir, rootlen) == 0)
+        fsname += rootlen;
+
+    if((usize = readfile(name, &data)) < 0) {
+        return -1;
+    }
+    buf = data;
+    cnt = usize;
+
+    /*
+     * Compress the file, if this makes it smaller. Gzip streams are
+     * passed to HTTP clients as they are, LZ4 blocks are decompressed
+     * by the file system. Files for mime handlers are not gzipped,
+     * but may use LZ4.
+     */
+    if (usize && (zip_gzip || zip_lz4)) {
+        zdata = malloc(usize + usize / 255 + 2 * (usize / UROM_LZ4_BLOCK) + 64);
+        if (zdata == NULL) {
+            fprintf(stderr, IDENT ": Out of memory\n");
+            free(data);
+            return -1;
+        }
+        zsize = -1;
+        if (zip_gzip) {
+            ext = strrchr(fsname, '.');
+            for (i = 0; ext && gzip_skip[i]; i++) {
+                if (stricmp(ext, gzip_skip[i]) == 0) {
+                    break;
                 }
-                /* Handle non-printable values. */
-                if (buf[i] < 32 || buf[i] > 126) {
-                    /* Handle a few escape sequences. */
-                    char *cp = strchr(esc_seq, buf[i]);
-                    if (cp && *cp) {
-                        cp++;
-                        fputc('\\', fpout);
-                        fputc(*cp, fpout);
-                        cpl_cnt += 2;
-                        /* Terminate line at line-feeds. */
-                        if (!enc_ugly) {
-                            nl_flag = *cp == 'n';
-                        }
-                    }
-                    else {
-                        /* Write all other values as hex. */
-                        cpl_cnt += fprintf(fpout, enc_ugly ? "\\x%x" : "\\x%02X", buf[i]);
-                        /* ANSI-C doesn't limit hex to 2 characters.
-                           Terminate the line if the next character
-                           is a hex digit. */
-                        if (i + 1 < cnt && isxdigit(buf[i + 1])) {
-                            fputc('"', fpout);
-                            nl_flag = 1;
-                        }
+            }
+            if (ext == NULL || gzip_skip[i] == NULL) {
+                zsize = gzipfile(data, usize, zdata, usize + usize / 255 + 64);
+                flags = ROMF_GZIP;
+            }
+        }
+        if (zip_lz4 && flags == 0) {
+            zsize = lz4file(data, usize, zdata);
+            flags = ROMF_LZ4;
+        }
+        if (zsize >= 0 && zsize < usize) {
+            buf = zdata;
+            cnt = zsize;
+            if (verbose)
+                fprintf(stderr, IDENT ": Compressed %s from %ld to %ld bytes\n", fsname, usize, zsize);
+        } else {
+            flags = 0;
+        }
+    }
+
+    /* The tag identifies the contents as sent to HTTP clients. */
+    if (flags & ROMF_GZIP) {
+        etag = crc32buf(buf, cnt);
+    } else {
+        etag = crc32buf(data, usize);
+    }
+    if (etag == 0) {
+        etag = 1;
+    }
+
+    entryno++;
+    entryname = realloc(entryname, (entryno + 1) * sizeof(char *));
+    if (entryname == NULL || (entryname[entryno] = strdup(fsname)) == NULL) {
+        fprintf(stderr, IDENT ": Out of memory\n");
+        return -1;
+    }
+    if (!enc_ugly) {
+        fprintf(fpout, "/*\n * File entry %d: %s\n */\n", entryno, fsname);
+    }
+    if (prog_types_compat) {
+        fprintf(fpout, "prog_char file%ddata[]", entryno);
+    } else {
+        fprintf(fpout, "const char file%ddata[] PROGMEM", entryno);
+    }
+    if (enc_strings) {
+        fputs(" = ", fpout);
+    } else {
+        fputs(" = {", fpout);
+    }
+
+    if (enc_strings) {
+        /*
+         * Encode buffer to string.
+         *
+         * When using this format, then at least text files will
+         * become user-editable. However, due to the string terminator
+         * each file occupies an additional byte in memory.
+         */
+        for(i = 0; i < cnt; i++) {
+            if (nl_flag) {
+                fputs("\n\"", fpout);
+                nl_flag = 0;
+                cpl_cnt = 0;
+            }
+            /* Handle non-printable values. */
+            if (buf[i] < 32 || buf[i] > 126) {
+                /* Handle a few escape sequences. */
+                char *cp = strchr(esc_seq, buf[i]);
+                if (cp && *cp) {
+                    cp++;
+                    fputc('\\', fpout);
+                    fputc(*cp, fpout);
+                    cpl_cnt += 2;
+                    /* Terminate line at line-feeds. */
+                    if (!enc_ugly) {
+                        nl_flag = *cp == 'n';
                     }
                 }
-                /* Handle non-printable values. */
                 else {
-                    if (buf[i] == '"' || buf[i] == '\\') {
-                        fputc('\\', fpout);
-                        cpl_cnt++;
+                    /* Write all other values as hex. */
+                    cpl_cnt += fprintf(fpout, enc_ugly ? "\\x%x" : "\\x%02X", buf[i]);
+                    /* ANSI-C doesn't limit hex to 2 characters.
+                       Terminate the line if the next character
+                       is a hex digit. */
+                    if (i + 1 < cnt && isxdigit(buf[i + 1])) {
+                        fputc('"', fpout);
+                        nl_flag = 1;
                     }
-                    fputc((int)buf[i], fpout);
-                    cpl_cnt++;
                 }
-                /* Terminate line if... */
-                if(nl_flag == 0 && /* ...not already flagged. */
-                   cpl_cnt >= max_char_per_line && /* ...maximum length reached. */
-                   i + 1 < cnt) { /* ...more to come. */
-                    fputc('"', fpout);
-                    nl_flag = 1;
+            }
+            /* Handle non-printable values. */
+            else {
+                if (buf[i] == '"' || buf[i] == '\\') {
+                    fputc('\\', fpout);
+                    cpl_cnt++;
                 }
+                fputc((int)buf[i], fpout);
+                cpl_cnt++;
             }
-        } else {
-            /*
-             * Encode buffer to characters.
-             *
-             * This is the original default encoding, where file contents
-             * represented in character arrays.
-             */
-            for(i = 0; i < cnt; i++) {
-                /* Limit characters per line. */
-                if((i % max_char_per_line) == 0) {
-                    if(total != 0 || i != 0) {
-                        fputc(',', fpout);
-                    }
-                    fputs("\n ", fpout);
-                } else {
+            /* Terminate line if... */
+            if(nl_flag == 0 && /* ...not already flagged. */
+               cpl_cnt >= max_char_per_line && /* ...maximum length reached. */
+               i + 1 < cnt) { /* ...more to come. */
+                fputc('"', fpout);
+                nl_flag = 1;
+            }
+        }
+    } else {
+        /*
+         * Encode buffer to characters.
+         *
+         * This is the original default encoding, where file contents
+         * represented in character arrays.
+         */
+        for(i = 0; i < cnt; i++) {
+            /* Limit characters per line. */
+            if((i % max_char_per_line) == 0) {
+                if(i != 0) {
                     fputc(',', fpout);
                 }
-                /* Write all characters as hex values. */
-                if (enc_hex) {
-                    fprintf(fpout, enc_ugly ? "0x%x" : "0x%02X", buf[i]);
-                }
-                /* Write all characters as decimal values. */
-                else if (enc_dec) {
+                fputs("\n ", fpout);
+            } else {
+                fputc(',', fpout);
+            }
+            /* Write all characters as hex values. */
+            if (enc_hex) {
+                fprintf(fpout, enc_ugly ? "0x%x" : "0x%02X", buf[i]);
+            }
+            /* Write all characters as decimal values. */
+            else if (enc_dec) {
+                fprintf(fpout, enc_ugly ? "%u" : "%3u", buf[i]);
+            }
+            /* Write characters or decimal values. */
+            else {
+                /* Write non-printable values as decimal. */
+                if (buf[i] < 32 || buf[i] > 126 || buf[i] == '\'' || buf[i] == '\\') {
                     fprintf(fpout, enc_ugly ? "%u" : "%3u", buf[i]);
                 }
-                /* Write characters or decimal values. */
-                else {
-                    /* Write non-printable values as decimal. */
-                    if (buf[i] < 32 || buf[i] > 126 || buf[i] == '\'' || buf[i] == '\\') {
-                        fprintf(fpout, enc_ugly ? "%u" : "%3u", buf[i]);
-                    }
-                    else
-                        fprintf(fpout, "'%c'", buf[i]);
-                }
+                else
+                    fprintf(fpout, "'%c'", buf[i]);
             }
         }
-        total += cnt;
     }
-    close(fd);
+    free(data);
+    free(zdata);
 
     if (enc_strings) {
         if (nl_flag == 0) {
@@ -222,12 +519,148 @@ int dofile(char *name)
         fprintf(fpout, "0, ");
 
     if (prog_types_compat) {
-        fprintf(fpout, "(prog_char *)file%dname, %ld, (prog_char *)file%ddata };\n", entryno, total, entryno);
+        fprintf(fpout, "(prog_char *)file%dname, %ld, (prog_char *)file%ddata", entryno, cnt, entryno);
     } else {
-        fprintf(fpout, "file%dname, %ld, file%ddata };\n", entryno, total, entryno);
+        fprintf(fpout, "file%dname, %ld, file%ddata", entryno, cnt, entryno);
     }
+    fprintf(fpout, ", %ld, 0x%08lXUL, %d };\n", usize, etag, flags);
 
-    return rc;
+    return 0;
+}
+
+/*
+ * Place all filenames into the slots of the index.
+ *
+ * Starting with the largest bucket, each bucket gets the first
+ * displacement, which moves all its names to free slots.
+ *
+ * Returns 0 on success or -1, if a bucket didn't fit.
+ */
+int placeindex(unsigned long *hash, int *bucket, int nb, int *disp, int *slot, int ns)
+{
+    int size;
+    int maxsize;
+    int b;
+    int d;
+    int i;
+    int j;
+    int k;
+
+    for (k = 0; k < ns; k++) {
+        slot[k] = 0;
+    }
+    for (maxsize = entryno; maxsize;) {
+        size = maxsize;
+        maxsize = 0;
+        for (b = 0; b < nb; b++) {
+            for (k = 0, i = 0; i < entryno; i++) {
+                k += bucket[i] == b;
+            }
+            if (k != size) {
+                if (k < size && k > maxsize)
+                    maxsize = k;
+                continue;
+            }
+            for (d = 0; d < 256; d++) {
+                for (i = 0; i < entryno; i++) {
+                    if (bucket[i] != b)
+                        continue;
+                    k = (int) (((hash[i] & 0xFFFF) + d * ((hash[i] >> 16) | 1)) & (ns - 1));
+                    if (slot[k])
+                        break;
+                    slot[k] = i + 1;
+                }
+                if (i == entryno)
+                    break;
+                /* Undo this displacement. */
+                for (j = 0; j < i; j++) {
+                    if (bucket[j] == b) {
+                        slot[((hash[j] & 0xFFFF) + d * ((hash[j] >> 16) | 1)) & (ns - 1)] = 0;
+                    }
+                }
+            }
+            if (d == 256)
+                return -1;
+            disp[b] = d;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Create the perfect hash index, see ROMINDEX in include/fs/uromfs.h.
+ *
+ * Filenames are distributed to buckets, about two per bucket. If the
+ * buckets can't be placed, another seed is tried and finally the
+ * number of slots doubled.
+ */
+int doindex(void)
+{
+    unsigned long *hash;
+    unsigned long seed = 0;
+    int *bucket;
+    int *disp;
+    int *slot = NULL;
+    int nb;
+    int ns;
+    int b;
+    int i;
+    int k;
+    int rc = -1;
+
+    for (nb = 1; nb < entryno / 2 && nb < 4096; nb <<= 1);
+    hash = malloc(entryno * sizeof(unsigned long));
+    bucket = malloc(entryno * sizeof(int));
+    disp = calloc(nb, sizeof(int));
+    if (hash == NULL || bucket == NULL || disp == NULL) {
+        fprintf(stderr, IDENT ": Out of memory\n");
+        return -1;
+    }
+    for (ns = 1; ns < entryno; ns <<= 1);
+    for (; rc && ns <= 65536; ns <<= 1) {
+        slot = realloc(slot, ns * sizeof(int));
+        for (k = 0; rc && k < 64; k++) {
+            seed = (2166136261UL + k) & 0xFFFFFFFFUL;
+            for (i = 0; i < entryno; i++) {
+                hash[i] = namehash(entryname[i + 1], seed);
+                bucket[i] = (int) (hash[i] >> 20) & (nb - 1);
+            }
+            rc = placeindex(hash, bucket, nb, disp, slot, ns);
+        }
+        if (rc == 0)
+            break;
+    }
+    if (rc) {
+        fprintf(stderr, IDENT ": Failed to create index, duplicate file names?\n");
+        return -1;
+    }
+    if (verbose)
+        fprintf(stderr, IDENT ": Index of %d files with %d buckets and %d slots\n", entryno, nb, ns);
+
+    fprintf(fpout, "\nstatic const uint8_t romIndexDisp[%d] = {", nb);
+    for (b = 0; b < nb; b++) {
+        fprintf(fpout, "%s%s%d", b ? "," : "", (b % 16) ? " " : "\n    ", disp[b]);
+    }
+    fprintf(fpout, "\n};\n");
+    fprintf(fpout, "\nstatic ROMENTRY * const romIndexSlot[%d] = {", ns);
+    for (k = 0; k < ns; k++) {
+        fputs(k ? "," : "", fpout);
+        fputs((k % 8) ? " " : "\n    ", fpout);
+        if (slot[k]) {
+            fprintf(fpout, "&file%dentry", slot[k]);
+        } else {
+            fputs("0", fpout);
+        }
+    }
+    fprintf(fpout, "\n};\n");
+    fprintf(fpout, "\nROMINDEX romIndex = { 0x%08lXUL, %d, %d, romIndexDisp, romIndexSlot };\n", seed, nb - 1, ns - 1);
+
+    free(hash);
+    free(bucket);
+    free(disp);
+    free(slot);
+
+    return 0;
 }
 
 int dodir(char *dirpath)
@@ -274,6 +707,8 @@ void usage(void)
       "-o <file> output file\n"
       "-r        recursive\n"
       "-v        verbose\n"
+      "-zg       gzip compress files for httpd, except *.shtml and *.asp\n"
+      "-zl       LZ4 compress files, which are not gzipped\n"
     , stderr);
 }
 
@@ -284,7 +719,7 @@ int main(int argc, char **argv)
     int rc = 0;
     char *ocp;
 
-    while((option = getopt(argc, argv, "c:e:l:o:rv?")) != EOF) {
+    while((option = getopt(argc, argv, "c:e:l:o:rvz:?")) != EOF) {
         switch(option) {
         case 'c':
             if (strchr(optarg, 'p')) {
@@ -324,6 +759,23 @@ int main(int argc, char **argv)
         case 'v':
             verbose++;
             break;
+        case 'z':
+            if (strcmp(optarg, "g") == 0) {
+#ifdef HAVE_LIBZ
+                zip_gzip++;
+#else
+                fprintf(stderr, IDENT ": Built without gzip support\n");
+                return 1;
+#endif
+            }
+            else if (strcmp(optarg, "l") == 0) {
+                zip_lz4++;
+            }
+            else {
+                usage();
+                return 1;
+            }
+            break;
         default:
             usage();
             return 1;
@@ -359,6 +811,9 @@ int main(int argc, char **argv)
         rootlen = 2;
         rc = dodir(".");
     }
+    if (rc == 0 && entryno) {
+        rc = doindex();
+    }
     fprintf(fpout, "\nROMENTRY *romEntryList = &file%dentry;\n", entryno);
     if(fpout != stdout)
         fclose(fpout);
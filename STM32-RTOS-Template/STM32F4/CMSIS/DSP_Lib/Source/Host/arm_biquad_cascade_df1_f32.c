@@ -0,0 +1,192 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_biquad_cascade_df1_f32.c   
+*   
+* Description:	SSE floating-point Biquad cascade DirectFormI(DF1) filter.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#include "arm_host_math.h"
+
+/**   
+ * @ingroup groupFilters   
+ */
+
+/**   
+ * @addtogroup BiquadCascadeDF1   
+ * @{   
+ */
+
+/*   
+ * One stage at a time, as in the C code.   
+ */
+static void arm_biquad_df1_stage_f32(
+  float32_t * pCoeffs,
+  float32_t * pState,
+  float32_t * pIn,
+  float32_t * pOut,
+  uint32_t blockSize)
+{
+  float32_t b0 = pCoeffs[0], b1 = pCoeffs[1], b2 = pCoeffs[2];
+  float32_t a1 = pCoeffs[3], a2 = pCoeffs[4];
+  float32_t Xn1 = pState[0], Xn2 = pState[1];
+  float32_t Yn1 = pState[2], Yn2 = pState[3];
+  float32_t Xn, acc;
+  uint32_t n;
+
+  for (n = 0u; n < blockSize; n++)
+  {
+    Xn = pIn[n];
+    acc = (b0 * Xn) + (b1 * Xn1) + (b2 * Xn2) + (a1 * Yn1) + (a2 * Yn2);
+    pOut[n] = acc;
+
+    Xn2 = Xn1;
+    Xn1 = Xn;
+    Yn2 = Yn1;
+    Yn1 = acc;
+  }
+
+  pState[0] = Xn1;
+  pState[1] = Xn2;
+  pState[2] = Yn1;
+  pState[3] = Yn2;
+}
+
+/*   
+ * Four stages at once, one in each lane.  At step t stage s works on sample   
+ * t - s, taking as input what stage s - 1 gave out at step t - 1, so the   
+ * stages run as a wavefront with the same operations as the C code.  A lane   
+ * keeps its state during the steps before it starts and after it ends.   
+ */
+static void arm_biquad_df1_4stages_f32(
+  float32_t * pCoeffs,
+  float32_t * pState,
+  float32_t * pIn,
+  float32_t * pOut,
+  uint32_t blockSize)
+{
+  __m128 b0, b1, b2, a1, a2;
+  __m128 Xn, Xn1, Xn2, Yn1, Yn2, acc, live;
+  __m128 s0, s1, s2, s3;
+  uint32_t t, steps = blockSize + 3u;
+
+  /* Coefficients and state, one stage per lane */
+  b0 = _mm_setr_ps(pCoeffs[0], pCoeffs[5], pCoeffs[10], pCoeffs[15]);
+  b1 = _mm_setr_ps(pCoeffs[1], pCoeffs[6], pCoeffs[11], pCoeffs[16]);
+  b2 = _mm_setr_ps(pCoeffs[2], pCoeffs[7], pCoeffs[12], pCoeffs[17]);
+  a1 = _mm_setr_ps(pCoeffs[3], pCoeffs[8], pCoeffs[13], pCoeffs[18]);
+  a2 = _mm_setr_ps(pCoeffs[4], pCoeffs[9], pCoeffs[14], pCoeffs[19]);
+
+  s0 = _mm_loadu_ps(pState);
+  s1 = _mm_loadu_ps(pState + 4);
+  s2 = _mm_loadu_ps(pState + 8);
+  s3 = _mm_loadu_ps(pState + 12);
+  _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+  Xn1 = s0;
+  Xn2 = s1;
+  Yn1 = s2;
+  Yn2 = s3;
+
+  acc = _mm_setzero_ps();
+
+  for (t = 0u; t < steps; t++)
+  {
+    /* Lane 0 takes the next input, the others the output of the lane below */
+    Xn = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(acc), 4));
+    if (t < blockSize)
+    {
+      Xn = _mm_move_ss(Xn, _mm_set_ss(pIn[t]));
+    }
+
+    acc = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(b0, Xn), _mm_mul_ps(b1, Xn1)), _mm_mul_ps(b2, Xn2)),
+            _mm_mul_ps(a1, Yn1)), _mm_mul_ps(a2, Yn2));
+
+    if (t >= 3u && t < blockSize)
+    {
+      Xn2 = Xn1;
+      Xn1 = Xn;
+      Yn2 = Yn1;
+      Yn1 = acc;
+    }
+    else
+    {
+      /* Lanes from t - blockSize + 1 up to t are working */
+      live = _mm_castsi128_ps(_mm_and_si128(
+               _mm_cmplt_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32((int32_t) t + 1)),
+               _mm_cmpgt_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32((int32_t) t - (int32_t) blockSize))));
+
+      Xn2 = _mm_blendv_ps(Xn2, Xn1, live);
+      Xn1 = _mm_blendv_ps(Xn1, Xn, live);
+      Yn2 = _mm_blendv_ps(Yn2, Yn1, live);
+      Yn1 = _mm_blendv_ps(Yn1, acc, live);
+    }
+
+    /* Lane 3 finishes sample t - 3 */
+    if (t >= 3u)
+    {
+      pOut[t - 3u] = _mm_cvtss_f32(_mm_shuffle_ps(acc, acc, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+  }
+
+  s0 = Xn1;
+  s1 = Xn2;
+  s2 = Yn1;
+  s3 = Yn2;
+  _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+  _mm_storeu_ps(pState, s0);
+  _mm_storeu_ps(pState + 4, s1);
+  _mm_storeu_ps(pState + 8, s2);
+  _mm_storeu_ps(pState + 12, s3);
+}
+
+/**   
+ * @param[in]  *S         points to an instance of the floating-point Biquad cascade structure.   
+ * @param[in]  *pSrc      points to the block of input data.   
+ * @param[out] *pDst      points to the block of output data.   
+ * @param[in]  blockSize  number of samples to process per call.   
+ * @return     none.   
+ *   
+ * Stages are taken four at a time, the remaining ones one at a time.   
+ */
+
+void arm_biquad_cascade_df1_f32(
+  const arm_biquad_casd_df1_inst_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pIn = pSrc;                         /* source pointer */
+  float32_t *pState = S->pState;                 /* pState pointer */
+  float32_t *pCoeffs = S->pCoeffs;               /* coefficient pointer */
+  uint32_t stage = S->numStages;                 /* loop counter */
+
+  if (blockSize == 0u)
+  {
+    return;
+  }
+
+  for (; stage >= 4u; stage -= 4u)
+  {
+    arm_biquad_df1_4stages_f32(pCoeffs, pState, pIn, pDst, blockSize);
+
+    /* Later stages work in place in the output buffer */
+    pIn = pDst;
+    pCoeffs += 20u;
+    pState += 16u;
+  }
+
+  for (; stage > 0u; stage--)
+  {
+    arm_biquad_df1_stage_f32(pCoeffs, pState, pIn, pDst, blockSize);
+
+    pIn = pDst;
+    pCoeffs += 5u;
+    pState += 4u;
+  }
+}
+
+/**   
+ * @} end of BiquadCascadeDF1 group   
+ */
@@ -0,0 +1,359 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_cfft_radix4_f32.c   
+*   
+* Description:	SSE radix-4 decimation in frequency CFFT & CIFFT, also used   
+*               by the RFFT/RIFFT.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#include "arm_host_math.h"
+
+/*   
+ * The butterflies of the C code, on four butterflies at once.  a, b, c   
+ * and d are the four inputs, which become the outputs in the same order as   
+ * the C code stores them: b gets twiddle 2 and c gets twiddle 1.   
+ */
+typedef struct
+{
+  __m128 re;
+  __m128 im;
+} arm_cfft_v4_t;
+
+static inline void arm_radix4_butterfly_v4(
+  arm_cfft_v4_t * a,
+  arm_cfft_v4_t * b,
+  arm_cfft_v4_t * c,
+  arm_cfft_v4_t * d,
+  __m128 co1, __m128 si1,
+  __m128 co2, __m128 si2,
+  __m128 co3, __m128 si3,
+  int inverse)
+{
+  __m128 r1, r2, s1, s2, t1, t2;
+
+  r1 = _mm_add_ps(a->re, c->re);
+  r2 = _mm_sub_ps(a->re, c->re);
+  s1 = _mm_add_ps(a->im, c->im);
+  s2 = _mm_sub_ps(a->im, c->im);
+  t1 = _mm_add_ps(b->re, d->re);
+  a->re = _mm_add_ps(r1, t1);
+  r1 = _mm_sub_ps(r1, t1);
+  t2 = _mm_add_ps(b->im, d->im);
+  a->im = _mm_add_ps(s1, t2);
+  s1 = _mm_sub_ps(s1, t2);
+  t1 = _mm_sub_ps(b->im, d->im);
+  t2 = _mm_sub_ps(b->re, d->re);
+
+  if (!inverse)
+  {
+    b->re = _mm_add_ps(_mm_mul_ps(r1, co2), _mm_mul_ps(s1, si2));
+    b->im = _mm_sub_ps(_mm_mul_ps(s1, co2), _mm_mul_ps(r1, si2));
+    r1 = _mm_add_ps(r2, t1);
+    r2 = _mm_sub_ps(r2, t1);
+    s1 = _mm_sub_ps(s2, t2);
+    s2 = _mm_add_ps(s2, t2);
+    c->re = _mm_add_ps(_mm_mul_ps(r1, co1), _mm_mul_ps(s1, si1));
+    c->im = _mm_sub_ps(_mm_mul_ps(s1, co1), _mm_mul_ps(r1, si1));
+    d->re = _mm_add_ps(_mm_mul_ps(r2, co3), _mm_mul_ps(s2, si3));
+    d->im = _mm_sub_ps(_mm_mul_ps(s2, co3), _mm_mul_ps(r2, si3));
+  }
+  else
+  {
+    b->re = _mm_sub_ps(_mm_mul_ps(r1, co2), _mm_mul_ps(s1, si2));
+    b->im = _mm_add_ps(_mm_mul_ps(s1, co2), _mm_mul_ps(r1, si2));
+    r1 = _mm_sub_ps(r2, t1);
+    r2 = _mm_add_ps(r2, t1);
+    s1 = _mm_add_ps(s2, t2);
+    s2 = _mm_sub_ps(s2, t2);
+    c->re = _mm_sub_ps(_mm_mul_ps(r1, co1), _mm_mul_ps(s1, si1));
+    c->im = _mm_add_ps(_mm_mul_ps(s1, co1), _mm_mul_ps(r1, si1));
+    d->re = _mm_sub_ps(_mm_mul_ps(r2, co3), _mm_mul_ps(s2, si3));
+    d->im = _mm_add_ps(_mm_mul_ps(s2, co3), _mm_mul_ps(r2, si3));
+  }
+}
+
+/* Four complex values from interleaved data, and back */
+static inline void arm_cfft_load_v4(
+  arm_cfft_v4_t * v,
+  float32_t * p)
+{
+  __m128 lo = _mm_loadu_ps(p);
+  __m128 hi = _mm_loadu_ps(p + 4);
+
+  v->re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+  v->im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static inline void arm_cfft_store_v4(
+  float32_t * p,
+  arm_cfft_v4_t * v)
+{
+  _mm_storeu_ps(p, _mm_unpacklo_ps(v->re, v->im));
+  _mm_storeu_ps(p + 4, _mm_unpackhi_ps(v->re, v->im));
+}
+
+/*   
+ * The stages with groups of four or more butterflies.  Butterflies j to   
+ * j + 3 of a group use neighbouring inputs, so they are loaded as vectors,   
+ * with the twiddles of each gathered once for all groups.   
+ */
+static void arm_radix4_stage_f32(
+  float32_t * pSrc,
+  uint32_t fftLen,
+  uint32_t n2,
+  float32_t * pCoef,
+  uint32_t twidCoefModifier,
+  int inverse)
+{
+  arm_cfft_v4_t a, b, c, d;
+  __m128 co1, si1, co2, si2, co3, si3;
+  uint32_t n1 = n2 * 4u;
+  uint32_t j, i0, ia[4], k;
+  float32_t tw[6][4];
+
+  for (j = 0u; j < n2; j += 4u)
+  {
+    for (k = 0u; k < 4u; k++)
+    {
+      ia[k] = (j + k) * twidCoefModifier;
+      tw[0][k] = pCoef[ia[k] * 2u];
+      tw[1][k] = pCoef[(ia[k] * 2u) + 1u];
+      tw[2][k] = pCoef[ia[k] * 4u];
+      tw[3][k] = pCoef[(ia[k] * 4u) + 1u];
+      tw[4][k] = pCoef[ia[k] * 6u];
+      tw[5][k] = pCoef[(ia[k] * 6u) + 1u];
+    }
+    co1 = _mm_loadu_ps(tw[0]);
+    si1 = _mm_loadu_ps(tw[1]);
+    co2 = _mm_loadu_ps(tw[2]);
+    si2 = _mm_loadu_ps(tw[3]);
+    co3 = _mm_loadu_ps(tw[4]);
+    si3 = _mm_loadu_ps(tw[5]);
+
+    for (i0 = j; i0 < fftLen; i0 += n1)
+    {
+      arm_cfft_load_v4(&a, pSrc + 2u * i0);
+      arm_cfft_load_v4(&b, pSrc + 2u * (i0 + n2));
+      arm_cfft_load_v4(&c, pSrc + 2u * (i0 + 2u * n2));
+      arm_cfft_load_v4(&d, pSrc + 2u * (i0 + 3u * n2));
+
+      arm_radix4_butterfly_v4(&a, &b, &c, &d, co1, si1, co2, si2, co3, si3, inverse);
+
+      arm_cfft_store_v4(pSrc + 2u * i0, &a);
+      arm_cfft_store_v4(pSrc + 2u * (i0 + n2), &b);
+      arm_cfft_store_v4(pSrc + 2u * (i0 + 2u * n2), &c);
+      arm_cfft_store_v4(pSrc + 2u * (i0 + 3u * n2), &d);
+    }
+  }
+}
+
+/*   
+ * The last stage, where each butterfly takes four neighbouring inputs.   
+ * Four butterflies are loaded and transposed so that each vector holds the   
+ * same input of all four.  The inverse scales by onebyfftLen instead of   
+ * using twiddles, as the C code does.   
+ */
+static void arm_radix4_last_stage_f32(
+  float32_t * pSrc,
+  uint32_t fftLen,
+  float32_t * pCoef,
+  int inverse,
+  float32_t onebyfftLen)
+{
+  arm_cfft_v4_t v[4];
+  __m128 r1, r2, s1, s2, t1, t2, scale, co, si;
+  uint32_t i0, k;
+
+  co = _mm_set1_ps(pCoef[0]);
+  si = _mm_set1_ps(pCoef[1]);
+  scale = _mm_set1_ps(onebyfftLen);
+
+  for (i0 = 0u; i0 < fftLen; i0 += 16u)
+  {
+    /* v[k] holds butterfly k, then input k of each butterfly */
+    for (k = 0u; k < 4u; k++)
+    {
+      __m128 lo = _mm_loadu_ps(pSrc + 2u * (i0 + 4u * k));
+      __m128 hi = _mm_loadu_ps(pSrc + 2u * (i0 + 4u * k) + 4u);
+
+      v[k].re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+      v[k].im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+    _MM_TRANSPOSE4_PS(v[0].re, v[1].re, v[2].re, v[3].re);
+    _MM_TRANSPOSE4_PS(v[0].im, v[1].im, v[2].im, v[3].im);
+
+    if (!inverse)
+    {
+      arm_radix4_butterfly_v4(&v[0], &v[1], &v[2], &v[3], co, si, co, si, co, si, 0);
+    }
+    else
+    {
+      r1 = _mm_add_ps(v[0].re, v[2].re);
+      r2 = _mm_sub_ps(v[0].re, v[2].re);
+      s1 = _mm_add_ps(v[0].im, v[2].im);
+      s2 = _mm_sub_ps(v[0].im, v[2].im);
+      t1 = _mm_add_ps(v[1].re, v[3].re);
+      v[0].re = _mm_mul_ps(_mm_add_ps(r1, t1), scale);
+      r1 = _mm_sub_ps(r1, t1);
+      t2 = _mm_add_ps(v[1].im, v[3].im);
+      v[0].im = _mm_mul_ps(_mm_add_ps(s1, t2), scale);
+      s1 = _mm_sub_ps(s1, t2);
+      t1 = _mm_sub_ps(v[1].im, v[3].im);
+      t2 = _mm_sub_ps(v[1].re, v[3].re);
+      v[1].re = _mm_mul_ps(r1, scale);
+      v[1].im = _mm_mul_ps(s1, scale);
+      r1 = _mm_sub_ps(r2, t1);
+      r2 = _mm_add_ps(r2, t1);
+      s1 = _mm_add_ps(s2, t2);
+      s2 = _mm_sub_ps(s2, t2);
+      v[2].re = _mm_mul_ps(r1, scale);
+      v[2].im = _mm_mul_ps(s1, scale);
+      v[3].re = _mm_mul_ps(r2, scale);
+      v[3].im = _mm_mul_ps(s2, scale);
+    }
+
+    _MM_TRANSPOSE4_PS(v[0].re, v[1].re, v[2].re, v[3].re);
+    _MM_TRANSPOSE4_PS(v[0].im, v[1].im, v[2].im, v[3].im);
+    for (k = 0u; k < 4u; k++)
+    {
+      arm_cfft_store_v4(pSrc + 2u * (i0 + 4u * k), &v[k]);
+    }
+  }
+}
+
+/**   
+ * @ingroup groupTransforms   
+ */
+
+/**   
+ * @addtogroup CFFT_CIFFT   
+ * @{   
+ */
+
+/**   
+ * @details   
+ * @brief Processing function for the floating-point CFFT/CIFFT.   
+ * @param[in]      *S    points to an instance of the floating-point CFFT/CIFFT structure.   
+ * @param[in, out] *pSrc points to the complex data buffer of size <code>2*fftLen</code>. Processing occurs in-place.   
+ * @return none.   
+ */
+
+void arm_cfft_radix4_f32(
+  const arm_cfft_radix4_instance_f32 * S,
+  float32_t * pSrc)
+{
+
+  if(S->ifftFlag == 1u)
+  {
+    /*  Complex IFFT radix-4  */
+    arm_radix4_butterfly_inverse_f32(pSrc, S->fftLen, S->pTwiddle,
+                                     S->twidCoefModifier, S->onebyfftLen);
+  }
+  else
+  {
+    /*  Complex FFT radix-4  */
+    arm_radix4_butterfly_f32(pSrc, S->fftLen, S->pTwiddle,
+                             S->twidCoefModifier);
+  }
+
+  if(S->bitReverseFlag == 1u)
+  {
+    /*  Bit Reversal */
+    arm_bitreversal_f32(pSrc, S->fftLen, S->bitRevFactor, S->pBitRevTable);
+  }
+
+}
+
+/**   
+ * @} end of CFFT_CIFFT group   
+ */
+
+/*   
+ * @brief  Core function for the floating-point CFFT butterfly process.   
+ * @param[in, out] *pSrc            points to the in-place buffer of floating-point data type.   
+ * @param[in]      fftLen           length of the FFT.   
+ * @param[in]      *pCoef           points to the twiddle coefficient buffer.   
+ * @param[in]      twidCoefModifier twiddle coefficient modifier that supports different size FFTs with the same twiddle factor table.   
+ * @return none.   
+ */
+
+void arm_radix4_butterfly_f32(
+  float32_t * pSrc,
+  uint16_t fftLen,
+  float32_t * pCoef,
+  uint16_t twidCoefModifier)
+{
+  uint32_t n2;
+  uint32_t modifier = twidCoefModifier;
+
+  /* A 4 point FFT is a single butterfly */
+  if (fftLen < 16u)
+  {
+    ref_arm_radix4_butterfly_f32(pSrc, fftLen, pCoef, twidCoefModifier);
+    return;
+  }
+
+  for (n2 = fftLen >> 2u; n2 > 1u; n2 >>= 2u)
+  {
+    arm_radix4_stage_f32(pSrc, fftLen, n2, pCoef, modifier, 0);
+    modifier <<= 2u;
+  }
+
+  arm_radix4_last_stage_f32(pSrc, fftLen, pCoef, 0, 0.0f);
+}
+
+/*   
+ * @brief  Core function for the floating-point CIFFT butterfly process.   
+ * @param[in, out] *pSrc            points to the in-place buffer of floating-point data type.   
+ * @param[in]      fftLen           length of the FFT.   
+ * @param[in]      *pCoef           points to twiddle coefficient buffer.   
+ * @param[in]      twidCoefModifier twiddle coefficient modifier that supports different size FFTs with the same twiddle factor table.   
+ * @param[in]      onebyfftLen      value of 1/fftLen.   
+ * @return none.   
+ */
+
+void arm_radix4_butterfly_inverse_f32(
+  float32_t * pSrc,
+  uint16_t fftLen,
+  float32_t * pCoef,
+  uint16_t twidCoefModifier,
+  float32_t onebyfftLen)
+{
+  uint32_t n2;
+  uint32_t modifier = twidCoefModifier;
+
+  if (fftLen < 16u)
+  {
+    ref_arm_radix4_butterfly_inverse_f32(pSrc, fftLen, pCoef, twidCoefModifier,
+                                         onebyfftLen);
+    return;
+  }
+
+  for (n2 = fftLen >> 2u; n2 > 1u; n2 >>= 2u)
+  {
+    arm_radix4_stage_f32(pSrc, fftLen, n2, pCoef, modifier, 1);
+    modifier <<= 2u;
+  }
+
+  arm_radix4_last_stage_f32(pSrc, fftLen, pCoef, 1, onebyfftLen);
+}
+
+/*   
+ * @brief  In-place bit reversal function, the C version.   
+ * @param[in, out] *pSrc        points to the in-place buffer of floating-point data type.   
+ * @param[in]      fftSize      length of the FFT.   
+ * @param[in]      bitRevFactor bit reversal modifier that supports different size FFTs with the same bit reversal table.   
+ * @param[in]      *pBitRevTab  points to the bit reversal table.   
+ * @return none.   
+ */
+
+void arm_bitreversal_f32(
+  float32_t * pSrc,
+  uint16_t fftSize,
+  uint16_t bitRevFactor,
+  uint16_t * pBitRevTab)
+{
+  ref_arm_bitreversal_f32(pSrc, fftSize, bitRevFactor, pBitRevTab);
+}
@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_dot_prod_q15.c   
+*   
+* Description:	SSE/AVX2 Q15 dot product.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#include "arm_host_math.h"
+
+/**   
+ * @ingroup groupMath   
+ */
+
+/**   
+ * @addtogroup dot_prod   
+ * @{   
+ */
+
+/**   
+ * @brief Dot product of Q15 vectors.   
+ * @param[in]       *pSrcA points to the first input vector   
+ * @param[in]       *pSrcB points to the second input vector   
+ * @param[in]       blockSize number of samples in each vector   
+ * @param[out]      *result output result returned here   
+ * @return none.   
+ *   
+ * The products are added in pairs by pmaddwd and the pair sums widened to   
+ * 64 bits.  The sum is exact, so the order does not change the result.  A   
+ * pair sum only overflows 32 bits when both products are 0x8000 * 0x8000,   
+ * giving INT32_MIN for 2^31; these are counted and 2^32 added for each.   
+ */
+
+void arm_dot_prod_q15(
+  q15_t * pSrcA,
+  q15_t * pSrcB,
+  uint32_t blockSize,
+  q63_t * result)
+{
+  q63_t sum = 0;                                 /* Temporary result storage */
+  uint32_t i = 0u;                               /* loop counter */
+  int64_t lanes[4];                              /* Lanes of the vector sums */
+  int32_t wraps[8];                              /* Lanes of the overflow counts */
+
+#ifdef __AVX2__
+
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  __m256i count = _mm256_setzero_si256();
+  __m256i min = _mm256_set1_epi32(INT32_MIN);
+  __m256i p;
+
+  for (; i + 16u <= blockSize; i += 16u)
+  {
+    p = _mm256_madd_epi16(_mm256_loadu_si256((__m256i *) (pSrcA + i)),
+                          _mm256_loadu_si256((__m256i *) (pSrcB + i)));
+
+    count = _mm256_sub_epi32(count, _mm256_cmpeq_epi32(p, min));
+    acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p)));
+    acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p, 1)));
+  }
+
+  _mm256_storeu_si256((__m256i *) lanes, _mm256_add_epi64(acc0, acc1));
+  _mm256_storeu_si256((__m256i *) wraps, count);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  sum += ((q63_t) wraps[0] + wraps[1] + wraps[2] + wraps[3] +
+          wraps[4] + wraps[5] + wraps[6] + wraps[7]) << 32;
+
+#else
+
+  __m128i acc0 = _mm_setzero_si128();
+  __m128i acc1 = _mm_setzero_si128();
+  __m128i count = _mm_setzero_si128();
+  __m128i min = _mm_set1_epi32(INT32_MIN);
+  __m128i p;
+
+  for (; i + 8u <= blockSize; i += 8u)
+  {
+    p = _mm_madd_epi16(_mm_loadu_si128((__m128i *) (pSrcA + i)),
+                       _mm_loadu_si128((__m128i *) (pSrcB + i)));
+
+    count = _mm_sub_epi32(count, _mm_cmpeq_epi32(p, min));
+    acc0 = _mm_add_epi64(acc0, _mm_cvtepi32_epi64(p));
+    acc1 = _mm_add_epi64(acc1, _mm_cvtepi32_epi64(_mm_unpackhi_epi64(p, p)));
+  }
+
+  _mm_storeu_si128((__m128i *) lanes, _mm_add_epi64(acc0, acc1));
+  _mm_storeu_si128((__m128i *) wraps, count);
+  sum = lanes[0] + lanes[1];
+  sum += ((q63_t) wraps[0] + wraps[1] + wraps[2] + wraps[3]) << 32;
+
+#endif /* __AVX2__ */
+
+  /* The remaining samples */
+  for (; i < blockSize; i++)
+  {
+    sum += (q63_t) ((q31_t) pSrcA[i] * pSrcB[i]);
+  }
+
+  /* Store the result in the destination buffer in 34.30 format */
+  *result = sum;
+}
+
+/**   
+ * @} end of dot_prod group   
+ */
@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_dot_prod_q31.c   
+*   
+* Description:	SSE/AVX2 Q31 dot product.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#include "arm_host_math.h"
+
+/**   
+ * @ingroup groupMath   
+ */
+
+/**   
+ * @addtogroup dot_prod   
+ * @{   
+ */
+
+/**   
+ * @brief Dot product of Q31 vectors.   
+ * @param[in]       *pSrcA points to the first input vector   
+ * @param[in]       *pSrcB points to the second input vector   
+ * @param[in]       blockSize number of samples in each vector   
+ * @param[out]      *result output result returned here   
+ * @return none.   
+ *   
+ * pmuldq gives the 64 bit products of the even elements, and of the odd   
+ * ones once shifted down.  Each product is truncated to 2.48 format as in   
+ * the C code; there is no 64 bit arithmetic shift before AVX-512, so the   
+ * sign bits are put back after a logical one.   
+ */
+
+void arm_dot_prod_q31(
+  q31_t * pSrcA,
+  q31_t * pSrcB,
+  uint32_t blockSize,
+  q63_t * result)
+{
+  q63_t sum = 0;                                 /* Temporary result storage */
+  uint32_t i = 0u;                               /* loop counter */
+  int64_t lanes[4];                              /* Lanes of the vector sum */
+
+#ifdef __AVX2__
+
+  __m256i acc = _mm256_setzero_si256();
+  __m256i zero = _mm256_setzero_si256();
+  __m256i top = _mm256_set1_epi64x((int64_t) (~0ULL << 50));
+  __m256i a, b, even, odd;
+
+  for (; i + 8u <= blockSize; i += 8u)
+  {
+    a = _mm256_loadu_si256((__m256i *) (pSrcA + i));
+    b = _mm256_loadu_si256((__m256i *) (pSrcB + i));
+
+    even = _mm256_mul_epi32(a, b);
+    odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+    even = _mm256_or_si256(_mm256_srli_epi64(even, 14),
+                           _mm256_and_si256(_mm256_cmpgt_epi64(zero, even), top));
+    odd = _mm256_or_si256(_mm256_srli_epi64(odd, 14),
+                          _mm256_and_si256(_mm256_cmpgt_epi64(zero, odd), top));
+
+    acc = _mm256_add_epi64(acc, _mm256_add_epi64(even, odd));
+  }
+
+  _mm256_storeu_si256((__m256i *) lanes, acc);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+#else
+
+  __m128i acc = _mm_setzero_si128();
+  __m128i zero = _mm_setzero_si128();
+  __m128i top = _mm_set1_epi64x((int64_t) (~0ULL << 50));
+  __m128i a, b, even, odd;
+
+  for (; i + 4u <= blockSize; i += 4u)
+  {
+    a = _mm_loadu_si128((__m128i *) (pSrcA + i));
+    b = _mm_loadu_si128((__m128i *) (pSrcB + i));
+
+    even = _mm_mul_epi32(a, b);
+    odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    even = _mm_or_si128(_mm_srli_epi64(even, 14),
+                        _mm_and_si128(_mm_cmpgt_epi64(zero, even), top));
+    odd = _mm_or_si128(_mm_srli_epi64(odd, 14),
+                       _mm_and_si128(_mm_cmpgt_epi64(zero, odd), top));
+
+    acc = _mm_add_epi64(acc, _mm_add_epi64(even, odd));
+  }
+
+  _mm_storeu_si128((__m128i *) lanes, acc);
+  sum = lanes[0] + lanes[1];
+
+#endif /* __AVX2__ */
+
+  /* The remaining samples */
+  for (; i < blockSize; i++)
+  {
+    sum += ((q63_t) pSrcA[i] * pSrcB[i]) >> 14u;
+  }
+
+  /* Store the result in the destination buffer in 16.48 format */
+  *result = sum;
+}
+
+/**   
+ * @} end of dot_prod group   
+ */
@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_fir_f32.c   
+*   
+* Description:	SSE/AVX floating-point FIR filter processing function.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#include "arm_host_math.h"
+
+/**   
+ * @ingroup groupFilters   
+ */
+
+/**   
+ * @addtogroup FIR   
+ * @{   
+ */
+
+/**   
+ * @brief Processing function for the floating-point FIR filter.   
+ * @param[in]   *S points to an instance of the floating-point FIR structure.   
+ * @param[in]   *pSrc points to the block of input data.   
+ * @param[out]  *pDst points to the block of output data.   
+ * @param[in]   blockSize number of samples to process per call.   
+ * @return      none.   
+ *   
+ * Four vectors of outputs are computed at once, each lane accumulating its   
+ * taps in the same order as the C code, from zero.  The outputs left over   
+ * are done one at a time.   
+ */
+
+void arm_fir_f32(
+  const arm_fir_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pState = S->pState;                 /* State pointer */
+  float32_t *pCoeffs = S->pCoeffs;               /* Coefficient pointer */
+  float32_t *px;                                 /* Temporary pointer for state buffer */
+  uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+  uint32_t i, k;                                 /* Loop counters */
+  float32_t acc;                                 /* Accumulator */
+  vf32_t acc0, acc1, acc2, acc3, b;              /* Vector accumulators and coefficient */
+
+  /* The new samples go after the numTaps - 1 previous ones */
+  memcpy(&pState[numTaps - 1u], pSrc, blockSize * sizeof(float32_t));
+
+  /* Blocks of four vectors of outputs */
+  for (i = 0u; i + (4u * VF32_LANES) <= blockSize; i += 4u * VF32_LANES)
+  {
+    px = &pState[i];
+
+    acc0 = vf32_zero();
+    acc1 = vf32_zero();
+    acc2 = vf32_zero();
+    acc3 = vf32_zero();
+
+    for (k = 0u; k < numTaps; k++)
+    {
+      b = vf32_set1(pCoeffs[k]);
+
+      acc0 = vf32_add(acc0, vf32_mul(vf32_load(px + k), b));
+      acc1 = vf32_add(acc1, vf32_mul(vf32_load(px + k + VF32_LANES), b));
+      acc2 = vf32_add(acc2, vf32_mul(vf32_load(px + k + 2u * VF32_LANES), b));
+      acc3 = vf32_add(acc3, vf32_mul(vf32_load(px + k + 3u * VF32_LANES), b));
+    }
+
+    vf32_store(pDst + i, acc0);
+    vf32_store(pDst + i + VF32_LANES, acc1);
+    vf32_store(pDst + i + 2u * VF32_LANES, acc2);
+    vf32_store(pDst + i + 3u * VF32_LANES, acc3);
+  }
+
+  /* Single vectors of outputs */
+  for (; i + VF32_LANES <= blockSize; i += VF32_LANES)
+  {
+    px = &pState[i];
+    acc0 = vf32_zero();
+
+    for (k = 0u; k < numTaps; k++)
+    {
+      acc0 = vf32_add(acc0, vf32_mul(vf32_load(px + k), vf32_set1(pCoeffs[k])));
+    }
+
+    vf32_store(pDst + i, acc0);
+  }
+
+  /* The remaining outputs */
+  for (; i < blockSize; i++)
+  {
+    px = &pState[i];
+    acc = 0.0f;
+
+    for (k = 0u; k < numTaps; k++)
+    {
+      acc += px[k] * pCoeffs[k];
+    }
+
+    pDst[i] = acc;
+  }
+
+  /* Keep the last numTaps - 1 samples for the next call */
+  memmove(pState, &pState[blockSize], (numTaps - 1u) * sizeof(float32_t));
+}
+
+/**   
+ * @} end of FIR group   
+ */
@@ -0,0 +1,386 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_host_bench.c   
+*   
+* Description:	Checks the SSE/AVX2 kernels of the host build against the   
+*               reference C code, then measures both.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "arm_host_math.h"
+
+/* Largest sizes used */
+#define MAX_TAPS        64u
+#define MAX_BLOCK       256u
+#define MAX_STAGES      9u
+#define MAX_FFT         1024u
+#define MAX_MAT         64u
+#define MAX_DOT         1024u
+
+/* Big enough for a complex FFT or a matrix */
+#define MAX_BUF         (MAX_MAT * MAX_MAT)
+
+/* Each kernel is timed for about this long */
+#define BENCH_SECONDS   0.2
+
+static uint32_t seed = 12345u;
+static int failures;
+
+static uint32_t rand32(void)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return seed;
+}
+
+/* In -1 to 1 */
+static float32_t randf(void)
+{
+  return ((float32_t) (int32_t) rand32()) / 2147483648.0f;
+}
+
+static void fill_f32(float32_t * p, uint32_t n)
+{
+  while (n--)
+  {
+    *p++ = randf();
+  }
+}
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void check(const char * name, int ok)
+{
+  printf("%-60s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok)
+  {
+    failures++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+** Bit-exactness
+** ------------------------------------------------------------------- */
+
+static float32_t bufA[MAX_BUF], bufB[MAX_BUF];
+static float32_t outA[MAX_MAT * MAX_MAT], outB[MAX_MAT * MAX_MAT];
+static float32_t stateA[MAX_TAPS + MAX_BLOCK], stateB[MAX_TAPS + MAX_BLOCK];
+static float32_t coeffs[MAX_MAT * MAX_MAT];
+
+static int same(const void * a, const void * b, uint32_t bytes)
+{
+  return memcmp(a, b, bytes) == 0;
+}
+
+static void test_fir(void)
+{
+  static const uint16_t taps[] = {1, 2, 3, 7, 16, 29, 64};
+  static const uint32_t blocks[] = {1, 5, 8, 31, 32, 33, 100, 256};
+  arm_fir_instance_f32 a, b;
+  uint32_t t, k, call;
+  int ok = 1;
+
+  for (t = 0u; t < sizeof(taps) / sizeof(taps[0]); t++)
+  {
+    for (k = 0u; k < sizeof(blocks) / sizeof(blocks[0]); k++)
+    {
+      fill_f32(coeffs, taps[t]);
+      arm_fir_init_f32(&a, taps[t], coeffs, stateA, blocks[k]);
+      arm_fir_init_f32(&b, taps[t], coeffs, stateB, blocks[k]);
+
+      /* Twice, so the state carried over is checked too */
+      for (call = 0u; call < 2u; call++)
+      {
+        fill_f32(bufA, blocks[k]);
+        memcpy(bufB, bufA, blocks[k] * sizeof(float32_t));
+        arm_fir_f32(&a, bufA, outA, blocks[k]);
+        ref_arm_fir_f32(&b, bufB, outB, blocks[k]);
+        ok &= same(outA, outB, blocks[k] * sizeof(float32_t));
+        ok &= same(stateA, stateB, (taps[t] - 1u) * sizeof(float32_t));
+      }
+    }
+  }
+
+  check("arm_fir_f32 is bit-exact", ok);
+}
+
+/* A stable section, poles inside the unit circle */
+static void biquad_coeffs(float32_t * p, uint32_t numStages)
+{
+  while (numStages--)
+  {
+    float32_t r = 0.5f + 0.45f * (randf() + 1.0f) / 2.0f;
+    float32_t c = randf();
+
+    *p++ = randf();
+    *p++ = randf();
+    *p++ = randf();
+    *p++ = 2.0f * r * c;
+    *p++ = -r * r;
+  }
+}
+
+static void test_biquad(void)
+{
+  static const uint32_t stages[] = {1, 2, 3, 4, 5, 7, 8, 9};
+  static const uint32_t blocks[] = {1, 2, 3, 4, 5, 17, 64, 256};
+  arm_biquad_casd_df1_inst_f32 a, b;
+  uint32_t s, k, call;
+  int ok = 1;
+
+  for (s = 0u; s < sizeof(stages) / sizeof(stages[0]); s++)
+  {
+    for (k = 0u; k < sizeof(blocks) / sizeof(blocks[0]); k++)
+    {
+      biquad_coeffs(coeffs, stages[s]);
+      arm_biquad_cascade_df1_init_f32(&a, stages[s], coeffs, stateA);
+      arm_biquad_cascade_df1_init_f32(&b, stages[s], coeffs, stateB);
+
+      for (call = 0u; call < 3u; call++)
+      {
+        fill_f32(bufA, blocks[k]);
+        memcpy(bufB, bufA, blocks[k] * sizeof(float32_t));
+
+        /* The last call works in place */
+        if (call == 2u)
+        {
+          arm_biquad_cascade_df1_f32(&a, bufA, bufA, blocks[k]);
+          ref_arm_biquad_cascade_df1_f32(&b, bufB, bufB, blocks[k]);
+          ok &= same(bufA, bufB, blocks[k] * sizeof(float32_t));
+        }
+        else
+        {
+          arm_biquad_cascade_df1_f32(&a, bufA, outA, blocks[k]);
+          ref_arm_biquad_cascade_df1_f32(&b, bufB, outB, blocks[k]);
+          ok &= same(outA, outB, blocks[k] * sizeof(float32_t));
+        }
+        ok &= same(stateA, stateB, 4u * stages[s] * sizeof(float32_t));
+      }
+    }
+  }
+
+  check("arm_biquad_cascade_df1_f32 is bit-exact", ok);
+}
+
+static void test_cfft(void)
+{
+  static const uint16_t lengths[] = {16, 64, 256, 1024};
+  arm_cfft_radix4_instance_f32 S;
+  uint32_t l, inverse, bitrev;
+  int ok = 1;
+
+  for (l = 0u; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+  {
+    for (inverse = 0u; inverse < 2u; inverse++)
+    {
+      for (bitrev = 0u; bitrev < 2u; bitrev++)
+      {
+        arm_cfft_radix4_init_f32(&S, lengths[l], inverse, bitrev);
+        fill_f32(bufA, 2u * lengths[l]);
+        memcpy(bufB, bufA, 2u * lengths[l] * sizeof(float32_t));
+        arm_cfft_radix4_f32(&S, bufA);
+        ref_arm_cfft_radix4_f32(&S, bufB);
+        ok &= same(bufA, bufB, 2u * lengths[l] * sizeof(float32_t));
+      }
+    }
+  }
+
+  check("arm_cfft_radix4_f32 is bit-exact", ok);
+}
+
+static void test_mat(void)
+{
+  static const uint16_t dims[][3] = {
+    {1, 1, 1}, {3, 5, 7}, {8, 8, 8}, {16, 16, 16}, {10, 33, 47}, {64, 64, 64}, {5, 64, 33}
+  };
+  arm_matrix_instance_f32 A, B, C;
+  uint32_t d;
+  int ok = 1;
+
+  for (d = 0u; d < sizeof(dims) / sizeof(dims[0]); d++)
+  {
+    arm_mat_init_f32(&A, dims[d][0], dims[d][1], bufA);
+    arm_mat_init_f32(&B, dims[d][1], dims[d][2], coeffs);
+    fill_f32(bufA, dims[d][0] * dims[d][1]);
+    fill_f32(coeffs, dims[d][1] * dims[d][2]);
+
+    arm_mat_init_f32(&C, dims[d][0], dims[d][2], outA);
+    ok &= arm_mat_mult_f32(&A, &B, &C) == ARM_MATH_SUCCESS;
+    arm_mat_init_f32(&C, dims[d][0], dims[d][2], outB);
+    ok &= ref_arm_mat_mult_f32(&A, &B, &C) == ARM_MATH_SUCCESS;
+    ok &= same(outA, outB, dims[d][0] * dims[d][2] * sizeof(float32_t));
+  }
+
+  check("arm_mat_mult_f32 is bit-exact", ok);
+}
+
+static void test_dot(void)
+{
+  static const uint32_t lengths[] = {0, 1, 7, 8, 15, 16, 17, 100, 1024};
+  static q15_t a15[MAX_DOT], b15[MAX_DOT];
+  static q31_t a31[MAX_DOT], b31[MAX_DOT];
+  q63_t ra, rb;
+  uint32_t l, i, extreme;
+  int ok15 = 1, ok31 = 1;
+
+  for (extreme = 0u; extreme < 2u; extreme++)
+  {
+    for (l = 0u; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    {
+      for (i = 0u; i < lengths[l]; i++)
+      {
+        /* The most negative values, whose products overflow a pair sum */
+        a15[i] = extreme ? -32768 : (q15_t) rand32();
+        b15[i] = extreme ? -32768 : (q15_t) rand32();
+        a31[i] = extreme ? INT32_MIN : (q31_t) rand32();
+        b31[i] = extreme ? INT32_MIN : (q31_t) rand32();
+      }
+
+      arm_dot_prod_q15(a15, b15, lengths[l], &ra);
+      ref_arm_dot_prod_q15(a15, b15, lengths[l], &rb);
+      ok15 &= ra == rb;
+
+      arm_dot_prod_q31(a31, b31, lengths[l], &ra);
+      ref_arm_dot_prod_q31(a31, b31, lengths[l], &rb);
+      ok31 &= ra == rb;
+    }
+  }
+
+  check("arm_dot_prod_q15 is exact", ok15);
+  check("arm_dot_prod_q31 is exact", ok31);
+}
+
+/* ----------------------------------------------------------------------
+** Benchmark
+** ------------------------------------------------------------------- */
+
+typedef void (*bench_fn_t)(int ref);
+
+static arm_fir_instance_f32 bench_fir_S;
+static arm_biquad_casd_df1_inst_f32 bench_biquad_S;
+static arm_cfft_radix4_instance_f32 bench_cfft_S;
+static arm_matrix_instance_f32 bench_A, bench_B, bench_C;
+static q15_t bench_a15[MAX_DOT], bench_b15[MAX_DOT];
+static q31_t bench_a31[MAX_DOT], bench_b31[MAX_DOT];
+static volatile q63_t bench_result;
+
+static void bench_fir(int ref)
+{
+  (ref ? ref_arm_fir_f32 : arm_fir_f32)(&bench_fir_S, bufA, outA, MAX_BLOCK);
+}
+
+static void bench_biquad(int ref)
+{
+  (ref ? ref_arm_biquad_cascade_df1_f32 : arm_biquad_cascade_df1_f32)
+    (&bench_biquad_S, bufA, outA, MAX_BLOCK);
+}
+
+static void bench_cfft(int ref)
+{
+  memcpy(bufB, bufA, 2u * MAX_FFT * sizeof(float32_t));
+  (ref ? ref_arm_cfft_radix4_f32 : arm_cfft_radix4_f32)(&bench_cfft_S, bufB);
+}
+
+static void bench_mat(int ref)
+{
+  (ref ? ref_arm_mat_mult_f32 : arm_mat_mult_f32)(&bench_A, &bench_B, &bench_C);
+}
+
+static void bench_dot15(int ref)
+{
+  q63_t r;
+
+  (ref ? ref_arm_dot_prod_q15 : arm_dot_prod_q15)(bench_a15, bench_b15, MAX_DOT, &r);
+  bench_result = r;
+}
+
+static void bench_dot31(int ref)
+{
+  q63_t r;
+
+  (ref ? ref_arm_dot_prod_q31 : arm_dot_prod_q31)(bench_a31, bench_b31, MAX_DOT, &r);
+  bench_result = r;
+}
+
+/* Millions of samples per second */
+static double bench_rate(bench_fn_t fn, int ref, uint32_t samples)
+{
+  double start = now(), elapsed;
+  uint32_t calls = 0u, i;
+
+  do
+  {
+    for (i = 0u; i < 16u; i++)
+    {
+      fn(ref);
+    }
+    calls += 16u;
+    elapsed = now() - start;
+  } while (elapsed < BENCH_SECONDS);
+
+  return (double) calls * samples / elapsed / 1e6;
+}
+
+static void bench(const char * name, const char * unit, bench_fn_t fn, uint32_t samples)
+{
+  double ref = bench_rate(fn, 1, samples);
+  double simd = bench_rate(fn, 0, samples);
+
+  printf("%-34s %-14s %9.1f %9.1f %7.1fx\n", name, unit, ref, simd, simd / ref);
+}
+
+int main(void)
+{
+  uint32_t i;
+
+  printf("CMSIS DSP host build, %s\n\n",
+#ifdef __AVX2__
+         "AVX2"
+#else
+         "SSE4.2"
+#endif
+         );
+
+  test_fir();
+  test_biquad();
+  test_cfft();
+  test_mat();
+  test_dot();
+
+  fill_f32(bufA, 2u * MAX_FFT);
+  fill_f32(coeffs, MAX_MAT * MAX_MAT);
+  arm_fir_init_f32(&bench_fir_S, MAX_TAPS, coeffs, stateA, MAX_BLOCK);
+  biquad_coeffs(coeffs, 8u);
+  arm_biquad_cascade_df1_init_f32(&bench_biquad_S, 8u, coeffs, stateB);
+  arm_cfft_radix4_init_f32(&bench_cfft_S, MAX_FFT, 0u, 1u);
+  arm_mat_init_f32(&bench_A, MAX_MAT, MAX_MAT, bufA);
+  arm_mat_init_f32(&bench_B, MAX_MAT, MAX_MAT, coeffs);
+  arm_mat_init_f32(&bench_C, MAX_MAT, MAX_MAT, outA);
+  for (i = 0u; i < MAX_DOT; i++)
+  {
+    bench_a15[i] = (q15_t) rand32();
+    bench_b15[i] = (q15_t) rand32();
+    bench_a31[i] = (q31_t) rand32();
+    bench_b31[i] = (q31_t) rand32();
+  }
+
+  printf("\n%-34s %-14s %9s %9s\n", "Msamples/s", "sample", "C", "SIMD");
+  bench("arm_fir_f32, 64 taps", "output", bench_fir, MAX_BLOCK);
+  bench("arm_biquad_cascade_df1_f32, 8 st", "output", bench_biquad, MAX_BLOCK);
+  bench("arm_cfft_radix4_f32, 1024 points", "point", bench_cfft, MAX_FFT);
+  bench("arm_mat_mult_f32, 64x64", "output element", bench_mat, MAX_MAT * MAX_MAT);
+  bench("arm_dot_prod_q15, 1024", "input pair", bench_dot15, MAX_DOT);
+  bench("arm_dot_prod_q31, 1024", "input pair", bench_dot31, MAX_DOT);
+
+  printf("\n%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
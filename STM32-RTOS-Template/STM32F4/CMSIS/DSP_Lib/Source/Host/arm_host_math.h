@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_host_math.h   
+*   
+* Description:	Vector helpers for the SSE/AVX2 kernels of the host build,   
+*               and the reference C functions they replace.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#ifndef _ARM_HOST_MATH_H
+#define _ARM_HOST_MATH_H
+
+#include "arm_math.h"
+#include <immintrin.h>
+
+/**   
+ * The host build compiles the library for ARM_MATH_CM0, so that every   
+ * function uses its generic C code, and replaces the kernels below with   
+ * SSE/AVX2 versions.  The generic C versions of these are also built, with   
+ * a ref_ prefix, and the vector versions give bit-exact results against   
+ * them: each output is computed with the same operations in the same   
+ * order, only for several outputs at once.   
+ */
+
+/* Reference C versions of the replaced kernels */
+void ref_arm_fir_f32(
+  const arm_fir_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+void ref_arm_biquad_cascade_df1_f32(
+  const arm_biquad_casd_df1_inst_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+void ref_arm_cfft_radix4_f32(
+  const arm_cfft_radix4_instance_f32 * S,
+  float32_t * pSrc);
+
+void ref_arm_radix4_butterfly_f32(
+  float32_t * pSrc,
+  uint16_t fftLen,
+  float32_t * pCoef,
+  uint16_t twidCoefModifier);
+
+void ref_arm_radix4_butterfly_inverse_f32(
+  float32_t * pSrc,
+  uint16_t fftLen,
+  float32_t * pCoef,
+  uint16_t twidCoefModifier,
+  float32_t onebyfftLen);
+
+void ref_arm_bitreversal_f32(
+  float32_t * pSrc,
+  uint16_t fftSize,
+  uint16_t bitRevFactor,
+  uint16_t * pBitRevTab);
+
+arm_status ref_arm_mat_mult_f32(
+  const arm_matrix_instance_f32 * pSrcA,
+  const arm_matrix_instance_f32 * pSrcB,
+  arm_matrix_instance_f32 * pDst);
+
+void ref_arm_dot_prod_q15(
+  q15_t * pSrcA,
+  q15_t * pSrcB,
+  uint32_t blockSize,
+  q63_t * result);
+
+void ref_arm_dot_prod_q31(
+  q31_t * pSrcA,
+  q31_t * pSrcB,
+  uint32_t blockSize,
+  q63_t * result);
+
+/*   
+ * Floating-point vectors, 8 lanes with AVX and 4 with SSE.  Only separate   
+ * multiplies and adds are used, so that results round as in the C code.   
+ */
+#ifdef __AVX__
+
+typedef __m256 vf32_t;
+
+#define VF32_LANES              8u
+#define vf32_zero()             _mm256_setzero_ps()
+#define vf32_set1(x)            _mm256_set1_ps(x)
+#define vf32_load(p)            _mm256_loadu_ps(p)
+#define vf32_store(p, v)        _mm256_storeu_ps((p), (v))
+#define vf32_add(a, b)          _mm256_add_ps((a), (b))
+#define vf32_mul(a, b)          _mm256_mul_ps((a), (b))
+
+#else
+
+typedef __m128 vf32_t;
+
+#define VF32_LANES              4u
+#define vf32_zero()             _mm_setzero_ps()
+#define vf32_set1(x)            _mm_set1_ps(x)
+#define vf32_load(p)            _mm_loadu_ps(p)
+#define vf32_store(p, v)        _mm_storeu_ps((p), (v))
+#define vf32_add(a, b)          _mm_add_ps((a), (b))
+#define vf32_mul(a, b)          _mm_mul_ps((a), (b))
+
+#endif /* __AVX__ */
+
+#endif /* _ARM_HOST_MATH_H */
@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------   
+* Project: 	    CMSIS DSP Library, host build   
+* Title:	    arm_mat_mult_f32.c   
+*   
+* Description:	SSE/AVX floating-point matrix multiplication.   
+*   
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it   
+* -------------------------------------------------------------------- */
+
+#include "arm_host_math.h"
+
+/**   
+ * @ingroup groupMatrix   
+ */
+
+/**   
+ * @addtogroup MatrixMult   
+ * @{   
+ */
+
+/**   
+ * @brief Floating-point matrix multiplication.   
+ * @param[in]       *pSrcA points to the first input matrix structure   
+ * @param[in]       *pSrcB points to the second input matrix structure   
+ * @param[out]      *pDst points to output matrix structure   
+ * @return     		The function returns either   
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.   
+ *   
+ * Each row of the output is computed a few vectors of columns at a time,   
+ * from rows of B, with every element summed from zero in the order of the   
+ * C code.   
+ */
+
+arm_status arm_mat_mult_f32(
+  const arm_matrix_instance_f32 * pSrcA,
+  const arm_matrix_instance_f32 * pSrcB,
+  arm_matrix_instance_f32 * pDst)
+{
+  float32_t *pInA = pSrcA->pData;                /* input data matrix pointer A */
+  float32_t *pInB = pSrcB->pData;                /* input data matrix pointer B */
+  float32_t *pOut = pDst->pData;                 /* output data matrix pointer */
+  float32_t *pRowA, *pColB;                      /* Temporary pointers */
+  float32_t sum;                                 /* Accumulator */
+  uint32_t numRowsA = pSrcA->numRows;            /* number of rows of input matrix A */
+  uint32_t numColsB = pSrcB->numCols;            /* number of columns of input matrix B */
+  uint32_t numColsA = pSrcA->numCols;            /* number of columns of input matrix A */
+  uint32_t row, col, k;                          /* loop counters */
+  vf32_t acc0, acc1, acc2, acc3, a;              /* Vector accumulators and element of A */
+
+#ifdef ARM_MATH_MATRIX_CHECK
+  /* Check for matrix mismatch condition */
+  if((pSrcA->numCols != pSrcB->numRows) ||
+     (pSrcA->numRows != pDst->numRows) || (pSrcB->numCols != pDst->numCols))
+  {
+    /* Set status as ARM_MATH_SIZE_MISMATCH */
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+#endif /*      #ifdef ARM_MATH_MATRIX_CHECK    */
+
+  for (row = 0u; row < numRowsA; row++)
+  {
+    pRowA = pInA + row * numColsA;
+
+    /* Four vectors of columns */
+    for (col = 0u; col + (4u * VF32_LANES) <= numColsB; col += 4u * VF32_LANES)
+    {
+      acc0 = vf32_zero();
+      acc1 = vf32_zero();
+      acc2 = vf32_zero();
+      acc3 = vf32_zero();
+      pColB = pInB + col;
+
+      for (k = 0u; k < numColsA; k++)
+      {
+        a = vf32_set1(pRowA[k]);
+        acc0 = vf32_add(acc0, vf32_mul(a, vf32_load(pColB)));
+        acc1 = vf32_add(acc1, vf32_mul(a, vf32_load(pColB + VF32_LANES)));
+        acc2 = vf32_add(acc2, vf32_mul(a, vf32_load(pColB + 2u * VF32_LANES)));
+        acc3 = vf32_add(acc3, vf32_mul(a, vf32_load(pColB + 3u * VF32_LANES)));
+        pColB += numColsB;
+      }
+
+      vf32_store(pOut + col, acc0);
+      vf32_store(pOut + col + VF32_LANES, acc1);
+      vf32_store(pOut + col + 2u * VF32_LANES, acc2);
+      vf32_store(pOut + col + 3u * VF32_LANES, acc3);
+    }
+
+    /* Single vectors of columns */
+    for (; col + VF32_LANES <= numColsB; col += VF32_LANES)
+    {
+      acc0 = vf32_zero();
+      pColB = pInB + col;
+
+      for (k = 0u; k < numColsA; k++)
+      {
+        acc0 = vf32_add(acc0, vf32_mul(vf32_set1(pRowA[k]), vf32_load(pColB)));
+        pColB += numColsB;
+      }
+
+      vf32_store(pOut + col, acc0);
+    }
+
+    /* The remaining columns */
+    for (; col < numColsB; col++)
+    {
+      sum = 0.0f;
+      pColB = pInB + col;
+
+      for (k = 0u; k < numColsA; k++)
+      {
+        sum += pRowA[k] * *pColB;
+        pColB += numColsB;
+      }
+
+      pOut[col] = sum;
+    }
+
+    pOut += numColsB;
+  }
+
+  /* Set status as ARM_MATH_SUCCESS */
+  return ARM_MATH_SUCCESS;
+}
+
+/**   
+ * @} end of MatrixMult group   
+ */
@@ -0,0 +1,419 @@
+/* ----------------------------------------------------------------------
+* Project: 	    CMSIS DSP Library, host build
+* Title:	    arm_pipeline_bench.c
+*
+* Description:	Checks the streaming pipeline against the functions called
+*               one at a time over a whole signal, then measures both.
+*
+* Target Processor: x86-64 with SSE4.2, or AVX2 when built with it
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "arm_host_math.h"
+#include "arm_pipeline.h"
+
+/*
+ * The chain is a lowpass FIR, a cascade of biquads and a decimating FIR,
+ * then the spectrum of each decimated block:
+ *
+ *   FIR -> biquads -> decimate by DEC_M -> CFFT of blockSize / DEC_M
+ */
+#define FIR_TAPS        32u
+#define NUM_BIQUADS     4u
+#define DEC_TAPS        32u
+#define DEC_M           4u
+
+#define TEST_BLOCK      1024u
+#define TEST_BLOCKS     16u
+#define TEST_LEN        (TEST_BLOCK * TEST_BLOCKS)
+
+/* The signal of the benchmark is larger than the caches */
+#define BENCH_LEN       (1u << 20)
+#define BENCH_TILE      64u
+
+/* Each way is timed for about this long */
+#define BENCH_SECONDS   0.3
+
+typedef struct
+{
+  arm_fir_instance_f32 fir;
+  arm_biquad_casd_df1_inst_f32 biquad;
+  arm_fir_decimate_instance_f32 decimate;
+  arm_cfft_radix4_instance_f32 cfft;
+  float32_t *pFirState;
+  float32_t *pDecState;
+  float32_t biquadState[4u * NUM_BIQUADS];
+  arm_pipeline_stage_f32 stages[4];
+  arm_pipeline_instance_f32 pipe;
+  float32_t *pScratch;
+} chain_t;
+
+static float32_t firCoeffs[FIR_TAPS];
+static float32_t biquadCoeffs[5u * NUM_BIQUADS];
+static float32_t decCoeffs[DEC_TAPS];
+
+static uint32_t seed = 12345u;
+static int failures;
+
+static uint32_t rand32(void)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return seed;
+}
+
+/* In -1 to 1 */
+static float32_t randf(void)
+{
+  return ((float32_t) (int32_t) rand32()) / 2147483648.0f;
+}
+
+static void fill_f32(float32_t * p, uint32_t n)
+{
+  while (n--)
+  {
+    *p++ = randf();
+  }
+}
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void check(const char * name, int ok)
+{
+  printf("%-60s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok)
+  {
+    failures++;
+  }
+}
+
+static float32_t * alloc_f32(uint32_t n)
+{
+  float32_t *p = calloc(n, sizeof(float32_t));
+
+  if (p == NULL)
+  {
+    fprintf(stderr, "out of memory\n");
+    exit(2);
+  }
+  return p;
+}
+
+/* Triangular windows, and stable biquads */
+static void make_coeffs(void)
+{
+  uint32_t i;
+
+  for (i = 0u; i < FIR_TAPS; i++)
+  {
+    firCoeffs[i] = (float32_t) (i < FIR_TAPS / 2u ? i + 1u : FIR_TAPS - i) /
+      (FIR_TAPS * FIR_TAPS / 4.0f);
+  }
+  for (i = 0u; i < DEC_TAPS; i++)
+  {
+    decCoeffs[i] = (float32_t) (i < DEC_TAPS / 2u ? i + 1u : DEC_TAPS - i) /
+      (DEC_TAPS * DEC_TAPS / 4.0f);
+  }
+  for (i = 0u; i < NUM_BIQUADS; i++)
+  {
+    biquadCoeffs[5u * i] = 0.2f;
+    biquadCoeffs[5u * i + 1u] = 0.4f;
+    biquadCoeffs[5u * i + 2u] = 0.2f;
+    biquadCoeffs[5u * i + 3u] = 0.5f - 0.1f * i;
+    biquadCoeffs[5u * i + 4u] = -0.3f;
+  }
+}
+
+/* Instances for blocks of blockSize */
+static void chain_instances(chain_t * c, uint32_t blockSize, uint32_t fftLen)
+{
+  c->pFirState = alloc_f32(FIR_TAPS + blockSize - 1u);
+  c->pDecState = alloc_f32(DEC_TAPS + blockSize - 1u);
+  c->pScratch = NULL;
+
+  arm_fir_init_f32(&c->fir, FIR_TAPS, firCoeffs, c->pFirState, blockSize);
+  arm_biquad_cascade_df1_init_f32(&c->biquad, NUM_BIQUADS, biquadCoeffs,
+                                  c->biquadState);
+  arm_fir_decimate_init_f32(&c->decimate, DEC_TAPS, DEC_M, decCoeffs,
+                            c->pDecState, blockSize);
+  arm_cfft_radix4_init_f32(&c->cfft, fftLen, 0u, 1u);
+}
+
+/* The instances for blocks of blockSize, and the pipeline of them */
+static arm_status chain_init(chain_t * c, uint32_t blockSize, uint32_t tileSize)
+{
+  /* Fused, only the input of the CFFT needs block buffers */
+  uint32_t scratchSize = ARM_PIPELINE_SCRATCH_SIZE(tileSize ? blockSize / DEC_M :
+                                                   blockSize, tileSize);
+
+  chain_instances(c, blockSize, blockSize / DEC_M);
+  c->pScratch = alloc_f32(scratchSize);
+
+  c->stages[0].type = ARM_PIPELINE_FIR;
+  c->stages[0].pInstance = &c->fir;
+  c->stages[1].type = ARM_PIPELINE_BIQUAD;
+  c->stages[1].pInstance = &c->biquad;
+  c->stages[2].type = ARM_PIPELINE_DECIMATE;
+  c->stages[2].pInstance = &c->decimate;
+  c->stages[3].type = ARM_PIPELINE_CFFT;
+  c->stages[3].pInstance = &c->cfft;
+
+  return arm_pipeline_init_f32(&c->pipe, 4u, c->stages, blockSize, tileSize,
+                               c->pScratch, scratchSize);
+}
+
+static void chain_free(chain_t * c)
+{
+  free(c->pFirState);
+  free(c->pDecState);
+  free(c->pScratch);
+}
+
+/* The pipeline over a whole signal, one block at a time */
+static void run_pipeline(chain_t * c, float32_t * pSrc, float32_t * pDst,
+                         uint32_t len)
+{
+  uint32_t i;
+
+  for (i = 0u; i < len; i += c->pipe.blockSize)
+  {
+    arm_pipeline_f32(&c->pipe, pSrc + i, pDst);
+    pDst += c->pipe.outSize;
+  }
+}
+
+/*
+ * The way the examples do it: each function over the whole signal, with
+ * an instance for blocks of the whole length, then a CFFT per frame.
+ */
+typedef struct
+{
+  chain_t c;
+  float32_t *pTmpA;
+  float32_t *pTmpB;
+  uint32_t fftLen;
+} whole_t;
+
+static void whole_init(whole_t * w, uint32_t len, uint32_t fftLen)
+{
+  chain_instances(&w->c, len, fftLen);
+  w->pTmpA = alloc_f32(len);
+  w->pTmpB = alloc_f32(len);
+  w->fftLen = fftLen;
+}
+
+static void whole_free(whole_t * w)
+{
+  chain_free(&w->c);
+  free(w->pTmpA);
+  free(w->pTmpB);
+}
+
+static void run_whole(whole_t * w, float32_t * pSrc, float32_t * pDst,
+                      uint32_t len)
+{
+  uint32_t i, j;
+
+  arm_fir_f32(&w->c.fir, pSrc, w->pTmpA, len);
+  arm_biquad_cascade_df1_f32(&w->c.biquad, w->pTmpA, w->pTmpB, len);
+  arm_fir_decimate_f32(&w->c.decimate, w->pTmpB, w->pTmpA, len);
+
+  for (i = 0u; i < len / DEC_M; i += w->fftLen)
+  {
+    for (j = 0u; j < w->fftLen; j++)
+    {
+      pDst[2u * j] = w->pTmpA[i + j];
+      pDst[2u * j + 1u] = 0.0f;
+    }
+    arm_cfft_radix4_f32(&w->c.cfft, pDst);
+    pDst += 2u * w->fftLen;
+  }
+}
+
+/* ----------------------------------------------------------------------
+** Checks
+** ------------------------------------------------------------------- */
+
+static void test_pipeline(void)
+{
+  static const uint32_t tiles[] = {0u, 4u, 64u, 100u, TEST_BLOCK};
+  float32_t *pSignal = alloc_f32(TEST_LEN);
+  float32_t *pRef = alloc_f32(TEST_LEN / 2u);
+  float32_t *pOut = alloc_f32(TEST_LEN / 2u);
+  whole_t w;
+  chain_t c;
+  uint32_t t;
+  int ok;
+
+  fill_f32(pSignal, TEST_LEN);
+  whole_init(&w, TEST_LEN, TEST_BLOCK / DEC_M);
+  run_whole(&w, pSignal, pRef, TEST_LEN);
+  whole_free(&w);
+
+  for (t = 0u; t < sizeof(tiles) / sizeof(tiles[0]); t++)
+  {
+    char name[64];
+
+    ok = chain_init(&c, TEST_BLOCK, tiles[t]) == ARM_MATH_SUCCESS &&
+      c.pipe.outSize == TEST_BLOCK / 2u;
+    memset(pOut, 0, TEST_LEN / 2u * sizeof(float32_t));
+    run_pipeline(&c, pSignal, pOut, TEST_LEN);
+    ok = ok && memcmp(pOut, pRef, TEST_LEN / 2u * sizeof(float32_t)) == 0;
+    chain_free(&c);
+
+    if (tiles[t] == 0u)
+    {
+      snprintf(name, sizeof(name), "Blocks match the whole signal, not fused");
+    }
+    else
+    {
+      snprintf(name, sizeof(name), "Blocks match the whole signal, tiles of %u",
+               (unsigned) tiles[t]);
+    }
+    check(name, ok);
+  }
+
+  free(pSignal);
+  free(pRef);
+  free(pOut);
+}
+
+static void test_init(void)
+{
+  float32_t scratch[ARM_PIPELINE_SCRATCH_SIZE(256u, 64u)];
+  arm_pipeline_instance_f32 S;
+  chain_t c;
+
+  chain_init(&c, 256u, 0u);
+
+  check("A block which the decimator can not divide is refused",
+        arm_pipeline_init_f32(&S, 4u, c.stages, 258u, 0u, scratch,
+                              sizeof(scratch) / sizeof(float32_t))
+        == ARM_MATH_LENGTH_ERROR);
+  check("A block of the wrong length for the CFFT is refused",
+        arm_pipeline_init_f32(&S, 4u, c.stages, 512u, 0u, scratch,
+                              sizeof(scratch) / sizeof(float32_t))
+        == ARM_MATH_LENGTH_ERROR);
+  check("A scratch buffer which is too small is refused",
+        arm_pipeline_init_f32(&S, 4u, c.stages, 256u, 0u, scratch,
+                              ARM_PIPELINE_SCRATCH_SIZE(256u, 0u) - 1u)
+        == ARM_MATH_LENGTH_ERROR);
+  check("A fused pipeline only needs blocks for the CFFT input",
+        arm_pipeline_init_f32(&S, 4u, c.stages, 256u, 64u, scratch,
+                              ARM_PIPELINE_SCRATCH_SIZE(64u, 64u))
+        == ARM_MATH_SUCCESS &&
+        arm_pipeline_init_f32(&S, 4u, c.stages, 256u, 64u, scratch,
+                              ARM_PIPELINE_SCRATCH_SIZE(64u, 64u) - 1u)
+        == ARM_MATH_LENGTH_ERROR);
+  check("Tiles smaller than the decimation are refused",
+        arm_pipeline_init_f32(&S, 4u, c.stages, 256u, DEC_M - 1u, scratch,
+                              sizeof(scratch) / sizeof(float32_t))
+        == ARM_MATH_ARGUMENT_ERROR);
+  check("A pipeline without stages is refused",
+        arm_pipeline_init_f32(&S, 0u, c.stages, 256u, 0u, scratch,
+                              sizeof(scratch) / sizeof(float32_t))
+        == ARM_MATH_ARGUMENT_ERROR);
+  check("Stage lengths are worked out",
+        arm_pipeline_init_f32(&S, 4u, c.stages, 256u, 64u, scratch,
+                              sizeof(scratch) / sizeof(float32_t))
+        == ARM_MATH_SUCCESS && c.stages[2].outLen == 64u &&
+        c.stages[3].inLen == 64u && S.outSize == 128u);
+
+  chain_free(&c);
+}
+
+/* ----------------------------------------------------------------------
+** Benchmark
+** ------------------------------------------------------------------- */
+
+/* Millions of input samples per second */
+static double bench_rate(chain_t * c, whole_t * w, float32_t * pSrc,
+                         float32_t * pDst)
+{
+  double start = now(), elapsed;
+  uint32_t runs = 0u;
+
+  do
+  {
+    if (w != NULL)
+    {
+      run_whole(w, pSrc, pDst, BENCH_LEN);
+    }
+    else
+    {
+      run_pipeline(c, pSrc, pDst, BENCH_LEN);
+    }
+    runs++;
+    elapsed = now() - start;
+  } while (elapsed < BENCH_SECONDS);
+
+  return (double) runs * BENCH_LEN / elapsed / 1e6;
+}
+
+static void bench(uint32_t blockSize)
+{
+  float32_t *pSrc = alloc_f32(BENCH_LEN);
+  float32_t *pDst = alloc_f32(BENCH_LEN / 2u);
+  double whole, blocks, fused;
+  whole_t w;
+  chain_t c;
+
+  fill_f32(pSrc, BENCH_LEN);
+
+  whole_init(&w, BENCH_LEN, blockSize / DEC_M);
+  whole = bench_rate(NULL, &w, pSrc, pDst);
+  whole_free(&w);
+
+  chain_init(&c, blockSize, 0u);
+  blocks = bench_rate(&c, NULL, pSrc, pDst);
+  chain_free(&c);
+
+  chain_init(&c, blockSize, BENCH_TILE);
+  fused = bench_rate(&c, NULL, pSrc, pDst);
+  chain_free(&c);
+
+  printf("%8u %12.1f %12.1f %12.1f %10u %10u\n", (unsigned) blockSize, whole,
+         blocks, fused,
+         (unsigned) (ARM_PIPELINE_SCRATCH_SIZE(blockSize, 0u) * sizeof(float32_t)),
+         (unsigned) (ARM_PIPELINE_SCRATCH_SIZE(blockSize / DEC_M, BENCH_TILE) *
+                     sizeof(float32_t)));
+
+  free(pSrc);
+  free(pDst);
+}
+
+int main(void)
+{
+  make_coeffs();
+
+  printf("CMSIS DSP streaming pipeline, %s\n\n",
+#ifdef __AVX2__
+         "AVX2"
+#else
+         "SSE4.2"
+#endif
+         );
+
+  test_pipeline();
+  test_init();
+
+  printf("\nFIR %u taps, %u biquads, decimate by %u with %u taps, CFFT of "
+         "block / %u\n", FIR_TAPS, NUM_BIQUADS, DEC_M, DEC_TAPS, DEC_M);
+  printf("%u samples, tiles of %u\n\n", BENCH_LEN, BENCH_TILE);
+  printf("%8s %38s %21s\n", "", "Msamples/s in", "scratch bytes");
+  printf("%8s %12s %12s %12s %10s %10s\n", "block", "whole signal", "blocks",
+         "fused", "blocks", "fused");
+  bench(256u);
+  bench(1024u);
+  bench(4096u);
+
+  printf("\n%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+/* ----------------------------------------------------------------------
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_pipeline_f32.c
+*
+* Description:	Floating-point pipeline processing function.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0, or the host build
+* -------------------------------------------------------------------- */
+
+#include "arm_pipeline.h"
+
+/**
+ * @addtogroup Pipeline
+ * @{
+ */
+
+/**
+ * @brief  Runs one stage on len samples.
+ * @param[in]  *pStage points to the stage.
+ * @param[in]  *pIn    points to the input samples.
+ * @param[out] *pOut   points to the output, which is not the input.
+ * @param[in]  len     number of input samples.
+ * @return     the number of output values.
+ */
+
+static uint32_t arm_pipeline_stage_run_f32(
+  const arm_pipeline_stage_f32 * pStage,
+  float32_t * pIn,
+  float32_t * pOut,
+  uint32_t len)
+{
+  arm_fir_decimate_instance_f32 *pDecimate;      /* Decimator of the stage */
+  uint32_t i;                                    /* Loop counter */
+
+  switch (pStage->type)
+  {
+  case ARM_PIPELINE_FIR:
+    arm_fir_f32((arm_fir_instance_f32 *) pStage->pInstance, pIn, pOut, len);
+    break;
+
+  case ARM_PIPELINE_BIQUAD:
+    arm_biquad_cascade_df1_f32((arm_biquad_casd_df1_inst_f32 *)
+                               pStage->pInstance, pIn, pOut, len);
+    break;
+
+  case ARM_PIPELINE_DECIMATE:
+    pDecimate = (arm_fir_decimate_instance_f32 *) pStage->pInstance;
+    arm_fir_decimate_f32(pDecimate, pIn, pOut, len);
+    len = len / pDecimate->M;
+    break;
+
+  case ARM_PIPELINE_CFFT:
+    /* The real samples become complex ones, transformed in place */
+    for (i = 0u; i < len; i++)
+    {
+      pOut[2u * i] = pIn[i];
+      pOut[(2u * i) + 1u] = 0.0f;
+    }
+    arm_cfft_radix4_f32((arm_cfft_radix4_instance_f32 *) pStage->pInstance,
+                        pOut);
+    len = 2u * len;
+    break;
+
+  default:
+    break;
+  }
+
+  return (len);
+}
+
+/**
+ * @brief Processing function for the floating-point pipeline.
+ * @param[in]  *S    points to an instance of the floating-point pipeline structure.
+ * @param[in]  *pSrc points to the block of <code>blockSize</code> input samples, which is not changed.
+ * @param[out] *pDst points to the block of <code>outSize</code> output values.
+ * @return     none.
+ *
+ * <b>Description:</b>
+ * \par
+ * Without fusing each stage processes the whole block, from one block
+ * buffer into the other, and the last stage writes to <code>pDst</code>.
+ * With fusing each run of FIR, biquad and decimator stages takes its input
+ * a tile at a time through all of its stages, passing it between the tile
+ * buffers, and only the output of the run is kept as a whole block.  The
+ * tiles are <code>tileSize</code> rounded down to a multiple of the
+ * decimation of the run.
+ */
+
+void arm_pipeline_f32(
+  const arm_pipeline_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst)
+{
+  arm_pipeline_stage_f32 *pStages = S->pStages;  /* Stages of the pipeline */
+  uint16_t numStages = S->numStages;             /* Number of stages */
+  float32_t *pIn = pSrc;                         /* Input of the stage or run */
+  float32_t *pOut;                               /* Output of the stage or run */
+  float32_t *pTileIn, *pTileOut;                 /* Input and output of a stage in a tile */
+  uint32_t tile;                                 /* Input samples per tile of the run */
+  uint32_t offset, outOffset;                    /* Input and output position in the run */
+  uint32_t len;                                  /* Samples in the tile */
+  uint16_t first, last;                          /* Stages of the run */
+  uint16_t k;                                    /* Loop counter */
+
+  if(S->tileSize == 0u)
+  {
+    /* Each stage on the whole block */
+    for (k = 0u; k < numStages; k++)
+    {
+      pOut = (k == (numStages - 1u)) ? pDst :
+        ((pIn == S->pBlockA) ? S->pBlockB : S->pBlockA);
+
+      (void) arm_pipeline_stage_run_f32(&pStages[k], pIn, pOut,
+                                        pStages[k].inLen);
+      pIn = pOut;
+    }
+
+    return;
+  }
+
+  for (first = 0u; first < numStages; first = last)
+  {
+    /* A run of streaming stages, or a CFFT on its own */
+    last = first + 1u;
+    tile = 1u;
+    if(pStages[first].type != ARM_PIPELINE_CFFT)
+    {
+      while((last < numStages) && (pStages[last].type != ARM_PIPELINE_CFFT))
+      {
+        last++;
+      }
+      tile = pStages[first].inLen / pStages[last - 1u].outLen;
+    }
+
+    pOut = (last == numStages) ? pDst :
+      ((pIn == S->pBlockA) ? S->pBlockB : S->pBlockA);
+
+    if(pStages[first].type == ARM_PIPELINE_CFFT)
+    {
+      (void) arm_pipeline_stage_run_f32(&pStages[first], pIn, pOut,
+                                        pStages[first].inLen);
+      pIn = pOut;
+      continue;
+    }
+
+    /* tile holds the decimation of the run, round the tiles down to it */
+    tile = (S->tileSize / tile) * tile;
+    outOffset = 0u;
+
+    for (offset = 0u; offset < pStages[first].inLen; offset += tile)
+    {
+      len = pStages[first].inLen - offset;
+      if(len > tile)
+      {
+        len = tile;
+      }
+
+      pTileIn = pIn + offset;
+      for (k = first; k < last; k++)
+      {
+        pTileOut = (k == (last - 1u)) ? (pOut + outOffset) :
+          ((pTileIn == S->pTileA) ? S->pTileB : S->pTileA);
+
+        len = arm_pipeline_stage_run_f32(&pStages[k], pTileIn, pTileOut, len);
+        pTileIn = pTileOut;
+      }
+
+      outOffset += len;
+    }
+
+    pIn = pOut;
+  }
+}
+
+/**
+ * @} end of Pipeline group
+ */
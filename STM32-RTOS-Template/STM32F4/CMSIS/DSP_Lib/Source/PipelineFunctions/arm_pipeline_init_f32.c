@@ -0,0 +1,144 @@
+/* ----------------------------------------------------------------------
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_pipeline_init_f32.c
+*
+* Description:	Floating-point pipeline initialization function.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0, or the host build
+* -------------------------------------------------------------------- */
+
+#include "arm_pipeline.h"
+
+/**
+ * @addtogroup Pipeline
+ * @{
+ */
+
+/**
+ * @brief  Initialization function for the floating-point pipeline.
+ * @param[in,out] *S          points to an instance of the floating-point pipeline structure.
+ * @param[in]     numStages   number of stages.
+ * @param[in,out] *pStages    points to the array of stages.
+ * @param[in]     blockSize   samples into the pipeline per call.
+ * @param[in]     tileSize    samples per tile of a fused run, or 0 to run each stage on the whole block.
+ * @param[in]     *pScratch   points to the scratch buffer.
+ * @param[in]     scratchSize number of samples in the scratch buffer.
+ * @return        The function returns ARM_MATH_SUCCESS, ARM_MATH_LENGTH_ERROR if a
+ *                block does not fit the stage it reaches or the scratch buffer is too
+ *                small, or ARM_MATH_ARGUMENT_ERROR if there are no stages or a fused
+ *                run needs bigger tiles to decimate.
+ *
+ * <b>Description:</b>
+ * \par
+ * Works out the length of the block at each stage, checks that each
+ * decimator gets a multiple of its factor M and each CFFT gets exactly
+ * <code>fftLen</code> samples, and splits the scratch buffer.  In a
+ * fused run the tiles must hold at least the product of the decimation
+ * factors of the run, so that each tile gives whole output samples, and
+ * only the blocks passed from one run to the next need block buffers.
+ */
+
+arm_status arm_pipeline_init_f32(
+  arm_pipeline_instance_f32 * S,
+  uint16_t numStages,
+  arm_pipeline_stage_f32 * pStages,
+  uint32_t blockSize,
+  uint32_t tileSize,
+  float32_t * pScratch,
+  uint32_t scratchSize)
+{
+  arm_pipeline_stage_f32 *pStage;                /* Stage being set up */
+  uint32_t len = blockSize;                      /* Samples reaching the stage */
+  uint32_t maxLen = 0u;                          /* Longest block between stages */
+  uint32_t factor = 1u;                          /* Decimation of the fused run so far */
+  uint32_t M;                                    /* Decimation factor of a stage */
+  uint32_t runEnd;                               /* The stage ends a fused run */
+  uint16_t i;                                    /* Loop counter */
+
+  if((numStages == 0u) || (pStages == NULL))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  if(blockSize == 0u)
+  {
+    return (ARM_MATH_LENGTH_ERROR);
+  }
+
+  for (i = 0u; i < numStages; i++)
+  {
+    pStage = &pStages[i];
+    pStage->inLen = len;
+
+    switch (pStage->type)
+    {
+    case ARM_PIPELINE_FIR:
+    case ARM_PIPELINE_BIQUAD:
+      pStage->outLen = len;
+      break;
+
+    case ARM_PIPELINE_DECIMATE:
+      M = ((arm_fir_decimate_instance_f32 *) pStage->pInstance)->M;
+      if((M == 0u) || ((len % M) != 0u))
+      {
+        return (ARM_MATH_LENGTH_ERROR);
+      }
+      pStage->outLen = len / M;
+      factor *= M;
+      break;
+
+    case ARM_PIPELINE_CFFT:
+      if(len != ((arm_cfft_radix4_instance_f32 *) pStage->pInstance)->fftLen)
+      {
+        return (ARM_MATH_LENGTH_ERROR);
+      }
+      pStage->outLen = 2u * len;
+      break;
+
+    default:
+      return (ARM_MATH_ARGUMENT_ERROR);
+    }
+
+    /* A CFFT ends a fused run, each run must decimate whole tiles */
+    runEnd = (pStage->type == ARM_PIPELINE_CFFT) || (i == (numStages - 1u)) ||
+      (pStages[i + 1u].type == ARM_PIPELINE_CFFT);
+    if(runEnd)
+    {
+      if((tileSize != 0u) && (tileSize < factor))
+      {
+        return (ARM_MATH_ARGUMENT_ERROR);
+      }
+      factor = 1u;
+    }
+
+    /* Inside a fused run the data only passes through the tiles */
+    if((i < (numStages - 1u)) && ((tileSize == 0u) || runEnd) &&
+       (pStage->outLen > maxLen))
+    {
+      maxLen = pStage->outLen;
+    }
+
+    len = pStage->outLen;
+  }
+
+  if(scratchSize < ARM_PIPELINE_SCRATCH_SIZE(maxLen, tileSize))
+  {
+    return (ARM_MATH_LENGTH_ERROR);
+  }
+
+  S->numStages = numStages;
+  S->pStages = pStages;
+  S->blockSize = blockSize;
+  S->outSize = len;
+  S->tileSize = tileSize;
+  S->pBlockA = pScratch;
+  S->pBlockB = pScratch + maxLen;
+  S->pTileA = pScratch + (2u * maxLen);
+  S->pTileB = pScratch + (2u * maxLen) + tileSize;
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of Pipeline group
+ */
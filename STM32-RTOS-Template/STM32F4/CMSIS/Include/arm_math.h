@@ -5806,12 +5806,13 @@ extern "C"
 					    uint32_t blockSize)
   {
     uint32_t i = 0u;
-    int32_t rOffset, dst_end;
+    int32_t rOffset;
+    int32_t *dst_end;
 
     /* Copy the value of Index pointer that points
      * to the current location from where the input samples to be read */
     rOffset = *readOffset;
-    dst_end = (int32_t) (dst_base + dst_length);
+    dst_end = dst_base + dst_length;
 
     /* Loop over the blockSize */
     i = blockSize;
@@ -5824,7 +5825,7 @@ extern "C"
 	/* Update the input pointer */
 	dst += dstInc;
 
-	if(dst == (int32_t *) dst_end)
+	if(dst == dst_end)
 	  {
 	    dst = dst_base;
 	  }
@@ -5906,13 +5907,14 @@ extern "C"
 					    uint32_t blockSize)
   {
     uint32_t i = 0;
-    int32_t rOffset, dst_end;
+    int32_t rOffset;
+    q15_t *dst_end;
 
     /* Copy the value of Index pointer that points
      * to the current location from where the input samples to be read */
     rOffset = *readOffset;
 
-    dst_end = (int32_t) (dst_base + dst_length);
+    dst_end = dst_base + dst_length;
 
     /* Loop over the blockSize */
     i = blockSize;
@@ -5925,7 +5927,7 @@ extern "C"
 	/* Update the input pointer */
 	dst += dstInc;
 
-	if(dst == (q15_t *) dst_end)
+	if(dst == dst_end)
 	  {
 	    dst = dst_base;
 	  }
@@ -6008,13 +6010,14 @@ extern "C"
 					   uint32_t blockSize)
   {
     uint32_t i = 0;
-    int32_t rOffset, dst_end;
+    int32_t rOffset;
+    q7_t *dst_end;
 
     /* Copy the value of Index pointer that points
      * to the current location from where the input samples to be read */
     rOffset = *readOffset;
 
-    dst_end = (int32_t) (dst_base + dst_length);
+    dst_end = dst_base + dst_length;
 
     /* Loop over the blockSize */
     i = blockSize;
@@ -6027,7 +6030,7 @@ extern "C"
 	/* Update the input pointer */
 	dst += dstInc;
 
-	if(dst == (q7_t *) dst_end)
+	if(dst == dst_end)
 	  {
 	    dst = dst_base;
 	  }
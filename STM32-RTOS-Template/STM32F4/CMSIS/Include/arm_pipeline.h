@@ -0,0 +1,149 @@
+/* ----------------------------------------------------------------------
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_pipeline.h
+*
+* Description:	Streaming block pipelines of DSP Library functions.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0, or the host build
+* -------------------------------------------------------------------- */
+
+#ifndef _ARM_PIPELINE_H
+#define _ARM_PIPELINE_H
+
+#include "arm_math.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+  /**
+   * @defgroup Pipeline Streaming Pipelines
+   *
+   * A pipeline runs a block of samples through a chain of filter and
+   * transform instances, one block per call, in the same way as the
+   * functions would be called one after the other.  The instances keep
+   * their state between calls, so a signal arriving in DMA-sized blocks
+   * gives the same output as if it was processed in one piece.
+   *
+   * The stages are described by an array of arm_pipeline_stage_f32, each
+   * with its type and a pointer to an instance which has already been
+   * initialised:
+   * <pre>
+   *     arm_pipeline_stage_f32 stages[3] = {
+   *       {ARM_PIPELINE_FIR, &fir},
+   *       {ARM_PIPELINE_DECIMATE, &decimator},
+   *       {ARM_PIPELINE_CFFT, &cfft}
+   *     };
+   * </pre>
+   * Each instance must be initialised for the number of samples which
+   * reach it in one block, which is <code>blockSize</code> divided by the
+   * decimation factors of the stages before it.  A CFFT stage takes
+   * <code>fftLen</code> real samples and gives their spectrum as
+   * <code>2*fftLen</code> interleaved complex values.
+   *
+   * \par Fusing
+   * When <code>tileSize</code> is not zero, runs of FIR, biquad and
+   * decimator stages are fused: the block is taken <code>tileSize</code>
+   * samples at a time through all the stages of the run, so that the data
+   * between them stays in two small tile buffers instead of passing through
+   * whole blocks.  On the host the tiles stay in the level 1 cache, and on
+   * the target the scratch buffer can be placed in core coupled memory.
+   * A CFFT stage needs its whole frame, so it ends a run.  The output is
+   * the same whether the pipeline is fused or not.
+   *
+   * \par Scratch buffer
+   * The pipeline needs <code>2*maxLen</code> samples of scratch for the
+   * blocks between stages, where <code>maxLen</code> is the longest block
+   * passed from one stage to the next, and <code>2*tileSize</code> more
+   * when it is fused.  When fused only the blocks passed from one run to
+   * the next count for <code>maxLen</code>, so a chain of filters and
+   * decimators ending in a CFFT needs just the input block of the CFFT.
+   * ARM_PIPELINE_SCRATCH_SIZE() gives the size.
+   */
+
+  /**
+   * @brief Types of pipeline stage.
+   */
+  typedef enum
+  {
+    ARM_PIPELINE_FIR = 0,            /**< arm_fir_instance_f32 with arm_fir_f32(). */
+    ARM_PIPELINE_BIQUAD = 1,         /**< arm_biquad_casd_df1_inst_f32 with arm_biquad_cascade_df1_f32(). */
+    ARM_PIPELINE_DECIMATE = 2,       /**< arm_fir_decimate_instance_f32 with arm_fir_decimate_f32(). */
+    ARM_PIPELINE_CFFT = 3            /**< arm_cfft_radix4_instance_f32 with arm_cfft_radix4_f32(). */
+  } arm_pipeline_stage_type;
+
+  /**
+   * @brief Stage of a floating-point pipeline.
+   */
+  typedef struct
+  {
+    arm_pipeline_stage_type type;    /**< what the stage does. */
+    void *pInstance;                 /**< points to the initialised instance of the function. */
+    uint32_t inLen;                  /**< samples into the stage per block, set by arm_pipeline_init_f32(). */
+    uint32_t outLen;                 /**< values out of the stage per block, set by arm_pipeline_init_f32(). */
+  } arm_pipeline_stage_f32;
+
+  /**
+   * @brief Instance structure for the floating-point pipeline.
+   */
+  typedef struct
+  {
+    uint16_t numStages;              /**< number of stages in the pipeline. */
+    arm_pipeline_stage_f32 *pStages; /**< points to the array of stages. */
+    uint32_t blockSize;              /**< samples into the pipeline per call. */
+    uint32_t outSize;                /**< values out of the pipeline per call. */
+    uint32_t tileSize;               /**< samples per tile of a fused run, or 0 when not fused. */
+    float32_t *pBlockA;              /**< first block buffer, of maxLen samples. */
+    float32_t *pBlockB;              /**< second block buffer, of maxLen samples. */
+    float32_t *pTileA;               /**< first tile buffer, of tileSize samples. */
+    float32_t *pTileB;               /**< second tile buffer, of tileSize samples. */
+  } arm_pipeline_instance_f32;
+
+  /**
+   * @brief Size of the scratch buffer of a pipeline, in samples.
+   * @param[in] maxLen   longest block passed from one stage, or fused run, to the next.
+   * @param[in] tileSize samples per tile, or 0 when not fused.
+   */
+#define ARM_PIPELINE_SCRATCH_SIZE(maxLen, tileSize) (2u * (maxLen) + 2u * (tileSize))
+
+  /**
+   * @brief  Initialization function for the floating-point pipeline.
+   * @param[in,out] *S          points to an instance of the floating-point pipeline structure.
+   * @param[in]     numStages   number of stages.
+   * @param[in,out] *pStages    points to the array of stages.
+   * @param[in]     blockSize   samples into the pipeline per call.
+   * @param[in]     tileSize    samples per tile of a fused run, or 0 to run each stage on the whole block.
+   * @param[in]     *pScratch   points to the scratch buffer.
+   * @param[in]     scratchSize number of samples in the scratch buffer.
+   * @return        The function returns ARM_MATH_SUCCESS, ARM_MATH_LENGTH_ERROR if a
+   *                block does not fit the stage it reaches or the scratch buffer is too
+   *                small, or ARM_MATH_ARGUMENT_ERROR if there are no stages or a fused
+   *                run needs bigger tiles to decimate.
+   */
+  arm_status arm_pipeline_init_f32(
+  arm_pipeline_instance_f32 * S,
+  uint16_t numStages,
+  arm_pipeline_stage_f32 * pStages,
+  uint32_t blockSize,
+  uint32_t tileSize,
+  float32_t * pScratch,
+  uint32_t scratchSize);
+
+  /**
+   * @brief Processing function for the floating-point pipeline.
+   * @param[in]  *S    points to an instance of the floating-point pipeline structure.
+   * @param[in]  *pSrc points to the block of <code>blockSize</code> input samples, which is not changed.
+   * @param[out] *pDst points to the block of <code>outSize</code> output values.
+   * @return     none.
+   */
+  void arm_pipeline_f32(
+  const arm_pipeline_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _ARM_PIPELINE_H */
@@ -0,0 +1,451 @@
+//
+// Loopback test of the packet framing on the host: packets are encoded into
+// a ring as the communication task does, the bytes are fed back to the
+// receiver in pieces of any size, as the RX DMA would give them, and the
+// decoded packets go through the handler table.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "packet.h"
+
+//
+// A small pool, like the one of the communication task
+//
+#define TEST_POOL_SIZE 4
+#define TEST_RING_SIZE 512
+#define TEST_PACKETS   2000
+
+static xPacket_Type pool[TEST_POOL_SIZE];
+static xPacket_Type *free_list[TEST_POOL_SIZE];
+static uint32_t free_count;
+
+//
+// What the handlers saw
+//
+static xPacket_Type received[TEST_PACKETS];
+static uint32_t received_count;
+static uint32_t unhandled_count;
+static uint8_t hold_packets;
+static xPacket_Type *held[TEST_POOL_SIZE];
+static uint32_t held_count;
+
+static int failures;
+
+/*******************************************************************************
+ *******************************************************************************/
+static void check(const char *name, int ok)
+{
+    printf("%-60s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok){
+	failures++;
+    }
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+static xPacket_Type *prvAlloc(void)
+{
+    if (free_count == 0){
+	return NULL;
+    }
+
+    return free_list[--free_count];
+}
+
+static void prvFree(xPacket_Type *packet)
+{
+    free_list[free_count++] = packet;
+}
+
+static void prvPoolInit(void)
+{
+    uint32_t i;
+
+    free_count = 0;
+    for (i=0; i<TEST_POOL_SIZE; i++){
+	vPacket_Init(&pool[i]);
+	prvFree(&pool[i]);
+    }
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+static void prvRecordHandler(xPacket_Type *packet)
+{
+    if (received_count < TEST_PACKETS){
+	received[received_count++] = *packet;
+    }
+}
+
+static void prvDeliver(xPacket_Type *packet)
+{
+    if (!ucPacket_Dispatch(packet)){
+	unhandled_count++;
+    }
+    if (hold_packets){
+	held[held_count++] = packet;
+    }else{
+	prvFree(packet);
+    }
+}
+
+/*******************************************************************************
+ * Handlers for every type but one, which must come back unhandled
+ *******************************************************************************/
+#define TEST_UNHANDLED_TYPE 0x7E
+
+static void prvHandlersInit(void)
+{
+    uint32_t i;
+
+    vPacket_ClearHandlers();
+    for (i=0; i<=COMMUNICATION_MAX_PACKET_TYPE; i++){
+	if (i != TEST_UNHANDLED_TYPE){
+	    xPacket_AddHandler(prvRecordHandler, i);
+	}
+    }
+}
+
+/*******************************************************************************
+ * The CRC unit a bit at a time, for each word of the packet
+ *******************************************************************************/
+static uint32_t prvReferenceCRC(const xPacket_Type *packet)
+{
+    uint8_t bytes[2 + COMMUNICATION_MAX_PACKET_SIZE + 4];
+    uint32_t length = 2 + packet->size;
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t word;
+    uint32_t i, j;
+
+    memset(bytes, 0, sizeof(bytes));
+    bytes[0] = packet->type;
+    bytes[1] = packet->size;
+    memcpy(&bytes[2], packet->data, packet->size);
+
+    for (i=0; i<length; i+=4){
+	word = bytes[i] | (bytes[i+1] << 8) | (bytes[i+2] << 16) | ((uint32_t)bytes[i+3] << 24);
+	crc ^= word;
+	for (j=0; j<32; j++){
+	    crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+	}
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+ * Random packets, with plenty of zeros and long runs without them
+ *******************************************************************************/
+static void prvRandomPacket(xPacket_Type *packet, uint32_t n)
+{
+    uint32_t i;
+    uint32_t kind = rand() % 4;
+
+    vPacket_Init(packet);
+    packet->type = rand() & 0xFF;
+    packet->size = (n < 8) ? 255 - n : rand() & 0xFF;
+    for (i=0; i<packet->size; i++){
+	switch (kind){
+	case 0:
+	    packet->data[i] = rand() & 0xFF;
+	    break;
+	case 1:
+	    packet->data[i] = (rand() % 3) ? 0 : rand() & 0xFF;
+	    break;
+	default:
+	    packet->data[i] = 1 + (rand() % 255);
+	    break;
+	}
+    }
+}
+
+static int prvSamePacket(const xPacket_Type *a, const xPacket_Type *b)
+{
+    return (a->type == b->type) && (a->size == b->size) &&
+	(memcmp(a->data, b->data, a->size) == 0);
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+static void prvReset(xPacket_Receiver *rx)
+{
+    prvPoolInit();
+    vPacket_ReceiverInit(rx, prvAlloc, prvDeliver);
+    received_count = 0;
+    unhandled_count = 0;
+    hold_packets = 0;
+    held_count = 0;
+}
+
+/*******************************************************************************
+ * Encodes into a plain buffer
+ *******************************************************************************/
+static uint32_t prvFrame(xPacket_Type *packet, uint8_t *frame)
+{
+    return ulPacket_Encode(packet, frame, 0xFFFFFFFF, 0);
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+static void prvTestCRC(void)
+{
+    xPacket_Type packet;
+    uint32_t i;
+    int ok = 1;
+
+    for (i=0; i<1000; i++){
+	prvRandomPacket(&packet, i);
+	if (ulPacket_CRC(&packet) != prvReferenceCRC(&packet)){
+	    ok = 0;
+	}
+    }
+    check("Word CRC matches the CRC unit", ok);
+}
+
+/*******************************************************************************
+ * Encodes the packets into a ring, as the task does, and takes the bytes out
+ * again in pieces of random size
+ *******************************************************************************/
+static void prvTestLoopback(void)
+{
+    static xPacket_Type sent[TEST_PACKETS];
+    static uint8_t ring[TEST_RING_SIZE];
+    uint8_t frame[PACKET_MAX_FRAME];
+    xPacket_Receiver rx;
+    uint32_t head = 0, tail = 0;
+    uint32_t length, chunk, i, j;
+    int bounded = 1;
+    int ok = 1;
+
+    prvReset(&rx);
+
+    for (i=0; i<TEST_PACKETS; i++){
+	prvRandomPacket(&sent[i], i);
+
+	//
+	// A few of the edges of COBS: nothing, all zeros, and a run of
+	// exactly 254 bytes without a zero
+	//
+	if (i == 8){
+	    sent[i].type = 0;
+	    sent[i].size = 0;
+	}
+	if (i == 9){
+	    memset(sent[i].data, 0, sent[i].size = 200);
+	    sent[i].type = 0;
+	}
+	if (i == 10){
+	    sent[i].type = 1;
+	    memset(sent[i].data, 0xFF, sent[i].size = 252);
+	}
+
+	length = ulPacket_Encode(&sent[i], ring, TEST_RING_SIZE - 1, head);
+	head += length;
+
+	for (j=0; j<length-1; j++){
+	    if (ring[(head - length + j) & (TEST_RING_SIZE - 1)] == 0){
+		bounded = 0;
+	    }
+	}
+	if ((length > PACKET_MAX_FRAME) || (ring[(head - 1) & (TEST_RING_SIZE - 1)] != 0)){
+	    bounded = 0;
+	}
+
+	//
+	// Drain the ring as the DMA would
+	//
+	while (tail != head){
+	    chunk = 1 + (rand() % 64);
+	    if (chunk > head - tail){
+		chunk = head - tail;
+	    }
+	    if (chunk > TEST_RING_SIZE - (tail & (TEST_RING_SIZE - 1))){
+		chunk = TEST_RING_SIZE - (tail & (TEST_RING_SIZE - 1));
+	    }
+	    vPacket_Receive(&rx, &ring[tail & (TEST_RING_SIZE - 1)], chunk);
+	    tail += chunk;
+	}
+    }
+
+    check("Frames hold no zero but the delimiter, within PACKET_MAX_FRAME", bounded);
+
+    j = 0;
+    for (i=0; i<TEST_PACKETS; i++){
+	if (sent[i].type == TEST_UNHANDLED_TYPE){
+	    continue;
+	}
+	if ((j >= received_count) || !prvSamePacket(&sent[i], &received[j])){
+	    ok = 0;
+	    break;
+	}
+	j++;
+    }
+    check("Packets come back in order through the handlers", ok && (j == received_count));
+    check("Packets without a handler are reported", unhandled_count == rx.frames - received_count);
+    check("No errors on a clean line", (rx.crc_errors == 0) && (rx.framing_errors == 0) && (rx.dropped == 0));
+    check("Pool is whole again", (free_count == TEST_POOL_SIZE) && (rx.packet == NULL));
+
+    //
+    // The encoded size of the edge cases
+    //
+    check("An empty packet is 8 bytes on the line", prvFrame(&sent[8], frame) == PACKET_OVERHEAD + 2);
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+static void prvTestErrors(void)
+{
+    xPacket_Type packet;
+    uint8_t frame[PACKET_MAX_FRAME];
+    uint8_t garbage[40];
+    xPacket_Receiver rx;
+    uint32_t length, i;
+
+    prvHandlersInit();
+
+    //
+    // A data byte changed on the way
+    //
+    prvReset(&rx);
+    prvRandomPacket(&packet, 100);
+    packet.type = 0x10;
+    packet.size = 20;
+    memset(packet.data, 0x55, packet.size);
+    length = prvFrame(&packet, frame);
+    frame[10] ^= 0x0F;
+    vPacket_Receive(&rx, frame, length);
+    check("A bad CRC is counted and nothing is delivered",
+	  (rx.crc_errors == 1) && (received_count == 0) && (free_count == TEST_POOL_SIZE - 1));
+
+    //
+    // Half a frame with its delimiter, then half a frame without: the first
+    // good frame after the second is lost with it
+    //
+    prvReset(&rx);
+    length = prvFrame(&packet, frame);
+    vPacket_Receive(&rx, frame, length / 2);
+    vPacket_Receive(&rx, (const uint8_t *)"", 1);
+    vPacket_Receive(&rx, frame, length);
+    check("A cut frame is a framing error, the next frame is good",
+	  (rx.framing_errors == 1) && (received_count == 1));
+    vPacket_Receive(&rx, frame, length / 2);
+    vPacket_Receive(&rx, frame, length);
+    vPacket_Receive(&rx, frame, length);
+    check("A frame without its end takes the next with it, then resyncs",
+	  (rx.framing_errors + rx.crc_errors == 2) && (received_count == 2));
+
+    //
+    // Noise between frames
+    //
+    prvReset(&rx);
+    for (i=0; i<sizeof(garbage); i++){
+	garbage[i] = 1 + (rand() % 255);
+    }
+    vPacket_Receive(&rx, frame, length);
+    vPacket_Receive(&rx, garbage, sizeof(garbage));
+    vPacket_Receive(&rx, (const uint8_t *)"", 1);
+    vPacket_Receive(&rx, frame, length);
+    check("Noise between frames is one error",
+	  (rx.framing_errors + rx.crc_errors == 1) && (received_count == 2));
+
+    //
+    // A size byte which does not match the data
+    //
+    prvReset(&rx);
+    length = prvFrame(&packet, frame);
+    frame[2] = 3;
+    vPacket_Receive(&rx, frame, length);
+    frame[2] = 40;
+    vPacket_Receive(&rx, frame, length);
+    check("A wrong size is a framing error", (rx.framing_errors == 2) && (received_count == 0));
+
+    //
+    // The handlers keep every packet: the pool runs dry
+    //
+    prvReset(&rx);
+    hold_packets = 1;
+    length = prvFrame(&packet, frame);
+    for (i=0; i<TEST_POOL_SIZE + 2; i++){
+	vPacket_Receive(&rx, frame, length);
+    }
+    check("Frames with no packet to go in are dropped",
+	  (received_count == TEST_POOL_SIZE) && (rx.dropped == 2));
+    hold_packets = 0;
+    while (held_count){
+	prvFree(held[--held_count]);
+    }
+    vPacket_Receive(&rx, frame, length);
+    check("Frames come in again once packets are freed", received_count == TEST_POOL_SIZE + 1);
+
+    //
+    // The whole table can be used
+    //
+    check("Handler for type 0xFF", xPacket_AddHandler(prvRecordHandler, 0xFF) == ERROR_NONE);
+    check("No handler past the table", xPacket_AddHandler(prvRecordHandler, 0x100) == ERROR_INDEX);
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+static void prvBench(void)
+{
+    static uint8_t ring[TEST_RING_SIZE];
+    xPacket_Type packet;
+    xPacket_Receiver rx;
+    uint32_t length, head = 0;
+    uint32_t i, n = 200000;
+    double t0, t1;
+
+    prvReset(&rx);
+    prvRandomPacket(&packet, 100);
+    packet.size = 64;
+    received_count = 0;
+
+    t0 = now();
+    for (i=0; i<n; i++){
+	length = ulPacket_Encode(&packet, ring, TEST_RING_SIZE - 1, head);
+	if ((head & (TEST_RING_SIZE - 1)) + length <= TEST_RING_SIZE){
+	    vPacket_Receive(&rx, &ring[head & (TEST_RING_SIZE - 1)], length);
+	}else{
+	    vPacket_Receive(&rx, &ring[head & (TEST_RING_SIZE - 1)], TEST_RING_SIZE - (head & (TEST_RING_SIZE - 1)));
+	    vPacket_Receive(&rx, ring, length - (TEST_RING_SIZE - (head & (TEST_RING_SIZE - 1))));
+	}
+	head += length;
+	received_count = 0;
+    }
+    t1 = now();
+
+    check("Every benchmark frame is delivered", rx.frames == n);
+    printf("\n%u packets of %u bytes encoded and decoded: %.0f packets/s, %.1f MB/s\n",
+	   n, packet.size, n / (t1 - t0), n * (PACKET_OVERHEAD + packet.size) / (t1 - t0) / 1e6);
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+int main(void)
+{
+    srand(1);
+
+    prvTestCRC();
+    prvHandlersInit();
+    prvTestLoopback();
+    prvTestErrors();
+    prvBench();
+
+    printf("\n%s\n", failures ? "FAILED" : "ALL PASSED");
+
+    return failures ? 1 : 0;
+}
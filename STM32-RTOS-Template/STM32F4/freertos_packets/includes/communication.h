@@ -1,28 +1,23 @@
-
 #ifndef __COMMUNICATION_H__
 #define __COMMUNICATION_H__
 
+#include "packet.h"
+
 //
 // OS level defines for creating tasks, queues, etc...
 //
 #define COMMUNICATION_STACK_SIZE 256
-#define COMMUNICATION_QUEUE_SIZE 4
+#define COMMUNICATION_QUEUE_SIZE 8
 
 //
-// List of packets or actions we know how to handle
+// Packets for reception and transmission come from a pool, so they are
+// never copied through the queue.  The rings are what the DMA works on,
+// each a power of two.  The TX ring holds at least one frame of the
+// longest packet.
 //
-#define COMMUNICATION_PACKET_PING     0xC0
-#define COMMUNICATION_MAX_PACKET_TYPE 0xFF
-
-//
-// All of the different possible communication task errors
-//
-typedef enum
-{
-    ERROR_NONE = 0,
-    ERROR_INDEX,
-} xCommunication_Error_Type;
- 
+#define COMMUNICATION_POOL_SIZE    8
+#define COMMUNICATION_RX_RING_SIZE 256
+#define COMMUNICATION_TX_RING_SIZE 512
 
 //
 // Indicator if a message is part of reception or transmission
@@ -33,32 +28,15 @@ typedef enum{
 } TX_OR_RX_Type;
 
 //
-// Structure and defines for our packet data types
+// The structure for a message passed in the queue.  For RECEIVE_DATA there
+// is new data in the RX ring and no packet, for TRANSMIT_DATA the packet is
+// from pxCommunication_Alloc and is freed once it is in the TX ring.
 //
-#define COMMUNICATION_MAX_PACKET_SIZE 256   
 typedef struct
 {
-    uint8_t type;    
-    uint8_t size;
-    uint8_t data[COMMUNICATION_MAX_PACKET_SIZE];    
-    uint32_t crc;    
-} xPacket_Type;
-
-//
-// The structure for a message passed in the queue
-//
-typedef struct 
-{
-    uint8_t rx_data;
-    uint8_t error;
     TX_OR_RX_Type tx_or_rx;
-    xPacket_Type packet;    
+    xPacket_Type *packet;
 } xCommunication_Message;
-   
-//
-// function pointer data type for packet handlers
-//
-typedef void (* vCommunicationFunctionPointer)( xPacket_Type *packet);
 
 //
 // our message passing Queue
@@ -68,8 +46,17 @@ extern xQueueHandle xCommunication_Queue;
 //
 // Public API
 //
+void vCommunication_Init(void);
 void vCommunication_Task(void *pvParameters);
-void vPacket_Init(xPacket_Type *packet);
+xPacket_Type *pxCommunication_Alloc(void);
+void vCommunication_Free(xPacket_Type *packet);
+portBASE_TYPE xCommunication_Send(xPacket_Type *packet);
 
+//
+// Called from USART2_IRQHandler on an idle line, and from the DMA stream
+// handlers, they return pdTRUE when a task was woken
+//
+portBASE_TYPE xCommunication_RxFromISR(void);
+portBASE_TYPE xCommunication_TxCompleteFromISR(void);
 
 #endif
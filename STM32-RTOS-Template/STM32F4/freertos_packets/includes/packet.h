@@ -0,0 +1,102 @@
+#ifndef __PACKET_H__
+#define __PACKET_H__
+
+//
+// Packets go over the serial line COBS encoded, with a zero byte between
+// frames.  A decoded frame is
+//
+//   type, size, data[size], crc (4 bytes, least significant first)
+//
+// The CRC is the CRC-32 of the STM32 CRC unit over type, size and data,
+// fed to it as little endian words with the last word padded with zeros.
+//
+// Nothing here touches the hardware except the CRC, which is done in
+// software when PACKET_SOFTWARE_CRC is defined, so the framing can be
+// tested on a host.
+//
+
+//
+// List of packets or actions we know how to handle
+//
+#define COMMUNICATION_PACKET_PING     0xC0
+#define COMMUNICATION_MAX_PACKET_TYPE 0xFF
+
+//
+// All of the different possible communication task errors
+//
+typedef enum
+{
+    ERROR_NONE = 0,
+    ERROR_INDEX,
+} xCommunication_Error_Type;
+
+//
+// Structure and defines for our packet data types
+//
+#define COMMUNICATION_MAX_PACKET_SIZE 256
+typedef struct
+{
+    uint8_t type;
+    uint8_t size;
+    uint8_t data[COMMUNICATION_MAX_PACKET_SIZE];
+    uint32_t crc;
+} xPacket_Type;
+
+//
+// Decoded bytes around the data, and the longest encoded frame with its
+// delimiter: one COBS code byte per 254 bytes and one to start
+//
+#define PACKET_OVERHEAD   (2 + 4)
+#define PACKET_MAX_RAW    (PACKET_OVERHEAD + 255)
+#define PACKET_MAX_FRAME  (PACKET_MAX_RAW + (PACKET_MAX_RAW / 254) + 2)
+
+//
+// function pointer data type for packet handlers
+//
+typedef void (* vCommunicationFunctionPointer)( xPacket_Type *packet);
+
+//
+// Where the receiver gets its packets from, and gives complete ones to.
+// The receiver keeps a packet from pxAlloc until a frame is decoded into
+// it, then vDeliver owns it.
+//
+typedef xPacket_Type *(* pxPacketAllocFunction)(void);
+typedef void (* vPacketDeliverFunction)(xPacket_Type *packet);
+
+//
+// Frame receiver, which decodes bytes straight into a packet as they come
+//
+typedef struct
+{
+    pxPacketAllocFunction pxAlloc;
+    vPacketDeliverFunction vDeliver;
+    xPacket_Type *packet;	// being decoded into, or NULL
+    uint16_t position;		// decoded bytes in this frame
+    uint8_t code;		// COBS code of the current block
+    uint8_t remaining;		// bytes left in the current block
+    uint8_t discard;		// skip to the next delimiter
+
+    //
+    // Statistics
+    //
+    uint32_t frames;		// delivered
+    uint32_t crc_errors;
+    uint32_t framing_errors;	// bad COBS, bad length
+    uint32_t dropped;		// no packet to decode into
+} xPacket_Receiver;
+
+//
+// Public API
+//
+void vPacket_Init(xPacket_Type *packet);
+uint32_t ulPacket_CRC(const xPacket_Type *packet);
+uint32_t ulPacket_Encode(xPacket_Type *packet, uint8_t *buffer, uint32_t mask, uint32_t start);
+
+void vPacket_ReceiverInit(xPacket_Receiver *rx, pxPacketAllocFunction pxAlloc, vPacketDeliverFunction vDeliver);
+void vPacket_Receive(xPacket_Receiver *rx, const uint8_t *bytes, uint32_t count);
+
+xCommunication_Error_Type xPacket_AddHandler(vCommunicationFunctionPointer handler, uint32_t index);
+void vPacket_ClearHandlers(void);
+uint8_t ucPacket_Dispatch(xPacket_Type *packet);
+
+#endif
@@ -33,237 +33,327 @@
 // OS variables
 //
 xQueueHandle xCommunication_Queue;
+static xQueueHandle xPacket_Pool;
 
 //
 // File Variables
 //
-static vCommunicationFunctionPointer communication_packet_list[COMMUNICATION_MAX_PACKET_TYPE];
+// The USART2 RX DMA (stream 5) writes rx_ring round and round, the task
+// reads it up to the DMA counter.  The task encodes frames into tx_ring at
+// tx_head and the TX DMA (stream 6) sends from tx_tail, one contiguous run
+// at a time.  tx_head and tx_tail only ever count up, tx_busy is the length
+// of the run being sent.
+//
+static xPacket_Type packet_pool[COMMUNICATION_POOL_SIZE];
+static xPacket_Receiver xReceiver;
+
+static uint8_t rx_ring[COMMUNICATION_RX_RING_SIZE];
+static uint32_t rx_tail;
+static volatile uint8_t rx_pending;
+
+static uint8_t tx_ring[COMMUNICATION_TX_RING_SIZE];
+static volatile uint32_t tx_head;
+static volatile uint32_t tx_tail;
+static volatile uint32_t tx_busy;
+
+#define COMMUNICATION_IRQ_PRIORITY 12
 
 //
 // Packet Handler Functions
 //
 static void prvPingPacketHandler(xPacket_Type *pkt);
-static xCommunication_Error_Type prvAddCommunicationPacketHandler(vCommunicationFunctionPointer handler, uint8_t index);
-static void prvSendPacket(xPacket_Type *packet);
-static uint32_t prvCRC_Calculation(xPacket_Type *packet);
+static void prvDeliverPacket(xPacket_Type *packet);
+static void prvTxStart(void);
 
 /*******************************************************************************
  *******************************************************************************/
 static void prvPingPacketHandler(xPacket_Type *pkt)
 {
+    //
+    // Passive: a reply would bounce between two boards (or round a
+    // loopback cable) for ever
+    //
     LEDS_Toggle(GREEN2);
-    
-    return;    
+
+    return;
 }
 
 /*******************************************************************************
+ * A packet from the pool, or NULL when they are all in use
  *******************************************************************************/
-static xCommunication_Error_Type
-prvAddCommunicationPacketHandler(vCommunicationFunctionPointer handler, uint8_t index)
+xPacket_Type *pxCommunication_Alloc(void)
 {
-    if (index > COMMUNICATION_MAX_PACKET_TYPE){
-	return ERROR_INDEX;     
-    }else{
-	communication_packet_list[index] = handler;         
+    xPacket_Type *packet;
+
+    if (xQueueReceive(xPacket_Pool, &packet, 0) != pdPASS){
+	return NULL;
     }
-    
-    return ERROR_NONE;    
+
+    return packet;
 }
 
 /*******************************************************************************
  *******************************************************************************/
-void vPacket_Init(xPacket_Type *packet)
+void vCommunication_Free(xPacket_Type *packet)
 {
-    uint32_t i;
-    
-    packet->type = 0;
-    packet->size = 0;
-    for (i=0; i<COMMUNICATION_MAX_PACKET_SIZE; i++){
-	packet->data[i] =0;     
-    }    
-    packet->crc =0;
-    
-    return;    
+    xQueueSend(xPacket_Pool, &packet, 0);
+
+    return;
 }
 
 /*******************************************************************************
+ * Hands a packet from pxCommunication_Alloc to the communication task to be
+ * sent.  The packet belongs to the task from then on, even when the queue
+ * is full and it is dropped.
  *******************************************************************************/
-static void prvSendPingPacket(void)
+portBASE_TYPE xCommunication_Send(xPacket_Type *packet)
 {
-    xPacket_Type packet;
-    vPacket_Init(&packet);
-    prvSendPacket(&packet);
-    
-    return;    
+    xCommunication_Message xMessage;
+
+    xMessage.tx_or_rx = TRANSMIT_DATA;
+    xMessage.packet = packet;
+    if (xQueueSend(xCommunication_Queue, &xMessage, 0) != pdPASS){
+	vCommunication_Free(packet);
+	return pdFAIL;
+    }
+
+    return pdPASS;
 }
 
 /*******************************************************************************
+ * A decoded packet with a good CRC
  *******************************************************************************/
-static void prvSendPacket(xPacket_Type *packet)
+static void prvDeliverPacket(xPacket_Type *packet)
 {
-    uint8_t i;
-    
-    uartPutch(packet->type);
-    uartPutch(packet->size);
-    for (i=0; i< packet->size; i++){
-	uartPutch(packet->data[i]);
-    }    
-    uartPutch(packet->type);
-
-    uartPutch( (packet->crc & 0x000000FF) );    
-    uartPutch( (packet->crc & 0x0000FF00) >> 8 );    
-    uartPutch( (packet->crc & 0x00FF0000) >> 16 );    
-    uartPutch( (packet->crc & 0xFF000000) >> 24);
-    
-    return;    
+    ucPacket_Dispatch(packet);
+    vCommunication_Free(packet);
+
+    return;
 }
 
 /*******************************************************************************
+ * Starts the TX DMA on what is waiting in tx_ring, up to the end of the
+ * ring.  Called with the DMA interrupt masked.
  *******************************************************************************/
-uint8_t charGetByte(void)
+static void prvTxStart(void)
 {
-    uint8_t retval;
-    
-    //
-    // Wait for character to arrive
-    //
-    while (USART_GetFlagStatus(USART2,  USART_FLAG_RXNE) != SET);
+    uint32_t tail = tx_tail & (COMMUNICATION_TX_RING_SIZE - 1);
+    uint32_t count = tx_head - tx_tail;
 
-    retval = USART_ReceiveData(USART2) & 0x00FF;    
-    
-    return retval;
-    
+    if (tx_busy || (count == 0)){
+	return;
+    }
+    if (count > COMMUNICATION_TX_RING_SIZE - tail){
+	count = COMMUNICATION_TX_RING_SIZE - tail;
+    }
+    tx_busy = count;
+
+    DMA1_Stream6->M0AR = (uint32_t)&tx_ring[tail];
+    DMA_SetCurrDataCounter(DMA1_Stream6, count);
+    DMA_Cmd(DMA1_Stream6, ENABLE);
+
+    return;
 }
 
 /*******************************************************************************
+ * The idle line, or the RX DMA half way or at the end of the ring: wake the
+ * task once for however much has come in
  *******************************************************************************/
-static uint32_t prvCRC_Calculation(xPacket_Type *packet)
+portBASE_TYPE xCommunication_RxFromISR(void)
 {
-    uint32_t i;
-    
-   
-    CRC_ResetDR();
-    
-    CRC->DR = packet->type;
-    CRC->DR = packet->size;
-    for (i=0; i< packet->size; i++){
-	CRC->DR = packet->data[i];	
+    xCommunication_Message xMessage;
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    if (rx_pending){
+	return pdFALSE;
+    }
+
+    rx_pending = 1;
+    xMessage.tx_or_rx = RECEIVE_DATA;
+    xMessage.packet = NULL;
+    if (xQueueSendFromISR(xCommunication_Queue, &xMessage, &xHigherPriorityTaskWoken) != pdTRUE){
+	rx_pending = 0;
+	LEDS_On(RED);
     }
-    
 
-    return CRC->DR;    
+    return xHigherPriorityTaskWoken;
 }
 
+/*******************************************************************************
+ * The TX DMA has sent its run, start the next one
+ *******************************************************************************/
+portBASE_TYPE xCommunication_TxCompleteFromISR(void)
+{
+    tx_tail += tx_busy;
+    tx_busy = 0;
+    prvTxStart();
+
+    return pdFALSE;
+}
 
 /*******************************************************************************
+ * Decodes what the RX DMA has written since last time
  *******************************************************************************/
-void vCommunication_Task(void * pvParameters)
+static void prvReceive(void)
 {
-    uint32_t i;    
-    xCommunication_Message xMessage;
-    xPacket_Type xPacket;
-    xCommunication_Error_Type error;
-    uint16_t data[8];
-    uint32_t crc;
-    uint32_t crc1;
-    uint32_t crc2;
-
-    
-   
+    uint32_t head;
+
+    head = (COMMUNICATION_RX_RING_SIZE - DMA_GetCurrDataCounter(DMA1_Stream5)) &
+	(COMMUNICATION_RX_RING_SIZE - 1);
+
+    if (head < rx_tail){
+	vPacket_Receive(&xReceiver, &rx_ring[rx_tail], COMMUNICATION_RX_RING_SIZE - rx_tail);
+	rx_tail = 0;
+    }
+    vPacket_Receive(&xReceiver, &rx_ring[rx_tail], head - rx_tail);
+    rx_tail = head;
+
+    return;
+}
+
+/*******************************************************************************
+ * Frames the packet straight into tx_ring and kicks the DMA
+ *******************************************************************************/
+static void prvTransmit(xPacket_Type *packet)
+{
+    //
+    // Wait for room for the longest frame
+    //
+    while (COMMUNICATION_TX_RING_SIZE - (tx_head - tx_tail) < PACKET_MAX_FRAME){
+	vTaskDelay(1);
+    }
+
+    tx_head += ulPacket_Encode(packet, tx_ring, COMMUNICATION_TX_RING_SIZE - 1, tx_head);
+    vCommunication_Free(packet);
+
+    taskENTER_CRITICAL();
+    prvTxStart();
+    taskEXIT_CRITICAL();
+
+    return;
+}
+
+/*******************************************************************************
+ * Sets up the packet pool, the handlers and the USART2 DMA streams.  Called
+ * before the scheduler starts, after the USART and the queue.
+ *******************************************************************************/
+void vCommunication_Init(void)
+{
+    DMA_InitTypeDef DMA_Rx;
+    DMA_InitTypeDef DMA_Tx;
+    xPacket_Type *packet;
+    uint32_t i;
+
+    xPacket_Pool = xQueueCreate( COMMUNICATION_POOL_SIZE, sizeof( xPacket_Type * ) );
+    if ( xPacket_Pool == 0 ){
+	while(1);
+    }
+    for (i=0; i< COMMUNICATION_POOL_SIZE; i++){
+	packet = &packet_pool[i];
+	vPacket_Init(packet);
+	xQueueSend(xPacket_Pool, &packet, 0);
+    }
+
+    vPacket_ReceiverInit(&xReceiver, pxCommunication_Alloc, prvDeliverPacket);
+
+    //
+    // Clear all packet handlers in case nothing gets installed, then
+    // install ours
+    //
+    vPacket_ClearHandlers();
+    xPacket_AddHandler(prvPingPacketHandler, COMMUNICATION_PACKET_PING);
+
+    //
+    // The CRC unit stays on, every packet in and out goes through it
+    //
     RCC_AHB1PeriphClockCmd( RCC_AHB1Periph_CRC, ENABLE);
-    CRC_ResetDR();
-    CRC->DR = 0x1a2b3c4d;
-    crc1 = CRC->DR;
-
-    CRC_ResetDR();
-    CRC->DR = 0x11223344;
-    crc1 = CRC->DR;
-
-    CRC_ResetDR();
-    CRC->DR = 192;
-    crc1 = CRC->DR;
-
-    CRC_ResetDR();
-    CRC->DR = 0x0000001a;
-    CRC->DR = 0x0000002b;
-    CRC->DR = 0x000000c3;
-    CRC->DR = 0x0000004d;
-    crc2 = CRC->DR;
-    RCC_AHB1PeriphClockCmd( RCC_AHB1Periph_CRC, DISABLE);	    	  
-    
+    RCC_AHB1PeriphClockCmd( RCC_AHB1Periph_DMA1, ENABLE);
+
     //
-    // Get rid of compiler warnings
+    // USART2 RX is DMA1 stream 5 channel 4, circular over rx_ring
     //
-    UNUSED(pvParameters);
+    DMA_DeInit(DMA1_Stream5);
+    DMA_StructInit(&DMA_Rx);
+    DMA_Rx.DMA_Channel = DMA_Channel_4;
+    DMA_Rx.DMA_PeripheralBaseAddr = (uint32_t)&USART2->DR;
+    DMA_Rx.DMA_Memory0BaseAddr = (uint32_t)rx_ring;
+    DMA_Rx.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    DMA_Rx.DMA_BufferSize = COMMUNICATION_RX_RING_SIZE;
+    DMA_Rx.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_Rx.DMA_Mode = DMA_Mode_Circular;
+    DMA_Rx.DMA_Priority = DMA_Priority_High;
+    DMA_Init(DMA1_Stream5, &DMA_Rx);
+    DMA_ITConfig(DMA1_Stream5, DMA_IT_HT | DMA_IT_TC, ENABLE);
 
     //
-    // Initialize our packet to a good default value
-    // 
-    vPacket_Init(&xPacket);
-    
+    // USART2 TX is DMA1 stream 6 channel 4, started by prvTxStart
     //
-    // Clear all packet handlers in case nothing gets installed
+    DMA_DeInit(DMA1_Stream6);
+    DMA_StructInit(&DMA_Tx);
+    DMA_Tx.DMA_Channel = DMA_Channel_4;
+    DMA_Tx.DMA_PeripheralBaseAddr = (uint32_t)&USART2->DR;
+    DMA_Tx.DMA_Memory0BaseAddr = (uint32_t)tx_ring;
+    DMA_Tx.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_Tx.DMA_BufferSize = 1;
+    DMA_Tx.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_Tx.DMA_Mode = DMA_Mode_Normal;
+    DMA_Tx.DMA_Priority = DMA_Priority_Medium;
+    DMA_Init(DMA1_Stream6, &DMA_Tx);
+    DMA_ITConfig(DMA1_Stream6, DMA_IT_TC, ENABLE);
+
     //
-    for (i=0; i< COMMUNICATION_MAX_PACKET_TYPE; i++){
-	communication_packet_list[i] = NULL;    
-    }
-        
+    // The handlers call the OS, so they must be below
+    // configMAX_SYSCALL_INTERRUPT_PRIORITY
     //
-    // Install our packet handlers
+    NVIC_SetPriority(USART2_IRQn, COMMUNICATION_IRQ_PRIORITY);
+    NVIC_SetPriority(DMA1_Stream5_IRQn, COMMUNICATION_IRQ_PRIORITY);
+    NVIC_SetPriority(DMA1_Stream6_IRQn, COMMUNICATION_IRQ_PRIORITY);
+    NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+    NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+    NVIC_EnableIRQ(USART2_IRQn);
+
+    USART_DMACmd(USART2, USART_DMAReq_Rx | USART_DMAReq_Tx, ENABLE);
+    USART_ITConfig(USART2, USART_IT_IDLE, ENABLE);
+    DMA_Cmd(DMA1_Stream5, ENABLE);
+
+    return;
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+void vCommunication_Task(void * pvParameters)
+{
+    xCommunication_Message xMessage;
+
     //
-    prvAddCommunicationPacketHandler(prvPingPacketHandler, COMMUNICATION_PACKET_PING);       
-    
+    // Get rid of compiler warnings
+    //
+    UNUSED(pvParameters);
+
     //
     // Our main task loop
     //
     for (;;){
-	//
-	// Initialize our message packet for this loop
-	//
-	vPacket_Init(&xMessage.packet);    
-
 	//
 	// Wait for the message to indicate we need to act
-	// 
+	//
 	while( xQueueReceive( xCommunication_Queue, &xMessage, portMAX_DELAY ) != pdPASS );
 
 	if (xMessage.tx_or_rx == TRANSMIT_DATA){
 	    //
 	    // Transmit the packet
-	    // 
-	}else{
-	    //
-	    // Copy the buffer with the packet
-	    // 
-	    ( void ) memcpy( ( void * ) &xPacket , ( void * ) &xMessage.packet, ( unsigned ) sizeof(xPacket) );
-
 	    //
-	    // Check the CRC
-	    // 
-	    RCC_AHB1PeriphClockCmd( RCC_AHB1Periph_CRC, ENABLE);
-	    crc = prvCRC_Calculation(&xPacket);
-	    RCC_AHB1PeriphClockCmd( RCC_AHB1Periph_CRC, DISABLE);	    	  
-	    
+	    prvTransmit(xMessage.packet);
+	}else{
 	    //
-	    // Check if handler is installed and call it
+	    // Decode the new data, complete packets go to their handlers.
+	    // Clear the flag first so that data coming in while we read
+	    // wakes us again.
 	    //
-	    if ((xPacket.type < COMMUNICATION_MAX_PACKET_TYPE)  &&
-		(communication_packet_list[xPacket.type] != (NULL)) && 
-		(crc == xPacket.crc)
-		)
-	    {
-
-		//
-		// Call Handler!
-		//
-		(communication_packet_list[xPacket.type])(&xPacket);       
-
-	    }else{
-		
-	    }            
+	    rx_pending = 0;
+	    prvReceive();
 	}
-        
-    }    
+    }
 
-    return;    
+    return;
 }
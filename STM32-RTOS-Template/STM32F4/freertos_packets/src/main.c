@@ -87,13 +87,8 @@ static void prvUSART_Init(void)
     USART_Init(USART2, &USART_2);
 
     //
-    // Interrupt on RX Not Empty
-    //
-    USART_ITConfig(USART2, USART_IT_RXNE, ENABLE);
-    NVIC_EnableIRQ(USART2_IRQn);
-     
-    //
-    // Enable the USART block
+    // Enable the USART block.  Reception and transmission go through DMA,
+    // set up by vCommunication_Init
     //
     USART_Cmd(USART2, ENABLE); 
     
@@ -157,6 +152,8 @@ int main(void)
     prvSetupHardware();
     
     queueCreation();
+
+    vCommunication_Init();
     
     taskCreation();
            
@@ -0,0 +1,320 @@
+//
+// Compiler Includes
+//
+#include "stdio.h"
+#include "string.h"
+#include "stdint.h"
+
+//
+// HW Includes
+//
+#ifndef PACKET_SOFTWARE_CRC
+#include "stm32f4xx.h"
+#include "stm32f4xx_conf.h"
+#endif
+
+//
+// Application
+//
+#include "packet.h"
+
+//
+// File Variables
+//
+static vCommunicationFunctionPointer communication_packet_list[COMMUNICATION_MAX_PACKET_TYPE + 1];
+
+#ifdef PACKET_SOFTWARE_CRC
+static uint32_t crc_table[256];
+#endif
+
+/*******************************************************************************
+ *******************************************************************************/
+void vPacket_Init(xPacket_Type *packet)
+{
+    memset(packet, 0, sizeof(xPacket_Type));
+
+    return;
+}
+
+#ifdef PACKET_SOFTWARE_CRC
+/*******************************************************************************
+ * What the CRC unit does with a word: CRC-32 with polynomial 0x04C11DB7,
+ * no reflection, over the bytes of the word most significant first.
+ *******************************************************************************/
+static uint32_t prvCRC_Word(uint32_t crc, uint32_t word)
+{
+    uint32_t i, j, c;
+
+    if (crc_table[1] == 0){
+	for (i=0; i<256; i++){
+	    c = i << 24;
+	    for (j=0; j<8; j++){
+		c = (c & 0x80000000) ? (c << 1) ^ 0x04C11DB7 : (c << 1);
+	    }
+	    crc_table[i] = c;
+	}
+    }
+
+    for (i=0; i<4; i++){
+	crc = (crc << 8) ^ crc_table[((crc >> 24) ^ (word >> 24)) & 0xFF];
+	word <<= 8;
+    }
+
+    return crc;
+}
+#endif
+
+/*******************************************************************************
+ * Feeds the CRC a word at a time.  type, size and data follow each other at
+ * the start of the packet, so the whole words are loaded straight from it
+ * and only the last one is put together, padded with zeros.
+ *******************************************************************************/
+uint32_t ulPacket_CRC(const xPacket_Type *packet)
+{
+    const uint8_t *bytes = &packet->type;
+    uint32_t length = 2 + packet->size;
+    uint32_t words = length >> 2;
+    uint32_t word;
+    uint32_t i;
+#ifdef PACKET_SOFTWARE_CRC
+    uint32_t crc = 0xFFFFFFFF;
+#define CRC_FEED(w)	crc = prvCRC_Word(crc, (w))
+#else
+#define CRC_FEED(w)	CRC->DR = (w)
+
+    CRC_ResetDR();
+#endif
+
+    for (i=0; i<words; i++){
+	memcpy(&word, &bytes[i << 2], sizeof(word));
+	CRC_FEED(word);
+    }
+
+    if (length & 3){
+	word = 0;
+	for (i=0; i< (length & 3); i++){
+	    word |= (uint32_t)bytes[(words << 2) + i] << (i << 3);
+	}
+	CRC_FEED(word);
+    }
+#undef CRC_FEED
+
+#ifdef PACKET_SOFTWARE_CRC
+    return crc;
+#else
+    return CRC->DR;
+#endif
+}
+
+/*******************************************************************************
+ * Byte n of the decoded frame
+ *******************************************************************************/
+static uint8_t prvRawByte(const xPacket_Type *packet, uint32_t n)
+{
+    if (n == 0){
+	return packet->type;
+    }
+    if (n == 1){
+	return packet->size;
+    }
+    n -= 2;
+    if (n < packet->size){
+	return packet->data[n];
+    }
+    n -= packet->size;
+
+    return (packet->crc >> (n << 3)) & 0xFF;
+}
+
+/*******************************************************************************
+ * Sets the CRC of the packet and COBS encodes it, with the delimiter, into
+ * buffer at start.  The buffer can be a ring: each index is masked, pass
+ * 0xFFFFFFFF for a plain buffer.  There must be room for PACKET_MAX_FRAME
+ * bytes, the number written is returned.
+ *******************************************************************************/
+uint32_t ulPacket_Encode(xPacket_Type *packet, uint8_t *buffer, uint32_t mask, uint32_t start)
+{
+    uint32_t length = PACKET_OVERHEAD + packet->size;
+    uint32_t code_index = start;
+    uint32_t out = start + 1;
+    uint8_t code = 1;
+    uint8_t byte;
+    uint32_t i;
+
+    packet->crc = ulPacket_CRC(packet);
+
+    for (i=0; i<length; i++){
+	byte = prvRawByte(packet, i);
+	if (byte == 0){
+	    buffer[code_index & mask] = code;
+	    code_index = out++;
+	    code = 1;
+	}else{
+	    buffer[out++ & mask] = byte;
+	    code++;
+	    if (code == 0xFF){
+		buffer[code_index & mask] = code;
+		code_index = out++;
+		code = 1;
+	    }
+	}
+    }
+    buffer[code_index & mask] = code;
+    buffer[out++ & mask] = 0;
+
+    return out - start;
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+void vPacket_ReceiverInit(xPacket_Receiver *rx, pxPacketAllocFunction pxAlloc, vPacketDeliverFunction vDeliver)
+{
+    memset(rx, 0, sizeof(xPacket_Receiver));
+    rx->pxAlloc = pxAlloc;
+    rx->vDeliver = vDeliver;
+
+    return;
+}
+
+/*******************************************************************************
+ * Stores decoded byte number rx->position of the frame in the packet.
+ *******************************************************************************/
+static void prvPutByte(xPacket_Receiver *rx, uint8_t byte)
+{
+    xPacket_Type *packet = rx->packet;
+    uint32_t n = rx->position++;
+
+    if (n == 0){
+	packet->type = byte;
+	packet->crc = 0;
+    }else if (n == 1){
+	packet->size = byte;
+    }else if (n < 2 + (uint32_t)packet->size){
+	packet->data[n - 2] = byte;
+    }else if (n < PACKET_OVERHEAD + (uint32_t)packet->size){
+	packet->crc |= (uint32_t)byte << ((n - 2 - packet->size) << 3);
+    }else{
+	rx->framing_errors++;
+	rx->discard = 1;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+ * A delimiter: checks the frame and hands the packet on.  The packet is
+ * kept for the next frame when the frame is bad.
+ *******************************************************************************/
+static void prvEndFrame(xPacket_Receiver *rx)
+{
+    xPacket_Type *packet = rx->packet;
+
+    if (!rx->discard && rx->code){
+	if ((rx->remaining != 0) || (rx->position < PACKET_OVERHEAD) ||
+	    (rx->position != PACKET_OVERHEAD + packet->size)){
+	    rx->framing_errors++;
+	}else if (ulPacket_CRC(packet) != packet->crc){
+	    rx->crc_errors++;
+	}else{
+	    rx->packet = NULL;
+	    rx->frames++;
+	    rx->vDeliver(packet);
+	}
+    }
+
+    rx->position = 0;
+    rx->code = 0;
+    rx->remaining = 0;
+    rx->discard = 0;
+
+    return;
+}
+
+/*******************************************************************************
+ * Decodes bytes from the line as they come, straight into the packet.  A
+ * zero byte always ends a frame, so after any error the receiver is back
+ * in step at the next one.
+ *******************************************************************************/
+void vPacket_Receive(xPacket_Receiver *rx, const uint8_t *bytes, uint32_t count)
+{
+    uint8_t byte;
+
+    while (count--){
+	byte = *bytes++;
+
+	if (byte == 0){
+	    prvEndFrame(rx);
+	    continue;
+	}
+	if (rx->discard){
+	    continue;
+	}
+
+	if (rx->remaining){
+	    prvPutByte(rx, byte);
+	    rx->remaining--;
+	    continue;
+	}
+
+	//
+	// A code byte.  The first of a frame needs a packet, the ones after a
+	// block shorter than 254 bytes stand for a zero.
+	//
+	if (rx->code == 0){
+	    if (rx->packet == NULL){
+		rx->packet = rx->pxAlloc();
+	    }
+	    if (rx->packet == NULL){
+		rx->dropped++;
+		rx->discard = 1;
+		continue;
+	    }
+	}else if (rx->code != 0xFF){
+	    prvPutByte(rx, 0);
+	}
+	rx->code = byte;
+	rx->remaining = byte - 1;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+xCommunication_Error_Type xPacket_AddHandler(vCommunicationFunctionPointer handler, uint32_t index)
+{
+    if (index > COMMUNICATION_MAX_PACKET_TYPE){
+	return ERROR_INDEX;
+    }else{
+	communication_packet_list[index] = handler;
+    }
+
+    return ERROR_NONE;
+}
+
+/*******************************************************************************
+ *******************************************************************************/
+void vPacket_ClearHandlers(void)
+{
+    uint32_t i;
+
+    for (i=0; i<= COMMUNICATION_MAX_PACKET_TYPE; i++){
+	communication_packet_list[i] = NULL;
+    }
+
+    return;
+}
+
+/*******************************************************************************
+ * Calls the handler of the packet type, returns 0 if there is none.
+ *******************************************************************************/
+uint8_t ucPacket_Dispatch(xPacket_Type *packet)
+{
+    if (communication_packet_list[packet->type] == NULL){
+	return 0;
+    }
+
+    (communication_packet_list[packet->type])(packet);
+
+    return 1;
+}
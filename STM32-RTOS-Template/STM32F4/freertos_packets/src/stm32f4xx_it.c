@@ -194,84 +194,64 @@ void TIM2_IRQHandler(void)
 }
 
 /**
-  * @brief  This function handles USART2_IRQ Handler.  
+  * @brief  This function handles USART2_IRQ Handler.  The line has gone idle
+  *         after some data, let the task read what the RX DMA has written.
   * @param  None
   * @retval None
   */
 void USART2_IRQHandler(void)
 {
-    portBASE_TYPE retval;    
     portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-    uint16_t data;
-    static xCommunication_Message xMessage;
-    static uint8_t data_count;
-    static uint8_t state =0;
-    
-    //
-    // If the RX Not Empty bit is set grab the byte
-    // 
-    if (USART_GetITStatus(USART2, USART_IT_RXNE) == SET){	
-	data = USART_ReceiveData(USART2);
+
+    if (USART_GetITStatus(USART2, USART_IT_IDLE) == SET){
+	//
+	// Reading SR then DR clears the idle flag
+	//
+	(void)USART2->SR;
+	(void)USART2->DR;
+	xHigherPriorityTaskWoken = xCommunication_RxFromISR();
     }
- 
-    //
-    // Create the packet and when ready send to task via OS
-    // 
-    switch(state){
-    case 0: 
-	xMessage.packet.type = data;	
-	state = 1;	
-	break;
-    case 1:
-	xMessage.packet.size = data;
-	data_count = 0;	
-	
-	if (xMessage.packet.size){
-	    state = 2;
-	}else{
-	    state = 3;
-	}
-	
-	
-	break;
-    case 2:
-	if (data_count < (xMessage.packet.size-1)){
-	    xMessage.packet.data[data_count] = data;
-	    data_count ++;	    
-	}else{
-	    data_count =0;
-	    state = 3;
-	}		
-	break;
-    case 3:
-	if (data_count <3 ){
-	    xMessage.packet.crc = data << (data_count << 2);
-	    data_count ++;	    
-	}else{
-	    data_count =0;
-	    state = 0;
-	    //
-	    // Send the byte to the OS
-	    //
-	    xMessage.tx_or_rx = RECEIVE_DATA;
-	    retval = xQueueSendFromISR( xCommunication_Queue, &xMessage, &xHigherPriorityTaskWoken );
-	    if (retval != pdTRUE){
-		LEDS_On(RED);	    
-	    }
-	}			
-	break;
-    default:
-	state = 0;
-	data_count = 0;	
-	break;       
+
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+  * @brief  This function handles DMA1_Stream5_IRQ Handler, USART2 RX half
+  *         way through or at the end of its ring.
+  * @param  None
+  * @retval None
+  */
+void DMA1_Stream5_IRQHandler(void)
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    if (DMA_GetITStatus(DMA1_Stream5, DMA_IT_HTIF5) == SET){
+	DMA_ClearITPendingBit(DMA1_Stream5, DMA_IT_HTIF5);
+	xHigherPriorityTaskWoken = xCommunication_RxFromISR();
+    }
+    if (DMA_GetITStatus(DMA1_Stream5, DMA_IT_TCIF5) == SET){
+	DMA_ClearITPendingBit(DMA1_Stream5, DMA_IT_TCIF5);
+	xHigherPriorityTaskWoken |= xCommunication_RxFromISR();
+    }
+
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+  * @brief  This function handles DMA1_Stream6_IRQ Handler, USART2 TX done.
+  * @param  None
+  * @retval None
+  */
+void DMA1_Stream6_IRQHandler(void)
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    if (DMA_GetITStatus(DMA1_Stream6, DMA_IT_TCIF6) == SET){
+	DMA_ClearITPendingBit(DMA1_Stream6, DMA_IT_TCIF6);
+	xHigherPriorityTaskWoken = xCommunication_TxCompleteFromISR();
     }
-   
-    //
-    // Clear the interrupt at the NVIC level
-    //
-    NVIC_ClearPendingIRQ(USART2_IRQn);
 
-    return;
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
 }
 
 /******************* (C) COPYRIGHT 2011 STMicroelectronics *****END OF FILE****/
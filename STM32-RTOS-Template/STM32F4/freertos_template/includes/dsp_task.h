@@ -0,0 +1,34 @@
+#ifndef __DSP_TASK_H__
+#define __DSP_TASK_H__
+
+#include "arm_math.h"
+
+#define DSP_STACK_SIZE 256
+#define DSP_QUEUE_SIZE 1
+
+/*
+ * DSP_InBuffer takes two blocks, for a DMA stream in circular mode: while
+ * it fills one half the task processes the other. The half transfer and
+ * transfer complete interrupts call DSP_BlockReadyFromISR() with the half
+ * which has just been filled.
+ */
+#define DSP_BLOCK_SIZE 256
+#define DSP_TILE_SIZE 64
+
+extern xQueueHandle xDSP_Queue;
+extern float32_t DSP_InBuffer[2 * DSP_BLOCK_SIZE];
+extern volatile uint32_t DSP_Overruns;
+extern volatile uint32_t DSP_PeakBin;
+
+typedef struct
+{
+    uint32_t half;
+} xDSP_Message;
+
+
+
+arm_status DSP_Init(void);
+void DSP_Task( void *pvParameters );
+void DSP_BlockReadyFromISR( uint32_t half, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#endif
@@ -0,0 +1,141 @@
+#include "stdio.h"
+#include "string.h"
+#include "stdint.h"
+
+#include "stm32f4xx.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "arm_math.h"
+#include "arm_pipeline.h"
+#include "dsp_task.h"
+#include "leds.h"
+#include "syscalls.h"
+
+/*
+ * The pipeline: moving average, DC blocker, moving average decimating by 4,
+ * and the spectrum of what is left.
+ */
+#define FIR_TAPS 16
+#define DEC_TAPS 16
+#define DEC_M 4
+#define FFT_LEN (DSP_BLOCK_SIZE / DEC_M)
+
+/* The test signal is a square wave, its peak is in bin FFT_LEN * DEC_M / TEST_PERIOD */
+#define TEST_PERIOD 64
+
+xQueueHandle xDSP_Queue;
+float32_t DSP_InBuffer[2 * DSP_BLOCK_SIZE];
+volatile uint32_t DSP_Overruns;
+volatile uint32_t DSP_PeakBin;
+
+/* Half of DSP_InBuffer the task is working on, or -1 */
+static volatile int32_t busyHalf = -1;
+
+static arm_fir_instance_f32 fir;
+static float32_t firCoeffs[FIR_TAPS];
+static float32_t firState[FIR_TAPS + DSP_BLOCK_SIZE - 1];
+
+/* y[n] = x[n] - x[n-1] + 0.995 * y[n-1] */
+static arm_biquad_casd_df1_inst_f32 biquad;
+static float32_t biquadCoeffs[5] = {1.0f, -1.0f, 0.0f, 0.995f, 0.0f};
+static float32_t biquadState[4];
+
+static arm_fir_decimate_instance_f32 decimate;
+static float32_t decCoeffs[DEC_TAPS];
+static float32_t decState[DEC_TAPS + DSP_BLOCK_SIZE - 1];
+
+static arm_cfft_radix4_instance_f32 cfft;
+
+static arm_pipeline_stage_f32 stages[4] = {
+    {ARM_PIPELINE_FIR, &fir, 0, 0},
+    {ARM_PIPELINE_BIQUAD, &biquad, 0, 0},
+    {ARM_PIPELINE_DECIMATE, &decimate, 0, 0},
+    {ARM_PIPELINE_CFFT, &cfft, 0, 0}
+};
+static arm_pipeline_instance_f32 pipeline;
+
+/* Fused, only the input of the CFFT is kept as a whole block */
+static float32_t scratch[ARM_PIPELINE_SCRATCH_SIZE(FFT_LEN, DSP_TILE_SIZE)];
+
+static float32_t spectrum[2 * FFT_LEN];
+static float32_t magnitude[FFT_LEN];
+
+arm_status DSP_Init(void)
+{
+    arm_status status;
+    uint32_t i;
+
+    for (i = 0; i < FIR_TAPS; i++){
+	firCoeffs[i] = 1.0f / FIR_TAPS;
+    }
+    for (i = 0; i < DEC_TAPS; i++){
+	decCoeffs[i] = 1.0f / DEC_TAPS;
+    }
+
+    arm_fir_init_f32(&fir, FIR_TAPS, firCoeffs, firState, DSP_BLOCK_SIZE);
+    arm_biquad_cascade_df1_init_f32(&biquad, 1, biquadCoeffs, biquadState);
+    status = arm_fir_decimate_init_f32(&decimate, DEC_TAPS, DEC_M, decCoeffs,
+				       decState, DSP_BLOCK_SIZE);
+    if (status == ARM_MATH_SUCCESS){
+	status = arm_cfft_radix4_init_f32(&cfft, FFT_LEN, 0, 1);
+    }
+    if (status == ARM_MATH_SUCCESS){
+	status = arm_pipeline_init_f32(&pipeline, 4, stages, DSP_BLOCK_SIZE,
+				       DSP_TILE_SIZE, scratch,
+				       sizeof(scratch) / sizeof(scratch[0]));
+    }
+
+    /* Until a DMA stream fills it */
+    for (i = 0; i < 2 * DSP_BLOCK_SIZE; i++){
+	DSP_InBuffer[i] = (i % TEST_PERIOD) < TEST_PERIOD / 2 ? 1.0f : -1.0f;
+    }
+
+    return status;
+}
+
+void DSP_Task( void *pvParameters )
+{
+    xDSP_Message xMessage;
+    float32_t peak;
+    uint32_t bin;
+    UNUSED(pvParameters);
+
+    for (;;){
+	while( xQueueReceive( xDSP_Queue, &xMessage, portMAX_DELAY ) != pdPASS );
+
+	busyHalf = xMessage.half;
+	arm_pipeline_f32(&pipeline, &DSP_InBuffer[xMessage.half * DSP_BLOCK_SIZE],
+			 spectrum);
+	busyHalf = -1;
+
+	/* Leave out DC, and the mirror image of the real signal */
+	arm_cmplx_mag_f32(spectrum, magnitude, FFT_LEN);
+	arm_max_f32(&magnitude[1], FFT_LEN / 2 - 1, &peak, &bin);
+	DSP_PeakBin = bin + 1;
+
+	LEDS_Toggle(GREEN);
+    }
+
+    return;
+}
+
+/*
+ * The DMA stream goes on into the other half, so the task must be done
+ * with it, and the block before must have been taken.
+ */
+void DSP_BlockReadyFromISR( uint32_t half, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    xDSP_Message xMessage;
+
+    if (busyHalf == (int32_t)(half ^ 1)){
+	DSP_Overruns++;
+	LEDS_On(RED);
+    }
+
+    xMessage.half = half;
+    if (xQueueSendFromISR( xDSP_Queue, &xMessage, pxHigherPriorityTaskWoken ) != pdTRUE){
+	DSP_Overruns++;
+	LEDS_On(RED);
+    }
+}
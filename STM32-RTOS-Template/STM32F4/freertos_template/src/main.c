@@ -5,6 +5,7 @@
 #include "timer2.h"
 #include "leds.h"
 #include "task1.h"
+#include "dsp_task.h"
 
 /*
  * Configure the clocks, GPIO and other peripherals as required by the demo.
@@ -37,6 +38,13 @@ void taskCreation(void)
 	LEDS_On(GREEN);
 	while(1);	
     }
+
+    retval = xTaskCreate( DSP_Task, ( signed portCHAR * ) "DSP",  DSP_STACK_SIZE, NULL, tskIDLE_PRIORITY+2, NULL );
+    if (retval != pdPASS){
+	LEDS_On(RED);
+	LEDS_On(GREEN);
+	while(1);	
+    }
     return;    
 }
 
@@ -48,6 +56,23 @@ void queueCreation(void)
 	LEDS_On(GREEN2);
 	while(1);	
     }
+
+    xDSP_Queue = xQueueCreate( DSP_QUEUE_SIZE, sizeof( xDSP_Message ) );
+    if ( xDSP_Queue == 0 ){
+	LEDS_On(RED2);
+	LEDS_On(GREEN2);
+	while(1);	
+    }
+    return;    
+}
+
+void dspInit(void)
+{
+    if ( DSP_Init() != ARM_MATH_SUCCESS ){
+	LEDS_On(RED);
+	LEDS_On(RED2);
+	while(1);	
+    }
     return;    
 }
 
@@ -58,6 +83,8 @@ int main(void)
     prvSetupHardware();
     
     queueCreation();
+
+    dspInit();
     
     taskCreation();
            
@@ -29,6 +29,7 @@
 #include "queue.h"
 #include "leds.h"
 #include "task1.h"
+#include "dsp_task.h"
 // #include "main.h"
 // #include "usb_core.h"
 // #include "usbd_core.h"
@@ -41,6 +42,9 @@
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 
+/* Half of DSP_InBuffer given to the DSP task next */
+static uint32_t dspHalf = 0;
+
 /* Private function prototypes -----------------------------------------------*/
 
 /******************************************************************************/
@@ -190,6 +194,15 @@ void TIM2_IRQHandler(void)
     if (retval != pdTRUE){
 	LEDS_On(RED);	    
     }
+
+    //
+    // Stands in for the half and full transfer interrupts of a DMA stream
+    // into DSP_InBuffer
+    //
+    DSP_BlockReadyFromISR( dspHalf, &xHigherPriorityTaskWoken );
+    dspHalf ^= 1;
+
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 	
     
 
@@ -0,0 +1,156 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <stdlib.h>
+#include "BenchmarkAO.hpp"
+#include "EchoAO.hpp"
+
+/** Duration of the phases ( in seconds ) */
+const int LATENCY_SECONDS    = 3;
+const int THROUGHPUT_SECONDS = 3;
+const int JITTER_SECONDS     = 5;
+
+BenchmarkAO::BenchmarkAO( DWORD prio, AObject * partner ) : AObject( prio ), echo( partner ), display( 0, 0xB8000 ) {
+  phase = PHASE_START;
+  seconds = 0;
+  rounds = 0;
+  rtMin = (unsigned long long) -1;
+  rtMax = rtSum = 0;
+  delivered = 0;
+  throughputTime = 0;
+  lastTick = 0;
+  periodMin = (unsigned long long) -1;
+  periodMax = periodSum = deviationMax = 0;
+  ticks = lastTickNumber = lostTicks = 0;
+}
+
+void
+BenchmarkAO::startPhase( int p ) {
+  phase = p;
+  phaseStart = PC_TimeStamp();
+  switch( phase ) {
+    case PHASE_LATENCY :
+      seconds = LATENCY_SECONDS;
+      display.print( 0, 2, "measuring context switch latency..." );
+      sendPing();
+      break;
+    case PHASE_THROUGHPUT :
+      seconds = THROUGHPUT_SECONDS;
+      display.print( 0, 3, "measuring message throughput..." );
+      sendBatch();
+      break;
+    case PHASE_JITTER :
+      seconds = JITTER_SECONDS;
+      display.print( 0, 4, "measuring timer jitter..." );
+      break;
+    case PHASE_DONE :
+      printReport();
+      exit( 0 );
+  }
+}
+
+void
+BenchmarkAO::sendPing() {
+  Message pe( this, echo, (DWORD) 0, ping );
+  pingTime = PC_TimeStamp();
+  putOutgoingMessage( &pe );
+}
+
+void
+BenchmarkAO::sendBatch() {
+  Message pe( this, echo, (DWORD) 0, payload );
+  for( DWORD i = 0; i < BENCHMARK_BATCH; i++ ) {
+    putOutgoingMessage( &pe );
+  }
+}
+
+void
+BenchmarkAO::measureTick( Message * msg ) {
+  unsigned long long now = PC_TimeStamp();
+  DWORD number = msg->getBinaryData();      // Timer time stamp ( tick number )
+  if( lastTick != 0 ) {
+    unsigned long long period = now - lastTick;
+    unsigned long long nominal = HOST_TIMER_PERIOD_US * 1000ULL;
+    unsigned long long deviation = ( period > nominal ) ? period - nominal : nominal - period;
+    if( period < periodMin ) periodMin = period;
+    if( period > periodMax ) periodMax = period;
+    if( deviation > deviationMax ) deviationMax = deviation;
+    periodSum += period;
+    lostTicks += number - lastTickNumber - 1;
+    ticks++;
+  }
+  lastTick = now;
+  lastTickNumber = number;
+}
+
+void
+BenchmarkAO::printReport() {
+  unsigned long long rt = ( rounds > 0 ) ? rtSum / rounds : 0;
+  display.print( 0, 6, "aoRTOS hosted port benchmark results:" );
+  display.setPosition( 0, 7 );
+  display.printf( "context switch : %d ns ( %d ping/pong rounds )", (int)( rt / 2 ), (int) rounds );
+  display.setPosition( 0, 8 );
+  display.printf( "round trip     : avg %d / min %d / max %d ns", (int) rt, (int) rtMin, (int) rtMax );
+  display.setPosition( 0, 9 );
+  display.printf( "message rate   : %d msg/s ( %d messages in %d ms )",
+    (int)( delivered * 1000000000ULL / throughputTime ), (int) delivered, (int)( throughputTime / 1000000 ) );
+  display.setPosition( 0, 10 );
+  display.printf( "timer period   : avg %d / min %d / max %d us",
+    (int)( ticks > 0 ? periodSum / ticks / 1000 : 0 ), (int)( periodMin / 1000 ), (int)( periodMax / 1000 ) );
+  display.setPosition( 0, 11 );
+  display.printf( "timer jitter   : max deviation %d us, lost %d of %d ticks",
+    (int)( deviationMax / 1000 ), (int) lostTicks, (int) ticks );
+  display.print( 0, 12, "\n" );
+}
+
+DWORD
+BenchmarkAO::processMessage( Message * msg ) {
+  switch( msg->getMessageID() ) {
+    case tick :
+      if( phase == PHASE_START ) {           // RTOS is running: start measurement
+        startPhase( PHASE_LATENCY );
+      } else if( phase == PHASE_JITTER ) {
+        measureTick( msg );
+      }
+      return 1;
+    case sec :
+      if( phase != PHASE_START && --seconds <= 0 ) {
+        if( phase == PHASE_THROUGHPUT ) {
+          throughputTime = PC_TimeStamp() - phaseStart;
+        }
+        startPhase( phase + 1 );
+      }
+      return 1;
+    case pong :
+      if( phase == PHASE_LATENCY ) {
+        unsigned long long rt = PC_TimeStamp() - pingTime;
+        if( rt < rtMin ) rtMin = rt;
+        if( rt > rtMax ) rtMax = rt;
+        rtSum += rt;
+        rounds++;
+        sendPing();
+      }
+      return 1;
+    case ack :
+      if( phase == PHASE_THROUGHPUT ) {
+        delivered = msg->getBinaryData();
+        sendBatch();
+      }
+      return 1;
+    default :
+      return 1;
+  }
+}
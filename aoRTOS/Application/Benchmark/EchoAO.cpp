@@ -0,0 +1,41 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "EchoAO.hpp"
+
+EchoAO::EchoAO( DWORD prio ) : AObject( prio ) {
+  count = 0;
+}
+
+DWORD
+EchoAO::processMessage( Message * msg ) {
+  switch( msg->getMessageID() ) {
+    case ping :                  // return time stamp of the request back to the source
+      {
+        Message pe( this, msg->getSource(), msg->getBinaryData(), pong );
+        putOutgoingMessage( &pe );
+      }
+      return 1;
+    case payload :
+      if( ++count % BENCHMARK_BATCH == 0 ) {
+        Message pe( this, msg->getSource(), count, ack );
+        putOutgoingMessage( &pe );
+      }
+      return 1;
+    default :
+      return 1;
+  }
+}
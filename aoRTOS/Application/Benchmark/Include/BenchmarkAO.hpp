@@ -0,0 +1,64 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef BENCHMARKAO_HPP_
+#define BENCHMARKAO_HPP_
+
+#include "AObject.hpp"
+#include "pc.hpp"
+
+/**
+ * Class BenchmarkAO measures the RTOS on the Linux hosted port.
+ * The measurement runs in phases those are switched by 'sec' messages of the Timer:
+ *  1. context switch latency - ping/pong round trips with EchoAO ( 2 context switches each );
+ *  2. message throughput - batches of payload messages to EchoAO;
+ *  3. timer jitter - period of 'tick' messages measured by host clock.
+ * Then the results are printed and the process exits.
+ */
+class BenchmarkAO : public AObject {
+  private:
+    enum Phase { PHASE_START, PHASE_LATENCY, PHASE_THROUGHPUT, PHASE_JITTER, PHASE_DONE };
+/** partner active object */
+    AObject * echo;
+    Display display;
+    int phase;
+/** seconds are left to the end of current phase */
+    int seconds;
+    unsigned long long phaseStart;
+/** latency phase: time of last ping, round trip statistics */
+    unsigned long long pingTime, rtMin, rtMax, rtSum;
+    DWORD rounds;
+/** throughput phase: amount of delivered messages */
+    DWORD delivered;
+    unsigned long long throughputTime;
+/** jitter phase: tick period statistics */
+    unsigned long long lastTick, periodMin, periodMax, periodSum, deviationMax;
+    DWORD ticks, lastTickNumber, lostTicks;
+
+    void  startPhase( int );
+    void  sendPing();
+    void  sendBatch();
+    void  measureTick( Message * );
+    void  printReport();
+  protected:
+    virtual DWORD processMessage( Message * );
+
+  public:
+    BenchmarkAO( DWORD, AObject * );
+    Display * getDisplay(){ return &display; };
+};
+
+#endif /*BENCHMARKAO_HPP_*/
@@ -0,0 +1,40 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef ECHOAO_HPP_
+#define ECHOAO_HPP_
+
+#include "AObject.hpp"
+
+/** Amount of payload messages EchoAO acknowledges by one ack message. */
+const DWORD BENCHMARK_BATCH = 64;
+
+/**
+ * Class EchoAO is the partner of BenchmarkAO: it replies pong on each ping
+ * and acknowledges each BENCHMARK_BATCH of payload messages.
+ */
+class EchoAO : public AObject {
+  private:
+/** count of received payload messages */
+    DWORD count;
+  protected:
+    virtual DWORD processMessage( Message * );
+
+  public:
+    EchoAO( DWORD );
+};
+
+#endif /*ECHOAO_HPP_*/
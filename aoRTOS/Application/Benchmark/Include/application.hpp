@@ -0,0 +1,32 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef APPLICATION_HPP_
+#define APPLICATION_HPP_
+
+/*
+ping - request to EchoAO, it returns pong back to the source
+pong - response to ping
+payload - message of throughput test, EchoAO only counts it
+ack - EchoAO acknowledges a batch of payload messages
+*/
+
+#define APP_MESSAGE_IDS ping,\
+  pong,\
+  payload,\
+  ack
+
+#endif /* APPLICATION_HPP_ */
@@ -36,6 +36,7 @@ LoggingAO::processMessage(Message * msg) {
       }
     case done :
       state = 0;
+      recall();      // port is free: replay deferred logging messages
       return 1;
     default :
       return 1;
@@ -50,9 +50,11 @@ MyAO::processMessage(Message * e) {
       return 1;
     case done :    // display is complete the job
       acknowledge = 1;
+      recall();      // deferred 'task' events can be processed now
       return 1;
     case done1 :    // display is complete the job
       acknowledge = 1;
+      recall();
       return 1;
     case task :    // Message comes from another AO
       if( acknowledge == 1 ) { // if display finished previous 'show' task send event to DisplayAO
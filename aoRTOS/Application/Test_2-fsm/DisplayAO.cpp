@@ -113,6 +113,7 @@ DisplayAOStateMachine::draw(Message *e) {
   switch (e->getMessageID()) {
     case tick :
       TRANSITION(&DisplayAOStateMachine::wait);
+      parent->recall();          // state is changed: give deferred 'show' events a chance
       break;
     case show :
       e->setMessageID(ret);    // return the event back into queue
@@ -122,6 +123,7 @@ DisplayAOStateMachine::draw(Message *e) {
       return 0;
     case done :
       TRANSITION(&DisplayAOStateMachine::wait);
+      parent->recall();
       break;
     default:
       break;
@@ -98,6 +98,7 @@ MyAOStateMachine::wait(Message *msg) {
       break;
     case done :
       TRANSITION(&MyAOStateMachine::exec);
+      parent->recall();          // state is changed: give deferred 'task' events a chance
       break;
     case task :
       msg->setMessageID(ret);    // return the event back into queue
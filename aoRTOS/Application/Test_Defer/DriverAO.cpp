@@ -0,0 +1,117 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <stdlib.h>
+#include "DriverAO.hpp"
+
+/** Ticks between steps: enough for TestAO to process a batch */
+const DWORD STEP_TICKS = 5;
+/** Size of the first batch of the overflow step ( it fits to incoming and deferred queues ) */
+const DWORD OVERFLOW_BATCH = 100;
+
+DriverAO::DriverAO( DWORD prio, TestAO * t ) : AObject( prio ), test( t ), display( 0, 0 ) {
+  step = 0;
+  ticks = 0;
+  failures = 0;
+  jobNumber = 1;
+}
+
+void
+DriverAO::send( MessageID mid, DWORD data ) {
+  Message pe( this, test, data, mid );
+  putOutgoingMessage( &pe );
+}
+
+void
+DriverAO::sendJobs( DWORD n ) {
+  for( DWORD i = 0; i < n; i++ ) {
+    send( job, jobNumber++ );
+  }
+}
+
+void
+DriverAO::check( int condition, char * name ) {
+  display.setPosition( 0, 2 + step );
+  display.printf( "step %d: %s - %s", step, name, condition ? "ok" : "FAILED" );
+  if( !condition )
+    failures++;
+}
+
+void
+DriverAO::runStep() {
+  DWORD i, ordered;
+  switch( step ) {
+    case 0 :                                // TestAO is locked
+      sendJobs( 3 );
+      send( noop, 0 );
+      send( noop, 0 );
+      break;
+    case 1 :
+      check( test->getAttempts() == 3 && test->deferredBufferLoad() == 3 && test->getProcessed() == 0,
+        "locked AO defers jobs, no recall without a state change" );
+      send( unlock, 0 );
+      sendJobs( 1 );
+      break;
+    case 2 :
+      check( test->getProcessed() == 4 && test->getHistory( 0 ) == 1 && test->getHistory( 1 ) == 2
+          && test->getHistory( 2 ) == 3 && test->getHistory( 3 ) == 4 && test->getAttempts() == 7
+          && test->deferredBufferLoad() == 0,
+        "recall on unlock replays deferred jobs in order" );
+      send( lock, 0 );
+      sendJobs( 2 );
+      send( alert, 1 );
+      break;
+    case 3 :
+      check( test->getProcessed() == 5 && test->getHistory( 4 ) == TEST_ALERT_TAG + 1
+          && test->deferredBufferLoad() == 2,
+        "urgent alert overtakes earlier events" );
+      sendJobs( OVERFLOW_BATCH );
+      break;
+    case 4 :
+      check( test->deferredBufferLoad() == 2 + OVERFLOW_BATCH && test->deferredOverflowCount() == 0,
+        "deferred queue keeps a full incoming batch" );
+      sendJobs( AO_DEFERRED_LENGTH - OVERFLOW_BATCH + 2 );   // 4 jobs more than the queue can keep
+      break;
+    case 5 :
+      check( test->deferredBufferLoad() == AO_DEFERRED_LENGTH && test->deferredOverflowCount() == 4,
+        "overflow of deferred queue is counted" );
+      send( unlock, 0 );
+      break;
+    case 6 :
+      ordered = ( test->getProcessed() == 5 + AO_DEFERRED_LENGTH );
+      for( i = 0; ordered && i < AO_DEFERRED_LENGTH; i++ ) {
+        ordered = ( test->getHistory( 5 + i ) == 5 + i );
+      }
+      check( ordered && test->deferredBufferLoad() == 0, "kept jobs are replayed in order" );
+      display.setPosition( 0, 3 + step );
+      display.printf( "%s\n", failures == 0 ? "PASS" : "FAIL" );
+      exit( failures == 0 ? 0 : 1 );
+  }
+  step++;
+}
+
+DWORD
+DriverAO::processMessage( Message * msg ) {
+  switch( msg->getMessageID() ) {
+    case tick :
+      if( ++ticks % STEP_TICKS == 0 ) {
+        runStep();
+      }
+      return 1;
+    default :
+      return 1;
+  }
+}
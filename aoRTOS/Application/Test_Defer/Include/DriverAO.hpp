@@ -0,0 +1,56 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef DRIVERAO_HPP_
+#define DRIVERAO_HPP_
+
+#include "AObject.hpp"
+#include "pc.hpp"
+#include "TestAO.hpp"
+
+/**
+ * Class DriverAO runs the test of deferred and urgent events on the Linux hosted port.
+ * Each step sends a batch of events to TestAO, the next step ( a few ticks later,
+ * when TestAO has processed the batch ) checks the result:
+ *  1. jobs to locked TestAO are deferred, successful noop events do not recall them;
+ *  2. unlock recalls deferred jobs, they are processed before a later job and in order;
+ *  3. urgent alert overtakes events those are sent before it;
+ *  4. overflow of the deferred queue is counted, the jobs kept are replayed in order.
+ * Then the result is printed and the process exits ( exit code 0 - PASS ).
+ */
+class DriverAO : public AObject {
+  private:
+    TestAO * test;
+    Display display;
+    int step;
+    DWORD ticks;
+    DWORD failures;
+/** data of the next job */
+    DWORD jobNumber;
+
+    void  send( MessageID, DWORD );
+    void  sendJobs( DWORD );
+    void  check( int, char * );
+    void  runStep();
+  protected:
+    virtual DWORD processMessage( Message * );
+
+  public:
+    DriverAO( DWORD, TestAO * );
+    Display * getDisplay(){ return &display; };
+};
+
+#endif /*DRIVERAO_HPP_*/
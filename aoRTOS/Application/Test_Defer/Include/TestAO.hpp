@@ -0,0 +1,51 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef TESTAO_HPP_
+#define TESTAO_HPP_
+
+#include "AObject.hpp"
+
+/** Maximum number of events TestAO keeps in its history. */
+const DWORD TEST_HISTORY_LENGTH = 160;
+/** Offset of alert data in the history ( to distinguish them from job data ). */
+const DWORD TEST_ALERT_TAG = 1000;
+
+/**
+ * Class TestAO is the object under test: it has two states, locked and open.
+ * In locked state it returns 0 on a job, so AObject::run() defers the job;
+ * on unlock it changes its state and recalls the deferred jobs.
+ * The alert event is declared urgent. The order of processed jobs and alerts
+ * is kept in the history that DriverAO checks.
+ */
+class TestAO : public AObject {
+  private:
+    int locked;
+/** number of job events have been passed to processMessage() */
+    DWORD attempts;
+    DWORD history[TEST_HISTORY_LENGTH];
+    DWORD processed;
+  protected:
+    virtual DWORD processMessage( Message * );
+
+  public:
+    TestAO( DWORD );
+    DWORD getAttempts(){ return attempts; };
+    DWORD getProcessed(){ return processed; };
+    DWORD getHistory( DWORD i ){ return history[i]; };
+};
+
+#endif /*TESTAO_HPP_*/
@@ -0,0 +1,34 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef APPLICATION_HPP_
+#define APPLICATION_HPP_
+
+/*
+job - unit of work, TestAO can not process it while it is locked ( it defers the job )
+noop - event TestAO always processes without change of its state
+lock - TestAO goes to locked state
+unlock - TestAO goes to open state and recalls deferred jobs
+alert - urgent event, it overtakes events those are waiting in incoming buffer
+*/
+
+#define APP_MESSAGE_IDS job,\
+  noop,\
+  lock,\
+  unlock,\
+  alert
+
+#endif /* APPLICATION_HPP_ */
@@ -0,0 +1,51 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "AOScheduler.hpp"
+#include "Timer.hpp"
+#include "TestAO.hpp"
+#include "DriverAO.hpp"
+
+/**
+ * Test of deferred, recalled and urgent events for Linux hosted port ( Porting/Linux ).
+ * Build: ant -Dcompiler=host with appDir =Test_Defer ( see build-lnx-host.properties )
+ */
+int smain(void)
+{
+  ISAObject::nestedLevel = 0;
+  // Objects allocation
+  Timer timer( 0 );
+  TestAO test( 2 );
+  DriverAO driver( 1, &test );
+  AOScheduler scheduler;
+
+  driver.getDisplay()->clearScreen( ' ' );
+  driver.getDisplay()->print( "aoRTOS deferred/urgent events test (Linux hosted port)" );
+
+  timer.addListener( &driver );
+
+  scheduler.add( &timer );
+  scheduler.add( &driver );
+  scheduler.add( &test );
+
+  scheduler.startOS();
+//  we never come here
+  return 0;
+}
+
+int main () {
+  return smain();
+}
@@ -0,0 +1,50 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "TestAO.hpp"
+
+TestAO::TestAO( DWORD prio ) : AObject( prio ) {
+  locked = 1;
+  attempts = 0;
+  processed = 0;
+  setUrgent( alert );
+}
+
+DWORD
+TestAO::processMessage( Message * msg ) {
+  switch( msg->getMessageID() ) {
+    case job :
+      attempts++;
+      if( locked )
+        return 0;             // AObject::run() defers the job
+      if( processed < TEST_HISTORY_LENGTH )
+        history[processed++] = msg->getBinaryData();
+      return 1;
+    case alert :
+      if( processed < TEST_HISTORY_LENGTH )
+        history[processed++] = TEST_ALERT_TAG + msg->getBinaryData();
+      return 1;
+    case lock :
+      locked = 1;
+      return 1;
+    case unlock :
+      locked = 0;
+      recall();               // state is changed: deferred jobs are processed before next incoming event
+      return 1;
+    default :
+      return 1;
+  }
+}
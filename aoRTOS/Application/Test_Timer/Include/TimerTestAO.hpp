@@ -0,0 +1,63 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef TIMERTESTAO_HPP_
+#define TIMERTESTAO_HPP_
+
+#include "AObject.hpp"
+#include "Timer.hpp"
+#include "pc.hpp"
+
+/** Number of one-shot time events those are armed at once */
+const DWORD TEST_SHOTS = 6;
+
+/**
+ * Class TimerTestAO checks the time events of the Timer on the Linux hosted port:
+ *  - one-shot time events armed in random order expire in order of expiration time,
+ *    a disarmed time event does not expire, a re-armed one expires at the new time;
+ *  - periodic time event is reloaded: it expires every period without a drift;
+ *  - arm() and disarm() called with interrupts disabled ( as in ISR ) leave them disabled.
+ * Then the result is printed and the process exits ( exit code 0 - PASS ).
+ */
+class TimerTestAO : public AObject {
+  private:
+    Timer * timer;
+    Display display;
+    TimeEvent * shots[TEST_SHOTS];
+    TimeEvent * cancelled;
+    TimeEvent * moved;
+    TimeEvent * periodic;
+    DWORD start;
+    DWORD history[TEST_SHOTS + 2];
+    DWORD expired;
+    DWORD late;
+    DWORD beats;
+    DWORD drift;
+    int masked;
+    int started;
+
+    void  armAll();
+    void  check( int, int, char * );
+    void  printReport();
+  protected:
+    virtual DWORD processMessage( Message * );
+
+  public:
+    TimerTestAO( DWORD, Timer * );
+    Display * getDisplay(){ return &display; };
+};
+
+#endif /*TIMERTESTAO_HPP_*/
@@ -0,0 +1,112 @@
+/*
+   Copyright (C) 2007-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <signal.h>
+#include "TimerTestAO.hpp"
+
+/** Expiration of the one-shot time events ( ticks after start ), armed in this order */
+static const DWORD SHOT_TICKS[TEST_SHOTS] = { 9, 3, 14, 1, 6, 11 };
+/** Expected order of expirations: the shots, moved time event ( 2 ) and no cancelled one ( 8 ) */
+static const DWORD EXPECTED[TEST_SHOTS + 1] = { 1, 2, 3, 6, 9, 11, 14 };
+const DWORD CANCELLED_TICKS = 8;
+const DWORD MOVED_TICKS     = 2;
+const DWORD BEAT_PERIOD     = 4;
+/** Duration of the test ( in ticks ) */
+const DWORD TEST_TICKS      = 30;
+
+TimerTestAO::TimerTestAO( DWORD prio, Timer * t ) : AObject( prio ), timer( t ), display( 0, 0 ) {
+  for( DWORD i = 0; i < TEST_SHOTS; i++ ) {
+    shots[i] = new TimeEvent( this, shot );
+  }
+  cancelled = new TimeEvent( this, shot );
+  moved = new TimeEvent( this, shot );
+  periodic = new TimeEvent( this, beat );
+  expired = late = beats = drift = 0;
+  masked = 0;
+  started = 0;
+}
+
+void
+TimerTestAO::armAll() {
+  start = Timer::getTimeStamp();
+  for( DWORD i = 0; i < TEST_SHOTS; i++ ) {
+    timer->arm( shots[i], SHOT_TICKS[i] );
+  }
+  timer->arm( cancelled, CANCELLED_TICKS );
+  timer->arm( moved, TEST_TICKS - 10 );  // far expiration, it is moved below
+  timer->arm( periodic, BEAT_PERIOD, BEAT_PERIOD );
+  timer->disarm( cancelled );
+  timer->arm( moved, MOVED_TICKS );        // re-arm moves the time event in the heap
+
+  // arm()/disarm() have to keep interrupts disabled as in ISR
+  TimeEvent probe( this, shot );
+  sigset_t current;
+  ENTER_CRITICAL()
+  timer->arm( &probe, TEST_TICKS * 2 );
+  timer->disarm( &probe );
+  sigprocmask( SIG_BLOCK, 0, &current );
+  masked = sigismember( &current, SIGALRM );
+  EXIT_CRITICAL()
+}
+
+void
+TimerTestAO::check( int condition, int row, char * name ) {
+  display.setPosition( 0, row );
+  display.printf( "%s - %s", name, condition ? "ok" : "FAILED" );
+}
+
+void
+TimerTestAO::printReport() {
+  int ordered = ( expired == TEST_SHOTS + 1 );
+  for( DWORD i = 0; ordered && i < expired; i++ ) {
+    ordered = ( history[i] == EXPECTED[i] );
+  }
+  int reloaded = ( beats >= TEST_TICKS / BEAT_PERIOD - 1 && drift == 0 );
+  check( ordered && late == 0, 2, "one-shot time events expire in order, disarm and re-arm" );
+  check( reloaded, 3, "periodic time event is reloaded without drift" );
+  check( masked, 4, "arm() and disarm() keep interrupts disabled" );
+  display.setPosition( 0, 5 );
+  display.printf( "%s\n", ( ordered && late == 0 && reloaded && masked ) ? "PASS" : "FAIL" );
+  exit( ( ordered && late == 0 && reloaded && masked ) ? 0 : 1 );
+}
+
+DWORD
+TimerTestAO::processMessage( Message * msg ) {
+  switch( msg->getMessageID() ) {
+    case tick :
+      if( !started ) {
+        started = 1;
+        armAll();
+      } else if( Timer::getTimeStamp() - start >= TEST_TICKS ) {
+        timer->disarm( periodic );
+        printReport();
+      }
+      return 1;
+    case shot :                 // data of time event message is its expiration time
+      if( expired < TEST_SHOTS + 2 )
+        history[expired++] = msg->getBinaryData() - start;
+      if( (DWORD_S)( Timer::getTimeStamp() - msg->getBinaryData() ) < 0 )
+        late++;                 // message before expiration time
+      return 1;
+    case beat :
+      if( msg->getBinaryData() != start + ++beats * BEAT_PERIOD )
+        drift++;
+      return 1;
+    default :
+      return 1;
+  }
+}
@@ -37,7 +37,7 @@ class Hsm : public State
    State* currState;
    
  public:
-   Hsm() : State(){};
+   Hsm() : State(), activeObject( 0 ), currState( 0 ){};
   /**
    * Initializing of HSM. Moving from pseudostate (null) to initial state (this), 
    * root of HSM's state tree. 
@@ -53,6 +53,7 @@ class Hsm : public State
   /**
    * Set-method for current state. After setting currState field, we have to check
    * does have this state init transition? If it has HSM moves to up along branch of state tree. 
+   * Events deferred by the active object are recalled on entry to the new state.
    */  
    void setState( State *dest );
   /**
@@ -15,6 +15,7 @@
 */
 
 #include "Include/Hsm.h"
+#include "AObject.hpp"
 
 void
 Hsm::init()
@@ -44,6 +45,8 @@ Hsm::setState( State *dest )
   {
     (currState = daughter)->enter(); // enter to the state and try fireInit() again ^
   }
+  if( activeObject != 0 )
+    activeObject->recall();          // new state can handle events deferred by previous one
 }
 
   /**
@@ -58,6 +61,6 @@ Hsm::dispatchEvent( Message *e )
   while( (parentState = parentState->fireEvent( e )) != 0 ); // fire event to all states
                         // below current state and stop on root or state that return 0.
   if( e->getMessageID() < 0 )  // if event can not be processed, fireEvent() marks event as 'ret'=-1.
-    return 0;           // return 'failed' flag
+    return 0;           // return 'failed' flag ( active object defers the event )
   return 1;             // return 'success'
 }
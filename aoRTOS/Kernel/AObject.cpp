@@ -32,6 +32,11 @@ AObject::AObject( DWORD prio )
   list = new ListenerList(AO_LISTENERS_LIST_LENGTH);
   incomingRingBuffer = new RingBuffer<Message>(AO_RINGBUFFER_LENGTH);
   outgoingRingBuffer = new RingBuffer<Message>(AO_RINGBUFFER_LENGTH);
+  deferredRingBuffer = new RingBuffer<Message>(AO_DEFERRED_LENGTH);
+  urgentRingBuffer = new RingBuffer<Message>(AO_URGENT_LENGTH);
+  recalled = 0;
+  deferredOverflow = 0;
+  urgentMask = 0;
   Process::init( this, &staticRun );
 }
 
@@ -39,30 +44,23 @@ AObject::~AObject() {
   delete list;
   delete incomingRingBuffer;
   delete outgoingRingBuffer;
+  delete deferredRingBuffer;
+  delete urgentRingBuffer;
 }
 
 void
 AObject::run() {
   Message msg;
-  int failedProcess = 0;   // count of failed try to process incoming events from buffer.
   while ( stop == 0 ) {    // this is infinite loop while stop = 0;
 //debugPrint( 55+getPriority(), (char)('A'+getPriority()) );
-    if ( incomingRingBuffer->get( &msg ) == 0 ) { // try to read event from buffer
-      ready = 0;          // have no any events to process
+    if ( getIncomingMessage( &msg ) == 0 ) { // try to read event from buffers
+      ready = 0;          // have no any events to process ( deferred events wait for recall )
       AO_CONTEXT_SW();    // pass CPU control to others AO by invoking of scheduler
     } else {
-      Message rev( msg );                   // create a clone of msg; TODO: because msg can be changed during processing by HSM ==not good==
+      Message rev( msg );                   // create a clone of msg because msg can be changed during processing by HSM
       if( processMessage( &msg ) == 0 ) {  // processMessage() can not complete a proceeding of the event
-        putIncomingMessage( &rev );         // return the event back to the buffer ( to tail)
-        failedProcess++;
-// In this point AO can continue to process other events. But if size of incoming buffer equals
-// to failedProcess it means that buffer contains only failed events so it is time to allow
-// other AO to run.
-        if( incomingRingBuffer->bufferLoad() <= failedProcess ) {
-          failedProcess = 0;
-          ready = 0;                    // allow scheduler to activate another AO
-          AO_CONTEXT_SW();              // schedule a tasks ...
-        }
+        if( defer( &rev ) == 0 )            // park the event until state of AO is changed ( recall() )
+          deferredOverflow++;               // deferred queue is full: the event is lost
       }
     }
   }
@@ -105,10 +103,26 @@ DWORD
 AObject::putIncomingMessage(Message * msg) {
   ready = 1; // this AO is ready to run. Scheduler will give it control during next schedule time
              // when this priority will be highest in the system.
+  DWORD mid = (DWORD) msg->getMessageID();
+  if (mid < 32 && (urgentMask & (1UL << mid)) != 0) {  // urgent event class goes to priority lane
+    if (urgentRingBuffer->write(msg) != 0)
+      return 1;                                          // ( FIFO is a fallback if the lane is full )
+  }
 // put incoming message to the buffer for further processing
   return incomingRingBuffer->write(msg);
 }
 
+DWORD
+AObject::getIncomingMessage(Message * msg) {
+  if (urgentRingBuffer->get(msg) != 0)       // priority lane first
+    return 1;
+  if (recalled > 0) {                        // then deferred events those were recalled
+    recalled--;
+    return deferredRingBuffer->get(msg);
+  }
+  return incomingRingBuffer->get(msg);
+}
+
 void AObject::log(BYTE level, char* text){
   if (level > LOGGING_LEVEL) {
     int size = 80;
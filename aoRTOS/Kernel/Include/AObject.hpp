@@ -36,6 +36,16 @@ class AObject : public Process {
    RingBuffer<Message> *incomingRingBuffer;
 /** ringBuffer keeps the outgoing events for farther processing by scheduler.*/
    RingBuffer<Message> *outgoingRingBuffer;
+/** ringBuffer keeps the events the current state can not handle ( deferred events ).*/
+   RingBuffer<Message> *deferredRingBuffer;
+/** priority lane: urgent events bypass FIFO of incoming events.*/
+   RingBuffer<Message> *urgentRingBuffer;
+/** number of recalled deferred events those have to be processed before incoming events.*/
+   DWORD recalled;
+/** number of events lost because queue of deferred events was full.*/
+   DWORD deferredOverflow;
+/** bit mask of urgent event classes: bit N is set when MessageID N goes to priority lane.*/
+   DWORD urgentMask;
 
 /***************** Methods ***************/
  protected:
@@ -69,9 +79,10 @@ class AObject : public Process {
    inline DWORD putOutgoingMessage( Message * msg ) {return outgoingRingBuffer->write( msg );};
 
 /**
- * Read next available message from incoming buffer.
+ * Read next available message: urgent events first, then recalled deferred events,
+ * then incoming buffer in FIFO order.
  */
-   inline DWORD getIncomingMessage( Message * msg ) {return incomingRingBuffer->get( msg );};
+   DWORD getIncomingMessage( Message * msg );
 
  public:
 /**
@@ -97,12 +108,38 @@ class AObject : public Process {
  */
    void removeListener( AObject * ao );
 
+/**
+ * Parks the event the current state can not handle. AObject::run() defers the event
+ * automatically if processMessage() returns 0 and counts the events lost because
+ * the queue is full ( see deferredOverflowCount() ).
+ *  @param msg - event to defer.
+ *  @return 1 - event is deferred, 0 - queue of deferred events is full.
+ */
+   inline DWORD defer( Message * msg ) {return deferredRingBuffer->write( msg );};
+
+/**
+ * Recalls all deferred events: they are processed again in their original order before
+ * any event from incoming buffer. Has to be invoked on a state change only: Hsm does it
+ * in setState(), an AO with own state ( or Fsm ) calls it after its transition.
+ *  @return number of recalled events.
+ */
+   inline DWORD recall() {return recalled = deferredRingBuffer->bufferLoad();};
+
+/**
+ * Marks the event class as urgent: events with this id bypass incoming FIFO through the
+ * priority lane of this active object.
+ *  @param mid - event id ( has to be less than 32 ).
+ */
+   inline void setUrgent( MessageID mid ) {if( (DWORD) mid < 32 ) urgentMask |= ( 1UL << mid );};
+
 /**
  * {Debug} Functions return level of loading of ring buffer.
  *  @return int - number of elements available for reading
  */
    inline DWORD incomingBufferLoad(){ return incomingRingBuffer->bufferLoad(); };
    inline DWORD outgoingBufferLoad(){ return outgoingRingBuffer->bufferLoad(); };
+   inline DWORD deferredBufferLoad(){ return deferredRingBuffer->bufferLoad(); };
+   inline DWORD deferredOverflowCount(){ return deferredOverflow; };
 /**
  * Helper function for logging service.
  *  @param level - logging level (info = 0, error = 1, debug = 2).
@@ -24,6 +24,8 @@
  * ready to accept an incoming message. rdPo points to first buffer element ready to be read out.
  * Pointers are moving thru buffer cyclically when pointer reach the bottom of buffer it go to
  * top.
+ * Writer (scheduler inside of interrupt) and reader (Active Object) do not share any counter:
+ * each side increments only its own one, so the interrupt can not lose an update of the other side.
  */
 template <class MessageType>
 class RingBuffer {
@@ -33,7 +35,9 @@ class RingBuffer {
 	DWORD wrPo;
 /** rdPo keeps index of element of queue that ready to be read.*/
 	DWORD rdPo;
-  DWORD load;
+/** Free running counters of written and read elements. Difference is a load of the buffer.*/
+  volatile DWORD wrCount;
+  volatile DWORD rdCount;
 /** Size of queue.*/
   DWORD N;
 /** Array of Messages */
@@ -61,17 +65,17 @@ class RingBuffer {
 /** The method returns amount of elements that are available for reading.
  *  ( for debugging use )
  */
-    inline DWORD bufferLoad(){return load;};
+    inline DWORD bufferLoad(){return wrCount - rdCount;};
 };
 
 template <class MessageType>
-RingBuffer<MessageType>::RingBuffer(DWORD n) : wrPo(0), rdPo(0), load(0) {
+RingBuffer<MessageType>::RingBuffer(DWORD n) : wrPo(0), rdPo(0), wrCount(0), rdCount(0) {
   N = ( n > AO_RINGBUFFER_LENGTH ) ? AO_RINGBUFFER_LENGTH : n;
   queue = new MessageType[N];
 }
 
 template <class MessageType>
-RingBuffer<MessageType>::RingBuffer() : N(AO_RINGBUFFER_LENGTH), wrPo(0), rdPo(0), load(0) {
+RingBuffer<MessageType>::RingBuffer() : N(AO_RINGBUFFER_LENGTH), wrPo(0), rdPo(0), wrCount(0), rdCount(0) {
   queue = new MessageType[N];
 }
 
@@ -83,10 +87,11 @@ RingBuffer<MessageType>::~RingBuffer() {
 template <class MessageType>
 DWORD
 RingBuffer<MessageType>::write( MessageType * message ) {
-  if( load < N ) {            // is buffer full ?
+  if( wrCount - rdCount < N ) {  // is buffer full ?
     queue[wrPo++] = *message;
     if (wrPo >= N) wrPo = 0;  // set pointer to next element and revert to 0 if wrPo >= N (implements a ring)
-    load++;
+    AO_COMPILER_BARRIER();    // element has to be stored before reader can see it
+    wrCount++;
     return 1;
   }
   return 0;
@@ -95,10 +100,11 @@ RingBuffer<MessageType>::write( MessageType * message ) {
 template <class MessageType>
 DWORD
 RingBuffer<MessageType>::get( MessageType * message ) {
-  if( load > 0 ) {             // is a buffer empty ?
+  if( wrCount != rdCount ) {   // is a buffer empty ?
     *message = queue[rdPo++];
     if (rdPo >= N) rdPo = 0;   // go to next element and revert to 0 if rdPo >= N (implements a ring)
-    load--;
+    AO_COMPILER_BARRIER();     // element has to be copied before writer can reuse it
+    rdCount++;
     return 1;
   }
   return 0;
@@ -19,11 +19,34 @@
 
 #include "ISAObject.hpp"
 
+/**
+ * Class TimeEvent is a timeout owned by an Active Object.
+ * When the timeout expires the Timer sends the message with given MessageID
+ * to the target Active Object only (not to the Timer's listeners).
+ * TimeEvent is armed and disarmed by Timer::arm() and Timer::disarm().
+ */
+class TimeEvent
+{
+  friend class Timer;
+  private:
+    AObject * target;
+    MessageID mid;
+    DWORD expiry;  /** absolute time of expiration (in ticks) */
+    DWORD period;  /** reload interval (in ticks), 0 for one-shot timeout */
+    DWORD_S index; /** position in the Timer's heap, -1 if the time event is not armed */
+  public:
+    TimeEvent( AObject * t, MessageID m ) : target(t), mid(m), expiry(0), period(0), index(-1) {};
+    inline BYTE isArmed() {return index >= 0;};
+};
+
 /**
  * Class Timer is a wrapper for system board clock.
  * Timer activates RTOS scheduler each time when interrupt from system clock rise.
- * Furthermore Timer can send events to the Active Objects those need time service.
- * These Active objects have to register to the Timer as listeners.
+ * Furthermore Timer can send events to the Active Objects those need time service:
+ *   - broadcast tick and sec messages to the Active Objects registered to the Timer as listeners;
+ *   - time events (one-shot or periodic timeouts) those are kept in a min-heap ordered by expiration time.
+ * If the port defines AO_TICKLESS_TIMER and the tick broadcast is switched off
+ * the system clock is programmed for the nearest expiration only.
  */
 class Timer : public ISAObject
 {
@@ -31,11 +54,21 @@ class Timer : public ISAObject
  * Helper variables:
  *   second - helps to select a seconds from tick's flow.
  *   period - helps to determ a moment to change display symbol.
+ *   heap, heapLength - binary min-heap of armed time events.
+ *   broadcast - tick and sec messages are sent to listeners if it is not 0.
  */
  private:
    WORD_S second, period;
    Message tickMsg, secMsg;
+   TimeEvent ** heap;
+   DWORD heapLength;
+   BYTE broadcast;
    static DWORD timeStamp;
+   void heapUp( DWORD );
+   void heapDown( DWORD );
+   void heapRemove( DWORD );
+   void dispatchTimeEvents();
+   void programClock();
  protected:
 /**
  *  This method overrides the processMessage() method from AObject superclass.
@@ -46,9 +79,21 @@ class Timer : public ISAObject
  */
    virtual AO_STACK * serviceInterrupt( AO_STACK * stp );
  public:
-/** Constructor creates Timer object with priority p */
-   Timer( DWORD p );
-   inline static DWORD getTimeStamp() {return timeStamp;};
+/** Constructor creates Timer object with priority p; broadcastTick turns on tick and sec messages */
+   Timer( DWORD p, BYTE broadcastTick = 1 );
+/** returns current time (in ticks) */
+   static DWORD getTimeStamp();
+/**
+ *  Arms time event te to expire after ticks and then every periodTicks (0 - one-shot).
+ *  Re-arms te if it is armed already. Returns 0 if the heap is full.
+ *  arm() and disarm() restore the interrupt state they found, so they are called from
+ *  Active Object's thread or from ISR ( interrupts stay disabled there ).
+ */
+   DWORD arm( TimeEvent * te, DWORD ticks, DWORD periodTicks = 0 );
+/**  Disarms time event te. Returns 0 if te was not armed. */
+   DWORD disarm( TimeEvent * te );
+/**  Turns on/off broadcasting of tick and sec messages to the listeners. */
+   void setBroadcast( BYTE b );
 };
 
 #endif
@@ -22,7 +22,15 @@
 
 /* Data structure configuration constants */
 const DWORD AO_RINGBUFFER_LENGTH       = 128;  //* set ring buffer maximum length (in Messages) */
+const DWORD AO_DEFERRED_LENGTH         = 128;  //* set length of deferred events queue of Active Object (in Messages), as incoming buffer */
+const DWORD AO_URGENT_LENGTH           = 16;   //* set length of priority lane of Active Object (in Messages) */
+const DWORD AO_TIME_EVENTS_LENGTH       = 32;   //* set maximum number of armed time events of Timer */
+const DWORD AO_TICKS_PER_SECOND        = 100;  //* set system clock rate (in ticks per second) */
+#ifdef _LINUX_
+const DWORD AO_STACK_LENGTH            = 16384; //* hosted port: stack keeps ucontext, signal frames and libc calls */
+#else
 const DWORD AO_STACK_LENGTH            = 256;  //* set stack length of Active Object (in DWORDs)*/
+#endif
 const DWORD AO_LISTENERS_LIST_LENGTH   = 16;    //* set length of listeners list */
 const DWORD AO_SCHEDULED_LIST_LENGTH   = 16;    //* set length of AO list for scheduler */
 const DWORD AO_INTERRUPT_TABLE_LENGTH  = 17;    //* set length of interrupt service AO table */
@@ -33,7 +41,7 @@ const BYTE LOGGING_LEVEL = 2;
 /** Enumeration of all event id are using in RTOS applications */
 enum MessageID
 {
-  ret = -1,  /** event is returned back to the ring buffer of AO, after processing was failed */
+  ret = -1,  /** event can not be processed in current state, AO defers it until a state change */
   no = 0,    /** unknown event */
   tick,      /** system clock event */
   sec,       /** system clock event with second period */
@@ -26,6 +26,9 @@ Process::~Process() {
 
 void
 Process::init( AObject * subClassThis, void cdecl (*fp)( AObject * ) ) {
+#ifdef _LINUX_
+  sp = hostStackInit( stack, AO_STACK_LENGTH, subClassThis, (void (*)( void * ))fp ); // ucontext frame ( porting issue )
+#else
   sp = &stack[AO_STACK_LENGTH];    // Load stack pointer
   *(--sp) = (DWORD)subClassThis;   // Simulate call to function with argument <this>
   *(--sp) = 0;                     // return address (fictive)
@@ -40,4 +43,5 @@ Process::init( AObject * subClassThis, void cdecl (*fp)( AObject * ) ) {
   *(--sp) = 0x1111;                // EBP = 0x1111
   *(--sp) = 0x2222;                // ESI = 0x2222
   *(--sp) = 0x3333;                // EDI = 0x3333
+#endif /* _LINUX_ */
 }
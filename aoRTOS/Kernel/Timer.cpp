@@ -19,17 +19,35 @@
 
 DWORD Timer::timeStamp;
 
+/** compares two time stamps with respect to wrap around of the tick counter */
+static inline BYTE
+isBefore( DWORD a, DWORD b ) {
+  return (DWORD_S) (a - b) < 0;
+}
+
 /** creates IS Active object with priority p and interrupt vector 0 */
-Timer::Timer( DWORD p ) : ISAObject( p, 0 ) {
-  second = 0;
+Timer::Timer( DWORD p, BYTE broadcastTick ) : ISAObject( p, 0 ) {
+  second = AO_TICKS_PER_SECOND;
   period = 0;
   Message e(this, 0, (DWORD) 0, tick);
   tickMsg = e;
   e.setMessageID(sec);
   secMsg = e;
+  heap = new TimeEvent*[AO_TIME_EVENTS_LENGTH];
+  heapLength = 0;
+  broadcast = broadcastTick;
   timeStamp = 0;
 }
 
+DWORD
+Timer::getTimeStamp() {
+#ifdef AO_TICKLESS_TIMER
+  return PC_ClockTicks();  // the clock interrupt does not come each tick
+#else
+  return timeStamp;
+#endif
+}
+
 AO_STACK *
 Timer::serviceInterrupt( AO_STACK *stk ) {
   /*
@@ -38,17 +56,37 @@ Timer::serviceInterrupt( AO_STACK *stk ) {
    * But if event processing can be delayed then Timer sends the message to itself and
    * its own thread will process this message by processMessage() method that is running with own priority.
    */
-  tickMsg.setBinaryData(++timeStamp);
-  putOutgoingMessage( &tickMsg );
+#ifdef AO_TICKLESS_TIMER
+  DWORD now = PC_ClockTicks();
+  DWORD elapsed = now - timeStamp;
+  timeStamp = now;
+#else
+  DWORD elapsed = 1;
+  ++timeStamp;
+#endif
+  if( broadcast != 0 ) {
+    tickMsg.setBinaryData(timeStamp);
+    putOutgoingMessage( &tickMsg );
+    if( elapsed >= (DWORD) second ) {
+      putOutgoingMessage( &secMsg );
+      second = AO_TICKS_PER_SECOND;
+    } else {
+      second -= (WORD_S) elapsed;
+    }
+  }
+
+  AO_CPU_SR sr;
+  SAVE_CRITICAL( sr )   // heap is shared with arm()/disarm() called by Active Objects
+  dispatchTimeEvents();
+  programClock();
+  RESTORE_CRITICAL( sr ) // interrupts stay disabled inside of ISR
   return stk;
 }
 
 DWORD
-Timer::processMessage(Message*) {
+Timer::processMessage(Message* msg) {
   char p;
-  if (--second < 0) {
-    putOutgoingMessage(&secMsg);
-    second = 100;
+  if (msg->getMessageID() == sec) {
     switch (period++) {
       case 0:
         p = '-';
@@ -70,3 +108,132 @@ Timer::processMessage(Message*) {
   }
   return 1;
 }
+
+/**
+ * Sends messages of all expired time events to theirs targets.
+ * Periodic time events are reloaded, one-shot ones are removed from the heap.
+ * Called with interrupts disabled.
+ */
+void
+Timer::dispatchTimeEvents() {
+  while( heapLength > 0 && !isBefore( timeStamp, heap[0]->expiry ) ) {
+    TimeEvent *te = heap[0];
+    Message e(this, te->target, te->expiry, te->mid);
+    putOutgoingMessage( &e );
+    if( te->period != 0 ) {
+      te->expiry += te->period;
+      heapDown( 0 );
+    } else {
+      heapRemove( 0 );
+    }
+  }
+}
+
+/**
+ * Programs the system clock for the next interrupt: next tick if broadcast is on,
+ * otherwise the nearest expiration. An idle tickless clock is left stopped.
+ * Called with interrupts disabled.
+ */
+void
+Timer::programClock() {
+#ifdef AO_TICKLESS_TIMER
+  if( broadcast != 0 ) {
+    PC_ClockProgram( timeStamp + 1 );
+  } else if( heapLength > 0 ) {
+    PC_ClockProgram( heap[0]->expiry );
+  }
+#endif
+}
+
+DWORD
+Timer::arm( TimeEvent * te, DWORD ticks, DWORD periodTicks ) {
+  AO_CPU_SR sr;
+  if( ticks == 0 )
+    ticks = 1;
+  SAVE_CRITICAL( sr )
+  if( te->index < 0 ) {
+    if( heapLength >= AO_TIME_EVENTS_LENGTH ) {
+      RESTORE_CRITICAL( sr )
+      return 0;
+    }
+    te->index = heapLength;
+    heap[heapLength++] = te;
+  }
+  te->expiry = getTimeStamp() + ticks;
+  te->period = periodTicks;
+  heapUp( te->index );
+  heapDown( te->index );
+  if( te->index == 0 && broadcast == 0 )
+    programClock();     // new nearest expiration
+  RESTORE_CRITICAL( sr )
+  return 1;
+}
+
+DWORD
+Timer::disarm( TimeEvent * te ) {
+  AO_CPU_SR sr;
+  SAVE_CRITICAL( sr )
+  if( te->index < 0 ) {
+    RESTORE_CRITICAL( sr )
+    return 0;
+  }
+  heapRemove( te->index );  // the clock may still interrupt once for removed expiration, it is harmless
+  RESTORE_CRITICAL( sr )
+  return 1;
+}
+
+void
+Timer::setBroadcast( BYTE b ) {
+  AO_CPU_SR sr;
+  SAVE_CRITICAL( sr )
+  broadcast = b;
+  second = AO_TICKS_PER_SECOND;
+  programClock();
+  RESTORE_CRITICAL( sr )
+}
+
+void
+Timer::heapUp( DWORD i ) {
+  TimeEvent *te = heap[i];
+  while( i > 0 ) {
+    DWORD parent = (i - 1) >> 1;
+    if( !isBefore( te->expiry, heap[parent]->expiry ) )
+      break;
+    heap[i] = heap[parent];
+    heap[i]->index = i;
+    i = parent;
+  }
+  heap[i] = te;
+  te->index = i;
+}
+
+void
+Timer::heapDown( DWORD i ) {
+  TimeEvent *te = heap[i];
+  for( ;; ) {
+    DWORD child = 2 * i + 1;
+    if( child >= heapLength )
+      break;
+    if( child + 1 < heapLength && isBefore( heap[child + 1]->expiry, heap[child]->expiry ) )
+      child++;
+    if( !isBefore( heap[child]->expiry, te->expiry ) )
+      break;
+    heap[i] = heap[child];
+    heap[i]->index = i;
+    i = child;
+  }
+  heap[i] = te;
+  te->index = i;
+}
+
+void
+Timer::heapRemove( DWORD i ) {
+  heap[i]->index = -1;
+  if( i != --heapLength ) {
+    TimeEvent *last = heap[heapLength];
+    heap[i] = last;
+    last->index = i;
+    heapUp( i );
+    heapDown( last->index );
+  }
+}
@@ -17,7 +17,9 @@
 /** Helper file to gather the all cpp files to one */
 
 //#include "RingBuffer.cpp"
-#include "memory.cpp"
+#ifndef _LINUX_
+#include "memory.cpp"   // hosted port uses libc heap ( see Porting/Linux/host/pc.cpp )
+#endif
 #include "ListenerList.cpp"
 #include "Process.cpp"
 #include "AObject.cpp"
@@ -35,6 +35,7 @@ typedef unsigned long    DWORD;                    /* Unsigned 32 bit type */
 typedef signed   long    DWORD_S;                  /* Signed   32 bit type */
 
 typedef unsigned long    AO_STACK;                 /* Each stack entry is 32-bit wide */
+typedef unsigned long    AO_CPU_SR;                /* Saved EFLAGS (interrupt state) */
 
 /*
 ***************************************************************************
@@ -99,6 +100,27 @@ typedef unsigned long    AO_STACK;                 /* Each stack entry is 32-bit
 {                                               \
     asm("sti");                                 \
 }
+/* Save interrupt state to _sr_ and disable interrupts (for code those are called from ISR too) */
+#define  SAVE_CRITICAL( _sr_ )                  \
+{                                               \
+    asm volatile ( "pushfl ;"                   \
+                   "popl %0 ;"                  \
+                   "cli"                        \
+                   : "=r" (_sr_)                \
+                   :                            \
+                   : "memory"                   \
+        );                                      \
+}
+/* Restore interrupt state saved by SAVE_CRITICAL() */
+#define  RESTORE_CRITICAL( _sr_ )               \
+{                                               \
+    asm volatile ( "pushl %0 ;"                 \
+                   "popfl"                      \
+                   :                            \
+                   : "r" (_sr_)                 \
+                   : "memory", "cc"             \
+        );                                      \
+}
 #endif /* _GCC_ */
 
 #ifdef _WATCOM_
@@ -112,7 +134,34 @@ typedef unsigned long    AO_STACK;                 /* Each stack entry is 32-bit
 {                                               \
     _asm { sti };                                 \
 }
+/* Save interrupt state to _sr_ and disable interrupts (for code those are called from ISR too) */
+#define  SAVE_CRITICAL( _sr_ )                  \
+{                                               \
+  _asm { pushfd };                              \
+  _asm { pop _sr_ };                            \
+  _asm { cli };                                 \
+}
+/* Restore interrupt state saved by SAVE_CRITICAL() */
+#define  RESTORE_CRITICAL( _sr_ )               \
+{                                               \
+  _asm { push _sr_ };                           \
+  _asm { popfd };                               \
+}
 #endif /* _WATCOM_ */
+/*
+***************************************************************************
+* Compiler barrier: keeps memory accesses of the RTOS data structures those
+* are shared with interrupt handlers in program order.
+***************************************************************************
+*/
+#ifdef _GCC_
+#define  AO_COMPILER_BARRIER()  asm volatile ( "" : : : "memory" )
+#endif /* _GCC_ */
+
+#ifdef _WATCOM_
+#define  AO_COMPILER_BARRIER()
+#endif /* _WATCOM_ */
+
 /*
 *********************************************************************************************************
 *                           Intel 80x386 (Protected-Mode, Flat Model)
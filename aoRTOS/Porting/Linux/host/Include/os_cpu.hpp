@@ -0,0 +1,130 @@
+/*
+   Copyright (C) 2010 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#ifndef _OS_CPU_HPP
+#define _OS_CPU_HPP
+
+#include <signal.h>
+
+#ifdef _GCC_
+#define cdecl
+#endif /* _GCC_ */
+/*
+***************************************************************************
+*                          DATA TYPES
+*                     (Compiler Specific)
+***************************************************************************
+*/
+
+typedef unsigned char    BOOLEAN;
+typedef unsigned char    BYTE;                     /* Unsigned  8 bit type */
+typedef signed   char    BYTE_S;                   /* Signed    8 bit type */
+typedef unsigned short   WORD;                     /* Unsigned 16 bit type */
+typedef signed   short   WORD_S;                   /* Signed   16 bit type */
+typedef unsigned long    DWORD;                    /* Unsigned 32 bit type (pointer wide on LP64 hosts) */
+typedef signed   long    DWORD_S;                  /* Signed   32 bit type (pointer wide on LP64 hosts) */
+
+typedef unsigned long    AO_STACK;                 /* Each stack entry is pointer wide */
+typedef sigset_t         AO_CPU_SR;                /* Saved signal mask (interrupt state) */
+
+/*
+***************************************************************************
+*                   Linux hosted port (simulation)
+*
+* The port emulates the Ix386 interrupt model with POSIX facilities:
+*   - a "CPU interrupt flag" is the SIGALRM bit of the process signal mask;
+*   - the PIT timer interrupt (vector 0x20) is a POSIX timer raising SIGALRM;
+*   - the scheduler's program interrupt (vector 0x30) is a direct call to
+*     the installed vector with SIGALRM masked;
+*   - the CPU context of an Active Object is a ucontext_t kept on the top
+*     of its own stack. AO_STACK * stack pointer saved by the scheduler
+*     is the address of this ucontext_t.
+***************************************************************************
+*/
+
+/** Period of emulated system clock interrupt (microseconds). 100 Hz as PIT on Ix386. */
+const unsigned long HOST_TIMER_PERIOD_US = 10000;
+
+/** System clock is one-shot: Timer programs it for the next expiration (see PC_ClockProgram()). */
+#define AO_TICKLESS_TIMER
+
+/** Signal mask that represents all interrupt lines of the emulated CPU. */
+extern sigset_t hostInterruptMask;
+
+/** Emulates 'int vect' instruction: invokes the vector with interrupts disabled. */
+void hostSoftwareInterrupt( BYTE vect );
+
+/** Builds initial CPU context for an Active Object (see Process::init()).
+ *  @param stack - bottom of the stack memory.
+ *  @param length - length of the stack (in AO_STACK elements).
+ *  @param arg - argument of the entry function.
+ *  @param fp - entry function.
+ *  @return value of stack pointer the scheduler uses to switch to the context.
+ */
+AO_STACK * hostStackInit( AO_STACK * stack, unsigned long length, void * arg, void (*fp)( void * ) );
+
+/* Port access is not available for hosted port. */
+#define inp( _register_, _value_ )   { _value_ = 0; }
+#define outp( _register_, _value_ )  { }
+
+/*
+***************************************************************************
+*                   Linux hosted port
+*
+* CPU interrupt enable/disable macros:
+* Disable/Enable interrupts by masking of signals the emulated interrupts use.
+*
+***************************************************************************
+*/
+/* Disable interrupts                        */
+#define  ENTER_CRITICAL()                                     \
+{                                                             \
+    sigprocmask( SIG_BLOCK, &hostInterruptMask, 0 );          \
+}
+/* Enable  interrupts                        */
+#define  EXIT_CRITICAL()                                      \
+{                                                             \
+    sigprocmask( SIG_UNBLOCK, &hostInterruptMask, 0 );        \
+}
+/* Save interrupt state to _sr_ and disable interrupts (for code those are called from ISR too) */
+#define  SAVE_CRITICAL( _sr_ )                                \
+{                                                             \
+    sigprocmask( SIG_BLOCK, &hostInterruptMask, &(_sr_) );    \
+}
+/* Restore interrupt state saved by SAVE_CRITICAL() */
+#define  RESTORE_CRITICAL( _sr_ )                             \
+{                                                             \
+    sigprocmask( SIG_SETMASK, &(_sr_), 0 );                   \
+}
+/*
+***************************************************************************
+* Compiler barrier: keeps memory accesses of the RTOS data structures those
+* are shared with interrupt handlers in program order.
+***************************************************************************
+*/
+#define  AO_COMPILER_BARRIER()  asm volatile ( "" : : : "memory" )
+
+/*
+*********************************************************************************************************
+*                           Linux hosted port
+* Context switching by using emulated program interrupt 0x30
+*********************************************************************************************************
+*/
+#define  AO_CONTEXT_SW()               \
+{                                      \
+    hostSoftwareInterrupt( 0x30 );     \
+}
+
+#endif /* _OS_CPU_HPP */
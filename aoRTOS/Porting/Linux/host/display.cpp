@@ -0,0 +1,161 @@
+/*
+   Copyright (C) 2010-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include "display.hpp"
+
+/** VGA colour index (blue, green, red bits) to ANSI colour index (red, green, blue bits) */
+static const int ansiColor[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+
+/**
+ * Writes the buffer to stdout. Active Objects can be preempted by the timer
+ * interrupt inside of the libc, so output is done with interrupts disabled.
+ */
+static void
+hostWrite( const char * s, int n )
+{
+  sigset_t flags;
+  sigprocmask( SIG_BLOCK, &hostInterruptMask, &flags );
+  while( n > 0 )
+  {
+    int w = write( 1, s, n );
+    if( w <= 0 )
+      break;
+    s += w;
+    n -= w;
+  }
+  sigprocmask( SIG_SETMASK, &flags, 0 );
+}
+
+int
+Display::isTerminal()
+{
+  static int tty = -1;
+  if( tty < 0 )
+    tty = isatty( 1 );
+  return tty;
+}
+
+void
+Display::locate()
+{
+  char seq[40];
+  int fg = color & 0x0F, bg = ( color >> 4 ) & 0x07;
+  int n = snprintf( seq, sizeof( seq ), "\033[%d;%dH\033[0;%s%s%d;%dm",
+                    y + 1, x + 1,
+                    ( fg & 0x08 ) ? "1;" : "",
+                    ( color & BLINK ) ? "5;" : "",
+                    30 + ansiColor[fg & 0x07], 40 + ansiColor[bg] );
+  hostWrite( seq, n );
+}
+
+void
+Display::clearScreen( int ch )
+{
+  if( isTerminal() )
+  {
+    locate();
+    hostWrite( "\033[2J", 4 );
+  }
+  setPosition( 0, 0 );
+}
+
+void
+Display::clearColomn( int ch, int x )
+{
+  if( isTerminal() )
+  {
+    for( int i = 0; i < maxY; i++)
+    {
+      print( x, i, (char)ch );
+    }
+  }
+}
+
+void
+Display::clearRow( int ch, int y )
+{
+  if( isTerminal() )
+  {
+    char row[80];
+    memset( row, ch, sizeof( row ) );
+    setPosition( 0, y );
+    locate();
+    hostWrite( row, ( maxX < (int)sizeof( row ) ) ? maxX : sizeof( row ) );
+  }
+}
+
+void
+Display::print( char s )
+{
+  char str[2] = { s, 0 };
+  print( str );
+}
+
+void
+Display::print( char * s )
+{
+  int n = strlen( s );
+  if( !isTerminal() )                    // plain output: rows are lines, no wrapping
+  {
+    if( y != lastY )
+    {
+      hostWrite( "\n", 1 );
+      lastY = y;
+    }
+    hostWrite( s, n );
+    x += n;
+    return;
+  }
+  while( n > 0 )
+  {
+    int chunk = maxX - x;                // rest of current row
+    if( chunk > n )
+      chunk = n;
+    locate();
+    hostWrite( s, chunk );
+    s += chunk;
+    n -= chunk;
+    if( (x += chunk) >= maxX )
+    {
+      x = 0;
+      y++;
+    };
+  }
+}
+
+void
+Display::printf( char * format, ... )
+{
+  char out[250];
+  va_list ap;
+  va_start( ap, format );
+  vsnprintf( out, sizeof( out ), format, ap );
+  va_end( ap );
+  print( out );
+}
+
+void
+Display::sprintf( char * out, char * format, ... )
+{
+  va_list ap;
+  va_start( ap, format );
+  vsprintf( out, format, ap );
+  va_end( ap );
+}
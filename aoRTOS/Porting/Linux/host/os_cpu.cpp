@@ -0,0 +1,105 @@
+/*
+   Copyright (C) 2010 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+/**
+ * Linux hosted replacement of Porting/Ix386/asm/nasm/os_cpu_gcc.asm:
+ * interrupt service routines and CPU context switching on top of ucontext.
+ */
+
+#include <ucontext.h>
+#include <stdint.h>
+#include "ISAObject.hpp"
+
+/**
+ * Initial frame of an Active Object placed on the top of its stack.
+ * The ucontext_t has to be the first field: scheduler keeps the address of
+ * the frame as AO_STACK * stack pointer and the port casts it back to ucontext_t.
+ */
+struct HostFrame
+{
+  ucontext_t context;
+  void (*fp)( void * );
+  void * arg;
+};
+
+/** CPU context of the main() thread. It becomes a context of idle AO in AOScheduler::startOS(). */
+static ucontext_t hostMainContext;
+/** Stack pointer (context) of running thread. */
+static AO_STACK * hostCurrentSP = (AO_STACK *)&hostMainContext;
+
+/** Entry point of a new context: the pointer to frame is split to two int arguments of makecontext() */
+static void
+hostEntry( unsigned int hi, unsigned int lo )
+{
+  HostFrame * frame = (HostFrame *)(uintptr_t)( ( (unsigned long long)hi << 32 ) | lo );
+  EXIT_CRITICAL()          // as iret loads SW = 0x202 on Ix386
+  frame->fp( frame->arg );
+  for( ;; )                // run() of an AO never returns on a target
+    AO_CONTEXT_SW();
+}
+
+AO_STACK *
+hostStackInit( AO_STACK * stack, unsigned long length, void * arg, void (*fp)( void * ) )
+{
+  uintptr_t top = (uintptr_t)( stack + length ) - sizeof( HostFrame );
+  HostFrame * frame = (HostFrame *)( top & ~(uintptr_t)15 );   // keep frame 16-byte aligned
+  unsigned long long p = (uintptr_t)frame;
+
+  frame->fp = fp;
+  frame->arg = arg;
+  getcontext( &frame->context );
+  frame->context.uc_stack.ss_sp = stack;
+  frame->context.uc_stack.ss_size = (BYTE *)frame - (BYTE *)stack;
+  frame->context.uc_link = 0;
+  // context starts with interrupts disabled: swapcontext() restores the signal mask before
+  // it restores registers, so an enabled SIGALRM could be delivered on the stack of previous context.
+  frame->context.uc_sigmask = hostInterruptMask;
+  makecontext( &frame->context, (void (*)())hostEntry, 2, (unsigned int)( p >> 32 ), (unsigned int)p );
+  return (AO_STACK *)frame;
+}
+
+/**
+ * Switches CPU to the context returned by processInterrupt(). Interrupts are masked here:
+ * the mask is saved to the context of preempted thread and restored when the thread resumes.
+ */
+static void
+hostSwitch( AO_STACK * next )
+{
+  if( next != hostCurrentSP )
+  {
+    ucontext_t * prev = (ucontext_t *)hostCurrentSP;
+    hostCurrentSP = next;
+    swapcontext( prev, (ucontext_t *)next );
+  }
+}
+
+/*********************************************************************************************************
+*                                            HANDLE TICK ISR
+*********************************************************************************************************/
+extern "C" void
+timerISR( void )
+{
+  hostSwitch( processInterrupt( 0, hostCurrentSP ) );
+}
+
+/*********************************************************************************************************
+*                                       SCHEDULER'S PROGRAM INTERRUPT SR
+*********************************************************************************************************/
+extern "C" void
+schedulerISR( void )
+{
+  hostSwitch( processInterrupt( SCHEDULER_INTERRUPT_NUMBER, hostCurrentSP ) );
+}
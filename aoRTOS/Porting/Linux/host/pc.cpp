@@ -0,0 +1,214 @@
+/*
+   Copyright (C) 2010-2012 by krasnop@bellsouth.net (Alexei Krasnopolski)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include "pc.hpp"
+
+#include "display.cpp"
+
+typedef void (*ISR)(void);
+
+/** Emulated Interrupt Descriptor Table */
+static ISR idt[256];
+
+sigset_t hostInterruptMask;
+
+/**
+ * Emulates CPU reset state: interrupts are disabled until the RTOS enables them
+ * in AOScheduler::startOS().
+ */
+static struct HostReset
+{
+  HostReset()
+  {
+    sigemptyset( &hostInterruptMask );
+    sigaddset( &hostInterruptMask, SIGALRM );
+    sigprocmask( SIG_BLOCK, &hostInterruptMask, 0 );
+  }
+} hostReset;
+
+/*
+*********************************************************************************************************
+*                                        EMULATED TIMER INTERRUPT
+* Description: SIGALRM handler that dispatches vector 0x20 (IRQ0 of 8259 PIC on Ix386).
+*              The kernel masks SIGALRM while the handler is running, as the CPU clears IF
+*              when it enters an interrupt gate.
+*********************************************************************************************************
+*/
+static void
+hostTimerSignal( int )
+{
+  if( idt[0x20] != 0 )
+    idt[0x20]();
+}
+
+static timer_t hostTimer;
+static struct timespec hostClockStart;
+
+/*
+*********************************************************************************************************
+*                                        PROGRAM SYSTEM CLOCK
+* Description: Arms one-shot POSIX timer to raise SIGALRM at the given tick (absolute time,
+*              so reprogramming does not accumulate a drift). Tick in the past fires immediately.
+*********************************************************************************************************
+*/
+void
+PC_ClockProgram( DWORD tick )
+{
+  struct itimerspec its;
+  unsigned long long ns = (unsigned long long)tick * HOST_TIMER_PERIOD_US * 1000 + hostClockStart.tv_nsec;
+
+  its.it_value.tv_sec = hostClockStart.tv_sec + ns / 1000000000ULL;
+  its.it_value.tv_nsec = ns % 1000000000ULL;
+  its.it_interval.tv_sec = 0;
+  its.it_interval.tv_nsec = 0;
+  timer_settime( hostTimer, TIMER_ABSTIME, &its, 0 );
+}
+
+DWORD
+PC_ClockTicks( void )
+{
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  unsigned long long ns = (unsigned long long)( ts.tv_sec - hostClockStart.tv_sec ) * 1000000000ULL
+                        + ts.tv_nsec - hostClockStart.tv_nsec;
+  return (DWORD)( ns / ( HOST_TIMER_PERIOD_US * 1000ULL ) );
+}
+
+/*
+*********************************************************************************************************
+*                                        START SYSTEM CLOCK
+* Description: Installs SIGALRM handler and programs the first clock interrupt in one tick.
+*              Then the Timer reprograms the clock for each next interrupt it needs.
+*********************************************************************************************************
+*/
+static void
+hostStartTimer( void )
+{
+  struct sigaction sa;
+  struct sigevent sev;
+
+  sa.sa_handler = hostTimerSignal;
+  sa.sa_flags = SA_RESTART;
+  sigemptyset( &sa.sa_mask );
+  sigaction( SIGALRM, &sa, 0 );
+
+  sev.sigev_notify = SIGEV_SIGNAL;
+  sev.sigev_signo = SIGALRM;
+  sev.sigev_value.sival_ptr = &hostTimer;
+  timer_create( CLOCK_MONOTONIC, &sev, &hostTimer );
+
+  clock_gettime( CLOCK_MONOTONIC, &hostClockStart );
+  PC_ClockProgram( 1 );
+}
+
+/*
+*********************************************************************************************************
+*                                        OBTAIN INTERRUPT VECTOR
+* Description: This function reads the pointer stored at the specified vector.
+* Arguments  : vect  is the desired interrupt vector number, a number between 0 and 255.
+* Returns    : The address of the Interrupt handler stored at the desired vector location.
+*********************************************************************************************************
+*/
+void * PC_VectGet( BYTE vect )
+{
+    return (void *)idt[vect];
+}
+
+/*
+*********************************************************************************************************
+*                                        INSTALL INTERRUPT VECTOR
+* Description: This function sets an interrupt vector in the emulated interrupt vector table.
+*              Installing of vector 0x20 starts the system clock.
+* Arguments  : vect  is the desired interrupt vector number, a number between 0 and 255.
+*              isr   is a pointer to a function to execute when the interrupt occurs.
+* Returns    : none
+*********************************************************************************************************
+*/
+WORD * PC_VectSet( BYTE vect, void (*isr)(void) )
+{
+    idt[vect] = isr;
+    if( vect == 0x20 )
+      hostStartTimer();
+    return (WORD *)&idt[vect];
+}
+
+void
+hostSoftwareInterrupt( BYTE vect )
+{
+  sigset_t flags;
+  sigprocmask( SIG_BLOCK, &hostInterruptMask, &flags );  // interrupt gate clears IF
+  if( idt[vect] != 0 )
+    idt[vect]();
+  sigprocmask( SIG_SETMASK, &flags, 0 );                 // iret restores IF
+}
+
+unsigned long long
+PC_TimeStamp( void )
+{
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void
+debugPrint( int pos, char s )
+{
+  if( Display::isTerminal() )          // there is no video RAM: debug line is shown only on terminal
+  {
+    char seq[24];
+    int n = snprintf( seq, sizeof( seq ), "\033[%d;%dH\033[0m%c", pos / 80 + 1, pos % 80 + 1, s );
+    hostWrite( seq, n );
+  }
+}
+
+void
+debugPrint( int pos, char* s )
+{
+  while( *s != 0 )
+  {
+    debugPrint( pos++, *s );
+    s++;
+  }
+}
+
+/*
+ * Heap of the hosted port is libc heap. Active Objects can be preempted inside of
+ * malloc()/free() so the calls are done with interrupts disabled.
+ */
+void* operator new( size_t sz ) {
+  sigset_t flags;
+  sigprocmask( SIG_BLOCK, &hostInterruptMask, &flags );
+  void* m = malloc( sz );
+  sigprocmask( SIG_SETMASK, &flags, 0 );
+  return m;
+}
+
+void operator delete( void* m ) {
+  sigset_t flags;
+  sigprocmask( SIG_BLOCK, &hostInterruptMask, &flags );
+  free( m );
+  sigprocmask( SIG_SETMASK, &flags, 0 );
+}
+
+void* operator new[]( size_t sz ) {
+  return operator new( sz );
+}
+
+void operator delete[]( void* m ) {
+  operator delete( m );
+}
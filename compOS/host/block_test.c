@@ -0,0 +1,283 @@
+/*
+ block_test.c - hosted test of the block request queue
+
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+#include <cosbase.h>
+
+#include <cos/debug.h>
+#include <cos/mem.h>
+#include <cos/block_dev.h>
+#include <cos/ramdisk.h>
+
+#include "host.h"
+
+#define TEST_SECTORS	4096			// 2MB
+#define BENCH_DISK	8192			// 4MB
+#define MAX_REQUESTS	32
+
+#define BENCH_SECTORS	8			// 4k requests
+#define BENCH_BATCHES	256
+
+static block_request_t rqs[MAX_REQUESTS];
+static u8_t* buffers[MAX_REQUESTS];
+
+// sectors given to record_request(), in order
+static u32_t order[MAX_REQUESTS];
+static count_t n_order;
+
+static int failures;
+
+static void check(cstring_t name, int passed)
+{
+	host_printf("%-60s %s\n", name, passed ? "PASS" : "FAIL");
+	if (!passed)
+		++failures;
+}
+
+static block_request_t* make_rq(count_t i, block_device_t* dev, u32_t op,
+				u32_t sector, u32_t count)
+{
+	block_request_t* rq = &rqs[i];
+
+	memzero(rq, sizeof(block_request_t));
+	rq->selector_type = BSELECT_BY_PTR;
+	rq->selector.ptr = dev;
+	rq->mode = BMODE_DEFAULT;
+	rq->op = op;
+	rq->sector = sector;
+	rq->count = count;
+	rq->buffer = buffers[i];
+	return rq;
+}
+
+static fresult_t record_request(block_request_t* rq, block_device_t* dev)
+{
+	order[n_order++] = rq->sector;
+	return ramdisk_request(rq, dev);
+}
+
+static fresult_t pending_request(block_request_t* rq, block_device_t* dev)
+{
+	order[n_order++] = rq->sector;
+	return BRESULT_PENDING;
+}
+
+static void test_immediate(void)
+{
+	block_device_t* dev = ramdisk_create(TEST_SECTORS, BMODE_IMMEDIATE);
+	block_request_t* rq;
+	int ok;
+
+	memset(buffers[0], 0x5A, 8 * RAMDISK_SECTOR_SIZE);
+	rq = make_rq(0, dev, BOP_WRITE, 100, 8);
+	ok = block_addrq(rq) == BRESULT_OK && rq->state == BSTATE_DONE;
+	rq = make_rq(1, dev, BOP_READ, 100, 8);
+	ok = ok && block_addrq(rq) == BRESULT_OK &&
+	     !memcmp(buffers[0], buffers[1], 8 * RAMDISK_SECTOR_SIZE);
+	check("Immediate requests are done at once", ok);
+
+	rq = make_rq(0, dev, BOP_READ, TEST_SECTORS - 4, 8);
+	check("Requests past the end fail",
+	      block_addrq(rq) == BRESULT_ERROR && block_wait(rq) ==
+	      BRESULT_ERROR);
+}
+
+static void test_merge(void)
+{
+	block_device_t* dev = ramdisk_create(TEST_SECTORS, BMODE_QUEUED);
+	block_request_t* rq;
+	count_t i;
+	int ok = 1;
+
+	block_plug(dev);
+	for (i = 0; i < 16; i++)
+	{
+		memset(buffers[i], i, RAMDISK_SECTOR_SIZE);
+		block_addrq(make_rq(i, dev, BOP_WRITE, 200 + i, 1));
+	}
+	ok = rqs[0].state == BSTATE_QUEUED;
+	block_unplug(dev);
+	for (i = 0; i < 16; i++)
+		ok &= block_wait(&rqs[i]) == BRESULT_OK;
+	check("Adjacent requests are merged",
+	      ok && dev->stats.dispatched == 1 && dev->stats.merged == 15);
+
+	// the other way round merges at the front
+	block_plug(dev);
+	for (i = 0; i < 16; i++)
+		block_addrq(make_rq(i, dev, BOP_READ, 215 - i, 1));
+	block_unplug(dev);
+	ok = dev->stats.dispatched == 2 && dev->stats.merged == 30;
+	for (i = 0; i < 16; i++)
+		ok &= block_wait(&rqs[i]) == BRESULT_OK &&
+		      buffers[i][RAMDISK_SECTOR_SIZE - 1] == 15 - i;
+	check("Requests are merged in front and keep their own buffers", ok);
+
+	// reads and writes are not merged
+	block_plug(dev);
+	block_addrq(make_rq(0, dev, BOP_READ, 300, 1));
+	block_addrq(make_rq(1, dev, BOP_WRITE, 301, 1));
+	block_unplug(dev);
+	check("Reads and writes are not merged", dev->stats.dispatched == 4);
+
+	rq = make_rq(0, dev, BOP_READ, 0, 1);
+	check("Unplugged requests are done at once",
+	      block_addrq(rq) == BRESULT_OK && rq->state == BSTATE_DONE);
+}
+
+static void test_order(void)
+{
+	block_device_t* dev = ramdisk_create(TEST_SECTORS, BMODE_QUEUED);
+	static u32_t sectors[5] = {50, 10, 90, 30, 70};
+	static u32_t expect[5] = {50, 70, 90, 10, 30};
+	block_request_t* a;
+	count_t i;
+	int ok;
+
+	dev->fn = record_request;
+
+	// leaves the position at 41
+	block_addrq(make_rq(0, dev, BOP_READ, 40, 1));
+
+	n_order = 0;
+	block_plug(dev);
+	for (i = 0; i < 5; i++)
+		block_addrq(make_rq(i, dev, BOP_READ, sectors[i], 1));
+	block_unplug(dev);
+
+	ok = n_order == 5;
+	for (i = 0; i < 5; i++)
+		ok &= order[i] == expect[i];
+	check("Requests are taken in elevator order", ok);
+
+	// a driver which completes later
+	dev->fn = pending_request;
+	n_order = 0;
+
+	block_addrq(make_rq(0, dev, BOP_READ, 1000, 1));
+	a = make_rq(1, dev, BOP_READ, 10, 1);
+	ok = block_addrq(a) == BRESULT_PENDING && a->state == BSTATE_QUEUED &&
+	     dev->active == &rqs[0];
+
+	// keep giving it requests ahead of the position, a is passed over
+	//  until its deadline
+	for (i = 0; i < MAX_REQUESTS - 2 && dev->active != a; i++)
+	{
+		block_addrq(make_rq(2 + (i & 1), dev, BOP_READ,
+				    2000 + i * 10, 1));
+		block_complete(dev, dev->active, BRESULT_OK);
+	}
+	check("An old request is taken when its deadline passes",
+	      ok && dev->active == a && a->state == BSTATE_ACTIVE &&
+	      i == BLOCK_DEADLINE + 1 && dev->stats.expired == 1);
+	block_complete(dev, a, BRESULT_OK);
+	while (dev->active)
+		block_complete(dev, dev->active, BRESULT_OK);
+
+	// an error is given to every merged request
+	block_plug(dev);
+	block_addrq(make_rq(0, dev, BOP_WRITE, 500, 2));
+	block_addrq(make_rq(1, dev, BOP_WRITE, 502, 2));
+	block_unplug(dev);
+	ok = rqs[0].state == BSTATE_ACTIVE && rqs[1].state == BSTATE_ACTIVE;
+	block_complete(dev, &rqs[0], BRESULT_ERROR);
+	check("Completing a request completes the merged ones",
+	      ok && block_wait(&rqs[0]) == BRESULT_ERROR &&
+	      block_wait(&rqs[1]) == BRESULT_ERROR && !dev->active);
+}
+
+/*
+  The benchmark writes 4k requests in batches of MAX_REQUESTS, queued
+  with the device plugged while a batch is added, or immediate.
+*/
+
+static block_function_t bench_fn;
+static u32_t bench_calls, bench_seek, bench_position;
+
+static fresult_t bench_request(block_request_t* rq, block_device_t* dev)
+{
+	bench_seek += (rq->sector > bench_position) ?
+		      rq->sector - bench_position :
+		      bench_position - rq->sector;
+	bench_position = rq->sector + rq->total;
+	++bench_calls;
+	return bench_fn(rq, dev);
+}
+
+static void bench(block_device_t* dev, cstring_t name, int random,
+		  u32_t mode)
+{
+	unsigned long long start, ns;
+	u32_t sector = 0;
+	count_t b, i;
+
+	dev->default_mode = mode;
+	bench_calls = bench_seek = bench_position = 0;
+
+	start = host_now();
+	for (b = 0; b < BENCH_BATCHES; b++)
+	{
+		block_plug(dev);
+		for (i = 0; i < MAX_REQUESTS; i++)
+		{
+			if (random)
+				sector = (host_random() %
+					  (BENCH_DISK / BENCH_SECTORS)) *
+					 BENCH_SECTORS;
+			block_addrq(make_rq(i, dev, BOP_WRITE, sector,
+					    BENCH_SECTORS));
+			sector = (sector + BENCH_SECTORS) % BENCH_DISK;
+		}
+		block_unplug(dev);
+		for (i = 0; i < MAX_REQUESTS; i++)
+			block_wait(&rqs[i]);
+	}
+	ns = host_now() - start;
+
+	host_printf("%-12s %-10s %8llu %10u %14u\n", name,
+		    mode == BMODE_QUEUED ? "queued" : "immediate",
+		    (unsigned long long)BENCH_BATCHES * MAX_REQUESTS *
+		    BENCH_SECTORS * RAMDISK_SECTOR_SIZE * 1000 / ns,
+		    bench_calls, bench_seek);
+}
+
+int block_test(void)
+{
+	block_device_t* dev;
+	count_t i;
+
+	failures = 0;
+
+	host_printf("\nBlock requests\n");
+	host_memory_init();
+	for (i = 0; i < MAX_REQUESTS; i++)
+		buffers[i] = host_calloc(BENCH_SECTORS * RAMDISK_SECTOR_SIZE);
+
+	test_immediate();
+	test_merge();
+	test_order();
+
+	host_printf("\n%d writes of %d bytes in batches of %d\n",
+		    BENCH_BATCHES * MAX_REQUESTS,
+		    BENCH_SECTORS * RAMDISK_SECTOR_SIZE, MAX_REQUESTS);
+	host_printf("%-12s %-10s %8s %10s %14s\n", "", "", "MB/s",
+		    "dispatches", "seek sectors");
+	dev = ramdisk_create(BENCH_DISK, BMODE_QUEUED);
+	bench_fn = dev->fn;
+	dev->fn = bench_request;
+	bench(dev, "sequential", 0, BMODE_IMMEDIATE);
+	bench(dev, "sequential", 0, BMODE_QUEUED);
+	bench(dev, "random", 1, BMODE_IMMEDIATE);
+	bench(dev, "random", 1, BMODE_QUEUED);
+
+	return failures;
+}
@@ -0,0 +1,160 @@
+/*
+ cluster.c - the old cluster based page allocator, for comparison
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+/*
+  This is phys_alloc() and phys_free() as they were before the buddy
+  allocator, without the tracing. The managers come from the host heap
+  instead of a free cluster and running out of memory returns NULL instead
+  of a panic, everything else is unchanged.
+*/
+
+#include <cosbase.h>
+
+#include <cos/debug.h>
+#include <cos/page.h>
+#include <cos/mem.h>
+
+#include "host.h"
+#include "cluster.h"
+
+static cluster_manager_t* first_man;
+
+// start again with no clusters
+void cluster_init(void)
+{
+	cluster_manager_t* next;
+	
+	while (first_man)
+	{
+		next = first_man->next;
+		host_free(first_man);
+		first_man = next;
+	}
+	
+	first_man = host_calloc(sizeof(cluster_manager_t));
+}
+
+page_cluster_t* cluster_add(iptr_t p_start, iptr_t p_end, u8_t p_type,
+			    page_cluster_t* p_next)
+{
+	cluster_manager_t* man = first_man;
+	u32_t i = 0;
+	page_cluster_t* c = &(man->clusters[i]);
+	
+	assert(!(p_start & ~PAGE_MASK));
+	assert(!(p_end & ~PAGE_MASK));
+
+	// loop to find a free cluster
+	while (c->start || c->end)
+	{
+		if (++i >= 127)
+		{
+			if (!man->next)
+				man->next = host_calloc(
+					sizeof(cluster_manager_t));
+			man = man->next;
+			i = 0;
+		}
+		c = &(man->clusters[i]);
+	}
+	
+	c->start = p_start;
+	c->end = p_end;
+	c->type = p_type;
+	c->next = p_next;
+	
+	return c;
+}
+
+ptr_t cluster_alloc(count_t n, u8_t use_type, u8_t from_type)
+{
+	cluster_manager_t* man = first_man;
+	u32_t i = 0;
+	page_cluster_t* c;
+	u32_t sz = n * PAGE_SIZE;
+	
+	if (n == 0)
+		return NULL;
+	
+	// find cluster of at least n pages, of type from_type
+	while (1)
+	{
+		if (i >= 127)
+		{
+			man = man->next;
+			if (!man)
+				return NULL;
+			i = 0;
+		}
+		
+		c = &(man->clusters[i]);
+		
+		if (c->type == from_type && (c->end - c->start) >= sz)
+		{
+			// add a cluster to describe remainder
+			if ((c->end - c->start) > sz)
+				cluster_add(c->start + sz, c->end, c->type,
+					    c->next);
+			
+			c->end = c->start + sz;
+			c->type = use_type;
+			c->next = 0;
+			
+			return (ptr_t)c->start;
+		}
+		++i;
+	}
+}
+
+void cluster_free(ptr_t p, u8_t to_type)
+{
+	cluster_manager_t* man = first_man;
+	u32_t i = 0;
+	page_cluster_t* c;
+	
+	// find cluster starting at p
+	while (1)
+	{
+		if (i >= 127)
+		{
+			man = man->next;
+			if (!man)
+				panic("Could not find pointer to free");
+			i = 0;
+		}
+		
+		c = &(man->clusters[i]);
+		
+		if (c->start == (iptr_t)p)
+		{
+			c->type = to_type;
+			return;
+		}
+		++i;
+	}
+}
+
+// number of clusters in use
+count_t cluster_count(void)
+{
+	cluster_manager_t* man;
+	count_t n = 0;
+	u32_t i;
+	
+	for (man = first_man; man; man = man->next)
+		for (i = 0; i < 127; i++)
+			if (man->clusters[i].start || man->clusters[i].end)
+				++n;
+	
+	return n;
+}
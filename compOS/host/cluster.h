@@ -0,0 +1,47 @@
+/*
+ cluster.h - the old cluster based page allocator, for comparison
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+#ifndef _COS_HOST_CLUSTER_H_
+#define _COS_HOST_CLUSTER_H_
+
+struct cluster_manager;
+typedef struct cluster_manager cluster_manager_t;
+
+struct page_cluster;
+typedef struct page_cluster page_cluster_t;
+
+struct page_cluster
+{
+	u32_t			start;
+	u32_t			end;		// *non-inclusive*
+	u8_t			type;
+	u8_t			reserved[3];
+	page_cluster_t*		next;
+	u32_t			reserved_2[4];
+};
+
+struct cluster_manager
+{
+	cluster_manager_t*	next;
+	u32_t			reserved[7];
+	page_cluster_t		clusters[127];
+};
+
+void cluster_init(void);
+page_cluster_t* cluster_add(iptr_t p_start, iptr_t p_end, u8_t p_type,
+			    page_cluster_t* p_next);
+ptr_t cluster_alloc(count_t n, u8_t use_type, u8_t from_type);
+void cluster_free(ptr_t p, u8_t to_type);
+count_t cluster_count(void);
+
+#endif // !_COS_HOST_CLUSTER_H_
@@ -0,0 +1,97 @@
+/*
+ host.c - hosted test support
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "host.h"
+
+void host_printf(const char* fmt, ...)
+{
+	va_list args;
+	
+	va_start(args, fmt);
+	vprintf(fmt, args);
+	va_end(args);
+}
+
+void* host_calloc(unsigned long sz)
+{
+	void* p = calloc(1, sz);
+	
+	if (!p)
+	{
+		printf("Out of host memory\n");
+		exit(2);
+	}
+	return p;
+}
+
+void host_free(void* p)
+{
+	free(p);
+}
+
+// xorshift, so every run does the same operations
+unsigned long host_random(void)
+{
+	static unsigned long long x = 88172645463325252ULL;
+	
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	return (unsigned long)(x >> 16);
+}
+
+unsigned long long host_now(void)
+{
+	struct timespec ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void host_exit(int code)
+{
+	fflush(stdout);
+	exit(code);
+}
+
+void host_map_memory(unsigned long addr, unsigned long len)
+{
+	void* p = mmap((void*)addr, len, PROT_READ | PROT_WRITE,
+		       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	
+	if (p != (void*)addr)
+	{
+		printf("Could not map memory at 0x%lx\n", addr);
+		exit(2);
+	}
+}
+
+int main(void)
+{
+	int failures = 0;
+	
+	failures += page_test();
+	failures += thread_test();
+	failures += slab_test();
+	failures += block_test();
+	failures += mem_test();
+	
+	printf("\n%d failure(s)\n", failures);
+	return failures ? 1 : 0;
+}
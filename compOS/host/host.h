@@ -0,0 +1,46 @@
+/*
+ host.h - hosted test support
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+/*
+  The hosted tests build parts of the kernel as a normal program. cosbase.h
+  clashes with the C library headers, so the files that include kernel
+  headers only talk to the C library through the functions below, which
+  are in host.c.
+*/
+
+#ifndef _COS_HOST_H_
+#define _COS_HOST_H_
+
+// real memory is mapped here, low enough to keep the page map small
+#define HOST_MEMORY		0x10000000UL
+#define HOST_MEMORY_SIZE	(16UL << 20)
+
+void host_printf(const char* fmt, ...);
+void* host_calloc(unsigned long sz);
+void host_free(void* p);
+unsigned long host_random(void);
+unsigned long long host_now(void);	// ns
+void host_exit(int code);
+void host_map_memory(unsigned long addr, unsigned long len);
+
+// in kernel.c
+void host_memory_init(void);
+
+// tests, called by main() in host.c
+int page_test(void);
+int thread_test(void);
+int slab_test(void);
+int block_test(void);
+int mem_test(void);
+
+#endif // !_COS_HOST_H_
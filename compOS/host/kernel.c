@@ -0,0 +1,109 @@
+/*
+ kernel.c - kernel functions and data needed by the hosted tests
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+#include <cosbase.h>
+
+#include <cos/sysinfo.h>
+#include <cos/debug.h>
+#include <cos/symbols.h>
+#include <cos/mem.h>
+#include <cos/page.h>
+#include <cos/int.h>
+#include <cos/thread.h>
+
+#include "host.h"
+
+static root_sysinfo_t host_sysinfo;
+root_sysinfo_t* sysinfo = &host_sysinfo;
+
+// only used by phys_init(), which the tests do not call
+linker_symbol kernel;
+linker_symbol end_kernel;
+
+u32_t g_kernel_state;
+
+// thread switches are not done on the host, the tests call do_sched()
+char FakeReturnAddr;
+
+static page_manager_t host_manager;
+static ptr_t host_map;
+
+void panic(cstring_t msg)
+{
+	host_printf("Kernel Panic: %s\n", msg);
+	host_exit(3);
+}
+
+void FailAssert(cstring_t cond, cstring_t file, int_t line)
+{
+	host_printf("Failed assertion (%s) at %s: %d\n", cond, file, line);
+	panic("Cannot recover!");
+}
+
+void Trace(cstring_t fmt, ...)
+{
+}
+
+// spawn_thread() builds a 32-bit interrupt frame at the top of its stack,
+//  with 64-bit words on the host it runs past the end
+ptr_t kalloc(size_t sz)
+{
+	return host_calloc(sz + 64);
+}
+
+void kfree(ptr_t p)
+{
+	host_free(p);
+}
+
+void install_handler(u8_t i, interrupt_handler_t hand)
+{
+}
+
+void init_timer()
+{
+}
+
+void Schedule(interrupt_state_t* state)
+{
+}
+
+unsigned long host_cli_count;
+
+u32_t Get_EFLAGS()
+{
+	return 0;
+}
+
+// cpuid works in user mode on any processor the tests run on
+u32_t Has_CPUID()
+{
+	return 1;
+}
+
+// set up a page manager for real memory, for the tests which use the
+//  pages they allocate
+void host_memory_init(void)
+{
+	count_t n_pages = (HOST_MEMORY + HOST_MEMORY_SIZE) / PAGE_SIZE;
+	
+	if (!host_map)
+	{
+		host_map_memory(HOST_MEMORY, HOST_MEMORY_SIZE);
+		host_map = host_calloc(phys_map_size(n_pages));
+	}
+	
+	sysinfo->page_manager = &host_manager;
+	phys_setup(host_map, n_pages);
+	phys_mark_by_ptr(HOST_MEMORY, HOST_MEMORY_SIZE, PG_CLUSTER_FREE);
+}
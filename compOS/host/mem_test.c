@@ -0,0 +1,236 @@
+/*
+ mem_test.c - hosted test of the mem* functions
+
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+#include <cosbase.h>
+
+#include <multiboot.h>
+#include <cos/debug.h>
+#include <cos/mem.h>
+#include <cos/init.h>
+#include <x86-asm.h>
+
+#include "host.h"
+
+#define BUF_SIZE	(64 * 1024 + 64)
+#define BENCH_BYTES	(64 * 1024 * 1024)
+
+// not in mem.h, set by mem_init()
+extern bool_t mem_sse;
+
+static u8_t* a;
+static u8_t* b;
+static u8_t* ref;
+
+// keeps the results of memcmp() in the benchmark
+static volatile int_t sink;
+
+static int failures;
+
+static void check(cstring_t name, int passed)
+{
+	host_printf("%-60s %s\n", name, passed ? "PASS" : "FAIL");
+	if (!passed)
+		++failures;
+}
+
+// the byte at a time versions these replaced, for checking and comparing
+static ptr_t old_memcpy(ptr_t dest, cptr_t src, count_t count)
+{
+	u8_t* pSrc = (u8_t*)src;
+	u8_t* pDest = (u8_t*)dest;
+
+	while (count--)
+		*pDest++ = *pSrc++;
+	return dest;
+}
+
+static ptr_t old_memset(ptr_t dest, u8_t c, count_t count)
+{
+	u8_t* p = (u8_t*)dest;
+
+	while (count--)
+		*p++ = c;
+	return dest;
+}
+
+static int_t old_memcmp(cptr_t p1, cptr_t p2, count_t count)
+{
+	u8_t* pa1 = (u8_t*)p1;
+	u8_t* pa2 = (u8_t*)p2;
+
+	while (count--)
+	{
+		if (!(*pa1 == *pa2))
+			return ((int_t)*pa2) - ((int_t)*pa1);
+		pa1++;
+		pa2++;
+	}
+	return 0;
+}
+
+static void fill(u8_t* p, count_t n)
+{
+	while (n--)
+		*p++ = host_random();
+}
+
+static int same(u8_t* p1, u8_t* p2, count_t n)
+{
+	while (n--)
+		if (*p1++ != *p2++)
+			return 0;
+	return 1;
+}
+
+// sizes around each path and its edges
+static count_t sizes[] = {0, 1, 3, 4, 15, 16, 17, 63, 64, 100, 511, 512,
+			  513, 575, 1000, 4096, 4099, 4672, 65536};
+#define N_SIZES		(sizeof(sizes) / sizeof(sizes[0]))
+
+static void test_mem(void)
+{
+	count_t i, n, da, sa;
+	u8_t* page;
+	int ok_cpy = 1, ok_set = 1, ok_cmp = 1;
+
+	for (i = 0; i < N_SIZES; i++)
+	{
+		n = sizes[i];
+		for (da = 0; da < 16; da += 3)
+			for (sa = 0; sa < 16; sa += 5)
+			{
+				fill(a, BUF_SIZE);
+				fill(b, BUF_SIZE);
+				old_memcpy(ref, b, BUF_SIZE);
+				old_memcpy(ref + da, a + sa, n);
+				ok_cpy &= memcpy(b + da, a + sa, n) == b + da &&
+					  same(b, ref, BUF_SIZE);
+
+				old_memset(ref + da, sa * 17, n);
+				ok_set &= memset(b + da, sa * 17, n) == b + da &&
+					  same(b, ref, BUF_SIZE);
+
+				// differ at each end and in the middle
+				old_memcpy(b + da, a + sa, n);
+				ok_cmp &= memcmp(a + sa, b + da, n) == 0;
+				if (n)
+				{
+					b[da + n / 2] ^= 0x80;
+					ok_cmp &= memcmp(a + sa, b + da, n) ==
+						  old_memcmp(a + sa, b + da, n);
+					b[da + n / 2] ^= 0x80;
+					b[da + n - 1]++;
+					ok_cmp &= memcmp(a + sa, b + da, n) ==
+						  old_memcmp(a + sa, b + da, n);
+					ok_cmp &= memcmp(a + sa, b + da, n - 1) == 0;
+				}
+			}
+	}
+	check("memcpy() at all sizes and alignments", ok_cpy);
+	check("memset() at all sizes and alignments", ok_set);
+	check("memcmp() at all sizes and alignments", ok_cmp);
+
+	// dest below src, as when scrolling
+	fill(a, BUF_SIZE);
+	old_memcpy(ref, a, BUF_SIZE);
+	memcpy(a, a + 160, 4000);
+	check("memcpy() copies forwards over itself",
+	      same(a, ref + 160, 4000) &&
+	      same(a + 4000, ref + 4000, BUF_SIZE - 4000));
+	fill(a, BUF_SIZE);
+	old_memcpy(ref, a, BUF_SIZE);
+	memcpy(a, a + 16, 4000);
+	check("memcpy() copies forwards over itself, less than a block",
+	      same(a, ref + 16, 4000));
+
+	page = (u8_t*)(((iptr_t)a + PAGE_SIZE - 1) & ~(iptr_t)(PAGE_SIZE - 1));
+	fill(a, BUF_SIZE);
+	old_memcpy(ref, a, BUF_SIZE);
+	old_memset(ref + (page - a), 0, PAGE_SIZE);
+	check("memzero_page() zeroes one page",
+	      memzero_page(page) == page && same(a, ref, BUF_SIZE));
+
+	// long SSE2 copies give interrupts a chance every 4 KiB
+	if (mem_sse)
+	{
+		unsigned long before = host_cli_count;
+		
+		memcpy(b + (-(iptr_t)b & 15), a + (-(iptr_t)a & 15), 64 * 1024);
+		check("memcpy() disables interrupts for 4 KiB at a time",
+		      host_cli_count - before == 16);
+	}
+}
+
+// MB/s for BENCH_BYTES in blocks of size n
+static unsigned long long bench(int fn, count_t n)
+{
+	unsigned long long start, ns;
+	count_t i, loops = BENCH_BYTES / n;
+
+	start = host_now();
+	for (i = 0; i < loops; i++)
+		switch (fn)
+		{
+		case 0: old_memcpy(b, a, n); break;
+		case 1: memcpy(b, a, n); break;
+		case 2: old_memset(b, i, n); break;
+		case 3: memset(b, i, n); break;
+		case 4: sink += old_memcmp(a, b, n); break;
+		case 5: sink += memcmp(a, b, n); break;
+		case 6: mem_sse = 1; memcpy(b, a, n); mem_sse = 0; break;
+		}
+	ns = host_now() - start;
+
+	return (unsigned long long)BENCH_BYTES * 1000 / ns;
+}
+
+int mem_test(void)
+{
+	bool_t sse;
+	count_t n;
+
+	failures = 0;
+
+	host_printf("\nMemory functions\n");
+	mem_init();
+	sse = mem_sse;
+	a = host_calloc(BUF_SIZE + PAGE_SIZE);
+	b = host_calloc(BUF_SIZE);
+	ref = host_calloc(BUF_SIZE);
+
+	// both ways, whichever mem_init() chose
+	host_printf("mem_init() %s SSE2\n", sse ? "chose" : "did not choose");
+	host_printf("Without SSE2\n");
+	mem_sse = 0;
+	test_mem();
+	host_printf("With SSE2\n");
+	mem_sse = 1;
+	test_mem();
+	mem_sse = 0;
+
+	host_printf("\nMB/s, 16 byte aligned, bytes at a time before\n");
+	host_printf("%8s %8s %8s %8s %8s %8s %8s %8s\n", "size", "memcpy",
+		    "", "", "memset", "", "memcmp", "");
+	host_printf("%8s %8s %8s %8s %8s %8s %8s %8s\n", "", "before",
+		    "rep", "SSE2", "before", "after", "before", "after");
+	old_memset(b, 0, BUF_SIZE);
+	old_memset(a, 0, BUF_SIZE);
+	for (n = 16; n <= 64 * 1024; n *= 4)
+		host_printf("%8d %8llu %8llu %8llu %8llu %8llu %8llu %8llu\n",
+			    n, bench(0, n), bench(1, n), bench(6, n),
+			    bench(2, n), bench(3, n), bench(4, n),
+			    bench(5, n));
+	mem_sse = sse;
+
+	return failures;
+}
@@ -0,0 +1,58 @@
+/*
+ node_queue.c - the old thread queues, for comparison
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+/*
+  This is queue_thread() and thread_queue_head() as they were before the
+  threads were linked into their queues, without the tracing. The queue is
+  passed in instead of taken from the thread and an empty queue gives NULL.
+  The nodes come from kalloc(), which is the host heap here.
+*/
+
+#include <cosbase.h>
+
+#include <cos/thread.h>
+#include <cos/mem.h>
+
+#include "node_queue.h"
+
+kthread_t* node_queue_head(node_queue_t* q)
+{
+	thread_node_t* p = q->head;
+	if (!p)
+		return NULL;
+	
+	q->head = p->next;	// detach the node
+	kthread_t* thr = p->thread;
+	kfree(p);
+	return thr;
+}
+
+void node_queue_thread(node_queue_t* q, kthread_t* thr)
+{
+	if (!(q->head))
+	{
+		q->head = kalloc(sizeof(thread_node_t));
+		q->head->thread = thr;
+		q->head->next = NULL;
+		return;
+	}
+	
+	thread_node_t* p = q->head;
+	while (p->next)
+		p = p->next;	// find end of queue
+
+	// last node will have a thread
+	p->next = kalloc(sizeof(thread_node_t));
+	p->next->thread = thr;
+	p->next->next = NULL;
+}
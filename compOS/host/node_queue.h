@@ -0,0 +1,37 @@
+/*
+ node_queue.h - the old thread queues, for comparison
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+#ifndef _COS_HOST_NODE_QUEUE_H_
+#define _COS_HOST_NODE_QUEUE_H_
+
+struct thread_node;
+typedef struct thread_node thread_node_t;
+
+struct node_queue;
+typedef struct node_queue node_queue_t;
+
+struct node_queue
+{
+	thread_node_t* head;
+};
+
+struct thread_node
+{
+	kthread_t* thread;
+	thread_node_t* next;
+};
+
+void node_queue_thread(node_queue_t* q, kthread_t* thr);
+kthread_t* node_queue_head(node_queue_t* q);
+
+#endif // !_COS_HOST_NODE_QUEUE_H_
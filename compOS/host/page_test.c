@@ -0,0 +1,495 @@
+/*
+ page_test.c - hosted test of the physical page allocator
+
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+/*
+  The pages are never touched, so the test manages a made up 64MB machine
+  laid out like phys_init() does it. Only the page map comes from the host.
+*/
+
+#include <cosbase.h>
+
+#include <cos/sysinfo.h>
+#include <cos/debug.h>
+#include <cos/page.h>
+#include <cos/mem.h>
+
+#include "host.h"
+#include "cluster.h"
+
+#define TEST_PAGES	16384			// 64MB
+#define LOWER_END	160			// 640k
+#define KERNEL_START	256			// 1M
+#define KERNEL_END	512
+#define MAP_END		(KERNEL_END + 64)
+
+#define PFN(p)			(((iptr_t)(p)) / PAGE_SIZE)
+#define BIT_TEST(map, i)	((map)[(i) >> 5] & (1UL << ((i) & 31)))
+
+#define STRESS_OPS	200000
+#define BENCH_OPS	20000
+#define MAX_LIVE	1024
+
+typedef struct test_alloc
+{
+	u32_t	pfn;
+	u32_t	n;
+	u8_t	use_type;
+	u8_t	from_type;
+}
+test_alloc_t;
+
+static page_manager_t test_manager;
+static ptr_t test_map;
+
+static test_alloc_t live[MAX_LIVE];
+static count_t n_live;
+
+// page owner, 0 if the page is not allocated by the test
+static u16_t owner[TEST_PAGES];
+static u8_t seen[TEST_PAGES];
+
+static int failures;
+
+static void check(cstring_t name, int passed)
+{
+	host_printf("%-60s %s\n", name, passed ? "PASS" : "FAIL");
+	if (!passed)
+		++failures;
+}
+
+static void setup(void)
+{
+	sysinfo->page_manager = &test_manager;
+	if (!test_map)
+		test_map = host_calloc(phys_map_size(TEST_PAGES));
+
+	phys_setup(test_map, TEST_PAGES);
+
+	phys_mark_by_ptr(0, PAGE_SIZE, PG_CLUSTER_BIOS);
+	phys_mark_by_ptr(LOWER_END * PAGE_SIZE,
+			 (KERNEL_START - LOWER_END) * PAGE_SIZE,
+			 PG_CLUSTER_ISA_HOLE);
+	phys_mark_by_ptr(KERNEL_START * PAGE_SIZE,
+			 (KERNEL_END - KERNEL_START) * PAGE_SIZE,
+			 PG_CLUSTER_KERNEL);
+	phys_mark_by_ptr(KERNEL_END * PAGE_SIZE,
+			 (MAP_END - KERNEL_END) * PAGE_SIZE,
+			 PG_CLUSTER_MANAGER);
+	phys_mark_by_ptr(PAGE_SIZE, (LOWER_END - 1) * PAGE_SIZE,
+			 PG_CLUSTER_FREE_LOWER);
+	phys_mark_by_ptr(MAP_END * PAGE_SIZE,
+			 (TEST_PAGES - MAP_END) * PAGE_SIZE, PG_CLUSTER_FREE);
+
+	n_live = 0;
+	memzero(owner, sizeof(owner));
+}
+
+static page_zone_t* zone(u8_t type)
+{
+	return &(test_manager.zones[type == PG_CLUSTER_FREE ? 0 : 1]);
+}
+
+// check the free lists and the bitmaps against the page map, returns 0 if
+//  anything is wrong
+static int check_zones(void)
+{
+	page_manager_t* man = &test_manager;
+	page_zone_t* z;
+	u32_t pfn, order, i, buddy;
+	count_t bits, blocks = 0, pages;
+
+	memzero(seen, sizeof(seen));
+
+	for (z = man->zones; z < man->zones + PG_ZONES; z++)
+	{
+		pages = 0;
+		for (order = 0; order <= PG_MAX_ORDER; order++)
+		{
+			u32_t prev = PG_NO_FRAME;
+
+			for (pfn = z->free[order]; pfn != PG_NO_FRAME;
+			     pfn = man->frames[pfn].next)
+			{
+				if (pfn & ((1 << order) - 1) ||
+				    pfn + (1 << order) > man->n_frames ||
+				    man->frames[pfn].prev != prev ||
+				    !BIT_TEST(man->bitmap[order], pfn >> order))
+					return 0;
+
+				// fully merged
+				buddy = pfn ^ (1 << order);
+				if (order < PG_MAX_ORDER &&
+				    buddy + (1 << order) <= man->n_frames &&
+				    BIT_TEST(man->bitmap[order],
+					     buddy >> order) &&
+				    man->frames[buddy].type == z->type)
+					return 0;
+
+				for (i = pfn; i < pfn + (1 << order); i++)
+				{
+					if (seen[i] || owner[i] ||
+					    man->frames[i].type != z->type)
+						return 0;
+					seen[i] = 1;
+				}
+
+				pages += 1 << order;
+				++blocks;
+				prev = pfn;
+			}
+		}
+		if (pages != z->free_pages)
+			return 0;
+	}
+
+	// every page of a free type is on a free list
+	for (i = 0; i < man->n_frames; i++)
+		if (!seen[i] && (man->frames[i].type == PG_CLUSTER_FREE ||
+		    man->frames[i].type == PG_CLUSTER_FREE_LOWER))
+			return 0;
+
+	// no bits set for blocks which are not on a free list
+	bits = 0;
+	for (order = 0; order <= PG_MAX_ORDER; order++)
+		for (i = 0; i < (man->n_frames >> order); i++)
+			if (BIT_TEST(man->bitmap[order], i))
+				++bits;
+
+	return bits == blocks;
+}
+
+static int can_alloc(u8_t from_type, count_t n)
+{
+	page_zone_t* z = zone(from_type);
+	u32_t order = 0;
+
+	while ((1 << order) < n)
+		++order;
+	for (; order <= PG_MAX_ORDER; order++)
+		if (z->free[order] != PG_NO_FRAME)
+			return 1;
+	return 0;
+}
+
+// mostly small allocations, some large ones
+static count_t random_size(void)
+{
+	u32_t r = host_random() % 100;
+
+	if (r < 70)
+		return 1 + host_random() % 4;
+	if (r < 95)
+		return 5 + host_random() % 60;
+	return 65 + host_random() % 960;
+}
+
+static u8_t random_use(void)
+{
+	static u8_t types[3] = {PG_CLUSTER_IN_USE, PG_CLUSTER_HEAP,
+				PG_CLUSTER_DMA};
+
+	return types[host_random() % 3];
+}
+
+// random allocations and frees, checked against the owner map
+static int stress(void)
+{
+	page_manager_t* man = &test_manager;
+	test_alloc_t* a;
+	count_t op, i, n;
+	u8_t from;
+	u32_t pfn;
+
+	for (op = 0; op < STRESS_OPS; op++)
+	{
+		if (n_live < MAX_LIVE && (n_live == 0 ||
+		    host_random() % MAX_LIVE >= n_live))
+		{
+			from = host_random() % 10 ? PG_CLUSTER_FREE :
+						    PG_CLUSTER_FREE_LOWER;
+			n = from == PG_CLUSTER_FREE ? random_size() :
+						      1 + host_random() % 8;
+			if (!can_alloc(from, n))
+				continue;
+
+			a = &live[n_live];
+			a->n = n;
+			a->use_type = random_use();
+			a->from_type = from;
+			a->pfn = PFN(phys_alloc(n, a->use_type, from));
+			++n_live;
+
+			pfn = a->pfn;
+			if (pfn + n > man->n_frames ||
+			    man->frames[pfn].next != n)
+				return 0;
+			if (from == PG_CLUSTER_FREE_LOWER && pfn + n > LOWER_END)
+				return 0;
+			for (i = pfn; i < pfn + n; i++)
+			{
+				if (owner[i] ||
+				    man->frames[i].type != a->use_type)
+					return 0;
+				owner[i] = n_live;
+			}
+		}
+		else
+		{
+			a = &live[host_random() % n_live];
+			for (i = a->pfn; i < a->pfn + a->n; i++)
+				owner[i] = 0;
+			phys_free((ptr_t)(a->pfn * PAGE_SIZE), a->from_type);
+
+			// keep the owner numbers in line with the array
+			if (a != &live[--n_live])
+			{
+				*a = live[n_live];
+				for (i = a->pfn; i < a->pfn + a->n; i++)
+					owner[i] = (a - live) + 1;
+			}
+		}
+
+		if (op % 1000 == 0 && !check_zones())
+			return 0;
+	}
+
+	return check_zones();
+}
+
+static void free_all(void)
+{
+	while (n_live)
+	{
+		--n_live;
+		phys_free((ptr_t)(live[n_live].pfn * PAGE_SIZE),
+			  live[n_live].from_type);
+	}
+	memzero(owner, sizeof(owner));
+}
+
+static void test_buddy(void)
+{
+	u32_t before[PG_ZONES][PG_ORDERS];
+	u32_t z, order;
+	int same;
+	ptr_t p, q;
+
+	setup();
+	check("Layout: free pages", zone(PG_CLUSTER_FREE)->free_pages ==
+	      TEST_PAGES - MAP_END &&
+	      zone(PG_CLUSTER_FREE_LOWER)->free_pages == LOWER_END - 1);
+	check("Layout: free lists", check_zones());
+	check("Layout: reserved pages keep their type",
+	      test_manager.frames[0].type == PG_CLUSTER_BIOS &&
+	      test_manager.frames[KERNEL_START].type == PG_CLUSTER_KERNEL &&
+	      test_manager.frames[MAP_END - 1].type == PG_CLUSTER_MANAGER);
+
+	for (z = 0; z < PG_ZONES; z++)
+		for (order = 0; order <= PG_MAX_ORDER; order++)
+			before[z][order] = test_manager.zones[z].free[order];
+
+	p = phys_alloc(3, PG_CLUSTER_HEAP, PG_CLUSTER_FREE);
+	q = phys_alloc(1, PG_CLUSTER_HEAP, PG_CLUSTER_FREE);
+	check("Unused pages of a block are given back",
+	      (iptr_t)q == (iptr_t)p + 3 * PAGE_SIZE &&
+	      zone(PG_CLUSTER_FREE)->free_pages == TEST_PAGES - MAP_END - 4 &&
+	      check_zones());
+	phys_free(p, PG_CLUSTER_FREE);
+	phys_free(q, PG_CLUSTER_FREE);
+
+	p = phys_alloc(2, PG_CLUSTER_DMA, PG_CLUSTER_FREE_LOWER);
+	check("Lower memory has its own zone",
+	      PFN(p) < LOWER_END && zone(PG_CLUSTER_FREE_LOWER)->free_pages ==
+	      LOWER_END - 3);
+	phys_free(p, PG_CLUSTER_FREE_LOWER);
+
+	p = phys_alloc(4, PG_CLUSTER_IN_USE, PG_CLUSTER_FREE);
+	phys_free(p, PG_CLUSTER_RESERVED);
+	check("Freeing to a type without a zone only changes the type",
+	      test_manager.frames[PFN(p)].type == PG_CLUSTER_RESERVED &&
+	      zone(PG_CLUSTER_FREE)->free_pages == TEST_PAGES - MAP_END - 4 &&
+	      check_zones());
+	phys_mark_by_ptr((iptr_t)p, 4 * PAGE_SIZE, PG_CLUSTER_FREE);
+
+	check("Random allocations keep the free lists consistent", stress());
+
+	free_all();
+	same = 1;
+	for (z = 0; z < PG_ZONES; z++)
+		for (order = 0; order <= PG_MAX_ORDER; order++)
+			if (before[z][order] == PG_NO_FRAME)
+				same &= test_manager.zones[z].free[order] ==
+					PG_NO_FRAME;
+			else
+				same &= test_manager.zones[z].free[order] !=
+					PG_NO_FRAME;
+	check("All blocks merge again after freeing everything",
+	      same && check_zones() &&
+	      zone(PG_CLUSTER_FREE)->free_pages == TEST_PAGES - MAP_END &&
+	      zone(PG_CLUSTER_FREE_LOWER)->free_pages == LOWER_END - 1);
+}
+
+/*
+  The benchmark runs the same sequence of allocations and frees on the
+  buddy allocator and the old cluster allocator.
+*/
+
+typedef struct bench_op
+{
+	u16_t	slot;		// alloc if n, else free
+	u16_t	n;
+}
+bench_op_t;
+
+static bench_op_t ops[BENCH_OPS];
+static ptr_t slots[MAX_LIVE];
+
+static void bench_ops(void)
+{
+	count_t i, live_slots = 0;
+	u8_t used[MAX_LIVE];
+	u32_t s;
+
+	memzero(used, sizeof(used));
+	for (i = 0; i < BENCH_OPS; i++)
+	{
+		if (live_slots < MAX_LIVE / 4 && (live_slots == 0 ||
+		    host_random() % (MAX_LIVE / 4) >= live_slots))
+		{
+			for (s = host_random() % MAX_LIVE; used[s];
+			     s = (s + 1) % MAX_LIVE)
+				;
+			used[s] = 1;
+			++live_slots;
+			ops[i].slot = s;
+			ops[i].n = random_size();
+		}
+		else
+		{
+			for (s = host_random() % MAX_LIVE; !used[s];
+			     s = (s + 1) % MAX_LIVE)
+				;
+			used[s] = 0;
+			--live_slots;
+			ops[i].slot = s;
+			ops[i].n = 0;
+		}
+	}
+}
+
+static void bench_cluster_init(void)
+{
+	cluster_init();
+	cluster_add(0, PAGE_SIZE, PG_CLUSTER_BIOS, 0);
+	cluster_add(PAGE_SIZE, LOWER_END * PAGE_SIZE, PG_CLUSTER_FREE_LOWER,
+		    0);
+	cluster_add(LOWER_END * PAGE_SIZE, KERNEL_START * PAGE_SIZE,
+		    PG_CLUSTER_ISA_HOLE, 0);
+	cluster_add(KERNEL_START * PAGE_SIZE, KERNEL_END * PAGE_SIZE,
+		    PG_CLUSTER_KERNEL, 0);
+	cluster_add(KERNEL_END * PAGE_SIZE, MAP_END * PAGE_SIZE,
+		    PG_CLUSTER_MANAGER, 0);
+	cluster_add(MAP_END * PAGE_SIZE, TEST_PAGES * PAGE_SIZE,
+		    PG_CLUSTER_FREE, 0);
+}
+
+// run the benchmark ops, returns the number of failed allocations
+static count_t bench_run(int buddy, unsigned long long* ns)
+{
+	unsigned long long start;
+	count_t i, failed = 0;
+	bench_op_t* op;
+
+	memzero(slots, sizeof(slots));
+
+	start = host_now();
+	for (i = 0, op = ops; i < BENCH_OPS; i++, op++)
+	{
+		if (op->n)
+		{
+			if (!buddy)
+				slots[op->slot] = cluster_alloc(op->n,
+					PG_CLUSTER_HEAP, PG_CLUSTER_FREE);
+			else if (can_alloc(PG_CLUSTER_FREE, op->n))
+				slots[op->slot] = phys_alloc(op->n,
+					PG_CLUSTER_HEAP, PG_CLUSTER_FREE);
+			if (!slots[op->slot])
+				++failed;
+		}
+		else if (slots[op->slot])
+		{
+			if (buddy)
+				phys_free(slots[op->slot], PG_CLUSTER_FREE);
+			else
+				cluster_free(slots[op->slot], PG_CLUSTER_FREE);
+			slots[op->slot] = NULL;
+		}
+	}
+	*ns = host_now() - start;
+
+	// free the rest
+	for (i = 0; i < MAX_LIVE; i++)
+	{
+		if (!slots[i])
+			continue;
+		if (buddy)
+			phys_free(slots[i], PG_CLUSTER_FREE);
+		else
+			cluster_free(slots[i], PG_CLUSTER_FREE);
+	}
+
+	return failed;
+}
+
+static void bench(void)
+{
+	unsigned long long ns;
+	count_t failed;
+	ptr_t p;
+
+	host_printf("\n%d random allocations and frees, up to %d live, "
+		    "in %d pages\n", BENCH_OPS, MAX_LIVE / 4,
+		    TEST_PAGES - MAP_END);
+	host_printf("%-20s %10s %10s %12s\n", "", "ns per op", "failed",
+		    "8192 pages");
+
+	bench_ops();
+
+	setup();
+	failed = bench_run(1, &ns);
+	p = can_alloc(PG_CLUSTER_FREE, 8192) ?
+		phys_alloc(8192, PG_CLUSTER_HEAP, PG_CLUSTER_FREE) : NULL;
+	host_printf("%-20s %10llu %10d %12s\n", "buddy", ns / BENCH_OPS,
+		    failed, p ? "yes" : "no");
+	check("Buddy allocator: large block after freeing everything",
+	      p != NULL && check_zones());
+
+	bench_cluster_init();
+	failed = bench_run(0, &ns);
+	p = cluster_alloc(8192, PG_CLUSTER_HEAP, PG_CLUSTER_FREE);
+	host_printf("%-20s %10llu %10d %12s  (%d clusters)\n", "cluster",
+		    ns / BENCH_OPS, failed, p ? "yes" : "no",
+		    cluster_count());
+	cluster_init();
+}
+
+int page_test(void)
+{
+	failures = 0;
+
+	host_printf("Physical page allocator\n");
+	test_buddy();
+	bench();
+
+	return failures;
+}
@@ -0,0 +1,214 @@
+/*
+ slab_test.c - hosted test of the object caches
+
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+#include <cosbase.h>
+
+#include <cos/sysinfo.h>
+#include <cos/debug.h>
+#include <cos/page.h>
+#include <cos/mem.h>
+#include <cos/heap.h>
+#include <cos/slab.h>
+
+#include "host.h"
+
+#define TEST_OBJECTS	1000
+#define BENCH_OPS	200000
+#define BENCH_LIVE	1000
+#define BENCH_SIZE	64
+
+#define MAGIC		0xC0FFEE
+
+typedef struct test_obj
+{
+	u32_t	magic;		// set by the constructor
+	u32_t	id;
+	u8_t	data[16];
+}
+test_obj_t;
+
+static ptr_t objs[TEST_OBJECTS];
+static count_t ctor_calls, dtor_calls, bad_dtor;
+
+static int failures;
+
+static void check(cstring_t name, int passed)
+{
+	host_printf("%-60s %s\n", name, passed ? "PASS" : "FAIL");
+	if (!passed)
+		++failures;
+}
+
+static u32_t free_pages(void)
+{
+	return sysinfo->page_manager->zones[0].free_pages;
+}
+
+static void test_ctor(ptr_t p)
+{
+	((test_obj_t*)p)->magic = MAGIC;
+	++ctor_calls;
+}
+
+static void test_dtor(ptr_t p)
+{
+	if (((test_obj_t*)p)->magic != MAGIC)
+		++bad_dtor;
+	++dtor_calls;
+}
+
+static void test_caches(void)
+{
+	kcache_t* c;
+	test_obj_t* o;
+	u32_t before;
+	count_t i, slabs;
+	iptr_t lowest[2];
+	int ok;
+
+	c = kcache_create("test", sizeof(test_obj_t), test_ctor, test_dtor);
+	before = free_pages();
+
+	ok = 1;
+	for (i = 0; i < TEST_OBJECTS; i++)
+	{
+		o = objs[i] = kcache_alloc(c);
+		ok &= o->magic == MAGIC &&
+		      phys_get_type(o) == PG_CLUSTER_SLAB &&
+		      !((iptr_t)o & (KCACHE_ALIGN - 1));
+		o->id = i;
+		memset(o->data, (u8_t)i, sizeof(o->data));
+	}
+	for (i = 0; i < TEST_OBJECTS; i++)
+	{
+		o = objs[i];
+		ok &= o->id == i && o->data[15] == (u8_t)i;
+	}
+	slabs = (TEST_OBJECTS + c->per_slab - 1) / c->per_slab;
+	check("Objects are constructed, aligned and do not overlap", ok);
+	check("Statistics count objects and slabs",
+	      c->stats.active == TEST_OBJECTS && c->stats.slabs == slabs &&
+	      c->stats.allocs == TEST_OBJECTS &&
+	      before - free_pages() == slabs * c->pages);
+
+	// freed objects keep their constructed state
+	for (i = 0; i < TEST_OBJECTS; i += 2)
+		kcache_free(c, objs[i]);
+	ok = 1;
+	for (i = 0; i < TEST_OBJECTS; i += 2)
+	{
+		o = objs[i] = kcache_alloc(c);
+		ok &= o->magic == MAGIC;
+	}
+	check("Reused objects keep their constructed state",
+	      ok && ctor_calls == slabs * c->per_slab &&
+	      c->stats.slabs == slabs);
+
+	for (i = 0; i < TEST_OBJECTS; i++)
+		kcache_free(c, objs[i]);
+	check("One empty slab is kept",
+	      c->stats.active == 0 && c->stats.slabs == 1 &&
+	      dtor_calls == (slabs - 1) * c->per_slab && !bad_dtor);
+
+	kcache_shrink(c);
+	check("All pages are given back after shrinking",
+	      c->stats.slabs == 0 && dtor_calls == ctor_calls &&
+	      free_pages() == before);
+	kcache_destroy(c);
+
+	// 20 per slab with 56 bytes to spare, so two colours
+	c = kcache_create("colour", 200, NULL, NULL);
+	lowest[0] = lowest[1] = PAGE_SIZE;
+	for (i = 0; i < c->per_slab * 2; i++)
+	{
+		objs[i] = kcache_alloc(c);
+		iptr_t off = (iptr_t)objs[i] & (PAGE_SIZE - 1);
+		if (off < lowest[i / c->per_slab])
+			lowest[i / c->per_slab] = off;
+	}
+	check("Consecutive slabs start at different offsets",
+	      c->colours == 2 && lowest[1] == lowest[0] + KCACHE_COLOUR);
+	for (i = 0; i < c->per_slab * 2; i++)
+		kcache_free(c, objs[i]);
+	kcache_destroy(c);
+
+	c = kcache_create("large", 1000, NULL, NULL);
+	before = free_pages();
+	for (i = 0; i < 50; i++)
+		objs[i] = kcache_alloc(c);
+	ok = c->pages == 2 && c->per_slab == 8 && c->stats.slabs == 7;
+	for (i = 0; i < 50; i++)
+		kcache_free(c, objs[i]);
+	kcache_destroy(c);
+	check("Large objects get multi page slabs",
+	      ok && free_pages() == before);
+}
+
+// random allocations and frees of one size, with about BENCH_LIVE live
+static unsigned long long bench_run(kcache_t* c, heap_t* h)
+{
+	unsigned long long start;
+	count_t i, n = 0, k;
+
+	start = host_now();
+	for (i = 0; i < BENCH_OPS; i++)
+	{
+		if (n < BENCH_LIVE && (n == 0 ||
+		    host_random() % (2 * BENCH_LIVE) >= n))
+			objs[n++] = c ? kcache_alloc(c) :
+					heap_alloc(h, BENCH_SIZE);
+		else
+		{
+			k = host_random() % n;
+			if (c)
+				kcache_free(c, objs[k]);
+			else
+				heap_free(h, objs[k]);
+			objs[k] = objs[--n];
+		}
+	}
+
+	while (n)
+	{
+		--n;
+		if (c)
+			kcache_free(c, objs[n]);
+		else
+			heap_free(h, objs[n]);
+	}
+
+	return (host_now() - start) / BENCH_OPS;
+}
+
+int slab_test(void)
+{
+	kcache_t* c;
+	heap_t* h;
+
+	failures = 0;
+
+	host_printf("\nObject caches\n");
+	host_memory_init();
+	kcache_init();
+	test_caches();
+
+	c = kcache_create("bench", BENCH_SIZE, NULL, NULL);
+	h = heap_create(512 * 1024, 0);
+	host_printf("\n%d random allocs and frees of %d bytes, ns per op\n",
+		    BENCH_OPS, BENCH_SIZE);
+	host_printf("kcache %8llu\n", bench_run(c, NULL));
+	host_printf("heap   %8llu\n", bench_run(NULL, h));
+	kcache_destroy(c);
+
+	return failures;
+}
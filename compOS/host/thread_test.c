@@ -0,0 +1,205 @@
+/*
+ thread_test.c - hosted test of the thread queues
+
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+/*
+  yield() and wait() trap to Schedule, which switches stacks and can not
+  be done on the host. The test does what they do before the trap and
+  then calls do_sched() like Schedule does, so the threads never run.
+*/
+
+#include <cosbase.h>
+
+#include <cos/debug.h>
+#include <cos/thread.h>
+#include <cos/init.h>
+
+#include "host.h"
+#include "node_queue.h"
+
+#define BENCH_OPS	100000
+#define MAX_THREADS	256
+
+// not in thread.h, used by Schedule and the thread functions
+kthread_t* do_sched();
+void queue_thread(kthread_t* thr);
+bool_t thread_queue_empty(thread_queue_t* tq);
+
+static kthread_t* threads[MAX_THREADS];
+static count_t n_threads;
+
+static int failures;
+
+static void check(cstring_t name, int passed)
+{
+	host_printf("%-60s %s\n", name, passed ? "PASS" : "FAIL");
+	if (!passed)
+		++failures;
+}
+
+static void dummy_thread()
+{
+}
+
+static kthread_t* sim_yield(void)
+{
+	queue_thread(get_current_thread());
+	return do_sched();
+}
+
+static kthread_t* sim_wait(thread_queue_t* tq)
+{
+	get_current_thread()->queue = tq;
+	return sim_yield();
+}
+
+static void test_queues(void)
+{
+	thread_queue_t wq = {NULL, NULL};
+	kthread_t* main_thr;
+	kthread_t* a;
+	kthread_t* b;
+	kthread_t* c;
+	int ok;
+
+	thread_init();
+	main_thr = threads[n_threads++] = get_current_thread();
+
+	a = threads[n_threads++] = spawn_thread(dummy_thread);
+	b = threads[n_threads++] = spawn_thread(dummy_thread);
+	c = threads[n_threads++] = spawn_thread(dummy_thread);
+
+	check("Threads start at the priority of their parent",
+	      main_thr->priority == PRIORITY_NORMAL &&
+	      a->priority == PRIORITY_NORMAL);
+
+	ok = sim_yield() == a && sim_yield() == b && sim_yield() == c &&
+	     sim_yield() == main_thr && sim_yield() == a;
+	check("Threads of one priority run in turn", ok);
+
+	// a is running, b and c are queued
+	set_priority(c, PRIORITY_NORMAL + 1);
+	ok = sim_yield() == c && sim_yield() == c;
+	set_priority(c, PRIORITY_NORMAL);
+	ok = ok && sim_yield() == b && sim_yield() == main_thr &&
+	     sim_yield() == a && sim_yield() == c;
+	check("A higher priority runs first", ok);
+
+	// c is running, b, main and a are queued
+	ok = sim_wait(&wq) == b && sim_wait(&wq) == main_thr &&
+	     !thread_queue_empty(&wq);
+	ok = ok && wake_one(&wq) == 1 && sim_yield() == a &&
+	     sim_yield() == c;
+	check("wake_one() wakes the first waiting thread", ok);
+
+	// c is running, b is waiting, main and a are queued
+	ok = wake_all(&wq) == 1 && thread_queue_empty(&wq) &&
+	     wake_one(&wq) == 0 && wake_all(&wq) == 0;
+	ok = ok && sim_yield() == main_thr && sim_yield() == a &&
+	     sim_yield() == b && sim_yield() == c;
+	check("wake_all() empties the queue", ok);
+
+	// c is running, main, a and b are queued
+	set_priority(b, PRIORITY_NORMAL - 1);
+	ok = sim_wait(&wq) == main_thr;
+	set_priority(c, PRIORITY_NORMAL + 1);
+	ok = ok && wake_one(&wq) == 1 && sim_yield() == c;
+	check("A woken thread goes to the run queue of its priority", ok);
+	set_priority(c, PRIORITY_NORMAL);
+
+	// c is running, a and main are queued
+	ok = sim_yield() == a && sim_yield() == main_thr &&
+	     sim_yield() == c && sim_wait(&wq) == a &&
+	     sim_wait(&wq) == main_thr && sim_wait(&wq) == b;
+	check("A lower priority only runs when nothing else can", ok);
+	wake_all(&wq);
+	set_priority(b, PRIORITY_NORMAL);
+}
+
+/*
+  The benchmark compares the intrusive queues with a copy of the old node
+  queues, with all threads runnable at one priority. A wake is one thread
+  waiting on a queue and being woken again.
+*/
+
+static void bench(count_t n)
+{
+	thread_queue_t wq = {NULL, NULL};
+	node_queue_t old_run = {NULL};
+	node_queue_t old_wq = {NULL};
+	unsigned long long start, t_yield, t_wake, t_old_yield, t_old_wake;
+	kthread_t* thr;
+	count_t i;
+
+	while (n_threads < n)
+		threads[n_threads++] = spawn_thread(dummy_thread);
+
+	start = host_now();
+	for (i = 0; i < BENCH_OPS; i++)
+		sim_yield();
+	t_yield = host_now() - start;
+
+	start = host_now();
+	for (i = 0; i < BENCH_OPS; i++)
+	{
+		sim_wait(&wq);
+		wake_one(&wq);
+	}
+	t_wake = host_now() - start;
+
+	// the old queues, with the same threads
+	thr = get_current_thread();
+	for (i = 0; i < n_threads; i++)
+		if (threads[i] != thr)
+			node_queue_thread(&old_run, threads[i]);
+
+	start = host_now();
+	for (i = 0; i < BENCH_OPS; i++)
+	{
+		node_queue_thread(&old_run, thr);
+		thr = node_queue_head(&old_run);
+	}
+	t_old_yield = host_now() - start;
+
+	start = host_now();
+	for (i = 0; i < BENCH_OPS; i++)
+	{
+		node_queue_thread(&old_wq, thr);
+		thr = node_queue_head(&old_run);
+		node_queue_thread(&old_run, node_queue_head(&old_wq));
+	}
+	t_old_wake = host_now() - start;
+
+	while (node_queue_head(&old_run))
+		;
+
+	host_printf("%8d %12llu %12llu %12llu %12llu\n", n,
+		    t_yield / BENCH_OPS, t_old_yield / BENCH_OPS,
+		    t_wake / BENCH_OPS, t_old_wake / BENCH_OPS);
+}
+
+int thread_test(void)
+{
+	failures = 0;
+
+	host_printf("\nThread queues\n");
+	test_queues();
+
+	host_printf("\nns per op     yield        yield         wake         wake\n");
+	host_printf(" threads   (intrusive)    (nodes)  (intrusive)      (nodes)\n");
+	bench(4);
+	bench(16);
+	bench(64);
+	bench(MAX_THREADS);
+
+	return failures;
+}
@@ -0,0 +1,42 @@
+/*
+ x86-asm.h - hosted version of include/x86-asm.h
+  
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+                     (See file "Copying")
+*/
+
+/*
+  The hosted tests run in user mode, where cli, sti and the control
+  registers fault. They have no interrupts and the C library has already
+  set up SSE, so these do nothing, except that cli is counted for the
+  tests. cpuid works in user mode. The Makefile puts this directory first
+  in the include path.
+*/
+
+#ifndef _X86_ASM_H_
+#define _X86_ASM_H_
+
+// number of cli, see kernel.c
+extern unsigned long host_cli_count;
+
+#define sti()
+#define cli()			((void)++host_cli_count)
+#define nop()
+#define halt()
+
+#define read_cr0()		0
+#define write_cr0(value)	((void)(value))
+#define read_cr4()		0
+#define write_cr4(value)	((void)(value))
+#define clts()
+
+#define cpuid(op,a,b,c,d) \
+__asm__ volatile ("cpuid":"=a" (a),"=b" (b),"=c" (c),"=d" (d):"a" (op),"c" (0))
+
+#endif // !_X86_ASM_H_
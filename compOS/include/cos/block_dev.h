@@ -28,18 +28,47 @@
 #ifndef _COS_BLOCK_DEV_H_
 #define _COS_BLOCK_DEV_H_
 
+#include <cos/thread.h>
+
 struct block_device;
 typedef struct block_device block_device_t;
 
 struct block_request;
 typedef struct block_request block_request_t;
 
+// starts a request, returns BRESULT_PENDING if the driver will call
+//  block_complete() later, or the result if it is already done
 typedef fresult_t (*block_function_t)(block_request_t* rq, block_device_t* dev);
 
+typedef struct block_stats
+{
+	u32_t			queued;		// requests added to the queue
+	u32_t			merged;		// requests merged into another
+	u32_t			dispatched;	// requests given to the driver
+	u32_t			expired;	// dispatched out of order because
+						// of their deadline
+	u32_t			seek;		// sectors moved between requests
+}
+block_stats_t;
+
 struct block_device
 {
 	block_function_t	fn;
 	u32_t			default_mode;
+	u32_t			sector_size;	// bytes
+	u32_t			n_sectors;
+	ptr_t			data;		// for the driver
+	
+	// request queue, only used in BMODE_QUEUED
+	block_request_t*	sorted;		// waiting requests by sector
+	block_request_t*	fifo_head;	// waiting requests by age
+	block_request_t*	fifo_tail;
+	block_request_t*	active;		// request the driver is doing
+	u32_t			position;	// sector after the last request
+	u32_t			serial;		// number of dispatches
+	u32_t			plugged;	// hold requests while non-zero
+	u32_t			dispatching;
+	block_stats_t		stats;
 };
 
 struct block_request
@@ -50,13 +79,45 @@ struct block_request
 		u32_t value;
 		block_device_t*	ptr;
 	} selector;
+	
+	u32_t			op;		// BOP_READ or BOP_WRITE
+	u32_t			sector;		// first sector
+	u32_t			count;		// number of sectors
+	ptr_t			buffer;
+	
+	volatile u32_t		state;		// BSTATE_*
+	fresult_t		result;
+	thread_queue_t		waiters;	// threads in block_wait()
+	
+	// used by blockio.c while the request is queued
+	u32_t			total;		// sectors including merged requests
+	u32_t			deadline;	// dispatch serial to go by
+	block_request_t*	next;		// in sorted
+	block_request_t*	prev;
+	block_request_t*	fifo_next;	// in fifo_head
+	block_request_t*	fifo_prev;
+	block_request_t*	merged;		// next request merged into this
+						// one, they follow in sector order
+	block_request_t*	merged_tail;
 };
 
+/*
+  A queued request can have others merged into it, the driver is given the
+  first and must do all of them, following the merged links. Each one has
+  its own buffer. Requests are taken off the queue in C-LOOK order (up
+  from the current position, then back to the lowest sector), unless the
+  oldest request has been waiting for BLOCK_DEADLINE dispatches.
+*/
+
 block_device_t* block_getdev(block_request_t* rq);
 void block_dump_rq(block_request_t* rq);
 void block_dump_dev(block_device_t* d);
 fresult_t block_dispatch(block_request_t* rq, block_device_t* d);
 fresult_t block_addrq(block_request_t* rq);
+fresult_t block_wait(block_request_t* rq);
+void block_complete(block_device_t* d, block_request_t* rq, fresult_t result);
+void block_plug(block_device_t* d);
+void block_unplug(block_device_t* d);
 
 // selector types
 #define BSELECT_UNKNOWN	0
@@ -65,5 +126,24 @@ fresult_t block_addrq(block_request_t* rq);
 // request modes
 #define BMODE_DEFAULT	0
 #define BMODE_IMMEDIATE 1
+#define BMODE_QUEUED	2
+
+// operations
+#define BOP_READ	0
+#define BOP_WRITE	1
+
+// request states
+#define BSTATE_QUEUED	0
+#define BSTATE_ACTIVE	1
+#define BSTATE_DONE	2
+
+// results
+#define BRESULT_OK	0
+#define BRESULT_ERROR	1
+#define BRESULT_PENDING	2
+
+// queue limits
+#define BLOCK_MAX_SECTORS	256		// largest merged request
+#define BLOCK_DEADLINE		16		// dispatches
 
 #endif // !_COS_BLOCK_DEV_H_
@@ -33,7 +33,10 @@
 #define _COS_DEBUG_H_
 
 // currently we have no need to address stuff above 4MB
+//  (the hosted tests give their own limit)
+#ifndef POINTER_MAX
 #define POINTER_MAX ((void*)(4096*1024))
+#endif
 
 // always include debugging stuff for now
 #define assert(x) if (!(x)) FailAssert(#x, __FILE__, __LINE__)
@@ -33,6 +33,7 @@
 	if they are successful.
 */
 
+void mem_init();
 void sys_init(multiboot_info_t* info);
 void gdt_init();
 void tss_init();
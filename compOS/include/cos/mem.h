@@ -41,6 +41,7 @@
 
 // from mem.c
 ptr_t memzero(ptr_t dest, count_t count);
+ptr_t memzero_page(ptr_t dest);
 ptr_t memcpy(ptr_t dest, cptr_t src, count_t count);
 ptr_t memset(ptr_t dest, u8_t c, count_t count);
 int_t memcmp(cptr_t p1, cptr_t p2, count_t count);
@@ -31,41 +31,64 @@
 struct page_manager;
 typedef struct page_manager page_manager_t;
 
-struct page_cluster;
-typedef struct page_cluster page_cluster_t;
+struct page_frame;
+typedef struct page_frame page_frame_t;
 
-// 32 bytes
-struct page_cluster
+struct page_zone;
+typedef struct page_zone page_zone_t;
+
+// largest block is 2^PG_MAX_ORDER pages (128MB)
+#define PG_MAX_ORDER	15
+#define PG_ORDERS	(PG_MAX_ORDER + 1)
+
+// number of zones, one for each free type (see page.c)
+#define PG_ZONES	2
+
+// end of a free list
+#define PG_NO_FRAME	((u32_t)~0)
+
+// 12 bytes, one for each page from address 0 to top of memory
+struct page_frame
 {
-	u32_t			start;
-	u32_t			end;		// *non-inclusive*
-	u8_t			type;
+	u8_t			type;		// type of this page
 	u8_t			reserved[3];	// alignment filler
-	page_cluster_t*		next;		// next in group of clusters
-						// eg next free
-	u32_t			reserved_2[4];	// for future use
+	u32_t			next;		// free block: next in free list
+						// allocated: number of pages
+	u32_t			prev;		// free block: prev in free list
 };
 
-// 1 page size
+// free pages of one type
+struct page_zone
+{
+	u8_t			type;		// free type, eg PG_CLUSTER_FREE
+	u8_t			reserved[3];	// alignment filler
+	u32_t			free_pages;	// number of free pages
+	u32_t			free[PG_ORDERS];// first free block of each order
+};
+
+// lives in the page at sysinfo->page_manager
 struct page_manager
 {
-	page_manager_t*		next;		// next page manager
-	u32_t			reserved[7];	// for future use, again
-	page_cluster_t		clusters[127];
+	page_frame_t*		frames;		// the page map
+	u32_t			n_frames;	// number of pages managed
+	u32_t*			bitmap[PG_ORDERS];	// one bit per block,
+							// set if block is free
+	page_zone_t		zones[PG_ZONES];
 };
 
 /*
-  start = end = 0 in a page cluster defines a cluster that is not valid
-  (free for over-writing with a valid cluster).
+  Physical memory is managed by a binary buddy allocator. A free block of
+  order k is 2^k pages long and starts at a page number which is a multiple
+  of 2^k. Each zone keeps a doubly linked free list of blocks per order,
+  linked through the page map by page number, and a block's bit in the
+  bitmap of its order is set while it is on a free list.
   
-  next = 0 defines the last page manager, a new one can be allocated if
-  needed.
+  Free blocks only merge with their buddy (the other half of the block of
+  the next order) if the buddy is free, of the same order and in the same
+  zone. All pages of a free block have the type of their zone.
   
-  To gest the page manager from a cluster, do this
-	ptr_manager = (ptr_cluster & PAGE_MASK);
-
-  So, no parent pointer is needed in a page cluster (as long as all page
-  clusters are contained in a page manager.
+  The page map and the bitmaps are placed just after the kernel by
+  phys_init(), nothing is ever written to a free page.
 */
 
 #define PAGE_MASK	(0xFFFFF000)
@@ -83,6 +106,7 @@ struct page_manager
 #define PG_CLUSTER_HEAP		0x11		// managed by kalloc()
 #define PG_CLUSTER_SYSTEM	0x12		// system stuff like GDT, IDT
 #define PG_CLUSTER_MANAGER	0x13
+#define PG_CLUSTER_SLAB		0x14		// managed by slab.c
 
 #define PG_CLUSTER_RESERVED	0x20		// no specific use
 #define PG_CLUSTER_DMA		0x21		// managed by DMA manager
@@ -92,13 +116,12 @@ struct page_manager
 #define PG_CLUSTER_UNKNOWN	0xFF		// unknown
 
 // functions in page.c
-page_manager_t* phys_alloc_manager(page_manager_t* last_man);
-page_cluster_t* phys_add_cluster(iptr_t p_start, iptr_t p_end, u8_t p_type,
-				 page_cluster_t* p_next);
-void phys_remove_cluster(page_cluster_t* c);
+size_t phys_map_size(count_t n_pages);
+void phys_setup(ptr_t map, count_t n_pages);
 void phys_mark_by_ptr(u32_t p, u32_t len, u8_t type_p);
 void phys_init();
 ptr_t phys_alloc(count_t n, u8_t use_type, u8_t from_type);
 void phys_free(ptr_t p, u8_t to_type);
+u8_t phys_get_type(ptr_t p);
 
 #endif // !_COS_PAGE_H_
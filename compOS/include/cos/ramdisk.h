@@ -0,0 +1,34 @@
+/*
+ ramdisk.h - block device in memory
+
+ Part of:       COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+                     (See file "Copying")
+*/
+
+#ifndef _COS_RAMDISK_H_
+#define _COS_RAMDISK_H_
+
+#include <cos/block_dev.h>
+
+#define RAMDISK_SECTOR_SIZE	512
+
+// functions in ramdisk.c
+block_device_t* ramdisk_create(count_t n_sectors, u32_t mode);
+fresult_t ramdisk_request(block_request_t* rq, block_device_t* dev);
+
+#endif // !_COS_RAMDISK_H_
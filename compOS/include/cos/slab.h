@@ -0,0 +1,100 @@
+/*
+ slab.h - object caches
+
+ Part of:       COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+                     (See file "Copying")
+*/
+
+#ifndef _COS_SLAB_H_
+#define _COS_SLAB_H_
+
+struct kcache;
+typedef struct kcache kcache_t;
+
+struct kslab;
+typedef struct kslab kslab_t;
+
+// constructor or destructor of a cached object
+typedef void (*kcache_fn_t)(ptr_t obj);
+
+// at the start of each slab
+struct kslab
+{
+	kcache_t*		cache;
+	kslab_t*		next;		// in the list of the cache
+	kslab_t*		prev;
+	ptr_t			free;		// first free object
+	count_t			in_use;		// objects handed out
+};
+
+typedef struct kcache_stats
+{
+	u32_t			allocs;		// calls to kcache_alloc()
+	u32_t			frees;		// calls to kcache_free()
+	u32_t			active;		// objects handed out now
+	u32_t			slabs;		// slabs owned now
+	u32_t			grows;		// slabs taken from phys_alloc()
+	u32_t			shrinks;	// slabs given back
+}
+kcache_stats_t;
+
+struct kcache
+{
+	cstring_t		name;
+	size_t			size;		// size of an object
+	size_t			stride;		// distance between objects
+	size_t			link;		// offset of the free list link
+	count_t			pages;		// pages in a slab, a power of 2
+	count_t			per_slab;	// objects in a slab
+	u32_t			colours;	// number of first object offsets
+	u32_t			colour_next;	// offset of the next new slab
+	kcache_fn_t		ctor;
+	kcache_fn_t		dtor;
+	kslab_t*		partial;	// slabs with free and used objects
+	kslab_t*		full;		// slabs with no free objects
+	kslab_t*		empty;		// one spare slab at most
+	kcache_t*		next;		// list of all caches
+	kcache_stats_t		stats;
+};
+
+/*
+  A slab is 2^n pages from phys_alloc(), which come aligned to their size,
+  so the slab of an object is found by masking its address. Free objects
+  are linked through the word at link, which is after the object if it
+  has a constructor so that objects keep their constructed state.
+*/
+
+// objects are aligned to this, and slabs are coloured in steps of it
+#define KCACHE_ALIGN		8
+#define KCACHE_COLOUR		32
+
+// largest slab
+#define KCACHE_MAX_PAGES	8
+
+// functions in slab.c
+void kcache_init();
+kcache_t* kcache_create(cstring_t name, size_t size, kcache_fn_t ctor,
+			kcache_fn_t dtor);
+void kcache_destroy(kcache_t* cache);
+ptr_t kcache_alloc(kcache_t* cache);
+void kcache_free(kcache_t* cache, ptr_t obj);
+void kcache_shrink(kcache_t* cache);
+void kcache_dump(kcache_t* cache);
+void kcache_dump_all();
+
+#endif // !_COS_SLAB_H_
@@ -44,18 +44,12 @@ typedef struct kernel_thread kthread_t;
 struct thread_queue;
 typedef struct thread_queue thread_queue_t;
 
-struct thread_node;
-typedef struct thread_node thread_node_t;
-
+// threads are linked into a queue through q_next and q_prev, a thread is
+//  on at most one queue at a time
 struct thread_queue
 {
-	thread_node_t* head;
-};
-
-struct thread_node
-{
-	kthread_t* thread;
-	thread_node_t* next;
+	kthread_t* head;
+	kthread_t* tail;
 };
 
 struct kernel_thread
@@ -67,7 +61,10 @@ struct kernel_thread
 	kthread_t* parent;
 	kthread_t* next;
 	kthread_t* child;
-	thread_queue_t* queue;
+	thread_queue_t* queue;	// queue to go on when this thread stops running
+	kthread_t* q_next;	// links in the queue this thread is on
+	kthread_t* q_prev;
+	u32_t priority;		// 0 is lowest, each priority has a run queue
 };
 
 typedef void (*thread_function_t)();
@@ -75,13 +72,17 @@ typedef void (*thread_function_t)();
 #define START_TICKS 20
 // 5 thread switches per second ignoring yields or waits
 
+#define THREAD_PRIORITIES 8
+#define PRIORITY_NORMAL 4
+
 // public stuff in thread.c
 kthread_t* get_current_thread();
 void yield();
 kthread_t* spawn_thread(thread_function_t fn);
+void set_priority(kthread_t* thr, u32_t priority);
 void wait(thread_queue_t* tq);
-void wake_one(thread_queue_t* tq);
-void wake_all(thread_queue_t* tq);
+count_t wake_one(thread_queue_t* tq);
+count_t wake_all(thread_queue_t* tq);
 
 // timer
 void init_timer();
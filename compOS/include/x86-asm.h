@@ -55,6 +55,32 @@ __asm__ volatile ("inb %%dx,%%al\n" \
 _v; \
 })
 
+// control registers
+#define read_cr0() ({ \
+unsigned long _v; \
+__asm__ volatile ("movl %%cr0,%0":"=r" (_v)); \
+_v; \
+})
+
+#define write_cr0(value) \
+__asm__ volatile ("movl %0,%%cr0"::"r" (value))
+
+#define read_cr4() ({ \
+unsigned long _v; \
+__asm__ volatile ("movl %%cr4,%0":"=r" (_v)); \
+_v; \
+})
+
+#define write_cr4(value) \
+__asm__ volatile ("movl %0,%%cr4"::"r" (value))
+
+// clear the task switched flag in cr0
+#define clts() __asm__ volatile ("clts"::)
+
+// processor identification, leaf op with sub-leaf 0
+#define cpuid(op,a,b,c,d) \
+__asm__ volatile ("cpuid":"=a" (a),"=b" (b),"=c" (c),"=d" (d):"a" (op),"c" (0))
+
 // load tss
 #define ltr(xx) __asm__ volatile ("ltr %0" :: "a" (xx))
 
@@ -29,6 +29,8 @@
 
 #include <cos/debug.h>
 #include <cos/block_dev.h>
+#include <cos/thread.h>
+#include <x86-asm.h>
 
 block_device_t* block_getdev(block_request_t* rq)
 {
@@ -45,48 +47,319 @@ void block_dump_rq(block_request_t* rq)
 	TRACE(("selector: type=0x%x, value=0x%x\n", rq->selector_type,
 		rq->selector.value));
 	
-	TRACE(("mode=0x%x\n", rq->mode));
+	TRACE(("mode=0x%x, op=%d, sector=%d, count=%d, state=%d\n",
+		rq->mode, rq->op, rq->sector, rq->count, rq->state));
 	
 	TRACE(("Finished\n"));
 }
 
 void block_dump_dev(block_device_t* d)
 {
+	block_stats_t* st = &(d->stats);
+	
 	TRACE(("Dumping block device at 0x%x\n", d));
 	
 	TRACE(("default_mode=0x%x, fn at 0x%x\n", d->default_mode, d->fn));
+	TRACE(("%d sectors of %d bytes, position=%d\n", d->n_sectors,
+		d->sector_size, d->position));
+	TRACE(("queued=%d, merged=%d, dispatched=%d, expired=%d, seek=%d\n",
+		st->queued, st->merged, st->dispatched, st->expired,
+		st->seek));
 	
 	TRACE(("Finished\n"));
 }
 
 fresult_t block_dispatch(block_request_t* rq, block_device_t* d)
 {
-	// just dispatch, assume everything is fine
+	return (*(d->fn))(rq, d);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Request queue, all of these are called with interrupts disabled
+
+// put a request in the sorted list and at the end of the fifo
+static void block_insert(block_device_t* d, block_request_t* rq)
+{
+	block_request_t* p = d->sorted;
+	block_request_t* last = NULL;
+	
+	while (p && p->sector <= rq->sector)
+	{
+		last = p;
+		p = p->next;
+	}
+	
+	rq->prev = last;
+	rq->next = p;
+	if (last)
+		last->next = rq;
+	else
+		d->sorted = rq;
+	if (p)
+		p->prev = rq;
+	
+	rq->deadline = d->serial + BLOCK_DEADLINE;
+	rq->fifo_next = NULL;
+	rq->fifo_prev = d->fifo_tail;
+	if (d->fifo_tail)
+		d->fifo_tail->fifo_next = rq;
+	else
+		d->fifo_head = rq;
+	d->fifo_tail = rq;
+}
+
+static void block_unlink(block_device_t* d, block_request_t* rq)
+{
+	if (rq->prev)
+		rq->prev->next = rq->next;
+	else
+		d->sorted = rq->next;
+	if (rq->next)
+		rq->next->prev = rq->prev;
+	
+	if (rq->fifo_prev)
+		rq->fifo_prev->fifo_next = rq->fifo_next;
+	else
+		d->fifo_head = rq->fifo_next;
+	if (rq->fifo_next)
+		rq->fifo_next->fifo_prev = rq->fifo_prev;
+	else
+		d->fifo_tail = rq->fifo_prev;
+}
+
+// put rq in the place of old in both lists
+static void block_replace(block_device_t* d, block_request_t* old,
+			  block_request_t* rq)
+{
+	rq->next = old->next;
+	rq->prev = old->prev;
+	rq->fifo_next = old->fifo_next;
+	rq->fifo_prev = old->fifo_prev;
+	rq->deadline = old->deadline;
+	
+	if (rq->prev)
+		rq->prev->next = rq;
+	else
+		d->sorted = rq;
+	if (rq->next)
+		rq->next->prev = rq;
+	
+	if (rq->fifo_prev)
+		rq->fifo_prev->fifo_next = rq;
+	else
+		d->fifo_head = rq;
+	if (rq->fifo_next)
+		rq->fifo_next->fifo_prev = rq;
+	else
+		d->fifo_tail = rq;
+}
+
+// merge a new request with a queued one it adjoins, returns 0 if there is
+//  none
+static bool_t block_merge(block_device_t* d, block_request_t* rq)
+{
+	block_request_t* p;
+	
+	for (p = d->sorted; p && p->sector <= rq->sector + rq->count;
+	     p = p->next)
+	{
+		if (p->op != rq->op || p->total + rq->count > BLOCK_MAX_SECTORS)
+			continue;
+		
+		// rq follows p
+		if (p->sector + p->total == rq->sector)
+		{
+			if (p->merged_tail)
+				p->merged_tail->merged = rq;
+			else
+				p->merged = rq;
+			p->merged_tail = rq;
+			p->total += rq->count;
+			return 1;
+		}
+		
+		// rq comes before p, and takes its place
+		if (rq->sector + rq->count == p->sector)
+		{
+			block_replace(d, p, rq);
+			rq->merged = p;
+			rq->merged_tail = p->merged_tail ? p->merged_tail : p;
+			rq->total += p->total;
+			p->merged_tail = NULL;
+			return 1;
+		}
+	}
+	
+	return 0;
+}
+
+// choose the next request to dispatch
+static block_request_t* block_next(block_device_t* d)
+{
+	block_request_t* rq = d->fifo_head;
+	
+	if ((i32_t)(d->serial - rq->deadline) >= 0)
+	{
+		++d->stats.expired;
+		return rq;
+	}
+	
+	// C-LOOK, the first request from the current position up
+	for (rq = d->sorted; rq && rq->sector < d->position; rq = rq->next)
+		;
+	
+	return rq ? rq : d->sorted;
+}
+
+// mark a request and all merged into it as done
+static void block_finish(block_device_t* d, block_request_t* rq,
+			 fresult_t result)
+{
+	block_request_t* next;
+	
+	assert(d->active == rq);
+	d->active = NULL;
+	
+	for (; rq; rq = next)
+	{
+		// the owner can reuse rq as soon as it is done
+		next = rq->merged;
+		rq->result = result;
+		rq->state = BSTATE_DONE;
+		wake_all(&(rq->waiters));
+	}
+}
+
+// give queued requests to the driver while it is idle
+static void block_run(block_device_t* d)
+{
+	block_request_t* rq;
+	block_request_t* p;
+	fresult_t result;
+	
+	// a driver completing a request from its function ends up here again
+	if (d->plugged || d->dispatching)
+		return;
+	d->dispatching = 1;
+	
+	while (!d->active && d->sorted)
+	{
+		rq = block_next(d);
+		block_unlink(d, rq);
+		
+		d->stats.seek += (rq->sector > d->position) ?
+				 rq->sector - d->position :
+				 d->position - rq->sector;
+		d->position = rq->sector + rq->total;
+		++d->stats.dispatched;
+		++d->serial;
+		
+		d->active = rq;
+		for (p = rq; p; p = p->merged)
+			p->state = BSTATE_ACTIVE;
+		
+		result = block_dispatch(rq, d);
+		if (result != BRESULT_PENDING)
+			block_finish(d, rq, result);
+	}
 	
-	return (*(d->fn))(rq, d);	// TODO: re-do this with more thought
+	d->dispatching = 0;
 }
 
+/////////////////////////////////////////////////////////////////////
+// Public functions
+
+// add a request, in BMODE_QUEUED this returns BRESULT_PENDING unless the
+//  request is already done, use block_wait() for the result
 fresult_t block_addrq(block_request_t* rq)
 {
 	assert_ptr(rq);
 	
 	block_device_t* dev = block_getdev(rq);
+	u32_t mode = rq->mode;
 	
 	assert_ptr(dev);
 	
-	// dont support overrides yet
-	assert(rq->mode == BMODE_DEFAULT);
-	
-	// only support immediate mode
-	assert(dev->default_mode == BMODE_IMMEDIATE);
+	if (mode == BMODE_DEFAULT)
+		mode = dev->default_mode;
 	
 	TRACE(("Adding block request:\n"));
 	block_dump_rq(rq);
-	block_dump_dev(dev);
 	
-	return block_dispatch(rq, dev);
+	rq->result = BRESULT_OK;
+	rq->waiters.head = rq->waiters.tail = NULL;
+	rq->merged = rq->merged_tail = NULL;
+	rq->total = rq->count;
+	
+	if (rq->count == 0 || rq->sector >= dev->n_sectors ||
+	    rq->count > dev->n_sectors - rq->sector)
+	{
+		rq->state = BSTATE_DONE;
+		rq->result = BRESULT_ERROR;
+		return BRESULT_ERROR;
+	}
+	
+	// the driver does it now
+	if (mode == BMODE_IMMEDIATE)
+	{
+		rq->state = BSTATE_ACTIVE;
+		rq->result = block_dispatch(rq, dev);
+		assert(rq->result != BRESULT_PENDING);
+		rq->state = BSTATE_DONE;
+		return rq->result;
+	}
+	
+	assert(mode == BMODE_QUEUED);
+	rq->state = BSTATE_QUEUED;
+	
+	cli();
+	++dev->stats.queued;
+	if (block_merge(dev, rq))
+		++dev->stats.merged;
+	else
+		block_insert(dev, rq);
+	block_run(dev);
+	sti();
+	
+	return (rq->state == BSTATE_DONE) ? rq->result : BRESULT_PENDING;
 }
 
-/*
- TODO:	Write TODO list!
-*/
+// wait for a request to be done and return its result
+fresult_t block_wait(block_request_t* rq)
+{
+	// done is final, so no need to lock for this
+	if (rq->state == BSTATE_DONE)
+		return rq->result;
+	
+	cli();
+	while (rq->state != BSTATE_DONE)
+		wait(&(rq->waiters));
+	sti();
+	
+	return rq->result;
+}
+
+// called by a driver when it has done a request it returned
+//  BRESULT_PENDING for, usually from its interrupt handler
+void block_complete(block_device_t* d, block_request_t* rq, fresult_t result)
+{
+	block_finish(d, rq, result);
+	block_run(d);
+}
+
+// hold back queued requests, to give them a chance to be merged
+void block_plug(block_device_t* d)
+{
+	cli();
+	++d->plugged;
+	sti();
+}
+
+void block_unplug(block_device_t* d)
+{
+	cli();
+	assert(d->plugged);
+	if (!--d->plugged)
+		block_run(d);
+	sti();
+}
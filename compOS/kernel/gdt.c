@@ -67,7 +67,7 @@ void gdt_init()
 	count_t i;
 
 	// firstly, wipe our GDT for safety
-	memset((ptr_t)sysinfo->gdt, 0, 4096);
+	memzero_page((ptr_t)sysinfo->gdt);
 
 	// initialise the kernel code segment
 	gdt_set_simple(1, 0x0A);
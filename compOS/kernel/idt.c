@@ -63,7 +63,7 @@ void idt_init()
 	idt_entry_t* the_idt = (idt_entry_t*) (sysinfo->interrupts->idt);
 
 	// Blank out the IDT page before we start
-	memset((ptr_t)the_idt, 0, 4096);
+	memzero_page((ptr_t)the_idt);
 
 	u32_t addr = (ulong_t) &g_entryPointTableStart;
 	// load dummy interrupt handlers
@@ -34,12 +34,39 @@
 #endif
 
 #include <cos/sysinfo.h>
+#include <cos/debug.h>
+#include <cos/page.h>
+#include <cos/mem.h>
+#include <cos/slab.h>
 
 #define KERNEL_HEAP_SIZE (512 * 1024)
 	// 512k
 
+// requests up to KALLOC_SLAB_MAX bytes come from a cache for their size
+//  class, 16, 32, ... 512 bytes
+#define KALLOC_CLASSES	6
+#define KALLOC_SLAB_MIN	16
+#define KALLOC_SLAB_MAX	(KALLOC_SLAB_MIN << (KALLOC_CLASSES - 1))
+
+static cstring_t class_names[KALLOC_CLASSES] =
+{
+	"kalloc-16", "kalloc-32", "kalloc-64",
+	"kalloc-128", "kalloc-256", "kalloc-512"
+};
+
+static kcache_t* class_caches[KALLOC_CLASSES];
+
 ptr_t kalloc(size_t sz)
 {
+	if (sz <= KALLOC_SLAB_MAX)
+	{
+		count_t i = 0;
+		
+		while ((KALLOC_SLAB_MIN << i) < sz)
+			++i;
+		return kcache_alloc(class_caches[i]);
+	}
+	
 #ifdef USE_BGET
 	return bget(sz);
 #else
@@ -49,6 +76,14 @@ ptr_t kalloc(size_t sz)
 
 void kfree(ptr_t p)
 {
+	// the size class caches have one page slabs
+	if (phys_get_type(p) == PG_CLUSTER_SLAB)
+	{
+		kslab_t* s = (kslab_t*)((iptr_t)p & PAGE_MASK);
+		kcache_free(s->cache, p);
+		return;
+	}
+	
 #ifdef USE_BGET
 	brel(p);
 #else
@@ -58,6 +93,16 @@ void kfree(ptr_t p)
 
 void kalloc_init()
 {
+	count_t i;
+	
+	kcache_init();
+	for (i = 0; i < KALLOC_CLASSES; i++)
+	{
+		class_caches[i] = kcache_create(class_names[i],
+						KALLOC_SLAB_MIN << i, NULL, NULL);
+		assert(class_caches[i]->pages == 1);
+	}
+	
 #ifdef USE_BGET
 	void* p = phys_alloc(KERNEL_HEAP_SIZE / PAGE_SIZE, PG_CLUSTER_HEAP,
 			PG_CLUSTER_FREE);
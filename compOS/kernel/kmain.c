@@ -162,6 +162,7 @@ void kmain(multiboot_info_t* info)
 	TRACE(("g_stack=%x, end of g_stack=%x\n", g_stack, g_stack + 16384));
 	TRACE(("Finished dumping kernel memory info\n\n"));
 
+	mem_init();
 	sys_init(info);
 	gdt_init();
 	tss_init();
@@ -33,6 +33,197 @@
 
 #include <cos/mem.h>
 #include <cos/debug.h>
+#include <x86-asm.h>
+
+extern u32_t Get_EFLAGS();
+extern u32_t Has_CPUID();
+
+/*
+  Blocks shorter than MEM_SMALL are done a byte at a time, and ones shorter
+  than MEM_REP a word at a time, where rep would take longer to start.
+  Longer ones are done with rep movsd/stosd once the destination is
+  aligned. On processors with SSE2 but without fast rep movsb (ERMS),
+  copies of MEM_SSE_MIN bytes or more whose source and destination have
+  the same alignment use SSE2 in 64 byte steps, as do whole pages zeroed
+  by memzero_page(). With ERMS, rep is as fast and starts sooner.
+
+  The kernel does not keep any SSE state of its own, so the SSE code saves
+  the xmm registers it uses and restores them after. It runs with
+  interrupts disabled and CR0.TS clear, so it can not fault and nobody
+  else can see the registers in between. To bound the interrupt latency
+  this is done for at most MEM_SSE_CHUNK bytes at a time, interrupts and
+  CR0.TS are restored between the chunks.
+
+  All copies go forwards, so memcpy() still works when dest is below src,
+  as vtext_scroll() needs.
+*/
+
+#define MEM_SMALL	16
+#define MEM_REP		128
+#define MEM_SSE_MIN	512
+#define MEM_SSE_CHUNK	4096
+
+#define CR0_MP		(1 << 1)
+#define CR0_EM		(1 << 2)
+#define CR0_TS		(1 << 3)
+#define CR4_OSFXSR	(1 << 9)
+#define CR4_OSXMMEXCPT	(1 << 10)
+
+#define CPUID_FXSR	(1 << 24)
+#define CPUID_SSE2	(1 << 26)
+#define CPUID_ERMS	(1 << 9)		// leaf 7, in ebx
+
+#define EFLAGS_IF	(1 << 9)
+
+// set by mem_init() if SSE2 is to be used
+bool_t mem_sse;
+
+// state saved by sse_begin()
+typedef struct sse_state
+{
+	u8_t	xmm[4 * 16];	// xmm0 to xmm3
+	u32_t	eflags;
+	u32_t	cr0;
+}
+sse_state_t;
+
+static void sse_begin(sse_state_t* st)
+{
+	st->eflags = Get_EFLAGS();
+	cli();
+	st->cr0 = read_cr0();
+	if (st->cr0 & CR0_TS)
+		clts();
+	
+	__asm__ volatile ("movdqu %%xmm0,(%0)\n"
+			  "\tmovdqu %%xmm1,16(%0)\n"
+			  "\tmovdqu %%xmm2,32(%0)\n"
+			  "\tmovdqu %%xmm3,48(%0)"
+			  :: "r" (st->xmm) : "memory");
+}
+
+static void sse_end(sse_state_t* st)
+{
+	__asm__ volatile ("movdqu (%0),%%xmm0\n"
+			  "\tmovdqu 16(%0),%%xmm1\n"
+			  "\tmovdqu 32(%0),%%xmm2\n"
+			  "\tmovdqu 48(%0),%%xmm3"
+			  :: "r" (st->xmm) : "memory");
+	
+	if (st->cr0 & CR0_TS)
+		write_cr0(st->cr0);
+	if (st->eflags & EFLAGS_IF)
+		sti();
+}
+
+// copy blocks of 64 bytes, dest and src 16 byte aligned, call between
+//  sse_begin() and sse_end()
+static void sse_copy_blocks(u8_t* dest, const u8_t* src, u32_t blocks)
+{
+	__asm__ volatile ("1:\tmovdqa (%1),%%xmm0\n"
+			  "\tmovdqa 16(%1),%%xmm1\n"
+			  "\tmovdqa 32(%1),%%xmm2\n"
+			  "\tmovdqa 48(%1),%%xmm3\n"
+			  "\tmovdqa %%xmm0,(%0)\n"
+			  "\tmovdqa %%xmm1,16(%0)\n"
+			  "\tmovdqa %%xmm2,32(%0)\n"
+			  "\tmovdqa %%xmm3,48(%0)\n"
+			  "\tadd $64,%0\n"
+			  "\tadd $64,%1\n"
+			  "\tdec %2\n"
+			  "\tjnz 1b"
+			  : "+r" (dest), "+r" (src), "+r" (blocks)
+			  :: "memory", "cc");
+}
+
+// zero blocks of 64 bytes, dest 16 byte aligned, call between sse_begin()
+//  and sse_end()
+static void sse_zero_blocks(u8_t* dest, u32_t blocks)
+{
+	__asm__ volatile ("pxor %%xmm0,%%xmm0\n"
+			  "1:\tmovdqa %%xmm0,(%0)\n"
+			  "\tmovdqa %%xmm0,16(%0)\n"
+			  "\tmovdqa %%xmm0,32(%0)\n"
+			  "\tmovdqa %%xmm0,48(%0)\n"
+			  "\tadd $64,%0\n"
+			  "\tdec %1\n"
+			  "\tjnz 1b"
+			  : "+r" (dest), "+r" (blocks)
+			  :: "memory", "cc");
+}
+
+// copy blocks of 64 bytes, dest and src 16 byte aligned, a chunk at a time
+static void sse_copy(u8_t* dest, const u8_t* src, u32_t blocks)
+{
+	sse_state_t st;
+	u32_t n;
+	
+	for (; blocks > 0; blocks -= n)
+	{
+		n = blocks < MEM_SSE_CHUNK / 64 ? blocks : MEM_SSE_CHUNK / 64;
+		sse_begin(&st);
+		sse_copy_blocks(dest, src, n);
+		sse_end(&st);
+		dest += n * 64;
+		src += n * 64;
+	}
+}
+
+// zero blocks of 64 bytes, dest 16 byte aligned, a chunk at a time
+static void sse_zero(u8_t* dest, u32_t blocks)
+{
+	sse_state_t st;
+	u32_t n;
+	
+	for (; blocks > 0; blocks -= n)
+	{
+		n = blocks < MEM_SSE_CHUNK / 64 ? blocks : MEM_SSE_CHUNK / 64;
+		sse_begin(&st);
+		sse_zero_blocks(dest, n);
+		sse_end(&st);
+		dest += n * 64;
+	}
+}
+
+// turn on SSE if the processor has it and it is worth using, the mem*
+//  functions can be used before this but will not use SSE
+void mem_init()
+{
+	u32_t a, b, c, d, max;
+	
+	TRACE(("Initialising memory functions...\n"));
+	
+	// a 386 or early 486 has no cpuid, and so no SSE
+	if (!Has_CPUID())
+	{
+		TRACE(("No cpuid, not using SSE2\n"));
+		return;
+	}
+	
+	cpuid(0, max, b, c, d);
+	cpuid(1, a, b, c, d);
+	if ((d & (CPUID_FXSR | CPUID_SSE2)) != (CPUID_FXSR | CPUID_SSE2))
+	{
+		TRACE(("No SSE2, not using it\n"));
+		return;
+	}
+	
+	if (max >= 7)
+	{
+		cpuid(7, a, b, c, d);
+		if (b & CPUID_ERMS)
+		{
+			TRACE(("Fast rep movsb, not using SSE2\n"));
+			return;
+		}
+	}
+	
+	write_cr0((read_cr0() & ~CR0_EM) | CR0_MP);
+	write_cr4(read_cr4() | CR4_OSFXSR | CR4_OSXMMEXCPT);
+	mem_sse = 1;
+	
+	TRACE(("Using SSE2 for large copies\n"));
+}
 
 //////////////////////////////////////////////////////////////////////////
 // mem* functions
@@ -40,6 +231,7 @@ ptr_t memcpy(ptr_t dest, cptr_t src, count_t count)
 {
 	u8_t* pSrc;
 	u8_t* pDest;
+	u32_t n, words;
 	
 	// save us from bad pointers
 	assert_ptr(dest);
@@ -47,24 +239,106 @@ ptr_t memcpy(ptr_t dest, cptr_t src, count_t count)
 	
 	pSrc = (u8_t*)src;
 	pDest = (u8_t*)dest;
-
-	while (count--)
-		*pDest++ = *pSrc++;
-
+	
+	if (count < MEM_SMALL)
+	{
+		while (count-- > 0)
+			*pDest++ = *pSrc++;
+		return dest;
+	}
+	
+	if (count < MEM_REP)
+	{
+		for (; count >= sizeof(iptr_t); count -= sizeof(iptr_t))
+		{
+			*(iptr_t*)pDest = *(iptr_t*)pSrc;
+			pDest += sizeof(iptr_t);
+			pSrc += sizeof(iptr_t);
+		}
+		while (count--)
+			*pDest++ = *pSrc++;
+		return dest;
+	}
+	
+	n = count;
+	if (mem_sse && n >= MEM_SSE_MIN &&
+	    !(((iptr_t)pDest ^ (iptr_t)pSrc) & 15))
+	{
+		u32_t head = -(iptr_t)pDest & 15;
+		
+		n -= head;
+		while (head--)
+			*pDest++ = *pSrc++;
+		
+		sse_copy(pDest, pSrc, n / 64);
+		pDest += n & ~63;
+		pSrc += n & ~63;
+		n &= 63;
+	}
+	else
+	{
+		u32_t head = -(iptr_t)pDest & 3;
+		
+		n -= head;
+		while (head--)
+			*pDest++ = *pSrc++;
+	}
+	
+	words = n / 4;
+	__asm__ volatile ("rep movsl\n"
+			  "\tmov %3,%2\n"
+			  "\trep movsb"
+			  : "+D" (pDest), "+S" (pSrc), "+c" (words)
+			  : "r" (n & 3)
+			  : "memory");
+	
 	return dest;
 }
 
 ptr_t memset(ptr_t dest, u8_t c, count_t count)
 {
 	u8_t* p;
+	u32_t n, head, words;
 	
 	// save us from bad pointers
 	assert_ptr(dest);
 
 	p = (u8_t*)dest;
-
-	while (count--)
+	
+	if (count < MEM_SMALL)
+	{
+		while (count-- > 0)
+			*p++ = c;
+		return dest;
+	}
+	
+	if (count < MEM_REP)
+	{
+		iptr_t w = (iptr_t)-1 / 0xFF * c;
+		
+		for (; count >= sizeof(iptr_t); count -= sizeof(iptr_t))
+		{
+			*(iptr_t*)p = w;
+			p += sizeof(iptr_t);
+		}
+		while (count--)
+			*p++ = c;
+		return dest;
+	}
+	
+	n = count;
+	head = -(iptr_t)p & 3;
+	n -= head;
+	while (head--)
 		*p++ = c;
+	
+	words = n / 4;
+	__asm__ volatile ("rep stosl\n"
+			  "\tmov %3,%1\n"
+			  "\trep stosb"
+			  : "+D" (p), "+c" (words)
+			  : "a" ((u32_t)c * 0x01010101), "r" (n & 3)
+			  : "memory");
 
 	return dest;
 }
@@ -74,6 +348,20 @@ ptr_t memzero(ptr_t dest, count_t count)
 	return memset(dest, 0, count);
 }
 
+// zero a page aligned page
+ptr_t memzero_page(ptr_t dest)
+{
+	assert_ptr(dest);
+	assert(!((iptr_t)dest & (PAGE_SIZE - 1)));
+	
+	if (mem_sse)
+		sse_zero(dest, PAGE_SIZE / 64);
+	else
+		memset(dest, 0, PAGE_SIZE);
+	
+	return dest;
+}
+
 int_t memcmp(cptr_t p1, cptr_t p2, count_t count)
 {
 	u8_t* pa1;
@@ -84,6 +372,16 @@ int_t memcmp(cptr_t p1, cptr_t p2, count_t count)
 	
 	pa1 = (u8_t*)p1;
 	pa2 = (u8_t*)p2;
+	
+	// skip the equal words, the bytes of the first different word are
+	//  compared below
+	while (count >= sizeof(iptr_t) && *(iptr_t*)pa1 == *(iptr_t*)pa2)
+	{
+		pa1 += sizeof(iptr_t);
+		pa2 += sizeof(iptr_t);
+		count -= sizeof(iptr_t);
+	}
+	
 	while (count--)
 	{
 		if (!(*pa1 == *pa2))
@@ -33,339 +33,257 @@
 #include <cos/page.h>
 #include <cos/mem.h>
 
-// add a new manager
-page_manager_t* phys_alloc_manager(page_manager_t* last_man)
+// free types which have a zone, in the order of the zones
+static u8_t zone_types[PG_ZONES] =
 {
-	page_manager_t* man = sysinfo->page_manager;
-	u32_t i = 0;
-	page_cluster_t* c = &(man->clusters[i]);
-	count_t n = 0;
-	
-	TRACE(("Allocating a new manager\n"));
-	TRACE(("First manager=0x%x, Last manager=0x%x\n", man, last_man));
+	PG_CLUSTER_FREE,
+	PG_CLUSTER_FREE_LOWER
+};
 
-	// loop to find a cluster representing free memory
-	while (c->type != PG_CLUSTER_FREE)
-	{
-		TRACE(("Loop (%d): cluster=0x%x, type=0x%x\n", n, c,
-			c->type));
-		TRACE(("\tstart=0x%x, end=0x%x\n", c->start, c->end));
-		// handle a bad cluster
-		if (c->start >= c->end)
-		{
-			TRACE(("\tBad cluster, Removing!\n"));
-			phys_remove_cluster(c);
-			TRACE(("\treturning current manager\n"));
-			return man;		// return this manager as it
-						// now has a free cluster
-		}
-		
-		if (++i >= 127)
-		{
-			TRACE(("End of this manager!\n"));
-			man = man->next;
-			assert(man);
-			TRACE(("Going to manager at 0x%x\n", man));
-			i = 0;
-		}
-		c = &(man->clusters[i]);
-		n++;
-	}
-	TRACE(("Found some free memory! cluster=0x%x", c));
-	TRACE(("start=0x%x, end=0x%x\n", c->start, c->end));
-	
-	// one last check for a bad cluster
-	if (c->start >= c->end)
-	{
-		TRACE(("\tBad cluster, Removing!\n"));
-		phys_remove_cluster(c);
-		TRACE(("\treturning current manager\n"));
-		return man;
-	}
+#define PFN(p)			(((iptr_t)(p)) / PAGE_SIZE)
+#define BIT_TEST(map, i)	((map)[(i) >> 5] & (1UL << ((i) & 31)))
+#define BIT_SET(map, i)		((map)[(i) >> 5] |= (1UL << ((i) & 31)))
+#define BIT_CLEAR(map, i)	((map)[(i) >> 5] &= ~(1UL << ((i) & 31)))
+
+// number of u32_t words in the bitmap of an order
+#define BITMAP_WORDS(n, order)	(((((n) + (1 << (order)) - 1) >> (order)) \
+				  + 31) / 32)
+
+static page_zone_t* phys_get_zone(u8_t type)
+{
+	page_manager_t* man = sysinfo->page_manager;
+	count_t i;
 	
-	// nudge this cluster along a page
-	TRACE(("Nudging this cluster along a page and"
-		" setting up new manager\n"));
-	man = (page_manager_t*)c->start;
-	c->start += PAGE_SIZE;
+	for (i = 0; i < PG_ZONES; i++)
+		if (man->zones[i].type == type)
+			return &(man->zones[i]);
 	
-	// setup new manager
-	memzero(man, PAGE_SIZE);
-	iptr_t m = (iptr_t)man;
-	last_man->next = man;
+	return NULL;
+}
+
+// put a block on the free list of its order
+static void phys_push(page_zone_t* z, u32_t pfn, u32_t order)
+{
+	page_manager_t* man = sysinfo->page_manager;
+	page_frame_t* f = &(man->frames[pfn]);
 	
-	TRACE(("Adding cluster to describe the new manager\n"));
-	phys_add_cluster(m, m + PAGE_SIZE, PG_CLUSTER_MANAGER, 0);
+	f->next = z->free[order];
+	f->prev = PG_NO_FRAME;
+	if (f->next != PG_NO_FRAME)
+		man->frames[f->next].prev = pfn;
+	z->free[order] = pfn;
 	
-	TRACE(("Returning manager at 0x%x\n", man));
-	return man;
+	BIT_SET(man->bitmap[order], pfn >> order);
 }
 
-page_cluster_t* phys_add_cluster(iptr_t p_start, iptr_t p_end, u8_t p_type,
-				 page_cluster_t* p_next)
+// take a block off the free list of its order
+static void phys_unlink(page_zone_t* z, u32_t pfn, u32_t order)
 {
 	page_manager_t* man = sysinfo->page_manager;
-	u32_t i = 0;
-	page_cluster_t* c = &(man->clusters[i]);
-	count_t n = 0;
+	page_frame_t* f = &(man->frames[pfn]);
 	
-	TRACE(("Adding a new cluster from 0x%x to 0x%x\n", p_start, p_end));
-	TRACE(("type=0x%x, next=0x%x\n", p_type, p_next));
-	TRACE(("First manager=0x%x\n", man));
+	if (f->prev != PG_NO_FRAME)
+		man->frames[f->prev].next = f->next;
+	else
+		z->free[order] = f->next;
+	if (f->next != PG_NO_FRAME)
+		man->frames[f->next].prev = f->prev;
 	
-	assert(!(p_start & ~PAGE_MASK));
-	assert(!(p_end & ~PAGE_MASK));	// must already be page aligned
+	BIT_CLEAR(man->bitmap[order], pfn >> order);
+}
 
-	// loop to find a free cluster
-	while (c->start || c->end)
+// free a block whose pages already have the type of the zone, merging it
+//  with its buddy for as long as the buddy is free as well
+static void phys_free_block(page_zone_t* z, u32_t pfn, u32_t order)
+{
+	page_manager_t* man = sysinfo->page_manager;
+	u32_t buddy;
+	
+	while (order < PG_MAX_ORDER)
 	{
-		TRACE(("Loop (%d): cluster=0x%x, type=0x%x\n", n, c,
-			c->type));
-		TRACE(("\tstart=0x%x, end=0x%x\n", c->start, c->end));
-		if (++i >= 127)
-		{
-			TRACE(("End of this manager!\n"));
-			if (!man->next)
-			{
-				TRACE(("Need to get a new manager\n"));
-				man = phys_alloc_manager(man);
-				assert(man);
-			}
-			else
-				man = man->next;
-			i = 0;
-			TRACE(("Going to manager at 0x%x\n", man));
-		}
-		c = &(man->clusters[i]);
-		n++;
+		buddy = pfn ^ (1 << order);
+		if (buddy + (1 << order) > man->n_frames ||
+		    !BIT_TEST(man->bitmap[order], buddy >> order) ||
+		    man->frames[buddy].type != z->type)
+			break;
+		
+		phys_unlink(z, buddy, order);
+		pfn &= ~(1 << order);
+		++order;
 	}
 	
-	TRACE(("Got a free cluster at 0x%x\n", c));
-	TRACE(("start=0x%x, end=0x%x, type=0x%x, next=0x%x\n", c->start,
-		c->end, c->type, c->next));
-	
-	c->start = p_start;
-	c->end = p_end;
-	c->type = p_type;
-	c->next = p_next;
-	
-	return c;
+	phys_push(z, pfn, order);
 }
 
-void phys_remove_cluster(page_cluster_t* c)
+// give pages [pfn, end) to a zone, in the largest aligned blocks possible
+static void phys_free_range(page_zone_t* z, u32_t pfn, u32_t end)
 {
-	TRACE(("Removing cluster at 0x%x\n", c));
-	memzero(c, sizeof(page_cluster_t));
-}
-
-// this is ONLY to be used in initialisation,
-// it is far too slow for normal use
-void phys_mark_by_ptr(u32_t p, u32_t len, u8_t type_p)
-{
-	TRACE(("Marking by pointer at 0x%x, length %d (0x%x)\n", p, len, len));
-	TRACE(("Will set type to 0x%x\n", type_p));
-	
-	if (len == 0)
-		return;
-
-	u32_t p_end = ((p + len) & PAGE_MASK) +
-		      (((p + len) & ~PAGE_MASK) ? 4096 : 0);
-	page_manager_t* man;
-	page_cluster_t* c;
+	page_manager_t* man = sysinfo->page_manager;
+	u32_t order;
 	u32_t i;
-	count_t n = 0;
 	
-	p &= PAGE_MASK;
+	z->free_pages += end - pfn;
 	
-	u32_t true_start = p;
-	u32_t xx;
-	
-	TRACE(("Ready to search, true start is 0x%x, end 0x%x\n", p, p_end));
+	while (pfn < end)
+	{
+		order = 0;
+		while (order < PG_MAX_ORDER && !(pfn & (1 << order)) &&
+		       pfn + (2 << order) <= end)
+			++order;
+		
+		for (i = 0; i < (1 << order); i++)
+			man->frames[pfn + i].type = z->type;
+		
+		phys_free_block(z, pfn, order);
+		pfn += 1 << order;
+	}
+}
 
-start_search:
-	man = sysinfo->page_manager;
-	i = 0;
-	++n;
-	xx = 0;
+// take one free page out of its zone, splitting the block it is in
+static void phys_take_page(page_zone_t* z, u32_t pfn)
+{
+	page_manager_t* man = sysinfo->page_manager;
+	u32_t order;
+	u32_t head = pfn;
 	
-	TRACE(("Starting search %d, p=0x%x\n", n, p));
+	// find the free block containing the page
+	for (order = 0; order <= PG_MAX_ORDER; order++)
+	{
+		head = pfn & ~((1 << order) - 1);
+		if (BIT_TEST(man->bitmap[order], head >> order))
+			break;
+	}
+	assert(order <= PG_MAX_ORDER);
 	
-	while (p < p_end)
+	phys_unlink(z, head, order);
+	
+	// give back the halves that do not contain the page
+	while (order > 0)
 	{
-		// check if end of this manager
-		if (i >= 127)
-		{
-			TRACE(("End of this manager!\n"));
-			man = man->next;
-			if (!man)
-				panic("Could not mark page!");
-			i = 0;
-			TRACE(("Going to manager at 0x%x\n", man));
-		}
-		
-		c = &(man->clusters[i]);
-		
-		TRACE(("Loop (%d): cluster at 0x%x\n", xx, c));
-		TRACE(("\tstart=0x%x, end=0x%x\n", c->start, c->end));
-		TRACE(("\ttype=0x%x, next=0x%x\n", c->type, c->next));
-		
-		// first check the obvious, p starts below c
-		if (p < c->start)
-			TRACE(("\tp is below c\n"));
-		else if (p > c->end)
-			TRACE(("\tp is above c\n"));
-		
-		// next check if p is at start of c
-		else if (p == c->start)
+		--order;
+		if (pfn & (1 << order))
 		{
-			// now check if c contains p...
-			if (p_end < c->end)
-			{
-				TRACE(("\tc contains p,"
-					" start of p is start of c\n"));
-				c->start = p_end;
-				goto finish;
-			}
-			
-			// or if p contains c (including p is exactly c)
-			else
-			{
-				TRACE(("\tp contains c\n"));
-				p = c->end;
-				TRACE(("\tRemoving c\n"));
-				phys_remove_cluster(c);
-				goto start_search;
-			}
+			phys_push(z, head, order);
+			head += 1 << order;
 		}
-		
-		// finally check if p starts within c
-		else if (p < c->end)
-		{
-			// maybe p is completely within c
-			if (p_end <= c->end)
-			{
-				TRACE(("\tc contains p\n"));
-				TRACE(("\tAdding new cluster from end of p"
-					" to end of c\n"));
-				page_cluster_t* nxt_c = phys_add_cluster(
-					p_end, c->end, c->type, c->next);
-				c->end = p;
-				c->next = nxt_c;
-				goto finish;
-			}
-			
-			// else p extends beyond c
-			else
-			{
-				TRACE(("\tp extends beyond c\n"));
-				u32_t tmp = p;
-				p = c->end;
-				c->end = tmp;
-				goto start_search;
-			}
-		}
-		
-		// otherwise, ignore the bugger
-		++i;
-		++xx;
+		else
+			phys_push(z, head + (1 << order), order);
 	}
-
-finish:
-	TRACE(("Finished, adding cluster for p\n"));
-
-	phys_add_cluster(true_start, p_end, type_p, 0);
+	
+	--z->free_pages;
 }
 
-// init physical page manager
-void phys_init()
+// bytes needed for the page map and bitmaps of n_pages pages
+size_t phys_map_size(count_t n_pages)
 {
-	TRACE(("Initialising physical page manager...\n"));
-
-	multiboot_info_t* info = sysinfo->multiboot;
-	page_manager_t* pgman = sysinfo->page_manager;
-	page_cluster_t* c = 0;
-	u32_t n;	// for calculations
+	size_t sz = n_pages * sizeof(page_frame_t);
+	u32_t order;
 	
-	TRACE(("sysinfo at 0x%x, first manager at 0x%x\n", info, pgman));
+	for (order = 0; order <= PG_MAX_ORDER; order++)
+		sz += BITMAP_WORDS(n_pages, order) * sizeof(u32_t);
 	
-	memzero (pgman, 4096);
+	return sz;
+}
+
+// set up an empty page manager for pages 0 to n_pages, using map as the
+//  page map (phys_map_size(n_pages) bytes). All pages are of unknown type.
+void phys_setup(ptr_t map, count_t n_pages)
+{
+	page_manager_t* man = sysinfo->page_manager;
+	u32_t* words;
+	u32_t order;
+	count_t i;
 	
-	// setup BIOS data area (page 0)
-	c = &(pgman->clusters[0]);
-	c->start = 0;
-	c->end = PAGE_SIZE;
-	c->type = PG_CLUSTER_BIOS;
+	memzero(man, sizeof(page_manager_t));
+	memzero(map, phys_map_size(n_pages));
 	
-	TRACE(("BIOS data area: start=0x%x, end=0x%x, type=0x%x\n",
-		c->start, c->end, c->type));
+	man->frames = (page_frame_t*)map;
+	man->n_frames = n_pages;
 	
-	n = (info->mem_lower << 10) & PAGE_MASK;
+	words = (u32_t*)(man->frames + n_pages);
+	for (order = 0; order <= PG_MAX_ORDER; order++)
+	{
+		man->bitmap[order] = words;
+		words += BITMAP_WORDS(n_pages, order);
+	}
 	
-	// setup remaining low memory
-	++c;
-	c->start = PAGE_SIZE;
-	c->end = n;
-	c->type = PG_CLUSTER_FREE_LOWER;
+	for (i = 0; i < n_pages; i++)
+		man->frames[i].type = PG_CLUSTER_UNKNOWN;
 	
-	TRACE(("Low memory: start=0x%x, end=0x%x, type=0x%x\n",
-		c->start, c->end, c->type));
-		
-	// setup ISA hole
-	++c;
-	c->start = n;
-	c->end = 0x100000;
-	c->type = PG_CLUSTER_ISA_HOLE;
+	for (i = 0; i < PG_ZONES; i++)
+	{
+		man->zones[i].type = zone_types[i];
+		for (order = 0; order <= PG_MAX_ORDER; order++)
+			man->zones[i].free[order] = PG_NO_FRAME;
+	}
+}
+
+// change the type of the pages from p to p + len, free pages are taken out
+//  of their zone and pages changed to a free type are given to its zone.
+// This is only meant to be used in initialisation.
+void phys_mark_by_ptr(u32_t p, u32_t len, u8_t type_p)
+{
+	page_manager_t* man = sysinfo->page_manager;
+	page_zone_t* z;
+	u32_t pfn, end, i;
 	
-	TRACE(("ISA Hole: start=0x%x, end=0x%x, type=0x%x\n",
-		c->start, c->end, c->type));
+	TRACE(("Marking by pointer at 0x%x, length %d (0x%x) as type 0x%x\n",
+		p, len, len, type_p));
 	
-	n = ((iptr_t)&end_kernel & PAGE_MASK) + (((iptr_t)&end_kernel & ~PAGE_MASK)
-					   ? 4096 : 0);
+	if (len == 0)
+		return;
 	
-	// setup kernel memory
-	++c;
-	c->start = (iptr_t)&kernel & PAGE_MASK;
-	c->end = n;
-	c->type = PG_CLUSTER_KERNEL;
+	pfn = PFN(p);
+	end = PFN(p + len + PAGE_SIZE - 1);
+	if (end > man->n_frames)
+		end = man->n_frames;
 	
-	TRACE(("Kernel: start=0x%x, end=0x%x, type=0x%x\n",
-		c->start, c->end, c->type));
+	for (i = pfn; i < end; i++)
+	{
+		z = phys_get_zone(man->frames[i].type);
+		if (z)
+			phys_take_page(z, i);
+		man->frames[i].type = type_p;
+	}
 	
-	// setup remaining high memory
-	++c;
-	c->start = n;
+	z = phys_get_zone(type_p);
+	if (z)
+		phys_free_range(z, pfn, end);
+}
+
+// init physical page manager
+void phys_init()
+{
+	multiboot_info_t* info = sysinfo->multiboot;
+	iptr_t lower, kernel_start, kernel_end, map, map_end, top;
+	count_t n_pages;
 	
-	n = ((info->mem_upper + 1024) << 10) & PAGE_MASK;
+	TRACE(("Initialising physical page manager...\n"));
 	
-	c->end = n;
-	c->type = PG_CLUSTER_FREE;
+	lower = (info->mem_lower << 10) & PAGE_MASK;
+	top = ((info->mem_upper + 1024) << 10) & PAGE_MASK;
+	kernel_start = (iptr_t)&kernel & PAGE_MASK;
+	kernel_end = ((iptr_t)&end_kernel + PAGE_SIZE - 1) & PAGE_MASK;
 	
-	TRACE(("High memory: start=0x%x, end=0x%x, type=0x%x\n",
-		c->start, c->end, c->type));
+	// the page map goes just after the kernel
+	n_pages = top / PAGE_SIZE;
+	map = kernel_end;
+	map_end = (map + phys_map_size(n_pages) + PAGE_SIZE - 1) & PAGE_MASK;
+	if (map_end > top)
+		panic("No memory for the page map!");
 	
-	// setup non present memory
-	++c;
-	c->start = n;
-	c->end = ~0;	// as unsigned gives MAXINT
-	c->type = PG_CLUSTER_NOT_PRESENT;
+	TRACE(("%d pages, page map from 0x%x to 0x%x\n", n_pages, map,
+		map_end));
 	
-	TRACE(("Non-present memory: start=0x%x, end=0x%x, type=0x%x\n",
-		c->start, c->end, c->type));
+	phys_setup((ptr_t)map, n_pages);
 	
-/*
-  Full 4GB address space is now managed, so we never have to worry
-  about a page not being a member of a cluster.
-  
-  Space used for this method:
-	Best case (now) = (6 clusters * 32 bytes + 32 bytes for manager)
-			= 224 bytes(4k allocated)
-	
-	Worst case (1 pg / cluster) = 2^20 clusters in 8257 managers
-				    = 32.2519... MB (32.2539... MB allocated)
-				    = 0.787... % of a 4GB system
-		(This worst case can only happen on a 4GB system)
-		(To be honest, it will never happen)
-*/
+	phys_mark_by_ptr(0, PAGE_SIZE, PG_CLUSTER_BIOS);
+	phys_mark_by_ptr(lower, 0x100000 - lower, PG_CLUSTER_ISA_HOLE);
+	phys_mark_by_ptr(kernel_start, kernel_end - kernel_start,
+			 PG_CLUSTER_KERNEL);
+	phys_mark_by_ptr(map, map_end - map, PG_CLUSTER_MANAGER);
+	phys_mark_by_ptr(PAGE_SIZE, lower - PAGE_SIZE, PG_CLUSTER_FREE_LOWER);
+	phys_mark_by_ptr(map_end, top - map_end, PG_CLUSTER_FREE);
 	
 	// grab the idata structure
 	init_data_t* idata = (init_data_t*)(((iptr_t)sysinfo->multiboot)
@@ -384,128 +302,89 @@ void phys_init()
 	TRACE(("Physical page manager ready!\n"));
 }
 
+// allocate n pages of type from_type and change them to use_type
 ptr_t phys_alloc(count_t n, u8_t use_type, u8_t from_type)
 {
-	TRACE(("Allocating physical memory, %d pages long\n", n));
-	TRACE(("From type 0x%x to type 0x%x\n", from_type, use_type));
+	page_manager_t* man = sysinfo->page_manager;
+	page_zone_t* z;
+	u32_t order = 0;
+	u32_t k, pfn;
+	count_t i;
 	
 	if (n == 0)
 		return NULL;
-
-	page_manager_t* man = sysinfo->page_manager;
-	u32_t i = 0;
-	page_cluster_t* c;
-	u32_t sz = n * PAGE_SIZE;
-	count_t xx = 0;
 	
-	TRACE(("First manager at 0x%x, sz=0x%x\n", man, sz));
+	z = phys_get_zone(from_type);
+	if (!z)
+		panic("No zone for this type");
+	
+	while ((1 << order) < n)
+		++order;
 	
-	// find cluster of at least n pages, of type from_type
-	while (1)
+	// smallest free block which is large enough
+	for (k = order; k <= PG_MAX_ORDER; k++)
+		if (z->free[k] != PG_NO_FRAME)
+			break;
+	if (k > PG_MAX_ORDER)
+		panic("Out of memory");
+	
+	pfn = z->free[k];
+	phys_unlink(z, pfn, k);
+	
+	// split it, keeping the lower half
+	while (k > order)
 	{
-		// check if end of this manager
-		if (i >= 127)
-		{
-			TRACE(("End of this manager!\n"));
-			man = man->next;
-			if (!man)
-				panic("Out of memory");
-			i = 0;
-			TRACE(("Going to manager at 0x%x\n", man));
-		}
-		
-		c = &(man->clusters[i]);
-		
-		TRACE(("Loop (%d): cluster at 0x%x\n", xx, c));
-		TRACE(("\tstart=0x%x, end=0x%x\n", c->start, c->end));
-		TRACE(("\ttype=0x%x, next=0x%x\n", c->type, c->next));
-		
-		// check type
-		if (c->type == from_type)
-		{
-			TRACE(("Correct type\n"));
-			// check size
-			if ((c->end - c->start) >= sz)
-			{
-				TRACE(("It's large enough!\n"));
-				// add a cluster to describe remainder
-				if ((c->end - c->start) > sz)
-				{
-					TRACE(("Adding a cluster to describe"
-						" remainder\n"));
-					phys_add_cluster(c->start + sz,
-							 c->end, c->type,
-							 c->next);
-				}
-				
-				// modify this cluster to describe allocated
-				//  region
-				c->end = c->start + sz;
-				c->type = use_type;
-				c->next = 0;
-				
-				TRACE(("Returning found pages\n"));
-				TRACE(("\tstart=0x%x, end=0x%x\n",
-					c->start, c->end));
-				TRACE(("\ttype=0x%x, next=0x%x\n",
-					c->type, c->next));
-				
-				return (ptr_t)c->start;
-			}
-		}
-		++xx;
-		++i;
+		--k;
+		phys_push(z, pfn + (1 << k), k);
 	}
+	
+	z->free_pages -= 1 << order;
+	
+	// give back the pages after the first n
+	if (n < (1 << order))
+		phys_free_range(z, pfn + n, pfn + (1 << order));
+	
+	for (i = 0; i < n; i++)
+		man->frames[pfn + i].type = use_type;
+	man->frames[pfn].next = n;
+	
+	return (ptr_t)(pfn * PAGE_SIZE);
 }
 
+// free pages from phys_alloc(), changing them to to_type
 void phys_free(ptr_t p, u8_t to_type)
 {
-	TRACE(("Freeing physical memory at 0x%x, to type 0x%x\n",
-		p, to_type));
 	page_manager_t* man = sysinfo->page_manager;
-	u32_t i = 0;
-	page_cluster_t* c;
-	
-	TRACE(("First manager at 0x%x\n", man));
-	count_t xx = 0;
+	page_zone_t* z;
+	u32_t pfn = PFN(p);
+	u32_t n, i;
+	
+	assert(pfn < man->n_frames);
+	if (phys_get_zone(man->frames[pfn].type))
+		panic("Freeing free pages");
+	
+	n = man->frames[pfn].next;
+	
+	z = phys_get_zone(to_type);
+	if (z)
+		phys_free_range(z, pfn, pfn + n);
+	else
+		for (i = 0; i < n; i++)
+			man->frames[pfn + i].type = to_type;
+}
+
+// type of the page containing p
+u8_t phys_get_type(ptr_t p)
+{
+	page_manager_t* man = sysinfo->page_manager;
+	u32_t pfn = PFN(p);
 	
-	// find cluster starting at p
-	while (1)
-	{
-		// check if end of this manager
-		if (i >= 127)
-		{
-			TRACE(("End of this manager!\n"));
-			man = man->next;
-			if (!man)
-				panic("Could not find pointer to free");
-			i = 0;
-			TRACE(("Going to manager at 0x%x\n", man));
-		}
-		
-		c = &(man->clusters[i]);
-		
-		TRACE(("Loop (%d): cluster at 0x%x\n", xx, c));
-		TRACE(("\tstart=0x%x, end=0x%x\n", c->start, c->end));
-		TRACE(("\ttype=0x%x, next=0x%x\n", c->type, c->next));
-		
-		if (c->start == (iptr_t)p)
-		{
-			TRACE(("Found correct pointer, changing type and"
-				" returning\n"));
-			c->type = to_type;
-			return;
-		}
-		++xx;
-		++i;
-	}
+	if (pfn >= man->n_frames)
+		return PG_CLUSTER_UNKNOWN;
+	return man->frames[pfn].type;
 }
 
 /*
-  TODO: Validation / Compaction functions.
-	Manage a free list during alloc / free.
-	Preserve next pointer in clusters when removing a cluster.
-	Protect the lot with mutexes.
-	Test, test and test again!
+  TODO: Protect the lot with mutexes.
 	Preserve modules passed by bootloader.
 */
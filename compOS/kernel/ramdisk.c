@@ -0,0 +1,67 @@
+/*
+ ramdisk.c - block device in memory
+
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+                     (See file "Copying")
+*/
+
+#include <cosbase.h>
+
+#include <cos/debug.h>
+#include <cos/page.h>
+#include <cos/mem.h>
+#include <cos/ramdisk.h>
+
+// create a ram disk of n_sectors sectors, mode is BMODE_IMMEDIATE or
+//  BMODE_QUEUED
+block_device_t* ramdisk_create(count_t n_sectors, u32_t mode)
+{
+	block_device_t* dev = kalloc(sizeof(block_device_t));
+	size_t sz = n_sectors * RAMDISK_SECTOR_SIZE;
+	
+	memzero(dev, sizeof(block_device_t));
+	dev->fn = ramdisk_request;
+	dev->default_mode = mode;
+	dev->sector_size = RAMDISK_SECTOR_SIZE;
+	dev->n_sectors = n_sectors;
+	dev->data = phys_alloc((sz + PAGE_SIZE - 1) / PAGE_SIZE,
+			       PG_CLUSTER_IN_USE, PG_CLUSTER_FREE);
+	
+	TRACE(("Ram disk at 0x%x, %d sectors\n", dev->data, n_sectors));
+	return dev;
+}
+
+// copy the sectors of a request and all requests merged into it, this is
+//  always done at once
+fresult_t ramdisk_request(block_request_t* rq, block_device_t* dev)
+{
+	u8_t* disk = (u8_t*)dev->data;
+	
+	for (; rq; rq = rq->merged)
+	{
+		u8_t* p = disk + rq->sector * RAMDISK_SECTOR_SIZE;
+		count_t n = rq->count * RAMDISK_SECTOR_SIZE;
+		
+		if (rq->op == BOP_READ)
+			memcpy(rq->buffer, p, n);
+		else
+			memcpy(p, rq->buffer, n);
+	}
+	
+	return BRESULT_OK;
+}
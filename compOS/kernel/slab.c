@@ -0,0 +1,297 @@
+/*
+ slab.c - object caches
+
+ Part of:	COS
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+                     (See file "Copying")
+*/
+
+/*
+  Each cache hands out objects of one size from slabs of whole pages. A
+  slab is on the partial or full list of its cache, or it is the spare
+  empty slab. When a second slab becomes empty it goes back to
+  phys_alloc(), so a cache never holds more than one unused slab.
+
+  The first object of each new slab is moved along by KCACHE_COLOUR bytes,
+  using up the space left at the end of the slab, so that objects at the
+  same place in different slabs do not all fall in the same cache lines.
+*/
+
+#include <cosbase.h>
+
+#include <cos/debug.h>
+#include <cos/page.h>
+#include <cos/mem.h>
+#include <cos/slab.h>
+
+// the cache which the kcache_t structures come from
+static kcache_t cache_cache;
+
+// list of all caches
+static kcache_t* first_cache;
+
+#define ALIGN_UP(x, a)		(((x) + (a) - 1) & ~((a) - 1))
+
+#define SLAB_HEADER		ALIGN_UP(sizeof(kslab_t), KCACHE_ALIGN)
+#define SLAB_BYTES(c)		((c)->pages * PAGE_SIZE)
+#define SLAB_OF(c, obj)		((kslab_t*)((iptr_t)(obj) & \
+					    ~(SLAB_BYTES(c) - 1)))
+#define LINK(c, obj)		(*(ptr_t*)((iptr_t)(obj) + (c)->link))
+
+static void slab_list_add(kslab_t** list, kslab_t* s)
+{
+	s->prev = NULL;
+	s->next = *list;
+	if (*list)
+		(*list)->prev = s;
+	*list = s;
+}
+
+static void slab_list_remove(kslab_t** list, kslab_t* s)
+{
+	if (s->prev)
+		s->prev->next = s->next;
+	else
+		*list = s->next;
+	if (s->next)
+		s->next->prev = s->prev;
+}
+
+static void kcache_setup(kcache_t* c, cstring_t name, size_t size,
+			 kcache_fn_t ctor, kcache_fn_t dtor)
+{
+	size_t space;
+
+	memzero(c, sizeof(kcache_t));
+	c->name = name;
+	c->size = size;
+	c->ctor = ctor;
+	c->dtor = dtor;
+
+	// keep the link out of constructed objects
+	if (ctor)
+	{
+		c->link = ALIGN_UP(size, sizeof(ptr_t));
+		c->stride = c->link + sizeof(ptr_t);
+	}
+	else
+		c->stride = (size < sizeof(ptr_t)) ? sizeof(ptr_t) : size;
+	c->stride = ALIGN_UP(c->stride, KCACHE_ALIGN);
+
+	// smallest slab with room for 8 objects
+	c->pages = 1;
+	while (c->pages < KCACHE_MAX_PAGES &&
+	       (SLAB_BYTES(c) - SLAB_HEADER) / c->stride < 8)
+		c->pages <<= 1;
+
+	space = SLAB_BYTES(c) - SLAB_HEADER;
+	c->per_slab = space / c->stride;
+	if (c->per_slab == 0)
+		panic("Object too large for a slab");
+	c->colours = (space - c->per_slab * c->stride) / KCACHE_COLOUR + 1;
+
+	c->next = first_cache;
+	first_cache = c;
+}
+
+// get a new slab for a cache, with all objects free
+static kslab_t* kcache_grow(kcache_t* c)
+{
+	kslab_t* s;
+	iptr_t obj;
+	count_t i;
+
+	s = (kslab_t*)phys_alloc(c->pages, PG_CLUSTER_SLAB, PG_CLUSTER_FREE);
+	assert(!((iptr_t)s & (SLAB_BYTES(c) - 1)));
+
+	s->cache = c;
+	s->in_use = 0;
+	s->free = NULL;
+
+	obj = (iptr_t)s + SLAB_HEADER + c->colour_next * KCACHE_COLOUR;
+	if (++c->colour_next >= c->colours)
+		c->colour_next = 0;
+
+	// link the objects in address order
+	for (i = c->per_slab - 1; i >= 0; i--)
+	{
+		ptr_t o = (ptr_t)(obj + i * c->stride);
+
+		if (c->ctor)
+			c->ctor(o);
+		LINK(c, o) = s->free;
+		s->free = o;
+	}
+
+	++c->stats.slabs;
+	++c->stats.grows;
+
+	TRACE(("Cache %s: new slab at 0x%x\n", c->name, s));
+	return s;
+}
+
+// give an empty slab back
+static void kcache_release(kcache_t* c, kslab_t* s)
+{
+	ptr_t o, next;
+
+	assert(!s->in_use);
+	TRACE(("Cache %s: releasing slab at 0x%x\n", c->name, s));
+
+	if (c->dtor)
+		for (o = s->free; o; o = next)
+		{
+			next = LINK(c, o);
+			c->dtor(o);
+		}
+
+	phys_free(s, PG_CLUSTER_FREE);
+
+	--c->stats.slabs;
+	++c->stats.shrinks;
+}
+
+void kcache_init()
+{
+	TRACE(("Initialising object caches...\n"));
+	kcache_setup(&cache_cache, "kcache", sizeof(kcache_t), NULL, NULL);
+}
+
+// create a cache for objects of size bytes. ctor is called for each
+//  object when its slab is created and dtor when the slab is given back,
+//  objects must be in their constructed state when they are freed.
+kcache_t* kcache_create(cstring_t name, size_t size, kcache_fn_t ctor,
+			kcache_fn_t dtor)
+{
+	kcache_t* c = kcache_alloc(&cache_cache);
+
+	kcache_setup(c, name, size, ctor, dtor);
+
+	TRACE(("Cache %s: size %d, stride %d, %d per %d page slab\n", name,
+		size, c->stride, c->per_slab, c->pages));
+	return c;
+}
+
+// destroy a cache, all objects must have been freed
+void kcache_destroy(kcache_t* cache)
+{
+	kcache_t** p = &first_cache;
+
+	assert(cache != &cache_cache);
+	if (cache->stats.active)
+		panic("Destroying a cache which is in use");
+
+	kcache_shrink(cache);
+
+	while (*p != cache)
+		p = &((*p)->next);
+	*p = cache->next;
+
+	kcache_free(&cache_cache, cache);
+}
+
+ptr_t kcache_alloc(kcache_t* cache)
+{
+	kslab_t* s = cache->partial;
+	ptr_t obj;
+
+	if (!s)
+	{
+		s = cache->empty;
+		if (s)
+			cache->empty = NULL;
+		else
+			s = kcache_grow(cache);
+		slab_list_add(&cache->partial, s);
+	}
+
+	obj = s->free;
+	s->free = LINK(cache, obj);
+	++s->in_use;
+
+	if (!s->free)
+	{
+		slab_list_remove(&cache->partial, s);
+		slab_list_add(&cache->full, s);
+	}
+
+	++cache->stats.allocs;
+	++cache->stats.active;
+
+	return obj;
+}
+
+void kcache_free(kcache_t* cache, ptr_t obj)
+{
+	kslab_t* s = SLAB_OF(cache, obj);
+
+	assert(s->cache == cache);
+	assert(s->in_use > 0);
+
+	if (!s->free)
+	{
+		slab_list_remove(&cache->full, s);
+		slab_list_add(&cache->partial, s);
+	}
+
+	LINK(cache, obj) = s->free;
+	s->free = obj;
+	--s->in_use;
+
+	if (!s->in_use)
+	{
+		slab_list_remove(&cache->partial, s);
+		if (!cache->empty)
+			cache->empty = s;
+		else
+			kcache_release(cache, s);
+	}
+
+	++cache->stats.frees;
+	--cache->stats.active;
+}
+
+// give the spare slab back
+void kcache_shrink(kcache_t* cache)
+{
+	if (cache->empty)
+	{
+		kcache_release(cache, cache->empty);
+		cache->empty = NULL;
+	}
+}
+
+void kcache_dump(kcache_t* cache)
+{
+	kcache_stats_t* st = &(cache->stats);
+
+	TRACE(("Cache %s at 0x%x: size %d, stride %d, %d per %d page slab\n",
+		cache->name, cache, cache->size, cache->stride,
+		cache->per_slab, cache->pages));
+	TRACE(("\tallocs=%d, frees=%d, active=%d\n", st->allocs, st->frees,
+		st->active));
+	TRACE(("\tslabs=%d, grows=%d, shrinks=%d\n", st->slabs, st->grows,
+		st->shrinks));
+}
+
+void kcache_dump_all()
+{
+	kcache_t* c;
+
+	for (c = first_cache; c; c = c->next)
+		kcache_dump(c);
+}
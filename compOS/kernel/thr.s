@@ -42,6 +42,7 @@
 %include "defs.inc"
 
 GLOBAL Get_EFLAGS
+GLOBAL Has_CPUID
 GLOBAL Get_ESP
 GLOBAL test_and_set
 GLOBAL test_and_set_r
@@ -77,6 +78,24 @@ Get_EFLAGS:
 	pop	eax		; pop contents into eax
 	ret
 
+; Return non-zero if the processor has cpuid, that is if the ID flag
+;	(bit 21) of eflags can be changed.
+align 16
+Has_CPUID:
+	pushfd			; push eflags
+	pop	eax
+	mov	ecx, eax
+	xor	eax, 1 << 21	; try to flip ID
+	push	eax
+	popfd
+	pushfd
+	pop	eax
+	push	ecx		; put back the original eflags
+	popfd
+	xor	eax, ecx
+	and	eax, 1 << 21
+	ret
+
 ; test and set a 32-bit value, this first bit is callable from C as
 ;	int test_and_set(int value, int* dest);
 ;
@@ -44,8 +44,14 @@ extern u32_t Get_EFLAGS();
 // pointer to the current thread
 static kthread_t* volatile pThisThread;
 
-// queue of runnable threads
-static thread_queue_t tqRun;
+// queues of runnable threads, one for each priority
+static thread_queue_t tqRun[THREAD_PRIORITIES];
+
+// bit n is set if tqRun[n] is not empty
+static u32_t uRunMask;
+
+#define RUN_QUEUE(thr)	(&tqRun[(thr)->priority])
+#define IS_RUN_QUEUE(q)	((q) >= tqRun && (q) < tqRun + THREAD_PRIORITIES)
 
 // defined in int.s, fake return address for creating a thread
 extern char FakeReturnAddr;
@@ -55,54 +61,66 @@ extern char FakeReturnAddr;
 
 bool_t thread_queue_empty(thread_queue_t* tq)
 {
-	thread_node_t* p = tq->head;
-	return (p && p->thread);
+	return (tq->head == NULL);
 }
 
 void thread_queue_dump(thread_queue_t* tq)
 {
-	thread_node_t* p = tq->head;
-	TRACE(("thread_queue_dump %x Head=%x\n", tq, p));
+	kthread_t* p = tq->head;
+	TRACE(("thread_queue_dump %x Head=%x Tail=%x\n", tq, p, tq->tail));
 	
 	while (p)
 	{
-		TRACE(("Node %x : thread=%x, next=%x\n", p, p->thread, p->next));
-		p = p->next;
+		TRACE(("Thread %x : next=%x, prev=%x\n", p, p->q_next, p->q_prev));
+		p = p->q_next;
 	}
 }
 
+// take a thread off the queue it is on
+void thread_queue_remove(thread_queue_t* tq, kthread_t* thr)
+{
+	if (thr->q_prev)
+		thr->q_prev->q_next = thr->q_next;
+	else
+		tq->head = thr->q_next;
+	
+	if (thr->q_next)
+		thr->q_next->q_prev = thr->q_prev;
+	else
+		tq->tail = thr->q_prev;
+	
+	thr->q_next = thr->q_prev = NULL;
+	
+	if (!tq->head && IS_RUN_QUEUE(tq))
+		uRunMask &= ~(1 << (tq - tqRun));
+}
+
 kthread_t* thread_queue_head(thread_queue_t* tq)
 {
-	thread_node_t* p = tq->head;
-	if (!p)
+	kthread_t* thr = tq->head;
+	if (!thr)
 		return pThisThread;
 	
-	tq->head = p->next;	// detach the node
-	kthread_t* thr = p->thread;
-	kfree(p);
+	thread_queue_remove(tq, thr);
 	return thr;
 }
 
+// put a thread at the end of its queue
 void queue_thread(kthread_t* thr)
 {
 	thread_queue_t* q = thr->queue;
 	TRACE(("QueueThread %x in %x\n", thr, q));
-	if (!(q->head))
-	{
-		q->head = kalloc(sizeof(thread_node_t));
-		q->head->thread = thr;
-		q->head->next = NULL;
-		return;
-	}
 	
-	thread_node_t* p = q->head;
-	while (p->next)
-		p = p->next;	// find end of queue
-
-	// last node will have a thread
-	p->next = kalloc(sizeof(thread_node_t));
-	p->next->thread = thr;
-	p->next->next = NULL;
+	thr->q_next = NULL;
+	thr->q_prev = q->tail;
+	if (q->tail)
+		q->tail->q_next = thr;
+	else
+		q->head = thr;
+	q->tail = thr;
+	
+	if (IS_RUN_QUEUE(q))
+		uRunMask |= 1 << (q - tqRun);
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -113,9 +131,18 @@ void queue_thread(kthread_t* thr)
 //	currently we only deal with Yield() so this is true
 kthread_t* do_sched()
 {
-	thread_queue_dump(&tqRun);
-	// assume we always have a runnable thread, for now
-	kthread_t* thr = thread_queue_head(&tqRun);
+	u32_t prio = THREAD_PRIORITIES - 1;
+	kthread_t* thr;
+	
+	// keep running the current thread if nothing else can run
+	if (!uRunMask)
+		return pThisThread;
+	
+	// highest priority with a runnable thread
+	while (!(uRunMask & (1 << prio)))
+		--prio;
+	
+	thr = thread_queue_head(&tqRun[prio]);
 	
 	TRACE(("Schedule, thr=%x esp=%x\n", thr, thr->esp));
 	pThisThread = thr;
@@ -168,7 +195,9 @@ void thread_init()
 	pThisThread->parent = pThisThread->next = pThisThread->child = NULL;
 			// no parent or child, no other threads allowed at this level
 	
-	pThisThread->queue = &tqRun;
+	pThisThread->q_next = pThisThread->q_prev = NULL;
+	pThisThread->priority = PRIORITY_NORMAL;
+	pThisThread->queue = RUN_QUEUE(pThisThread);
 	
 	install_handler(0x50, &Schedule);
 	
@@ -207,12 +236,38 @@ kthread_t* spawn_thread(thread_function_t fn)
 	thr->next = thr->child = NULL;
 	add_child_thread(thr);
 	
-	thr->queue = &tqRun;
+	thr->priority = pThisThread->priority;
+	thr->queue = RUN_QUEUE(thr);
 	queue_thread(thr);
 	
 	return thr;
 }
 
+// change the priority of a thread, a runnable thread goes to the end of
+//  the run queue of its new priority
+void set_priority(kthread_t* thr, u32_t priority)
+{
+	assert(priority < THREAD_PRIORITIES);
+	TRACE(("Thread %x priority %d -> %d\n", thr, thr->priority, priority));
+	
+	// a waiting thread gets its new run queue when it is woken
+	if (!IS_RUN_QUEUE(thr->queue))
+	{
+		thr->priority = priority;
+		return;
+	}
+	
+	// the current thread is not on its run queue
+	if (thr != pThisThread)
+		thread_queue_remove(thr->queue, thr);
+	
+	thr->priority = priority;
+	thr->queue = RUN_QUEUE(thr);
+	
+	if (thr != pThisThread)
+		queue_thread(thr);
+}
+
 // wait on a given thread queue
 void wait(thread_queue_t* tq)
 {
@@ -232,7 +287,7 @@ count_t wake_one(thread_queue_t* tq)
 	if (thr != pThisThread)
 	{
 		TRACE(("Waking thread %x from queue %x\n", thr, tq));
-		thr->queue = &tqRun;
+		thr->queue = RUN_QUEUE(thr);
 		queue_thread(thr);
 		return 1;
 	}
@@ -253,7 +308,7 @@ count_t wake_all(thread_queue_t* tq)
 	{
 		thr = thread_queue_head(tq);
 		TRACE(("\tWaking Thread %x\n", thr));
-		thr->queue = &tqRun;
+		thr->queue = RUN_QUEUE(thr);
 		queue_thread(thr);
 		i++;
 	}
@@ -300,7 +355,7 @@ void minit(mutex_t* m)
 	assert_ptr(m);
 	m->state = MUTEX_UNLOCKED;
 	m->owner = NULL;
-	m->queue.head = NULL;
+	m->queue.head = m->queue.tail = NULL;
 }
 
 /*
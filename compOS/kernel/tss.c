@@ -36,7 +36,7 @@
 void tss_init()
 {
 	TRACE(("Initialising TSS...\n"));
-	memset(sysinfo->tss_seg, 0, 4096);
+	memzero_page(sysinfo->tss_seg);
 	
 	// values taken from GeekOS
 	u8_t entry = gdt_add(0x09, // 1001b: 32 bit, !busy
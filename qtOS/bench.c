@@ -0,0 +1,75 @@
+/****************************************************************************************/
+/* qtOS dispatch benchmark:                                                             */
+/* - Runs 10, 100 and 1000 step tasks in 4 priority levels and measures the number of   */
+/*   dispatches per second.                                                             */
+/* Build on Linux with:                                                                 */
+/*   gcc -O2 -DqtOS_MAXPROC=1000 bench.c qtos_basic.c -o bench                          */
+/****************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "qtos_basic.h"
+
+#define BENCH_DISPATCHES 2000000
+#define BENCH_PRIORITIES 4
+
+/* Shared memory: */
+
+int BenchSteps;                 /* steps of each task before it joins */
+int BenchCount[ qtOS_MAXPROC ]; /* steps done by each task */
+
+/* Task functions: */
+
+int bench_init()
+{
+  BenchCount[qtOS_self_PID()] = 0;
+  return 0;
+} /* bench_init */
+
+int bench_step()
+{
+  int failure, pid;
+
+  failure = 0;
+  pid = qtOS_self_PID();
+  BenchCount[pid] = BenchCount[pid] + 1;
+  if( BenchCount[pid] == BenchSteps ) {
+    failure = qtOS_join();
+  } /* if */
+  return failure;
+} /* bench_step */
+
+/* **************************************************************************************/
+
+int main()
+{
+  int sizes[] = { 10, 100, 1000 };
+  int failure = 0;
+  int i, n, s;
+  char name[16];
+  struct timespec t0, t1;
+  double seconds;
+
+  for( s = 0; s < 3 && failure == 0; s = s + 1 ) {
+    n = sizes[s];
+    if( n > qtOS_MAXPROC ) {
+      printf( "bench: qtOS_MAXPROC is %d, build with -DqtOS_MAXPROC=%d\n", qtOS_MAXPROC, n );
+      break;
+    } /* if */
+    BenchSteps = BENCH_DISPATCHES / n;
+    qtOS_init();
+    for( i = 0; i < n; i = i + 1 ) {
+      sprintf( name, "t%d", i );
+      qtOS_new_task( name, i % BENCH_PRIORITIES, bench_init, bench_step );
+      qtOS_fork( name );
+    } /* for */
+    clock_gettime( CLOCK_MONOTONIC, &t0 );
+    failure = qtOS_run();
+    clock_gettime( CLOCK_MONOTONIC, &t1 );
+    seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    printf( "bench: %4d tasks, %10.0f dispatches per second\n",
+            n, (double)BenchSteps * n / seconds );
+  } /* for */
+  return failure;
+} /* main */
@@ -21,7 +21,7 @@ char *qtOS_err_tbl[] = {
   /* 09 */ "Cannot fork an already active task!",
   /* 10 */ "Cannot call an already active task!",
   /* 11 */ "Cannot call a second task!",
-  /* 12 */ "Undefined error",
+  /* 12 */ "Priority out of range!",
   /* 13 */ "Undefined error",
   /* 14 */ "Undefined error",
   /* 15 */ "Software error, join() called from some non-running process!",
@@ -35,9 +35,16 @@ qtOS_control_block_t qtOS;
 
 int qtOS_init( )
 {
+  int p;
+
   qtOS.error = 0;
   qtOS.tasks.length = 0;
-  qtOS.processes.length = 0;
+  qtOS.running = -1;
+  qtOS.active = 0;
+  qtOS.ready.map = 0;
+  for( p = 0; p < qtOS_MAXPRI; p = p + 1 ) {
+    qtOS.ready.head[p] = -1;
+  } /* for */
   qtOS.policy = qtOS_PREEMPTIVE;
   printf( "qtOS ready.\n" );
   return 0;
@@ -55,7 +62,10 @@ int qtOS_new_task( char name[], int priority, int (* init)(), int (* step)() )
 
   failure = 0;
   index = qtOS.tasks.length;
-  if( index < qtOS_MAXPROC ) {
+  if( priority < 0 || priority >= qtOS_MAXPRI ) {
+    qtOS.error = 12; /* Priority out of range! */
+    failure = -1;
+  } else if( index < qtOS_MAXPROC ) {
     qtOS.tasks.task[index].name = (char *)strdup( name );
     qtOS.tasks.task[index].status = qtOS_IDLE;
     qtOS.tasks.task[index].parent = -1;
@@ -63,13 +73,14 @@ int qtOS_new_task( char name[], int priority, int (* init)(), int (* step)() )
     qtOS.tasks.task[index].callee = -1;
     qtOS.tasks.task[index].priority = priority;
     qtOS.tasks.task[index].xpri = priority;
-    qtOS.tasks.task[index].baton = 0;
+    qtOS.tasks.task[index].next = -1;
+    qtOS.tasks.task[index].prev = -1;
     qtOS.tasks.task[index].init = init;
     qtOS.tasks.task[index].step = step;
-    backup = qtOS.processes.PID[0]; /* to make qtOS_self_*() work... */
-    qtOS.processes.PID[0] = index;  /* ... during init() execution.  */
+    backup = qtOS.running; /* to make qtOS_self_*() work... */
+    qtOS.running = index;  /* ... during init() execution.  */
     failure = qtOS.tasks.task[index].init();
-    qtOS.processes.PID[0] = backup;
+    qtOS.running = backup;
     if( failure ) {
       qtOS.error = 5; /* Failed to execute task init()! */
     } else {
@@ -84,7 +95,7 @@ int qtOS_new_task( char name[], int priority, int (* init)(), int (* step)() )
 
 int qtOS_self_PID()
 {
-  return qtOS.processes.PID[0];
+  return qtOS.running;
 } /* qtOS_self_PID */
 
 char *qtOS_self_name()
@@ -102,7 +113,7 @@ int qtOS_can_work( )
 {
   int can;
   can = -1;
-  if( qtOS.error != 0 || qtOS.processes.length == 0 ) { can = 0; }
+  if( qtOS.error != 0 || qtOS.active == 0 ) { can = 0; }
   return can;
 } /* qtOS_can_work */
 
@@ -119,16 +130,78 @@ int qtOS_lookup( char name[] )
   return index;
 } /* qtOS_lookup */
 
+int qtOS_ready_insert( int itask )
+{
+  int p, head, tail;
+
+  /* Append the task at the end of the ring of its priority */
+  p = qtOS.tasks.task[itask].xpri;
+  head = qtOS.ready.head[p];
+  if( head < 0 ) {
+    qtOS.tasks.task[itask].next = itask;
+    qtOS.tasks.task[itask].prev = itask;
+    qtOS.ready.head[p] = itask;
+    qtOS.ready.map = qtOS.ready.map | (1UL << p);
+  } else {
+    tail = qtOS.tasks.task[head].prev;
+    qtOS.tasks.task[itask].next = head;
+    qtOS.tasks.task[itask].prev = tail;
+    qtOS.tasks.task[tail].next = itask;
+    qtOS.tasks.task[head].prev = itask;
+  } /* if */
+  return 0;
+} /* qtOS_ready_insert */
+
+int qtOS_ready_remove( int itask )
+{
+  int p, next, prev;
+
+  p = qtOS.tasks.task[itask].xpri;
+  next = qtOS.tasks.task[itask].next;
+  prev = qtOS.tasks.task[itask].prev;
+  if( next == itask ) { /* it was the only one of its priority */
+    qtOS.ready.head[p] = -1;
+    qtOS.ready.map = qtOS.ready.map & ~(1UL << p);
+  } else {
+    qtOS.tasks.task[prev].next = next;
+    qtOS.tasks.task[next].prev = prev;
+    if( qtOS.ready.head[p] == itask ) { qtOS.ready.head[p] = next; }
+  } /* if */
+  qtOS.tasks.task[itask].next = -1;
+  qtOS.tasks.task[itask].prev = -1;
+  return 0;
+} /* qtOS_ready_remove */
+
+int qtOS_ready_first( )
+{
+  unsigned long map;
+  int p;
+
+  /* Highest priority is the lowest bit set in the ready map */
+  map = qtOS.ready.map;
+  if( map == 0 ) {
+    p = -1;
+  } else {
+#if defined( __GNUC__ )
+    p = __builtin_ctzl( map );
+#else
+    p = 0;
+    while( (map & 0xFUL) == 0 ) { map = map >> 4; p = p + 4; }
+    while( (map & 1UL) == 0 ) { map = map >> 1; p = p + 1; }
+#endif
+  } /* if */
+  return p;
+} /* qtOS_ready_first */
+
 int qtOS_call( char name[] )
 {
   int index, failure, curr;
 
   failure = 0;
-  if( qtOS.processes.length > 0 ) {
-    curr = qtOS.processes.PID[0];
+  curr = qtOS.running;
+  if( curr >= 0 ) {
     if( qtOS.tasks.task[curr].status == qtOS_RUNNING ) {
       qtOS.tasks.task[curr].status = qtOS_BLOCKED;
-      qtOS.tasks.task[curr].baton = 0;
     } else {
       if( qtOS.tasks.task[curr].status == qtOS_BLOCKED && qtOS.tasks.task[curr].callee >= 0 ) {
         qtOS.error = 11; /* Cannot call a second task! */
@@ -137,8 +210,6 @@ int qtOS_call( char name[] )
         curr = -1; /* There is no process running, must be qtOS */
       } /* if */
     } /* if */
-  } else {
-    curr = -1; /* There is no process running, must be qtOS */
   } /* if */
   if( failure == 0 ) {
     index = qtOS_lookup( name );
@@ -161,9 +232,9 @@ int qtOS_call( char name[] )
           qtOS.tasks.task[index].xpri = qtOS.tasks.task[curr].xpri;
         } /* if */
       } /* if */
-      /* Add new process to active processes' list */
-      qtOS.processes.PID[qtOS.processes.length] = index;
-      qtOS.processes.length = qtOS.processes.length + 1;
+      /* Add new process to the ready ring of its execution priority */
+      qtOS_ready_insert( index );
+      qtOS.active = qtOS.active + 1;
       failure = 0;
     } else { /* The task is active and cannot have the same instance running twice */
       qtOS.error = 10; /* Cannot call an already active task! */
@@ -175,32 +246,24 @@ int qtOS_call( char name[] )
 
 int qtOS_return( )
 {
-  int index, top;
+  int index, caller;
   int failure;
 
-  if( qtOS.processes.length > 0 ) {
-    index = qtOS.processes.PID[0];
+  index = qtOS.running;
+  if( qtOS.active > 0 && index >= 0 ) {
     if( qtOS.tasks.task[index].status == qtOS_RUNNING ) {
       qtOS.tasks.task[index].status = qtOS_IDLE;
       qtOS.tasks.task[index].xpri = qtOS.tasks.task[index].priority;
-      qtOS.tasks.task[index].baton = 0;
-      if( qtOS.tasks.task[index].caller >= 0 ) {
-        qtOS.tasks.task[qtOS.tasks.task[index].caller].status = qtOS_READY;
+      caller = qtOS.tasks.task[index].caller;
+      if( caller >= 0 ) {
+        qtOS.tasks.task[caller].status = qtOS_READY;
+        qtOS_ready_insert( caller );
         qtOS.tasks.task[index].caller = -1;
       } /* if */
-      index = 0;
-      top = qtOS.processes.length - 1;
-      while( index < top ) {
-        qtOS.processes.PID[index] = qtOS.processes.PID[index + 1];
-        index = index + 1;
-      } /* while */
+      qtOS.active = qtOS.active - 1;
       failure = 0;
-      if( index > 0 ) {
-        qtOS.processes.length = top;
-      } else { /* Last active process deallocated! */
-        qtOS.processes.length = 0;
+      if( qtOS.active == 0 ) { /* Last active process deallocated! */
         qtOS.error = 0;
-        failure = 0;
       } /* if */
     } else {
       qtOS.error = 18; /* Software error, qtOS cannot return */
@@ -219,12 +282,8 @@ int qtOS_fork( char name[] )
   int index, failure, curr;
 
   failure = 0;
-  if( qtOS.processes.length > 0 ) {
-    curr = qtOS.processes.PID[0];
-    if( qtOS.tasks.task[curr].status != qtOS_RUNNING ) {
-      curr = -1; /* There is no process running, must be qtOS */
-    } /* if */
-  } else {
+  curr = qtOS.running;
+  if( curr >= 0 && qtOS.tasks.task[curr].status != qtOS_RUNNING ) {
     curr = -1; /* There is no process running, must be qtOS */
   } /* if */
   index = qtOS_lookup( name );
@@ -236,9 +295,9 @@ int qtOS_fork( char name[] )
       qtOS.tasks.task[index].status = qtOS_READY;
       /* Mark current process / qtOS as the parent process */
       qtOS.tasks.task[index].parent = curr;
-      /* Add new process to active processes' list */
-      qtOS.processes.PID[qtOS.processes.length] = index;
-      qtOS.processes.length = qtOS.processes.length + 1;
+      /* Add new process to the ready ring of its priority */
+      qtOS_ready_insert( index );
+      qtOS.active = qtOS.active + 1;
       failure = 0;
     } else { /* The task is active and cannot have the same instance running twice */
       qtOS.error = 9; /* Cannot fork an already active task! */
@@ -250,32 +309,22 @@ int qtOS_fork( char name[] )
 
 int qtOS_join( )
 {
-  int index, top;
+  int index;
   int failure;
 
-  if( qtOS.processes.length > 0 ) {
-    index = qtOS.processes.PID[0];
+  index = qtOS.running;
+  if( qtOS.active > 0 && index >= 0 ) {
     if( qtOS.tasks.task[index].status == qtOS_RUNNING ) {
       qtOS.tasks.task[index].status = qtOS_IDLE;
       qtOS.tasks.task[index].xpri = qtOS.tasks.task[index].priority;
-      qtOS.tasks.task[index].baton = 0;
       if( qtOS.tasks.task[index].parent >= 0 ) {
         /* Should the son send some signal to the parent, must be coded here */
         qtOS.tasks.task[index].parent = -1;
       } /* if */
-      index = 0;
-      top = qtOS.processes.length - 1;
-      while( index < top ) {
-        qtOS.processes.PID[index] = qtOS.processes.PID[index + 1];
-        index = index + 1;
-      } /* while */
+      qtOS.active = qtOS.active - 1;
       failure = 0;
-      if( index > 0 ) {
-        qtOS.processes.length = top;
-      } else { /* Last active process deallocated! */
-        qtOS.processes.length = 0;
+      if( qtOS.active == 0 ) { /* Last active process deallocated! */
         qtOS.error = 0;
-        failure = 0;
       } /* if */
     } else {
       qtOS.error = 15; /* Software error, join() called from some non-running process */
@@ -288,97 +337,34 @@ int qtOS_join( )
   return failure;
 } /* qtOS_join */
 
-int qtOS_cmp( int itask, int jtask )
-{
-  int istat, jstat, sign;
-
-  istat = 0;
-  switch( qtOS.tasks.task[itask].status ) {
-    case qtOS_BLOCKED: istat = istat + 1;
-    case qtOS_READY:   istat = istat + 1;
-    default:           ;
-  } /* switch */
-  jstat = 0;
-  switch( qtOS.tasks.task[jtask].status ) {
-    case qtOS_BLOCKED: jstat = jstat + 1;
-    case qtOS_READY:   jstat = jstat + 1;
-    default:           ;
-  } /* switch */
-  sign = istat - jstat;
-  if( sign == 0 ) {
-    sign = qtOS.tasks.task[itask].xpri - qtOS.tasks.task[jtask].xpri;
-  } /* if */
-  if( sign == 0 ) {
-    sign = qtOS.tasks.task[itask].baton - qtOS.tasks.task[jtask].baton;
-  } /* if */
-  return sign;
-} /* qtOS_cmp */
-
 int qtOS_schedule( )
 {
-  int max, i, j, itask, jtask, found, same, failure;
-
-  max = qtOS.processes.length;
-  if( max > 0 ) {
-    itask = qtOS.processes.PID[0];
-    if( qtOS.tasks.task[itask].status == qtOS_RUNNING ) {
-      qtOS.tasks.task[itask].baton = 1;
-      if( qtOS.policy == qtOS_PREEMPTIVE ) {
-        qtOS.tasks.task[itask].status = qtOS_READY;
-      } /* if */
-    } /* if */
+  int itask, p, failure;
+
+  failure = 0;
+  itask = qtOS.running;
+  if( itask >= 0 && qtOS.tasks.task[itask].status == qtOS_RUNNING &&
+      qtOS.policy == qtOS_PREEMPTIVE
+     ) {
+    /* Running task goes behind the ready tasks of the same priority */
+    qtOS.tasks.task[itask].status = qtOS_READY;
+    qtOS_ready_insert( itask );
   } /* if */
-  /* Sort active processes */
-  i = 1;
-  while( i < max ) { /* linear insertion sort */
-    itask = qtOS.processes.PID[i];
-    j = i - 1;
-    found = 0;
-    while( j >= 0 && found==0 ) {
-      if( qtOS_cmp( itask, qtOS.processes.PID[j] ) < 0 ) {
-        qtOS.processes.PID[j+1] = qtOS.processes.PID[j];
-        j = j - 1;
-      } else {
-        found = 1;
-      } /* if */
-    } /* while */
-    if( found > 0 ) {
-      qtOS.processes.PID[j+1] = itask;
-    } else {
-      qtOS.processes.PID[0] = itask;
-    } /* if */
-    i = i + 1;
-  } /* while */
-  if( max > 0 ) {
-    itask = qtOS.processes.PID[0];
-    if( qtOS.tasks.task[itask].status == qtOS_BLOCKED ) {
-      qtOS.error = 3;  /* All tasks are blocked! */
-      failure = -1;
-    } else {
+  if( itask < 0 || qtOS.tasks.task[itask].status != qtOS_RUNNING ) {
+    p = qtOS_ready_first();
+    if( p >= 0 ) {
+      itask = qtOS.ready.head[p];
+      qtOS_ready_remove( itask );
       qtOS.tasks.task[itask].status = qtOS_RUNNING;
-      j = 1;     /* look for task with baton within same priority block ... */
-      found = 0; /* ... than the first one. */
-      same = 1;
-      while( j < max && same > 0 && found == 0 ) {
-        jtask = qtOS.processes.PID[j];
-        if( qtOS.tasks.task[jtask].status == qtOS_READY &&
-            qtOS.tasks.task[itask].xpri == qtOS.tasks.task[jtask].xpri
-           ) {
-          if( qtOS.tasks.task[jtask].baton > 0 ) {
-            qtOS.tasks.task[jtask].baton = 0;
-            found = 1;
-          } else {
-            j = j + 1;
-          } /* if */
-        } else {
-          same = 0; /* end of block of processes with same priority */
-        } /* if */
-      } /* while */
-      failure = 0;
+      qtOS.running = itask;
+    } else {
+      if( qtOS.active > 0 ) {
+        qtOS.error = 3;  /* All tasks are blocked! */
+        failure = -1;
+      } else { /* There are no processes to schedule! */
+        qtOS.error = 0;
+      } /* if */
     } /* if */
-  } else { /* There are no processes to schedule! */
-    qtOS.error = 0;
-    failure = 0;
   } /* if */
   return failure;
 } /* qtOS_schedule */
@@ -387,8 +373,8 @@ int qtOS_dispatch( )
 {
   int index, failure;
 
-  index = qtOS.processes.PID[0];
-  if( qtOS.tasks.task[index].status == qtOS_RUNNING ) {
+  index = qtOS.running;
+  if( index >= 0 && qtOS.tasks.task[index].status == qtOS_RUNNING ) {
     failure = qtOS.tasks.task[index].step();
   } else {
     qtOS.error = 17;  /* Software error, no process to dispatch! */
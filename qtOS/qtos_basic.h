@@ -23,7 +23,8 @@ typedef struct qtOS_PCB_s {
   qtOS_process_status_t status;
   int priority;
   int xpri;
-  int baton;
+  int next; /* ready ring of the same xpri */
+  int prev;
   int parent;
   int caller;
   int callee;
@@ -31,17 +32,21 @@ typedef struct qtOS_PCB_s {
   int (* step)();
 } qtOS_PCB_t;
 
+#ifndef qtOS_MAXPROC
 #define qtOS_MAXPROC 16
+#endif
+
+#define qtOS_MAXPRI 32 /* priorities 0 (highest) to 31, one bit each in the ready map */
 
 typedef struct qtOS_task_list_s {
   qtOS_PCB_t task[ qtOS_MAXPROC ];
   int        length;
 } qtOS_task_list_t;
 
-typedef struct qtOS_PID_list_s {
-  int PID[ qtOS_MAXPROC ];
-  int length;
-} qtOS_PID_list_t;
+typedef struct qtOS_ready_list_s {
+  int           head[ qtOS_MAXPRI ]; /* next process to run of each priority, -1 if none */
+  unsigned long map;                 /* bit p is set when head[p] is not empty */
+} qtOS_ready_list_t;
 
 typedef enum qtOS_policy_e {
   qtOS_NON_PREEMPTIVE, /* default */
@@ -49,9 +54,11 @@ typedef enum qtOS_policy_e {
 } qtOS_policy_t;
 
 typedef struct qtOS_control_block_s {
-  qtOS_task_list_t tasks;
-  qtOS_PID_list_t  processes; /* indices of the previous list */
-  qtOS_policy_t    policy;
+  qtOS_task_list_t  tasks;
+  qtOS_ready_list_t ready;   /* indices of READY tasks, by priority */
+  int               running; /* index of the RUNNING task, -1 for qtOS */
+  int               active;  /* number of READY, RUNNING and BLOCKED tasks */
+  qtOS_policy_t     policy;
   int              error;
 } qtOS_control_block_t;
 
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <usmartx.h>
+
+/* Timer benchmark for the Linux host. Measures the cost of starting, re-starting and stopping
+ * software timers and of expiring them from uSMARTX_Tick() or from the timer task.
+ */
+
+#define MAX_TIMERS		4000
+#define MAX_TIMEOUT		10000
+#define EXPIRE_TIMEOUT	1000
+
+TSK_CREATE(TMR_tcb);
+
+task_entry_t tsk_tbl[] = {	{&TMR_Task, &TMR_tcb, 0, "TIMER"},
+							{0, 0}
+							};
+
+tic_t timers[MAX_TIMERS];
+uint16 expected[MAX_TIMERS];
+uint32 fired;
+uint32 errors;
+
+STATUS TimeoutHandler(uint8 Event, void *pArg1, void *pArg2) {
+	tic_t *ptic = (tic_t*) pArg1;
+	
+	/* The timer must expire exactly at the tick it was started for */
+	if( (uint16) TMR_GetTicks() != expected[ptic - timers] )
+		errors++;
+	fired++;
+	return SYS_OK;
+}
+
+double Now(void) {
+	struct timespec ts;
+	
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void RunScheduler(void) {
+	while( uSMARTX_Scheduler() != SYS_IDLE )
+		;
+}
+
+void StartTimers(int n, uint16 maxTout, uint8 mode) {
+	int i;
+	uint16 tout;
+	
+	for(i = 0; i < n; i++) {
+		tout = 1 + rand() % maxTout;
+		expected[i] = (uint16) TMR_GetTicks() + tout;
+		TMR_Start(&timers[i], tout, &TimeoutHandler, 0, &timers[i], 0, mode);
+	}
+}
+
+double Expire(int n, uint8 mode) {
+	double t;
+	int i;
+	
+	fired = 0;
+	StartTimers(n, EXPIRE_TIMEOUT, mode);
+	t = Now();
+	for(i = 0; i < EXPIRE_TIMEOUT; i++) {
+		uSMARTX_Tick();
+		RunScheduler();
+	}
+	t = Now() - t;
+	
+	if( fired != n )
+		errors++;
+	return t / n;
+}
+
+int main(void) {
+	static const int counts[] = { 10, 100, 1000, MAX_TIMERS };
+	double t, tStart, tReStart, tStop, tExpire, tDeferred;
+	int i, c, n;
+	
+	uSMARTX_Init(tsk_tbl);
+	RunScheduler();
+	srand(1);
+	
+	/* Touch all timers once, so the first measurement doesn't count page faults */
+	StartTimers(MAX_TIMERS, MAX_TIMEOUT, TMR_ONE_SHOT);
+	for(i = 0; i < MAX_TIMERS; i++)
+		TMR_Stop(&timers[i]);
+	
+	printf("timers   start  re-start    stop  expire  deferred   [ns per timer]\n");
+	for(c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+		n = counts[c];
+		
+		t = Now();
+		StartTimers(n, MAX_TIMEOUT, TMR_ONE_SHOT);
+		tStart = (Now() - t) / n;
+		
+		t = Now();
+		StartTimers(n, MAX_TIMEOUT, TMR_ONE_SHOT);
+		tReStart = (Now() - t) / n;
+		
+		t = Now();
+		for(i = 0; i < n; i++)
+			TMR_Stop(&timers[i]);
+		tStop = (Now() - t) / n;
+		
+		tExpire = Expire(n, TMR_ONE_SHOT);
+		tDeferred = Expire(n, TMR_ONE_SHOT | TMR_DEFERRED);
+		
+		printf("%6d %7.1f %9.1f %7.1f %7.1f %9.1f\n", n, tStart, tReStart, tStop, tExpire, tDeferred);
+	}
+	
+	if( errors )
+		printf("%lu timers expired at the wrong tick\n", errors);
+	return errors ? 1 : 0;
+}
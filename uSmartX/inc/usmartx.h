@@ -177,18 +177,40 @@ typedef struct buf_s {
  *	The timer won't be restarted automaticaly.
  */
 #define TMR_ONE_SHOT	2
+
+/*!	\brief Software timer mode
+ *
+ *	Can be or-ed to \e TMR_ONE_SHOT or \e TMR_PERIODIC. The call-back function of the expired timer won't be executed from
+ *	the uSMARTX_Tick() context but from the timer task TMR_Task().
+ */
+#define TMR_DEFERRED	16
+
+/*!	\brief Timer wheel size
+ *
+ *	Each level of the timer wheel has 2^TMR_WHEEL_BITS slots. The number of levels is chosen to cover all 16 bit timeouts.
+ *	More bits mean less cascading of timers between the levels, but each slot takes a queue_t of RAM. The whole wheel must not
+ *	have more than 256 slots, so TMR_WHEEL_BITS must not exceed 6.
+ */
+#ifndef TMR_WHEEL_BITS
+#define TMR_WHEEL_BITS	4
+#endif
 /*!	@}*/
 
 #define TMR_NOT_ACTIVE	4
 #define TMR_ACTIVE		8
+#define TMR_PENDING		32
+
+#define TMR_WHEEL_SIZE		(1 << TMR_WHEEL_BITS)
+#define TMR_WHEEL_MASK		(TMR_WHEEL_SIZE - 1)
+#define TMR_WHEEL_LEVELS	((16 + TMR_WHEEL_BITS - 1) / TMR_WHEEL_BITS)
 
 
 typedef struct tic_s {
 	struct dll_s *pnxt;
 	struct dll_s *pprv;
 
-	uint16 abs;			/* Absolute ticks */
-	uint16 rel;			/* Relative ticks to next timer in queue */
+	uint16 abs;			/* Timeout ticks */
+	uint16 exp;			/* Tick at which the timer expires */
 	
 	/* Callback function of timer. It is called with three parameters:
 	 * - event number
@@ -201,6 +223,7 @@ typedef struct tic_s {
 	void *parg2;
 	
 	uint8 flags;		/* timer flags */
+	uint8 slot;			/* Timer wheel slot the timer is enqueued in */
 	
 } tic_t;
 
@@ -261,6 +284,7 @@ void TMR_Start(HANDLE *ph, uint16 tout, STATUS(*pfxn)(uint8, void*, void*), uint
 void TMR_ReStart(HANDLE *ph);
 void TMR_Stop(HANDLE *ph);
 uint32 TMR_GetTicks(void);
+STATUS TMR_Task(STATUS event);
 
 
 /*!	\addtogroup uSMARTX_api_system
@@ -301,6 +325,8 @@ void INT_Restore(size_t flags);
 /* Internal functions */
 
 void timer_enqueue(tic_t *ptic);
+void timer_rearm(tic_t *ptic);
+void timer_insert(tic_t *ptic);
 void timer_dequeue(tic_t *ptic);
 void remove_timeout(tic_t *ptic);
 void append_timeout(tcb_t *ptcb, STATUS (*pfxn)(uint8 evt, void *parg1, void *parg2), uint16 tout);
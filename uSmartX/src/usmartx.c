@@ -147,8 +147,8 @@
  *  is that the function must be executed with interrupts disabled. Usually this function is placed in an interrupt service rutine which is triggered
  *  by a timer or by an external event. The system timer tick resolution is determined by the frequency the function is called.
  *	
- *	All timers (pending system calls incorporate a timer) are enqueued in a relative timer queue. This means only one timer is evaluated. All others
- *  are relative to the first one which has the shortest expiration time. This increases performance drasticaly when dealing with multiple software timers.
+ *	All timers (pending system calls incorporate a timer) are enqueued in a hierarchical timer wheel. Starting and stopping a timer takes constant
+ *  time and each system tick only one slot of the wheel is evaluated, no matter how many software timers are running.
  * 
  *	\warning If the system timer tick functionality is not needed, pending system calls musn't be called with a timeout value. \e NO_WAIT should
  *	be used for specifying the timeout. 
@@ -178,6 +178,11 @@
  *	The H8 architecture disables/enables interrupts by
  *	clearing/setting the I bit in the CCR register.
  *
+ *	\subsection host_port Linux host
+ *
+ *	The host port runs the kernel in a single process and calls uSMARTX_Tick() from the main loop, so the interrupt functions
+ *	are empty. It is used to benchmark the kernel, see usmartx/host/linux/test/.
+ *
  *  \section examples Sample applications
  *	
  *	Plase see the related pages for some sample applications. The examples are to be used with an ATmega64 device
@@ -219,8 +224,14 @@
 /*!	\example timers.c
  */
 
-/* Timer queue */
-volatile queue_t g_timerq;			/* Timer queue */
+/* Timer wheel. Level n holds the timers expiring within 2^(TMR_WHEEL_BITS * (n + 1)) ticks */
+volatile queue_t g_tmr_wheel[TMR_WHEEL_LEVELS * TMR_WHEEL_SIZE];
+
+/* Expired deferred timers waiting for the timer task */
+volatile queue_t g_tmr_expq;
+
+/* Timer task, known after TMR_Task() was run the first time */
+volatile tcb_t *g_tmr_ptcb;
 
 /* Elapsed timer ticks since OS start */
 volatile uint32 g_ticks;
@@ -244,8 +255,15 @@ volatile queue_t g_taskq;		    /* Global tasks queue. All tasks waiting for CPU
  */
 void uSMARTX_Init(task_entry_t *ptbl) {
 	tcb_t *ptcb;
-	/* Init timers pointer */	
-	g_timerq.pobject = 0;
+	uint16 i;
+	/* Init timer wheel */	
+	for( i = 0; i < TMR_WHEEL_LEVELS * TMR_WHEEL_SIZE; i++ ) {
+		g_tmr_wheel[i].pobject = 0;
+		g_tmr_wheel[i].plast = 0;
+	}
+	g_tmr_expq.pobject = 0;
+	g_tmr_expq.plast = 0;
+	g_tmr_ptcb = 0;
 	
 	/* Reset system ticks */
 	g_ticks = 0;
@@ -335,33 +353,45 @@ STATUS uSMARTX_Scheduler(void) {
  *	\attention This function must not be interrupted.
  */
 void uSMARTX_Tick(void) {
-	tic_t *ptic = (tic_t*) g_timerq.pobject;	
+	tic_t *ptic;
+	queue_t *pslot;
+	uint16 now;
+	uint8 level;
 		
     g_ticks++;
+    now = (uint16) g_ticks;
            	
-	/* If no active timer return. */
-    if( !ptic )
-    	return; 
+	/* Each time a level wraps around move the timers of the next slot of the upper level down. */
+	for( level = 1; level < TMR_WHEEL_LEVELS; level++ ) {
+		if( (now >> (TMR_WHEEL_BITS * (level - 1))) & TMR_WHEEL_MASK )
+			break;
+		pslot = (queue_t*) &g_tmr_wheel[level * TMR_WHEEL_SIZE + ((now >> (TMR_WHEEL_BITS * level)) & TMR_WHEEL_MASK)];
+		while( (ptic = (tic_t*) dequeue_top_object( pslot )) )
+			timer_insert( ptic );
+	}
     
-    /* Decrement relative ticks. If zero dequeue the timer(s) from the list. */	
-    if( --ptic->rel ) {    	
-    	return;
-    }
-    		
-	while( !ptic->rel ) {
-		ptic = (tic_t*) dequeue_top_object( (queue_t*) &g_timerq );
+	/* All timers in the current slot of the lowest level have expired. */
+	pslot = (queue_t*) &g_tmr_wheel[now & TMR_WHEEL_MASK];
+	while( (ptic = (tic_t*) dequeue_top_object( pslot )) ) {
+		ptic->flags &= ~TMR_ACTIVE;
 		
-		/* Clear the active flag and exec the callback function */
-		ptic->flags &= ~TMR_ACTIVE;									
-		ptic->pfxn(ptic->evt, ptic->parg1, ptic->parg2);
+		/* Pass deferred timers to the timer task and wake it up */
+		if( (ptic->flags & TMR_DEFERRED) && g_tmr_ptcb ) {
+			ptic->flags |= TMR_PENDING;
+			enqueue_bottom_object( (queue_t*) &g_tmr_expq, (dll_t*) ptic );
+			if( g_tmr_ptcb->flags == TSK_SUSPENDED ) {
+				g_tmr_ptcb->flags = TSK_READY;
+				priority_enqueue_tsk( (tcb_t*) g_tmr_ptcb );
+			}
+			continue;
+		}
 		
-		/* If timer is of periodic type enqueue it again */
-		if( ptic->flags & TMR_PERIODIC )
-			timer_enqueue( ptic );
+		/* Exec the callback function */
+		ptic->pfxn(ptic->evt, ptic->parg1, ptic->parg2);
 		
-		/* Check if there are more elapsed timers */
-		if( !(ptic = (tic_t*) g_timerq.pobject) )		
-			return;
+		/* If timer is of periodic type enqueue it again, unless the callback has re-started it */
+		if( (ptic->flags & TMR_PERIODIC) && !(ptic->flags & (TMR_ACTIVE | TMR_PENDING)) )
+			timer_rearm( ptic );
 	}		
 }
 /*!	@}
@@ -446,9 +476,11 @@ void TSK_Resume(HANDLE *ph) {
  *	@{
  *	In addition to time control over tasks the uSmartX kernel provides another way of time control via software timers. Each system tick
  *	software timers are evaluated. If one or more timers expires the tiemr associated call-back function is executed. the uSmartX kernel places
- *	timers in a so called relative time queue, where each timer expiration is relative to the preceeding timer. Timers that will expire at the
- *	same time have 0 relative ticks. In this way each system tick only one timer is evaluated. This increase performances drasticaly.
- *	Please note that the call-back function will be executed from uSMARTX_Tick() function context.
+ *	timers in a hierarchical timer wheel. The lowest level has one slot for each of the next 2^TMR_WHEEL_BITS ticks, each upper level has slots
+ *	covering 2^TMR_WHEEL_BITS times more ticks. When a level wraps around, the timers of the next upper slot are moved down. In this way starting
+ *	and stopping a timer takes constant time and each system tick only one slot is evaluated.
+ *	Please note that the call-back function will be executed from uSMARTX_Tick() function context, unless the timer was started with the
+ *	\e TMR_DEFERRED mode. The call-back function of such a timer is executed from the TMR_Task() task.
  *	\n\n
  *	The call back function must be of type:
  *	\code STATUS my_callback_func(uint8, void*, void*)
@@ -465,8 +497,9 @@ void TSK_Resume(HANDLE *ph) {
  *  \param evt		event to be passed to the call-back function
  *  \param parg1	argument 1 to be passed to the call-back function
  *  \param parg2	argument 2 to be passed to the call-back function
- *  \param mode		one-shot or periodic mode
+ *  \param mode		one-shot or periodic mode, optionally or-ed with \e TMR_DEFERRED
  *	\attention		The callback function will be executed from the context where uSMARTX_Tick function was called.
+ *					A timeout value of 0 is handled like 1.
  */
 void TMR_Start(HANDLE *ph, uint16 tout, STATUS(*pfxn)(uint8, void*, void*), uint8 evt, void *parg1, void *parg2, uint8 mode) {
 	size_t flags;
@@ -475,7 +508,7 @@ void TMR_Start(HANDLE *ph, uint16 tout, STATUS(*pfxn)(uint8, void*, void*), uint
 	flags = INT_Disable();
 	
 	/* If timer already active dequeue it first */
-	if( ptic->flags & TMR_ACTIVE )
+	if( ptic->flags & (TMR_ACTIVE | TMR_PENDING) )
 	  timer_dequeue( ptic );
 
     ptic->abs = tout;
@@ -483,7 +516,7 @@ void TMR_Start(HANDLE *ph, uint16 tout, STATUS(*pfxn)(uint8, void*, void*), uint
 	ptic->evt = evt;
 	ptic->parg1 = parg1;
 	ptic->parg2 = parg2;
-	ptic->flags	|= mode;	
+	ptic->flags	= (ptic->flags & ~(TMR_PERIODIC | TMR_ONE_SHOT | TMR_DEFERRED)) | mode;	
 	timer_enqueue( ptic );
 	
 	INT_Restore( flags ); 
@@ -503,7 +536,7 @@ void TMR_ReStart(HANDLE *ph) {
 	flags = INT_Disable();
 	
 	/* If timer already active dequeue it first */
-	if( ptic->flags & TMR_ACTIVE )
+	if( ptic->flags & (TMR_ACTIVE | TMR_PENDING) )
 	  timer_dequeue( ptic );
 	  
 	timer_enqueue( ptic );
@@ -522,7 +555,7 @@ void TMR_Stop(HANDLE *ph) {
 
 	flags = INT_Disable();
 	
-	if( ptic->flags & TMR_ACTIVE )
+	if( ptic->flags & (TMR_ACTIVE | TMR_PENDING) )
 		timer_dequeue( ptic );
 		
 	INT_Restore( flags ); 
@@ -547,6 +580,50 @@ uint32 TMR_GetTicks(void) {
 	return tmp2;
 }
 
+/*! \brief Timer task
+ *
+ *	This task executes the call-back functions of expired timers started with the \e TMR_DEFERRED mode, so they don't extend
+ *	the uSMARTX_Tick() context. Add the task with its own TCB to the tasks table. Its priority decides when the call-back functions
+ *	run compared to other tasks. The task suspends itself when there are no more expired timers and it is resumed by uSMARTX_Tick().
+ *	Until the task was run the first time deferred call-back functions are executed from uSMARTX_Tick().
+ *	\code
+ 	TSK_CREATE(TMR_tcb);
+ 	
+	task_entry_t task_tbl[] = {	{&TMR_Task, &TMR_tcb, 0, "TIMER"},
+								{&TSK1, &TSK1_tcb, 1, "TASK1"},
+								{0, 0} };
+ *	\endcode
+ *
+ *  \param event	task entry event
+ *	\retval SYS_OK
+ */
+STATUS TMR_Task(STATUS event) {
+	size_t flags;
+	tic_t *ptic;
+	tcb_t *ptcb = get_curr_tsk();
+	
+	flags = INT_Disable();
+	g_tmr_ptcb = ptcb;
+	
+	while( (ptic = (tic_t*) dequeue_top_object( (queue_t*) &g_tmr_expq )) ) {
+		ptic->flags &= ~TMR_PENDING;
+		INT_Restore( flags );
+		
+		ptic->pfxn(ptic->evt, ptic->parg1, ptic->parg2);
+		
+		/* Periodic timers are enqueued again relative to the tick they expired, unless the callback has re-started them */
+		flags = INT_Disable();
+		if( (ptic->flags & TMR_PERIODIC) && !(ptic->flags & (TMR_ACTIVE | TMR_PENDING)) )
+			timer_rearm( ptic );
+	}
+	
+	/* Wait until uSMARTX_Tick() passes the next expired timer */
+	ptcb->flags = TSK_SUSPENDED;
+	INT_Restore( flags );
+	
+	return SYS_OK;
+}
+
 ///*! \brief Get free CPU running counter
 // *
 // *	This function is called from the scheduler to get the curret ticks of a CPU timer.
@@ -567,45 +644,44 @@ uint32 TMR_GetTicks(void) {
  */
  
  
- /* Insert a timer in a timer the queue */
+ /* Insert a timer in the timer wheel, the timer expires after abs ticks */
 void timer_enqueue(tic_t *ptic) {
-	uint16 ticks;
-	tic_t *t;
+	ptic->exp = (uint16) g_ticks + (ptic->abs ? ptic->abs : 1);
+	timer_insert( ptic );
+}
+
+/* Insert a periodic timer again. The next expiration is relative to the last one if the timer is not late by a whole period. */
+void timer_rearm(tic_t *ptic) {
+	uint16 late = (uint16) g_ticks - ptic->exp;
 	
-    ptic->flags |= TMR_ACTIVE;
-	ticks = ptic->abs;
-	if( (t = (tic_t*) g_timerq.pobject) ) {
-		while( t->rel <= ticks) {
-			ticks -= t->rel;
-			if( t->pnxt )			
-				t = (tic_t*) t->pnxt;
-			else {
-				ptic->rel = ticks;
-				enqueue_bottom_object( (queue_t*) &g_timerq, (dll_t*) ptic );
-				return;
-			}
-		}	
-		ptic->rel = ticks;
-		t->rel -= ticks;		
-		if( t->pprv )
-			enqueue_middle_object( (dll_t*) t, (dll_t*) ptic );			
-		else 
-			enqueue_top_object( (queue_t*) &g_timerq, (dll_t*) ptic );
-	}
-    else {
-    	ptic->rel = ticks;
-	    enqueue_top_object( (queue_t*) &g_timerq, (dll_t*) ptic );
-    }
+	if( late < ptic->abs )
+		ptic->exp += ptic->abs;
+	else
+		ptic->exp = (uint16) g_ticks + 1;
+	timer_insert( ptic );
+}
+
+/* Insert a timer in the slot of its expiration tick, on the lowest level that covers the remaining ticks */
+void timer_insert(tic_t *ptic) {
+	uint16 ticks = ptic->exp - (uint16) g_ticks;
+	uint8 level = 0;
+	
+	while( (level < TMR_WHEEL_LEVELS - 1) && (ticks >> (TMR_WHEEL_BITS * (level + 1))) )
+		level++;
+	
+	ptic->flags |= TMR_ACTIVE;
+	ptic->slot = level * TMR_WHEEL_SIZE + ((ptic->exp >> (TMR_WHEEL_BITS * level)) & TMR_WHEEL_MASK);
+	enqueue_bottom_object( (queue_t*) &g_tmr_wheel[ptic->slot], (dll_t*) ptic );
 }
 
-/* Dequeue a timer from timer list */
+/* Dequeue a timer from the timer wheel or from the expired timers queue */
 void timer_dequeue(tic_t *ptic) {
-	ptic->flags &= ~TMR_ACTIVE;
-	/* If this is not the last timer add the relative ticks to the next timer */
-	if( ptic->pnxt )		
-		((tic_t*)ptic->pnxt)->rel += ptic->rel;
+	if( ptic->flags & TMR_PENDING )
+		dequeue_object( (queue_t*) &g_tmr_expq, (dll_t*) ptic );
+	else
+		dequeue_object( (queue_t*) &g_tmr_wheel[ptic->slot], (dll_t*) ptic );
 	
-	dequeue_object( (queue_t*) &g_timerq, (dll_t*) ptic );
+	ptic->flags &= ~(TMR_ACTIVE | TMR_PENDING);
 }
 
 /* Append a timer to the task */